@@ -0,0 +1,142 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+
+#include "voreen/core/voreenapplication.h"
+#include "voreen/core/datastructures/octree/octreebrickpoolmanager.h"
+#include "voreen/core/datastructures/octree/octreebrickpoolmanagerdisk.h"
+#include "voreen/core/utils/stringutils.h"
+
+#include "tgt/filesystem.h"
+#include "tgt/stopwatch.h"
+
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+using namespace voreen;
+
+/**
+ * Measures the throughput of concurrent getBrick()/releaseBrick() calls on the
+ * octree brick pool managers for an increasing number of threads.
+ *
+ * Usage: brickpoolbenchmark [maxNumThreads] [numAccessesPerThread]
+ */
+
+const size_t BRICK_DIM = 16;
+const size_t BRICK_MEMORY_SIZE = BRICK_DIM*BRICK_DIM*BRICK_DIM*sizeof(uint16_t);
+const size_t NUM_BRICKS = 4096;                     // 32 MB brick pool
+const size_t BUFFER_SIZE = 1 << 20;                 // 1 MB buffers => 128 bricks per buffer
+const size_t DISK_RAM_LIMIT = 16 << 20;             // half of the pool fits into the RAM
+
+/// Worker: reads random bricks and touches their first voxel.
+void accessBricks(const OctreeBrickPoolManagerBase* manager, const std::vector<uint64_t>* addresses,
+                  size_t numAccesses, unsigned int seed, uint64_t* checksum)
+{
+    uint64_t sum = 0;
+    unsigned int state = seed;
+    for (size_t i = 0; i < numAccesses; i++) {
+        // linear congruential generator, since rand() is not thread-safe
+        state = state * 1103515245u + 12345u;
+        uint64_t address = (*addresses)[(state >> 8) % addresses->size()];
+        const uint16_t* brick = manager->getBrick(address);
+        sum += brick[0];
+        manager->releaseBrick(address);
+    }
+    *checksum = sum;
+}
+
+/// Runs the benchmark with 1..maxNumThreads threads on the passed (uninitialized) manager.
+void benchmarkManager(OctreeBrickPoolManagerBase* manager, const std::string& name, size_t maxNumThreads, size_t numAccesses) {
+    manager->initialize(BRICK_MEMORY_SIZE);
+
+    std::vector<uint64_t> addresses;
+    for (size_t i = 0; i < NUM_BRICKS; i++) {
+        uint64_t address = manager->allocateBrick();
+        uint16_t* brick = manager->getWritableBrick(address);
+        brick[0] = static_cast<uint16_t>(i);
+        manager->releaseBrick(address, OctreeBrickPoolManagerBase::WRITE);
+        addresses.push_back(address);
+    }
+
+    std::cout << name << ":" << std::endl;
+    double singleThreadRate = 0.0;
+    for (size_t numThreads = 1; numThreads <= maxNumThreads; numThreads *= 2) {
+        std::vector<boost::thread*> threads;
+        std::vector<uint64_t> checksums(numThreads, 0);
+
+        uint64_t startTicks = tgt::Stopwatch::getTicks();
+        for (size_t t = 0; t < numThreads; t++)
+            threads.push_back(new boost::thread(boost::bind(&accessBricks, manager, &addresses, numAccesses,
+                static_cast<unsigned int>(t+1), &checksums[t])));
+        for (size_t t = 0; t < numThreads; t++) {
+            threads[t]->join();
+            delete threads[t];
+        }
+        uint64_t runtime = std::max<uint64_t>(tgt::Stopwatch::getTicks() - startTicks, 1);
+
+        double rate = static_cast<double>(numThreads*numAccesses) / (static_cast<double>(runtime) / 1000.0);
+        if (numThreads == 1)
+            singleThreadRate = rate;
+        std::cout << "  " << std::setw(3) << numThreads << " threads: " << std::setw(8) << runtime << " ms, "
+                  << std::setw(12) << static_cast<uint64_t>(rate) << " accesses/s, speedup "
+                  << std::setprecision(3) << rate / singleThreadRate << std::endl;
+    }
+    std::cout << "  " << manager->getDescription() << std::endl << std::endl;
+
+    manager->deinitialize();
+    delete manager;
+}
+
+int main(int argc, char** argv) {
+    VoreenApplication app("brickpoolbenchmark", "brickpoolbenchmark", "Benchmarks concurrent brick access of the octree brick pool managers", argc, argv);
+    app.initialize();
+
+    size_t maxNumThreads = boost::thread::hardware_concurrency();
+    size_t numAccesses = 1000000;
+    if (argc > 1)
+        maxNumThreads = static_cast<size_t>(stoi(argv[1]));
+    if (argc > 2)
+        numAccesses = static_cast<size_t>(stoi(argv[2]));
+    maxNumThreads = std::max<size_t>(maxNumThreads, 1);
+
+    std::cout << "BrickPoolBenchmark: " << NUM_BRICKS << " bricks of " << BRICK_MEMORY_SIZE << " bytes, "
+              << numAccesses << " accesses per thread" << std::endl << std::endl;
+
+    benchmarkManager(new OctreeBrickPoolManagerRAM(BUFFER_SIZE), "OctreeBrickPoolManagerRAM", maxNumThreads, numAccesses);
+
+    std::string brickPoolPath = app.getTemporaryPath("brickpoolbenchmark");
+    if (!tgt::FileSystem::dirExists(brickPoolPath))
+        tgt::FileSystem::createDirectory(brickPoolPath);
+    benchmarkManager(new OctreeBrickPoolManagerDisk(BUFFER_SIZE, DISK_RAM_LIMIT, brickPoolPath),
+        "OctreeBrickPoolManagerDisk", maxNumThreads, numAccesses);
+    tgt::FileSystem::deleteDirectoryRecursive(brickPoolPath);
+
+    app.deinitialize();
+    return 0;
+}
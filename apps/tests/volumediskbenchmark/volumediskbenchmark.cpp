@@ -0,0 +1,166 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+
+#include "voreen/core/voreenapplication.h"
+#include "voreen/core/datastructures/volume/volumedisk.h"
+#include "voreen/core/datastructures/volume/volumeatomic.h"
+#include "voreen/core/utils/stringutils.h"
+
+#include "tgt/filesystem.h"
+#include "tgt/stopwatch.h"
+
+using namespace voreen;
+using tgt::svec3;
+
+/**
+ * Compares the row-wise brick reading formerly used by VolumeDiskRaw::loadBrick
+ * (one read and one seek per brick row) with the coalesced reads of the current
+ * implementation, for cubic bricks of 32^3 to 512^3 voxels. For each brick size, the
+ * results of both methods are compared first and the benchmark fails if they differ.
+ *
+ * Usage: volumediskbenchmark [volumeDim] [numRepetitions]
+ */
+
+/// Reference implementation: reads the brick row by row via std::ifstream.
+void loadBrickRowWise(const std::string& filename, const svec3& volumeDim, size_t bytesPerVoxel,
+                      const svec3& brickOffset, const svec3& brickDim, char* dest)
+{
+    std::ifstream infile(filename.c_str(), std::ios::in | std::ios::binary);
+    infile.seekg((volumeDim.x*volumeDim.y*brickOffset.z + volumeDim.x*brickOffset.y + brickOffset.x)*bytesPerVoxel);
+
+    size_t numBytesPerLine = brickDim.x * bytesPerVoxel;
+    for (size_t z = 0; z < brickDim.z; z++) {
+        for (size_t y = 0; y < brickDim.y; y++) {
+            infile.read(dest, numBytesPerLine);
+            dest += numBytesPerLine;
+            infile.seekg((volumeDim.x-brickDim.x)*bytesPerVoxel, std::ios_base::cur);
+        }
+        infile.seekg((volumeDim.y-brickDim.y)*volumeDim.x*bytesPerVoxel, std::ios_base::cur);
+    }
+}
+
+/// Returns the average runtime of the passed number of reads in ms.
+double benchmarkRowWise(const VolumeDiskRaw& disk, const svec3& brickDim, size_t numRepetitions, VolumeRAM* dest) {
+    uint64_t startTicks = tgt::Stopwatch::getTicks();
+    for (size_t i = 0; i < numRepetitions; i++) {
+        svec3 brickOffset = (disk.getDimensions() - brickDim) * i / std::max<size_t>(numRepetitions - 1, 1);
+        loadBrickRowWise(disk.getFileName(), disk.getDimensions(), disk.getBytesPerVoxel(), brickOffset, brickDim,
+            reinterpret_cast<char*>(dest->getData()));
+    }
+    return static_cast<double>(tgt::Stopwatch::getTicks() - startTicks) / numRepetitions;
+}
+
+/// Returns the average runtime of the passed number of reads in ms.
+double benchmarkCoalesced(const VolumeDiskRaw& disk, const svec3& brickDim, size_t numRepetitions, VolumeRAM* dest) {
+    uint64_t startTicks = tgt::Stopwatch::getTicks();
+    for (size_t i = 0; i < numRepetitions; i++) {
+        svec3 brickOffset = (disk.getDimensions() - brickDim) * i / std::max<size_t>(numRepetitions - 1, 1);
+        disk.loadBrick(brickOffset, brickDim, dest);
+    }
+    return static_cast<double>(tgt::Stopwatch::getTicks() - startTicks) / numRepetitions;
+}
+
+/// Reads the same unaligned brick with both methods and returns true, if the results are identical.
+bool verifyBrick(const VolumeDiskRaw& disk, const svec3& brickDim) {
+    svec3 brickOffset = (disk.getDimensions() - brickDim) / size_t(3) + svec3(1, 0, 1);
+    brickOffset = tgt::min(brickOffset, disk.getDimensions() - brickDim);
+
+    VolumeRAM_UInt8 rowWise(brickDim);
+    VolumeRAM_UInt8 coalesced(brickDim);
+    loadBrickRowWise(disk.getFileName(), disk.getDimensions(), disk.getBytesPerVoxel(), brickOffset, brickDim,
+        reinterpret_cast<char*>(rowWise.getData()));
+    disk.loadBrick(brickOffset, brickDim, &coalesced);
+    return memcmp(rowWise.getData(), coalesced.getData(), rowWise.getNumBytes()) == 0;
+}
+
+int main(int argc, char** argv) {
+    VoreenApplication app("volumediskbenchmark", "volumediskbenchmark", "Benchmarks brick reads from raw volume files", argc, argv);
+    app.initialize();
+
+    size_t volumeDim = 576;
+    size_t numRepetitions = 8;
+    if (argc > 1)
+        volumeDim = static_cast<size_t>(stoi(argv[1]));
+    if (argc > 2)
+        numRepetitions = static_cast<size_t>(stoi(argv[2]));
+    numRepetitions = std::max<size_t>(numRepetitions, 1);
+
+    // write uint8 test volume slice by slice
+    std::string filename = app.getTemporaryPath("volumediskbenchmark.raw");
+    {
+        std::ofstream outfile(filename.c_str(), std::ios::out | std::ios::binary);
+        std::vector<char> slice(volumeDim*volumeDim);
+        for (size_t z = 0; z < volumeDim; z++) {
+            for (size_t i = 0; i < slice.size(); i++)
+                slice[i] = static_cast<char>(i + z);
+            outfile.write(&slice[0], slice.size());
+        }
+        if (outfile.fail()) {
+            std::cerr << "Failed to write test volume: " << filename << std::endl;
+            return 1;
+        }
+    }
+    VolumeDiskRaw disk(filename, "uint8", svec3(volumeDim));
+
+    std::cout << "VolumeDiskBenchmark: " << volumeDim << "^3 uint8 volume, "
+              << numRepetitions << " reads per brick size (warm file cache)" << std::endl << std::endl;
+    std::cout << "  brick     row-wise    coalesced    speedup" << std::endl;
+
+    bool mismatch = false;
+    for (size_t brickSize = 32; brickSize <= 512 && brickSize <= volumeDim; brickSize *= 2) {
+        svec3 brickDim(brickSize);
+        if (!verifyBrick(disk, brickDim)) {
+            std::cerr << "  " << brickSize << "^3: coalesced read differs from row-wise read" << std::endl;
+            mismatch = true;
+            continue;
+        }
+
+        VolumeRAM_UInt8* dest = new VolumeRAM_UInt8(brickDim);
+
+        // warm up file cache
+        disk.loadBrick(svec3::zero, brickDim, dest);
+
+        double rowWise = benchmarkRowWise(disk, brickDim, numRepetitions, dest);
+        double coalesced = benchmarkCoalesced(disk, brickDim, numRepetitions, dest);
+        std::cout << "  " << std::setw(3) << brickSize << "^3 "
+                  << std::setw(9) << std::fixed << std::setprecision(2) << rowWise << " ms "
+                  << std::setw(9) << coalesced << " ms "
+                  << std::setw(9) << rowWise / std::max(coalesced, 0.01) << std::endl;
+        delete dest;
+    }
+
+    tgt::FileSystem::deleteFile(filename);
+
+    app.deinitialize();
+    return (mismatch ? 1 : 0);
+}
@@ -0,0 +1,225 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "voreen/core/datastructures/volume/volume.h"
+#include "voreen/core/datastructures/volume/volumeatomic.h"
+#include "voreen/core/datastructures/volume/operators/volumeoperatorresample.h"
+#include "voreen/core/voreenapplication.h"
+
+using namespace voreen;
+
+typedef void (*TestFunctionPointer)();
+
+int testsNum = 0;
+int successNum = 0;
+int failureNum = 0;
+
+/**
+ * Throws given failureMessage if condition is @c false.
+ *
+ * @throws std::string if condition is @c false
+ */
+void test(const bool& condition, const std::string& failureMessage) throw(std::string) {
+    if (!condition)
+        throw failureMessage;
+}
+
+/**
+ * Throws modified given failure message if @c actual deviates from @c expected by more than @c epsilon.
+ *
+ * @throws std::string if the values differ
+ */
+void testNear(float actual, float expected, float epsilon, const std::string& failureMessage) throw(std::string) {
+    std::stringstream s;
+    s << failureMessage << " [actual: " << actual << ", expected: " << expected << "]";
+    test(std::fabs(actual - expected) <= epsilon, s.str());
+}
+
+/**
+ * Runs the given test function and gives a status report on standard output stream.
+ *
+ * @note In case of a throw exception except std::string,
+ *       the application terminates with error code 1.
+ */
+void runTest(const TestFunctionPointer& testFunction, const std::string& testName) {
+    std::cout << "Testing " << testName << "... ";
+
+    testsNum++;
+    try {
+        try {
+            testFunction();
+        }
+        catch (const tgt::Exception& e) {
+            test(false, "tgt::Exception thrown: " + std::string(e.what()));
+        }
+    }
+    catch (const std::string& failureMessage) {
+        std::cout << "[failure]" << std::endl;
+        std::cout << "  Reason: " << failureMessage << std::endl;;
+        failureNum++;
+        return;
+    }
+    catch (...) {
+        std::cout << "[fatal]" << std::endl;
+        std::cout << "  Unknown exception thrown." << std::endl;
+        exit(1);
+    }
+
+    std::cout << "[success]" << std::endl;
+    successNum++;
+}
+
+/// Creates a volume of the passed dimensions whose values rise linearly along x from minValue to maxValue.
+template<typename T>
+Volume* createRampVolume(const tgt::svec3& dims, float minValue, float maxValue) {
+    VolumeAtomic<T>* ram = new VolumeAtomic<T>(dims);
+    for (size_t z = 0; z < dims.z; z++)
+        for (size_t y = 0; y < dims.y; y++)
+            for (size_t x = 0; x < dims.x; x++)
+                ram->voxel(x, y, z) = static_cast<T>(minValue + (maxValue - minValue) * x / (dims.x - 1));
+    return new Volume(ram, tgt::vec3(1.f), tgt::vec3(0.f));
+}
+
+/// Resamples the volume along x. The result volume is owned by the caller.
+Volume* resampleX(const Volume* volume, int targetDimX, VolumeRAM::Filter filter) {
+    tgt::ivec3 dims(volume->getDimensions());
+    dims.x = targetDimX;
+    Volume* result = VolumeOperatorResample::APPLY_OP(volume, dims, filter);
+    test(result != 0, "no result volume");
+    test(tgt::ivec3(result->getDimensions()) == dims, "result volume has invalid dimensions");
+    return result;
+}
+
+/**
+ * Catmull-Rom splines reproduce linear functions, so cubic resampling of a float ramp within [-100, 100]
+ * has to yield the ramp values at the interior positions, not values clamped to [0, 1].
+ */
+void testCubicFloatRamp() {
+    const size_t sourceDimX = 11;
+    const int targetDimX = 21;
+    Volume* source = createRampVolume<float>(tgt::svec3(sourceDimX, 4, 3), -100.f, 100.f);
+    Volume* result = resampleX(source, targetDimX, VolumeRAM::CUBIC);
+    const VolumeRAM_Float* resultRAM = result->getRepresentation<VolumeRAM_Float>();
+    test(resultRAM != 0, "result is not a float volume");
+
+    const float ratio = static_cast<float>(sourceDimX) / static_cast<float>(targetDimX);
+    float minValue = resultRAM->voxel(0, 0, 0);
+    float maxValue = minValue;
+    for (int x = 0; x < targetDimX; x++) {
+        const float value = resultRAM->voxel(x, 2, 1);
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+
+        // positions whose four taps lie within the volume
+        const float pos = std::max(x*ratio - 0.5f, 0.f);
+        if (pos >= 1.f && pos < static_cast<float>(sourceDimX) - 2.f) {
+            std::stringstream s;
+            s << "cubic interpolation of ramp incorrect at x=" << x;
+            testNear(value, -100.f + 20.f*pos, 0.01f, s.str());
+        }
+    }
+    testNear(minValue, -100.f, 0.01f, "minimum of resampled ramp incorrect");
+    test(maxValue > 90.f, "maximum of resampled ramp has been clamped");
+
+    delete result;
+    delete source;
+}
+
+/// Linear resampling of a float ramp within [-100, 100] has to preserve the value range.
+void testLinearFloatRamp() {
+    Volume* source = createRampVolume<float>(tgt::svec3(11, 3, 3), -100.f, 100.f);
+    Volume* result = resampleX(source, 21, VolumeRAM::LINEAR);
+    const VolumeRAM_Float* resultRAM = result->getRepresentation<VolumeRAM_Float>();
+    test(resultRAM != 0, "result is not a float volume");
+
+    testNear(resultRAM->voxel(0, 1, 1), -100.f, 0.01f, "first value of resampled ramp incorrect");
+    for (size_t x = 1; x < 21; x++)
+        test(resultRAM->voxel(x, 1, 1) > resultRAM->voxel(x-1, 1, 1), "resampled ramp is not increasing");
+    test(resultRAM->voxel(20, 1, 1) > 90.f, "maximum of resampled ramp has been clamped");
+
+    delete result;
+    delete source;
+}
+
+/**
+ * The overshoot of cubic resampling at a step edge must be clamped to the range of integer types
+ * instead of wrapping around.
+ */
+void testCubicIntegerStepClamped() {
+    const tgt::svec3 dims(8, 2, 2);
+    VolumeRAM_Int8* ram = new VolumeRAM_Int8(dims);
+    for (size_t i = 0; i < ram->getNumVoxels(); i++)
+        ram->voxel(i) = ((i % dims.x) < dims.x/2 ? -128 : 127);
+    Volume* source = new Volume(ram, tgt::vec3(1.f), tgt::vec3(0.f));
+
+    Volume* result = resampleX(source, 29, VolumeRAM::CUBIC);
+    const VolumeRAM_Int8* resultRAM = result->getRepresentation<VolumeRAM_Int8>();
+    test(resultRAM != 0, "result is not an int8 volume");
+
+    // the step lies between source samples 3 and 4: a wrap-around of the over-/undershoot would flip the sign
+    const float ratio = static_cast<float>(dims.x) / 29.f;
+    for (int x = 0; x < 29; x++) {
+        const float pos = std::max(x*ratio - 0.5f, 0.f);
+        std::stringstream s;
+        s << "overshoot at step edge has not been clamped at x=" << x << " [value: " << (int)resultRAM->voxel(x, 1, 1) << "]";
+        if (pos <= 3.f)
+            test(resultRAM->voxel(x, 1, 1) < -100, s.str());
+        else if (pos >= 4.f)
+            test(resultRAM->voxel(x, 1, 1) > 100, s.str());
+    }
+
+    delete result;
+    delete source;
+}
+
+/**
+ * Runs volume resampling tests.
+ */
+int main(int argc, char** argv) {
+    VoreenApplication app("volumeresampletest", "volumeresampletest", "Tests the VolumeOperatorResample", argc, argv);
+    app.initialize();
+    std::cout << "VolumeResampleTest application started..." << std::endl << std::endl;
+
+    runTest(testCubicFloatRamp, "cubic resampling of float volume within [-100, 100]");
+    runTest(testLinearFloatRamp, "linear resampling of float volume within [-100, 100]");
+    runTest(testCubicIntegerStepClamped, "cubic resampling of int8 step edge");
+
+    std::cout << std::endl << "VolumeResampleTest application finished..." << std::endl;
+    std::cout << std::endl << "---" << std::endl;
+    std::cout << testsNum << " tests run, " << successNum << " successful and " << failureNum << " failed." << std::endl;
+
+    app.deinitialize();
+
+    if(successNum == testsNum)
+        return 0;
+    else
+        exit(EXIT_FAILURE);
+}
@@ -38,6 +38,7 @@
 #include "voreen/core/network/processornetwork.h"
 #include "voreen/core/properties/buttonproperty.h"
 #include "voreen/core/utils/stringutils.h"
+#include "voreen/core/utils/tracing.h"
 
 #include "voreen/qt/voreenapplicationqt.h"
 
@@ -154,6 +155,11 @@ int main(int argc, char* argv[]) {
     cmdParser->addFlagOption("trigger-geometrysaves", triggerGeometrySaves, CommandLineParser::MainOption,
         "Trigger a \"save file\" event on all GeometrySave and TextSave processors after the network has been evaluated.");
 
+    std::string traceFilename;
+    cmdParser->addOption<std::string>("trace", traceFilename, CommandLineParser::MainOption,
+        "Record a trace of the network evaluation and write it to the specified file "
+        "in the Chrome trace event format (viewable with chrome://tracing).");
+
     std::string scriptFilename;
 #ifdef VRN_MODULE_PYTHON
     vrnApp.getCommandLineParser()->addOption("script", scriptFilename, CommandLineParser::MainOption,
@@ -195,6 +201,8 @@ int main(int argc, char* argv[]) {
     // create network evaluator
     networkEvaluator_ = new NetworkEvaluator(glMode, initContext_);
     vrnApp.registerNetworkEvaluator(networkEvaluator_);
+    if (!traceFilename.empty())
+        Tracer::setEnabled(true);
 
     // load and execute workspace, if specified
     Workspace* workspace = 0;
@@ -235,6 +243,17 @@ int main(int argc, char* argv[]) {
         qtApp_->exec();
     }
 
+    // write trace
+    if (!traceFilename.empty()) {
+        try {
+            networkEvaluator_->writeChromeTrace(traceFilename);
+            LINFO("Trace written to " << traceFilename);
+        }
+        catch (VoreenException& e) {
+            LERROR(e.what());
+        }
+    }
+
     // clean up
     LINFO("Deinitializing network ...");
     networkEvaluator_->deinitializeNetwork();
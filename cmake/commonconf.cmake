@@ -240,6 +240,11 @@ ELSEIF(UNIX)
 
     LIST(APPEND VRN_DEFINITIONS "-DUNIX")  
     LIST(APPEND VRN_DEFINITIONS "-D__STDC_CONSTANT_MACROS")  
+
+    IF(NOT APPLE)
+        # clock_gettime() is used by the tracing subsystem
+        LIST(APPEND VRN_EXTERNAL_LIBRARIES rt)
+    ENDIF()
     
     IF(VRN_DEPLOYMENT)
         MESSAGE("Unix deployment build")        
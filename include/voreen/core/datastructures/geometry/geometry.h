@@ -37,6 +37,9 @@
 
 namespace voreen {
 
+class GeometryBinarySerializer;
+class GeometryBinaryDeserializer;
+
 /**
  * Abstract base class for Geometry objects that
  * can be passed through GeometryPorts.
@@ -137,6 +140,18 @@ public:
      * Supposed to be overridden by each concrete subclass.
      */
     virtual void deserialize(XmlDeserializer& s);
+
+    /**
+     * Writes the geometry data to the binary geometry format (@see GeometryBinarySerializer).
+     * The transformation matrix is written by the serializer itself.
+     *
+     * The default implementation throws a SerializationException. Geometries whose data
+     * is stored in contiguous arrays override this method and its counterpart.
+     */
+    virtual void serializeBinary(GeometryBinarySerializer& s) const;
+
+    /// Reads the data written by serializeBinary(). @see GeometryBinaryDeserializer
+    virtual void deserializeBinary(GeometryBinaryDeserializer& s);
 private:
     tgt::mat4 transformationMatrix_;    ///< Usually model to world
 
@@ -33,6 +33,7 @@
 
 #include "voreen/core/io/serialization/xmlserializer.h"
 #include "voreen/core/io/serialization/xmldeserializer.h"
+#include "voreen/core/io/serialization/geometrybinaryserializer.h"
 
 namespace voreen {
 
@@ -133,6 +134,14 @@ public:
         Geometry::deserialize(s);
     }
 
+    virtual void serializeBinary(GeometryBinarySerializer& s) const {
+        s.writeVector(points_);
+    }
+
+    virtual void deserializeBinary(GeometryBinaryDeserializer& s) {
+        s.readVector(points_);
+    }
+
 protected:
     std::vector<T> points_;
 
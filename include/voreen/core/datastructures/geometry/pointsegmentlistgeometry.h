@@ -32,6 +32,7 @@
 
 #include "voreen/core/io/serialization/xmlserializer.h"
 #include "voreen/core/io/serialization/xmldeserializer.h"
+#include "voreen/core/io/serialization/geometrybinaryserializer.h"
 
 namespace voreen {
 
@@ -173,6 +174,26 @@ public:
         Geometry::deserialize(s);
     }
 
+    /// Writes the number of segments followed by one blob per segment.
+    virtual void serializeBinary(GeometryBinarySerializer& s) const {
+        s.write(static_cast<uint64_t>(segmentList_.size()));
+        for (size_t i=0; i<segmentList_.size(); ++i)
+            s.writeVector(segmentList_[i]);
+    }
+
+    virtual void deserializeBinary(GeometryBinaryDeserializer& s) {
+        uint64_t numSegments = 0;
+        s.read(numSegments);
+        std::vector< std::vector<T> > segmentList;
+        // each segment occupies at least its element size and count
+        if (numSegments > s.getNumRemainingBytes() / (2*sizeof(uint64_t)))
+            throw SerializationException("Invalid segment count in binary geometry");
+        segmentList.resize(static_cast<size_t>(numSegments));
+        for (size_t i=0; i<segmentList.size(); ++i)
+            s.readVector(segmentList[i]);
+        setData(segmentList);
+    }
+
 protected:
     // contains a list of segments, each segment consists of points
     std::vector< std::vector<T> > segmentList_;
@@ -36,6 +36,7 @@
 
 #include "voreen/core/io/serialization/xmlserializer.h"
 #include "voreen/core/io/serialization/xmldeserializer.h"
+#include "voreen/core/io/serialization/geometrybinaryserializer.h"
 
 namespace voreen {
 
@@ -114,6 +115,11 @@ public:
 
     virtual void deserialize(XmlDeserializer& s);
 
+    /// Writes the triangles as one contiguous blob.
+    virtual void serializeBinary(GeometryBinarySerializer& s) const;
+
+    virtual void deserializeBinary(GeometryBinaryDeserializer& s);
+
     /// Flags the bounding box and OpenGL buffer as invalid.
     void invalidate();
 
@@ -245,6 +251,17 @@ void TriangleMeshGeometry<V>::deserialize(XmlDeserializer& s) {
     s.deserializeBinaryBlob("triangles", triangles_);
 }
 
+template <class V>
+void TriangleMeshGeometry<V>::serializeBinary(GeometryBinarySerializer& s) const {
+    s.writeVector(triangles_);
+}
+
+template <class V>
+void TriangleMeshGeometry<V>::deserializeBinary(GeometryBinaryDeserializer& s) {
+    s.readVector(triangles_);
+    invalidate();
+}
+
 template <class V>
 void TriangleMeshGeometry<V>::invalidate() {
     boundingBoxValid_ = false;
@@ -36,6 +36,7 @@
 
 #include "voreen/core/io/serialization/xmlserializer.h"
 #include "voreen/core/io/serialization/xmldeserializer.h"
+#include "voreen/core/io/serialization/geometrybinaryserializer.h"
 
 namespace voreen {
 
@@ -77,6 +78,11 @@ public:
 
     virtual void deserialize(XmlDeserializer& s);
 
+    /// Writes the triangle indices and the vertices as two contiguous blobs.
+    virtual void serializeBinary(GeometryBinarySerializer& s) const;
+
+    virtual void deserializeBinary(GeometryBinaryDeserializer& s);
+
     /// Flags the bounding box and OpenGL buffer as invalid.
     void invalidate();
 
@@ -108,6 +114,12 @@ public:
         vertices_ = vertices;
     }
 
+    /// Replaces all triangles of the mesh at once. The vertices have to be set before. Flags the bounding box and OpenGL buffer as invalid.
+    void setTriangles(const std::vector<TriangleType>& triangles) {
+        triangles_ = triangles;
+        invalidate();
+    }
+
 protected:
 
     virtual void updateBoundingBox() const;
@@ -261,6 +273,33 @@ void TriangleMeshGeometryIndexed<I, V>::deserialize(XmlDeserializer& s) {
     s.deserializeBinaryBlob("vertices", vertices_);
 }
 
+template <class I, class V>
+void TriangleMeshGeometryIndexed<I, V>::serializeBinary(GeometryBinarySerializer& s) const {
+    s.writeVector(triangles_);
+    s.writeVector(vertices_);
+}
+
+template <class I, class V>
+void TriangleMeshGeometryIndexed<I, V>::deserializeBinary(GeometryBinaryDeserializer& s) {
+    std::vector<TriangleType> triangles;
+    std::vector<VertexType> vertices;
+    s.readVector(triangles);
+    s.readVector(vertices);
+
+    // reject indices referring to non-existing vertices
+    for (size_t i=0; i<triangles.size(); ++i) {
+        for (size_t j=0; j<3; ++j) {
+            if (static_cast<uint64_t>(triangles[i].v_[j]) >= static_cast<uint64_t>(vertices.size()))
+                throw SerializationException("Invalid vertex index in binary geometry: " + itos(static_cast<uint64_t>(triangles[i].v_[j]))
+                    + " (number of vertices: " + itos(static_cast<uint64_t>(vertices.size())) + ")");
+        }
+    }
+
+    triangles_.swap(triangles);
+    vertices_.swap(vertices);
+    invalidate();
+}
+
 template <class I, class V>
 void TriangleMeshGeometryIndexed<I, V>::invalidate() {
     boundingBoxValid_ = false;
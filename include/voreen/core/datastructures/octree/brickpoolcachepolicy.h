@@ -0,0 +1,214 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef VRN_BRICKPOOLCACHEPOLICY_H
+#define VRN_BRICKPOOLCACHEPOLICY_H
+
+#include "voreen/core/voreencoreapi.h"
+#include "voreen/core/utils/exception.h"
+
+#include "tgt/types.h"
+
+#include <string>
+#include <vector>
+
+namespace voreen {
+
+/**
+ * Eviction policy for the brick buffers of a brick pool manager that pages buffers in and out of the RAM.
+ *
+ * Buffers are identified by their ids [0, numIds). The policy only manages the order in which resident buffers
+ * are evicted; it does not own any buffer data. Accesses to resident buffers are not reported to the policy,
+ * since they must not require a global lock. Instead, the pool manager keeps a reference bit per buffer,
+ * which the policy queries (and clears) via an EvictionCallback when selecting a victim.
+ *
+ * All list nodes are stored in an array indexed by buffer id, so inserting and evicting buffers does
+ * not allocate any memory.
+ *
+ * @note The policy is not thread-safe. The pool manager has to serialize all calls.
+ */
+class VRN_CORE_API BrickPoolCachePolicy {
+public:
+    enum ReferenceState {
+        NOT_EVICTABLE,      ///< buffer is currently in use and must not be evicted
+        REFERENCED,         ///< buffer has been accessed since the last check (the reference bit has been cleared)
+        NOT_REFERENCED      ///< buffer has not been accessed since the last check
+    };
+
+    /**
+     * Interface the pool manager passes to selectVictim().
+     */
+    class EvictionCallback {
+    public:
+        virtual ~EvictionCallback() {}
+
+        /// Returns the reference state of the buffer and clears its reference bit.
+        virtual ReferenceState testAndClearReference(size_t id) = 0;
+
+        /**
+         * Atomically checks that the buffer is still evictable and marks it as not resident.
+         * Returns false, if the buffer has been pinned in the meantime.
+         */
+        virtual bool claim(size_t id) = 0;
+    };
+
+    BrickPoolCachePolicy();
+    virtual ~BrickPoolCachePolicy() {}
+
+    /// Returns the identifier of the policy, as accepted by createPolicy().
+    virtual std::string getName() const = 0;
+
+    /**
+     * Resets the policy.
+     *
+     * @param numIds number of buffer ids
+     * @param capacity maximum number of buffers resident in RAM
+     */
+    virtual void initialize(size_t numIds, size_t capacity);
+
+    /// Increases the number of buffer ids, keeping the state of the existing ones.
+    void setNumIds(size_t numIds);
+
+    /// Is to be called when the buffer has become resident.
+    virtual void insert(size_t id) = 0;
+
+    /**
+     * Selects a resident buffer to be evicted and claims it via the callback.
+     * Returns false, if no buffer could be claimed (i.e., all buffers are in use).
+     */
+    virtual bool selectVictim(EvictionCallback& callback, size_t& victim) = 0;
+
+    /// Returns the number of resident buffers tracked by the policy.
+    virtual size_t getNumResident() const = 0;
+
+    /**
+     * Creates the policy with the passed name: "clock", "2q" or "arc".
+     *
+     * @throw VoreenException if the name is unknown
+     */
+    static BrickPoolCachePolicy* createPolicy(const std::string& name) throw (VoreenException);
+
+protected:
+    static const uint32_t NO_NODE;
+
+    /// List membership of a node. Each policy uses a subset.
+    enum ListID {
+        LIST_NONE = 0,
+        LIST_RESIDENT_1,    ///< clock / A1in (2Q) / T1 (ARC)
+        LIST_RESIDENT_2,    ///< Am (2Q) / T2 (ARC)
+        LIST_GHOST_1,       ///< A1out (2Q) / B1 (ARC)
+        LIST_GHOST_2        ///< B2 (ARC)
+    };
+
+    struct Node {
+        uint32_t previous_;
+        uint32_t next_;
+        uint8_t list_;
+        Node() : previous_(NO_NODE), next_(NO_NODE), list_(LIST_NONE) {}
+    };
+
+    /// Doubly linked list over the node array. The head is the oldest entry.
+    struct List {
+        uint32_t head_;
+        uint32_t tail_;
+        size_t size_;
+        List() : head_(NO_NODE), tail_(NO_NODE), size_(0) {}
+    };
+
+    void pushBack(List& list, uint8_t listID, size_t id);
+    void unlink(List& list, size_t id);
+    /// Moves the head of the list to its tail (i.e., advances the clock hand).
+    void rotate(List& list);
+    /// Bounds the number of steps of a victim search, so that it terminates if all buffers are pinned.
+    size_t getMaxSearchSteps() const;
+
+    std::vector<Node> nodes_;
+    size_t capacity_;
+};
+
+/**
+ * CLOCK (second chance): resident buffers are checked in insertion order; referenced buffers get a second chance.
+ */
+class VRN_CORE_API BrickPoolCachePolicyClock : public BrickPoolCachePolicy {
+public:
+    virtual std::string getName() const { return "clock"; }
+    virtual void initialize(size_t numIds, size_t capacity);
+    virtual void insert(size_t id);
+    virtual bool selectVictim(EvictionCallback& callback, size_t& victim);
+    virtual size_t getNumResident() const { return clock_.size_; }
+
+private:
+    List clock_;
+};
+
+/**
+ * 2Q (Johnson and Shasha): new buffers enter a FIFO queue (A1in) and are only moved to the main queue (Am),
+ * if they are requested again after having been evicted while their id is still remembered in the ghost queue A1out.
+ * Buffers that are touched only once (e.g., by a slice sweep) therefore never displace the working set in Am.
+ * Am is managed by CLOCK.
+ */
+class VRN_CORE_API BrickPoolCachePolicy2Q : public BrickPoolCachePolicy {
+public:
+    virtual std::string getName() const { return "2q"; }
+    virtual void initialize(size_t numIds, size_t capacity);
+    virtual void insert(size_t id);
+    virtual bool selectVictim(EvictionCallback& callback, size_t& victim);
+    virtual size_t getNumResident() const { return a1in_.size_ + am_.size_; }
+
+private:
+    bool evictFromA1in(EvictionCallback& callback, size_t& victim);
+    bool evictFromAm(EvictionCallback& callback, size_t& victim);
+
+    List a1in_;
+    List am_;
+    List a1out_;
+    size_t maxA1inSize_;    ///< Kin: 25% of the capacity
+    size_t maxA1outSize_;   ///< Kout: 50% of the capacity
+};
+
+/**
+ * ARC (Megiddo and Modha) in its CLOCK-based variant CAR (Bansal and Modha), which only needs reference bits
+ * instead of reordering on every hit. T1 holds buffers accessed once recently, T2 buffers accessed at least twice;
+ * the ghost lists B1/B2 remember evicted ids and adapt the target size of T1.
+ */
+class VRN_CORE_API BrickPoolCachePolicyARC : public BrickPoolCachePolicy {
+public:
+    virtual std::string getName() const { return "arc"; }
+    virtual void initialize(size_t numIds, size_t capacity);
+    virtual void insert(size_t id);
+    virtual bool selectVictim(EvictionCallback& callback, size_t& victim);
+    virtual size_t getNumResident() const { return t1_.size_ + t2_.size_; }
+
+private:
+    List t1_;
+    List t2_;
+    List b1_;
+    List b2_;
+    size_t targetT1Size_;   ///< adaptive target size p of T1
+};
+
+} // namespace
+
+#endif // VRN_BRICKPOOLCACHEPOLICY_H
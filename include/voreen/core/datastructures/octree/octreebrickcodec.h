@@ -0,0 +1,84 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef VRN_OCTREEBRICKCODEC_H
+#define VRN_OCTREEBRICKCODEC_H
+
+#include "voreen/core/voreencoreapi.h"
+
+#include "tgt/types.h"
+
+#include <string>
+
+namespace voreen {
+
+/**
+ * Lossless codec for octree bricks, used by brick pool managers for compressing bricks on disk.
+ *
+ * The brick values are split into blocks of BLOCK_SIZE values. Each block is stored
+ * as its minimum value (frame of reference) followed by the offsets to the minimum, bit-packed with
+ * the smallest bit width that can represent the block's value range. Nearly homogeneous regions therefore
+ * shrink to a few bits per voxel, and constant blocks to three bytes.
+ *
+ * If the encoded brick would not be smaller than the raw brick, the raw brick is stored instead
+ * (i.e., an encoded size equal to the raw brick size denotes an uncompressed brick).
+ */
+class VRN_CORE_API OctreeBrickCodec {
+public:
+    /// Number of values per block sharing one reference value and bit width.
+    static const size_t BLOCK_SIZE = 64;
+
+    /// @param numValues number of uint16_t values per brick (i.e., voxels times channels)
+    OctreeBrickCodec(size_t numValues);
+
+    /// Returns the size of a raw brick in bytes.
+    size_t getRawSize() const;
+
+    /// Returns the maximum size of an encoded brick in bytes, i.e. the size of the buffer to be passed to encode().
+    size_t getMaxEncodedSize() const;
+
+    /**
+     * Encodes the brick into the passed buffer.
+     *
+     * @param brick the raw brick
+     * @param encoded output buffer with at least getMaxEncodedSize() bytes
+     * @return the number of bytes written to the output buffer
+     */
+    size_t encode(const uint16_t* brick, char* encoded) const;
+
+    /**
+     * Decodes the encoded brick into the passed brick buffer.
+     *
+     * @return false, if the encoded data is corrupt
+     */
+    bool decode(const char* encoded, size_t encodedSize, uint16_t* brick) const;
+
+private:
+    size_t numValues_;
+};
+
+} // namespace
+
+#endif // VRN_OCTREEBRICKCODEC_H
@@ -28,6 +28,7 @@
 
 #include "voreen/core/utils/exception.h"
 #include "voreen/core/voreenobject.h"
+#include "voreen/core/utils/atomicvalue.h"
 
 #include <vector>
 #include <string>
@@ -55,6 +56,26 @@ public:
         WRITE
     };
 
+    /**
+     * Counters for measuring the benefit of brick prefetching.
+     * A hit is a brick access that is served by a buffer loaded by a prefetch request,
+     * a miss is a brick access that requires a synchronous disk load.
+     *
+     * @see prefetchBricks
+     */
+    struct PrefetchStatistics {
+        uint64_t numRequested_;     ///< number of brick addresses passed to prefetchBricks()
+        uint64_t numLoaded_;        ///< number of buffers loaded by the prefetch threads
+        uint64_t numHits_;          ///< number of first accesses to a prefetched buffer
+        uint64_t numMisses_;        ///< number of synchronous buffer loads during brick access
+        uint64_t numWasted_;        ///< number of prefetched buffers evicted before being accessed
+
+        PrefetchStatistics();
+
+        /// Returns the fraction of buffer loads that have been served by prefetching.
+        float getHitRate() const;
+    };
+
     OctreeBrickPoolManagerBase();
     virtual ~OctreeBrickPoolManagerBase();
 
@@ -103,9 +124,32 @@ public:
      */
     virtual void flushPoolToDisk(ProgressReporter* progressReporter = 0) = 0;
 
+    /**
+     * Asynchronously loads the bricks stored at the passed virtual memory addresses,
+     * so that subsequent getBrick() calls do not have to wait for the disk.
+     * The request is only a hint: it returns immediately and may be dropped.
+     *
+     * The default implementation does nothing, which is appropriate for
+     * brick pools residing in RAM.
+     */
+    virtual void prefetchBricks(const std::vector<uint64_t>& virtualMemoryAddresses) const;
+
+    /// Returns the prefetch counters. The default implementation returns zero counters.
+    virtual PrefetchStatistics getPrefetchStatistics() const;
+
+    /// Resets the prefetch counters.
+    virtual void resetPrefetchStatistics();
+
     /// Returns the memory size of one brick in byte.
     size_t getBrickMemorySizeInByte() const;
 
+    /**
+     * Returns the number of bytes the brick stored at the passed virtual memory address occupies
+     * in the persistent brick storage, which may be less than the brick memory size for compressing managers.
+     * Returns 0, if the size is not known. The default implementation returns the brick memory size.
+     */
+    virtual size_t getCompressedBrickSize(uint64_t virtualMemoryAddress) const;
+
     /// Returns the amount of memory in bytes that has been allocated for the entire brick pool.
     virtual uint64_t getBrickPoolMemoryAllocated() const = 0;
 
@@ -149,6 +193,10 @@ private:
 
 /**
  * Basic brick pool manager that stores the entire brick in RAM.
+ *
+ * getBrick() and getWritableBrick() do not lock: the brick buffers are referenced from a
+ * two-level table whose entries are never relocated, and the number of allocated buffers
+ * is published atomically after a buffer has been added to the table.
  */
 class VRN_CORE_API OctreeBrickPoolManagerRAM : public OctreeBrickPoolManagerBase {
 
@@ -207,9 +255,19 @@ private:
     size_t singleBufferSizeBytes_;        ///< actual size of a single buffer in bytes (next smaller multiple of brick memory size)
     uint64_t nextVirtualMemoryAddress_;   ///< virtual memory address of next allocated brick
 
-    std::vector<char*> brickBuffers_;     ///< pointer to the buffers storing the bricks
+    /// Returns the brick buffer with the passed index, which must be smaller than numBuffers_.
+    char* getBuffer(size_t bufferID) const;
+
+    /// Adds a buffer to the table and publishes it. Has to be called with the mutex held.
+    void appendBuffer(char* buffer);
+
+    std::vector<char**> bufferTable_;     ///< chunks of BUFFER_TABLE_CHUNK_SIZE buffer pointers, allocated on demand
+    AtomicValue<size_t> numBuffers_;      ///< number of buffers in the table
+
+    mutable boost::mutex mutex_;          ///< protects the buffer table during allocation and (de)serialization
 
-    mutable boost::mutex mutex_;          ///< mutex for handling multi-threaded brick access
+    static const size_t MAX_NUM_BUFFERS;  ///< maximum number of brick buffers
+    static const size_t BUFFER_TABLE_CHUNK_SIZE;  ///< number of buffer pointers per table chunk
 };
 
 
@@ -27,12 +27,15 @@
 #define VRN_OCTREEBRICKPOOLMANAGERDISK_H
 
 #include "voreen/core/datastructures/octree/octreebrickpoolmanager.h"
-#include "voreen/core/datastructures/octree/brickpoolmanagerqueue.h"
+#include "voreen/core/datastructures/octree/brickpoolcachepolicy.h"
 
 #include <map>
+#include <deque>
+#include <boost/thread/thread.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/condition_variable.hpp>
+#include <boost/detail/atomic_count.hpp>
 
 #include "tgt/assert.h"
 
@@ -121,24 +124,30 @@ class VRN_CORE_API OctreeBrickPoolManagerDisk : public OctreeBrickPoolManagerBas
      */
     struct BufferEntry {
         bool isInRAM_;                               //<
+        bool isLoading_;                             //< flag, if the buffer is currently read from disk
+        bool isQueuedForPrefetch_;                   //< flag, if the buffer is in the prefetch queue
+        bool isPrefetched_;                          //< flag, if the buffer has been prefetched and not been accessed yet
         bool mustBeSavedToDisk_;                     //< flag, if the buffer must be saved to disk
+        bool referenced_;                            //< flag, if the buffer has been accessed since the last eviction pass (second chance)
         char* data_;                                 //< pointer to the buffer data
         uint8_t inUse_;                              //< counter of handels using the buffer
         BrickEntry* bricksInUse_;                    //< array to all bricks in the buffer (counting handels)
-        BrickPoolManagerQueueNode<size_t>* node_;    //< pointer to the queue for least resently used update
 
-        BufferEntry(size_t numberOfBricks, char* data, BrickPoolManagerQueueNode<size_t>* node)
+        BufferEntry(size_t numberOfBricks, char* data)
             : isInRAM_(false)
+            , isLoading_(false)
+            , isQueuedForPrefetch_(false)
+            , isPrefetched_(false)
             , mustBeSavedToDisk_(false)
+            , referenced_(false)
             , data_(data)
             , inUse_(0)
             , bricksInUse_(new BrickEntry[numberOfBricks])
-            , node_(node)
         {}
         ~BufferEntry() {
             tgtAssert(inUse_ == 0, "buffer still in use");
             delete[] bricksInUse_;
-            delete data_;
+            delete[] data_;
         }
     };
 
@@ -178,6 +187,43 @@ public:
 
     virtual void flushPoolToDisk(ProgressReporter* progressReporter = 0);
 
+    /**
+     * Queues the buffers containing the passed bricks for being loaded by the prefetch threads.
+     * Buffers that are already in RAM or being loaded are skipped. At most maxNumBuffersInRAM-1
+     * buffers are queued, since prefetching more would evict the buffers just loaded.
+     */
+    virtual void prefetchBricks(const std::vector<uint64_t>& virtualMemoryAddresses) const;
+
+    virtual PrefetchStatistics getPrefetchStatistics() const;
+    virtual void resetPrefetchStatistics();
+
+    /// Sets the number of I/O threads used for prefetching (default: 2). Zero disables prefetching.
+    void setNumPrefetchThreads(size_t numThreads);
+
+    /**
+     * Selects the policy deciding which buffer is evicted from RAM: "clock", "2q" (default) or "arc".
+     * Resident buffers are kept.
+     * @see BrickPoolCachePolicy
+     * @throw VoreenException if the policy name is unknown
+     */
+    void setCachePolicy(const std::string& policyName) throw (VoreenException);
+
+    /// Returns the name of the current cache policy.
+    std::string getCachePolicy() const;
+
+    /**
+     * Enables or disables compression of the buffer files (default: enabled).
+     * Affects only buffers written afterwards, since buffer files are loaded regardless of their compression.
+     * @see OctreeBrickCodec
+     */
+    void setBrickCompression(bool enabled);
+
+    /// Returns whether the buffer files are compressed.
+    bool getBrickCompression() const;
+
+    /// Returns the compressed size of the brick, or 0 if the brick's buffer has not been written in this session.
+    virtual size_t getCompressedBrickSize(uint64_t virtualMemoryAddress) const;
+
     uint64_t allocateBrick() throw (VoreenException);
     void deleteBrick(uint64_t virtualMemoryAddress);
 
@@ -203,11 +249,62 @@ private:
     BufferEntry* loadBufferFromDisk(size_t bufferID, bool blocking, boost::unique_lock<boost::mutex> &lock) const throw (VoreenException);
 
     /**
-     * Saves a single buffer to the disk.
+     * Saves a single buffer to the disk. If brick compression is enabled, each brick is encoded separately
+     * and the file consists of a header, the table of encoded brick sizes and the encoded bricks.
      * @note This function is not protected by a mutex.
      */
     void saveBufferToDisk(const size_t bufferID) const;
 
+    /**
+     * Reads the buffer file into a newly allocated buffer, decompressing it if necessary. Returns the null pointer on failure.
+     * @note This function does not access shared state and may be called without holding the mutex.
+     */
+    char* readBufferFile(const std::string& bufferFile) const;
+
+    /**
+     * Reads the encoded brick sizes of a buffer file from its header (without decoding the bricks) and writes them
+     * to the passed array of numBrickSlotsPerBuffer_ entries. Returns false, if the file could not be read.
+     */
+    bool readBufferFileBrickSizes(const std::string& bufferFile, uint32_t* brickSizes) const;
+
+    /**
+     * Removes the buffer selected by the cache policy from RAM and saves it to disk, if necessary.
+     * Buffers that are in use are never evicted.
+     * @param keepPrefetched if true, prefetched buffers that have not been accessed yet are not evicted
+     * @return false, if no buffer could be evicted
+     * @note Expects the global mutex to be locked.
+     */
+    bool evictBuffer(bool keepPrefetched) const;
+
+    /**
+     * Increases the use count of the buffer, loading it from disk if necessary.
+     * Resident buffers are pinned holding only their stripe lock.
+     */
+    BufferEntry* pinBuffer(size_t bufferID, bool blocking) const throw (VoreenException);
+
+    /// Decreases the use count of the buffer. Returns true, if it is not in use anymore. @note Expects the stripe lock to be held.
+    bool unpinBuffer(BufferEntry* entry) const;
+
+    /// Wakes up threads waiting for an evictable buffer. @note Expects no lock to be held.
+    void notifyBufferReleased() const;
+
+    /// Returns the mutex protecting the per-buffer state of the passed buffer.
+    boost::mutex& getStripeMutex(size_t bufferID) const { return stripeMutexes_[bufferID % NUM_LOCK_STRIPES]; }
+    /// Returns the condition signaled on brick release of the passed buffer.
+    boost::condition_variable& getStripeCondition(size_t bufferID) const { return stripeConds_[bufferID % NUM_LOCK_STRIPES]; }
+
+    /// Passes the per-buffer state to the cache policy. Defined in the source file.
+    class BufferEvictionCallback;
+
+    /// Main loop of the prefetch threads.
+    void prefetchThreadMain() const;
+
+    /// Starts the prefetch threads, if not already running. @note Expects the mutex to be locked.
+    void startPrefetchThreads() const;
+
+    /// Clears the prefetch queue and joins the prefetch threads. @note Expects the mutex NOT to be locked.
+    void stopPrefetchThreads();
+
     //--------------------
     //  members
     //--------------------
@@ -229,12 +326,36 @@ private:
     ///brick ram management
     mutable size_t numBuffersInRAM_;                               //<
     mutable std::vector<BufferEntry*> bufferVector_;               //<
-    mutable BrickPoolManagerQueue<size_t> brickPoolManagerQueue_;  //< least resently used queue
+    mutable BrickPoolCachePolicy* cachePolicy_;                    //< decides which buffer is evicted
+    mutable std::vector<uint32_t> compressedBrickSizes_;           //< encoded size of each brick written to disk (0 = unknown)
+    bool compressBricks_;                                          //< if true, buffer files are written compressed
     std::vector<uint64_t> deletedBricks_;                          //< bricks, which had been deleted
 
     ///multi threaded
+    /**
+     * The global mutex protects the queue, the buffer files, the RAM accounting and the prefetch state.
+     * The per-buffer state (residency, use counts, data pointer) is protected by one of NUM_LOCK_STRIPES
+     * stripe mutexes, so that threads accessing resident bricks of different buffers do not contend.
+     * Lock order: global mutex before stripe mutex.
+     */
+    static const size_t NUM_LOCK_STRIPES = 64;
+    static const size_t MAX_NUM_BUFFERS;            //< capacity of bufferVector_, reserved on initialization, since it is read without the global mutex
+
     mutable boost::mutex mutex_;                    //< mutex to handle multi-threaded access
     mutable boost::condition_variable cond_;        //< condidion to handle thread sleeping
+    mutable boost::mutex stripeMutexes_[NUM_LOCK_STRIPES];             //< per-buffer stripe locks
+    mutable boost::condition_variable stripeConds_[NUM_LOCK_STRIPES];  //< signaled, if a brick of the stripe is released
+    mutable boost::detail::atomic_count numEvictionWaiters_;           //< number of threads waiting for an evictable buffer
+
+    ///prefetching
+    size_t numPrefetchThreads_;                                 //< number of I/O threads
+    mutable std::vector<boost::thread*> prefetchThreads_;       //< running I/O threads (started on first prefetch request)
+    mutable std::deque<size_t> prefetchQueue_;                  //< ids of the buffers to be prefetched
+    mutable bool stopPrefetching_;                              //< signals the prefetch threads to terminate
+    mutable boost::condition_variable prefetchCond_;            //< wakes up the prefetch threads
+    mutable PrefetchStatistics prefetchStatistics_;             //< prefetch counters (except hits)
+    mutable boost::detail::atomic_count numPrefetchHits_;       //< prefetch hits, counted on the lock-free fast path
+    uint64_t numPrefetchHitsAtReset_;                           //< value of numPrefetchHits_ on last reset
 };
 
 } // namespace
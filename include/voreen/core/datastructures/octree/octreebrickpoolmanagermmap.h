@@ -0,0 +1,179 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef VRN_OCTREEBRICKPOOLMANAGERMMAP_H
+#define VRN_OCTREEBRICKPOOLMANAGERMMAP_H
+
+#include "voreen/core/datastructures/octree/octreebrickpoolmanager.h"
+
+#include <vector>
+#include <string>
+
+#include "voreen/core/utils/atomicvalue.h"
+
+#include <boost/thread/mutex.hpp>
+
+namespace voreen {
+
+/**
+ * Brick pool manager that maps the brick buffer files into the virtual address space
+ * of the process (mmap on POSIX systems, file mappings on Windows).
+ *
+ * In contrast to the OctreeBrickPoolManagerDisk, no buffers are explicitly loaded or evicted:
+ * the operating system's page cache takes over the role of the LRU queue and pages the
+ * bricks in and out on demand. Consequently, getBrick() and getWritableBrick() reduce to
+ * a lock-free buffer lookup and pointer arithmetic: the buffer table is preallocated and
+ * never relocated, and the number of mapped buffers is published atomically. The manager
+ * mutex is only held for mapping new buffers and for flushing. Bricks obtained via
+ * getWritableBrick() are marked dirty and written back at page granularity by flushPoolToDisk().
+ *
+ * @note Concurrent writes to the same brick have to be synchronized by the caller.
+ *  A brick address may only be accessed after allocateBrick() has returned it.
+ *
+ * @see OctreeBrickPoolManagerDisk
+ */
+class VRN_CORE_API OctreeBrickPoolManagerMmap : public OctreeBrickPoolManagerBase {
+
+public:
+    /**
+     * @param maxSingleBufferSize Maximum size of a single buffer file in byte. The actual
+     *  buffer size is determined by rounding down to the nearest multiple of the brick memory size.
+     * @param brickPoolPath directory where the buffer files are stored. Must exist.
+     * @param bufferFilePrefix filename prefix of the buffer files
+     */
+    OctreeBrickPoolManagerMmap(size_t maxSingleBufferSize, const std::string& brickPoolPath,
+                               const std::string& bufferFilePrefix = "");
+    virtual ~OctreeBrickPoolManagerMmap();
+
+    /// @see VoreenSerializableObject
+    std::string getClassName() const { return "OctreeBrickPoolManagerMmap"; }
+    /// @see VoreenSerializableObject
+    OctreeBrickPoolManagerMmap* create() const;
+
+    virtual uint64_t allocateBrick() throw (VoreenException);
+    virtual void deleteBrick(uint64_t virtualMemoryAddress);
+
+    /// Returns a pointer into the mapped buffer file. Does not perform any I/O.
+    virtual const uint16_t* getBrick(uint64_t virtualMemoryAddress, bool blocking = true) const throw (VoreenException);
+
+    /// Returns a pointer into the mapped buffer file and marks the brick as dirty. Does not perform any I/O.
+    virtual uint16_t* getWritableBrick(uint64_t virtualMemoryAddress, bool blocking = true) const throw (VoreenException);
+
+    virtual void releaseBrick(uint64_t virtualMemoryAddress, AccessMode mode = READ) const;
+
+    /// Always returns true, since residency is handled by the operating system.
+    virtual bool isBrickInRAM(uint64_t virtualMemoryAddress) const;
+
+    /// Writes back the pages of all dirty bricks synchronously.
+    virtual void flushPoolToDisk(ProgressReporter* progressReporter = 0);
+
+    /// Returns the byte size of a single brick buffer file.
+    size_t getBrickBufferSizeInBytes() const;
+
+    /// Returns the number of brick buffer files.
+    size_t getNumBrickBuffers() const;
+
+    virtual uint64_t getBrickPoolMemoryAllocated() const;
+    virtual uint64_t getBrickPoolMemoryUsed() const;
+    virtual std::string getDescription() const;
+
+    /// @see Serializer::serialize
+    virtual void serialize(XmlSerializer& s) const;
+
+    /// @see Deserializer::deserialize
+    virtual void deserialize(XmlDeserializer& s);
+
+protected:
+    virtual void initialize(size_t brickMemorySizeInByte) throw (VoreenException);
+    virtual void deinitialize() throw (VoreenException);
+
+    static const std::string loggerCat_;
+
+private:
+    /**
+     * A single mapped buffer file.
+     */
+    struct MappedBuffer {
+        char* data_;                            ///< start of the mapped view
+        void* fileHandle_;                      ///< file handle (Windows only)
+        void* mappingHandle_;                   ///< file mapping handle (Windows only)
+        int fileDescriptor_;                    ///< file descriptor (POSIX only)
+        AtomicValue<int>* dirtyBricks_;         ///< one dirty flag per brick slot
+
+        MappedBuffer(size_t numBrickSlots);
+        ~MappedBuffer();
+
+    private:
+        MappedBuffer(const MappedBuffer&);
+        MappedBuffer& operator=(const MappedBuffer&);
+    };
+
+    /**
+     * Opens (and creates, if necessary) the buffer file, resizes it to the buffer size
+     * and maps it into memory.
+     *
+     * @note This function is not protected by a mutex.
+     */
+    MappedBuffer* mapBufferFile(const std::string& bufferFile) const throw (VoreenException);
+
+    /**
+     * Unmaps the buffer and closes the underlying file.
+     * @note This function is not protected by a mutex.
+     */
+    void unmapBufferFile(MappedBuffer* buffer) const;
+
+    /**
+     * Writes back the pages covering the dirty bricks of the passed buffer.
+     * @note This function is not protected by a mutex.
+     */
+    void flushBuffer(MappedBuffer* buffer) const;
+
+    /// Unmaps all buffers without flushing them.
+    void clearBuffers();
+
+    /// Maximum number of buffer files.
+    static const size_t MAX_NUM_BUFFERS;
+
+    std::string brickPoolPath_;                 ///< directory where the buffer files are stored
+    std::string bufferFilePrefix_;              ///< filename prefix of the buffer files
+
+    size_t maxBufferSizeBytes_;                 ///< maximum buffer size in byte (as passed to the constructor)
+    size_t singleBufferSizeBytes_;              ///< actual size of a single buffer in bytes (multiple of brick memory size)
+    size_t numBrickSlotsPerBuffer_;             ///< number of brick slots per buffer
+    size_t pageSize_;                           ///< page size of the system, used for aligning flushes
+
+    uint64_t nextVirtualMemoryAddress_;         ///< virtual memory address of next allocated brick
+    std::vector<uint64_t> deletedBricks_;       ///< bricks that have been deleted and can be re-used
+
+    std::vector<std::string> bufferFiles_;      ///< disk files storing the brick buffers
+    MappedBuffer** buffers_;                    ///< mapped buffers (MAX_NUM_BUFFERS entries), index corresponds to bufferFiles_
+    AtomicValue<size_t> numBuffers_;            ///< number of valid entries in buffers_, published after mapping
+
+    mutable boost::mutex mutex_;                ///< serializes mapping, flushing, allocation and deletion
+};
+
+} // namespace
+
+#endif
@@ -148,6 +148,9 @@ private:
         const tgt::svec3& nodeOffsetInTexture, size_t sliceIndexInNode, size_t curLevel, size_t targetLevel,
         uint16_t* textureBuffer, const tgt::svec3& textureDim, clock_t timeLimit, tgt::Stopwatch& runtimeWatch, bool& complete) const;
 
+    /// Passes the bricks of the node's children in the range [childStart, childEnd) to the brick pool manager for prefetching.
+    void prefetchChildBricks(const VolumeOctreeNode* node, const tgt::svec3& childStart, const tgt::svec3& childEnd) const;
+
     // low-level helper functions
     template<class T>
     VolumeOctreeNode* createTreeNodeFromTexture(const tgt::svec3& llf, const tgt::svec3& urb,
@@ -163,6 +166,16 @@ private:
         uint16_t* avgValues, uint16_t* minValues, uint16_t* maxValues,
         std::vector< std::vector<uint64_t> >& histograms) const;
 
+    /// Creates the level 0 node at the passed node index from a slab containing the node's plate. Thread-safe.
+    VolumeOctreeNode* createLevel0Node(const tgt::svec3& nodeIndex, const std::string& inputDataFormat,
+        const std::vector<const void*>& slabDataBuffers, const tgt::svec3& slabDim,
+        bool octreeOptimization, uint16_t homogeneityThreshold, std::vector< std::vector<uint64_t> >& histograms)
+        throw (VoreenException);
+
+    /**
+     * Creates a parent node from the passed child nodes and takes ownership of the children:
+     * they are either attached to the returned node or deleted, also if an exception is thrown.
+     */
     VolumeOctreeNode* createParentNode(VolumeOctreeNode* children[8], bool octreeOptimization, uint16_t homogeneityThreshold,
         uint16_t* avgValues, uint16_t* minValues, uint16_t* maxValues)
         throw (VoreenException);
@@ -175,6 +188,9 @@ private:
 
     void deleteSubTree(VolumeOctreeNode* root) const;
 
+    /// Stores the brick sizes reported by the brick pool manager in the nodes of the subtree. Is to be called after flushing the pool.
+    void assignCompressedBrickSizes(VolumeOctreeNode* root) const;
+
     void serializeNodeBuffer(char*& binaryBuffer, size_t& bufferSize) const
         throw (SerializationException);
 
@@ -69,6 +69,7 @@ class Histogram1D;
 class VRN_CORE_API VolumeOctreeNode {
 
     friend class VolumeOctreeBase;
+    friend class VolumeOctree;
 
 public:
     virtual ~VolumeOctreeNode();
@@ -82,6 +83,9 @@ public:
     bool hasBrick() const;
     uint64_t getBrickAddress() const;
 
+    /// Returns the number of bytes the node's brick occupies in the persistent brick pool, or 0 if unknown.
+    uint32_t getCompressedBrickSize() const;
+
     bool isLeaf() const;
     virtual bool isHomogeneous() const;
 
@@ -98,7 +102,7 @@ public:
     // serialization (do not call directly)
     virtual void serializeContentToBinaryBuffer(char* buffer) const;
     virtual void deserializeContentFromBinaryBuffer(const char* buffer);
-    virtual size_t getContentSize() const { return sizeof(uint64_t) + sizeof(bool); }  ///< brickAddress + inVolume
+    virtual size_t getContentSize() const { return sizeof(uint64_t) + sizeof(uint32_t) + sizeof(bool); }  ///< brickAddress + compressedBrickSize + inVolume
 
     VolumeOctreeNode* children_[8];     ///< The node's child nodes in ZYX order (like voxels in a volume).
 
@@ -112,6 +116,9 @@ protected:
       */
     uint64_t brickAddress_;
 
+    /// Size of the brick in the persistent brick pool in bytes (@see OctreeBrickPoolManagerBase::getCompressedBrickSize), or 0 if unknown.
+    uint32_t compressedBrickSize_;
+
     /// True, if the node lies completely or partially inside the volume.
     bool inVolume_;
 
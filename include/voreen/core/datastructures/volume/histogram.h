@@ -235,10 +235,14 @@ template<typename T, int ND>
                 //TODO: out of range
                 return (bucketCounts_[dim] - 1);
             }
+            else if (maxValues_[dim] == minValues_[dim]) {
+                return 0;
+            }
             else {
                 v -= minValues_[dim];
-                return static_cast<int>(bucketCounts_[dim] * (v / (maxValues_[dim] - minValues_[dim])));
-                //TODO: clamp?
+                int bucket = static_cast<int>(bucketCounts_[dim] * (v / (maxValues_[dim] - minValues_[dim])));
+                // the maximum value belongs to the last bucket
+                return std::min(bucket, bucketCounts_[dim] - 1);
             }
         }
 
@@ -299,6 +303,12 @@ class Histogram1DGeneric : public HistogramGeneric<T, 1> {
         void addSample(T value) {
             HistogramGeneric<T, 1>::addSample(static_cast<double>(value));
         }
+
+        /// Adds count samples of the passed value.
+        void addSamples(T value, uint64_t count) {
+            HistogramGeneric<T, 1>::increaseBucket(static_cast<size_t>(HistogramGeneric<T, 1>::mapValueToBucket(value, 0)), count);
+        }
+
         T getMinValue() const {
             return HistogramGeneric<T, 1>::getMinValue(0);
         }
@@ -357,6 +367,7 @@ public:
 
     /**
      * Creates a histogram with a bucket count of 256.
+     * The VolumeMinMax and VolumeStatistics are computed in the same pass (@see VolumeDerivedDataEngine).
      *
      * @see VolumeDerivedData
      */
@@ -36,13 +36,34 @@ public:
     virtual Volume* apply(const VolumeBase* volume, int kernelSize = 3, ProgressReporter* progressReporter = 0) const = 0;
 };
 
-// Generic implementation:
+/**
+ * Generic implementation. The z slices are filtered in parallel (if OpenMP is available).
+ *
+ * 8 and 16 bit data is filtered with a sliding histogram (Huang): the histogram of the kernel window
+ * is updated incrementally while moving along a row, so that only two planes of the window have to be
+ * visited per voxel. For all other data types, the median is selected from the window values.
+ */
 template<typename T>
 class VolumeOperatorMedianGeneric : public VolumeOperatorMedianBase {
 public:
     virtual Volume* apply(const VolumeBase* volume, int kernelSize = 3, ProgressReporter* progressReporter = 0) const;
     //Implement isCompatible using a handy macro:
     IS_COMPATIBLE
+
+private:
+    void filterSliceHistogram(const T* input, T* output, const tgt::svec3& volDim, size_t z, size_t halfKernelDim,
+        std::vector<uint32_t>& histogram) const;
+
+    void filterSliceSelection(const T* input, T* output, const tgt::svec3& volDim, size_t z, size_t halfKernelDim,
+        std::vector<T>& values) const;
+
+    /// Adds (delta = 1) or removes (delta = -1) the window plane at x to/from the histogram.
+    void updateHistogram(const T* input, const tgt::svec3& volDim, size_t x, size_t ymin, size_t ymax, size_t zmin, size_t zmax,
+        int delta, std::vector<uint32_t>& histogram, size_t median, size_t& numBelowMedian) const;
+
+    static size_t getBin(T value) {
+        return static_cast<size_t>(static_cast<int>(value) - static_cast<int>(std::numeric_limits<T>::min()));
+    }
 };
 
 template<typename T>
@@ -55,30 +76,41 @@ Volume* VolumeOperatorMedianGeneric<T>::apply(const VolumeBase* vh, int kernelSi
     if (!va)
         return 0;
 
-    VolumeAtomic<T>* output = va->clone();
-
-    size_t halfKernelDim = static_cast<size_t>(kernelSize / 2);
     tgt::svec3 volDim = vh->getDimensions();
-    VRN_FOR_EACH_VOXEL_WITH_PROGRESS(pos, tgt::ivec3(0), volDim, progressReporter) {
-        size_t zmin = pos.z >= halfKernelDim ? pos.z - halfKernelDim : 0;
-        size_t zmax = std::min(pos.z+halfKernelDim, volDim.z-1);
-        size_t ymin = pos.y >= halfKernelDim ? pos.y - halfKernelDim : 0;
-        size_t ymax = std::min(pos.y+halfKernelDim, volDim.y-1);
-        size_t xmin = pos.x >= halfKernelDim ? pos.x - halfKernelDim : 0;
-        size_t xmax = std::min(pos.x+halfKernelDim, volDim.x-1);
-
-        tgt::svec3 npos;
-        std::vector<T> values;
-        for (npos.z=zmin; npos.z<=zmax; npos.z++) {
-            for (npos.y=ymin; npos.y<=ymax; npos.y++) {
-                for (npos.x=xmin; npos.x<=xmax; npos.x++) {
-                    values.push_back(va->voxel(npos));
-                }
+    VolumeAtomic<T>* output = new VolumeAtomic<T>(volDim);
+
+    const T* inputData = va->voxel();
+    T* outputData = output->voxel();
+    const size_t halfKernelDim = static_cast<size_t>(std::max(kernelSize, 1) / 2);
+    const bool useHistogram = std::numeric_limits<T>::is_integer && sizeof(T) <= 2;
+    const size_t numBins = (useHistogram ? static_cast<size_t>(1) << (8*sizeof(T)) : 0);
+
+    const int numSlices = static_cast<int>(volDim.z);
+    const int slabSize = getParallelSlabSize(numSlices);
+    for (int slabStart = 0; slabStart < numSlices; slabStart += slabSize) {
+        const int slabEnd = std::min(slabStart + slabSize, numSlices);
+
+        #ifdef VRN_MODULE_OPENMP
+        #pragma omp parallel
+        #endif
+        {
+            // per-thread buffers
+            std::vector<uint32_t> histogram(numBins, 0);
+            std::vector<T> values;
+
+            #ifdef VRN_MODULE_OPENMP
+            #pragma omp for schedule(dynamic)
+            #endif
+            for (int z = slabStart; z < slabEnd; z++) {
+                if (useHistogram)
+                    filterSliceHistogram(inputData, outputData, volDim, static_cast<size_t>(z), halfKernelDim, histogram);
+                else
+                    filterSliceSelection(inputData, outputData, volDim, static_cast<size_t>(z), halfKernelDim, values);
             }
         }
-        size_t len = values.size();
-        nth_element(values.begin(), values.begin()+(len/2), values.end());
-        output->voxel(pos) = values[len / 2];
+
+        if (progressReporter)
+            progressReporter->setProgress(static_cast<float>(slabEnd) / static_cast<float>(numSlices));
     }
 
     if (progressReporter)
@@ -87,6 +119,97 @@ Volume* VolumeOperatorMedianGeneric<T>::apply(const VolumeBase* vh, int kernelSi
     return new Volume(output, vh);
 }
 
+template<typename T>
+void VolumeOperatorMedianGeneric<T>::filterSliceHistogram(const T* input, T* output, const tgt::svec3& volDim, size_t z,
+    size_t halfKernelDim, std::vector<uint32_t>& histogram) const
+{
+    const size_t zmin = z >= halfKernelDim ? z - halfKernelDim : 0;
+    const size_t zmax = std::min(z+halfKernelDim, volDim.z-1);
+
+    // the median bin is kept from row to row, since neighboring rows usually have similar medians
+    size_t median = 0;
+    size_t numBelowMedian = 0;
+    for (size_t y = 0; y < volDim.y; y++) {
+        const size_t ymin = y >= halfKernelDim ? y - halfKernelDim : 0;
+        const size_t ymax = std::min(y+halfKernelDim, volDim.y-1);
+        const size_t planeSize = (zmax-zmin+1) * (ymax-ymin+1);
+
+        for (size_t nx = 0; nx <= std::min(halfKernelDim, volDim.x-1); nx++)
+            updateHistogram(input, volDim, nx, ymin, ymax, zmin, zmax, 1, histogram, median, numBelowMedian);
+
+        T* outputRow = output + (z*volDim.y + y)*volDim.x;
+        for (size_t x = 0; x < volDim.x; x++) {
+            // slide window: [x-halfKernelDim-1, x+halfKernelDim-1] => [x-halfKernelDim, x+halfKernelDim]
+            if (x > 0 && x+halfKernelDim < volDim.x)
+                updateHistogram(input, volDim, x+halfKernelDim, ymin, ymax, zmin, zmax, 1, histogram, median, numBelowMedian);
+            if (x > halfKernelDim)
+                updateHistogram(input, volDim, x-halfKernelDim-1, ymin, ymax, zmin, zmax, -1, histogram, median, numBelowMedian);
+
+            // move the median bin until it contains the value with rank len/2
+            const size_t xmin = x >= halfKernelDim ? x - halfKernelDim : 0;
+            const size_t xmax = std::min(x+halfKernelDim, volDim.x-1);
+            const size_t rank = (xmax-xmin+1) * planeSize / 2;
+            while (numBelowMedian > rank) {
+                median--;
+                numBelowMedian -= histogram[median];
+            }
+            while (numBelowMedian + histogram[median] <= rank) {
+                numBelowMedian += histogram[median];
+                median++;
+            }
+            outputRow[x] = static_cast<T>(static_cast<int>(median) + static_cast<int>(std::numeric_limits<T>::min()));
+        }
+
+        // remove the last window, leaving the histogram empty for the next row
+        for (size_t nx = (volDim.x-1 >= halfKernelDim ? volDim.x-1-halfKernelDim : 0); nx < volDim.x; nx++)
+            updateHistogram(input, volDim, nx, ymin, ymax, zmin, zmax, -1, histogram, median, numBelowMedian);
+        tgtAssert(numBelowMedian == 0, "histogram not empty");
+    }
+}
+
+template<typename T>
+void VolumeOperatorMedianGeneric<T>::updateHistogram(const T* input, const tgt::svec3& volDim, size_t x,
+    size_t ymin, size_t ymax, size_t zmin, size_t zmax,
+    int delta, std::vector<uint32_t>& histogram, size_t median, size_t& numBelowMedian) const
+{
+    for (size_t nz = zmin; nz <= zmax; nz++) {
+        const T* column = input + (nz*volDim.y + ymin)*volDim.x + x;
+        for (size_t ny = ymin; ny <= ymax; ny++, column += volDim.x) {
+            const size_t bin = getBin(*column);
+            histogram[bin] += delta;
+            if (bin < median)
+                numBelowMedian += delta;
+        }
+    }
+}
+
+template<typename T>
+void VolumeOperatorMedianGeneric<T>::filterSliceSelection(const T* input, T* output, const tgt::svec3& volDim, size_t z,
+    size_t halfKernelDim, std::vector<T>& values) const
+{
+    const size_t zmin = z >= halfKernelDim ? z - halfKernelDim : 0;
+    const size_t zmax = std::min(z+halfKernelDim, volDim.z-1);
+    for (size_t y = 0; y < volDim.y; y++) {
+        const size_t ymin = y >= halfKernelDim ? y - halfKernelDim : 0;
+        const size_t ymax = std::min(y+halfKernelDim, volDim.y-1);
+        for (size_t x = 0; x < volDim.x; x++) {
+            const size_t xmin = x >= halfKernelDim ? x - halfKernelDim : 0;
+            const size_t xmax = std::min(x+halfKernelDim, volDim.x-1);
+
+            values.clear();
+            for (size_t nz = zmin; nz <= zmax; nz++) {
+                for (size_t ny = ymin; ny <= ymax; ny++) {
+                    const T* row = input + (nz*volDim.y + ny)*volDim.x;
+                    values.insert(values.end(), row + xmin, row + xmax + 1);
+                }
+            }
+            size_t len = values.size();
+            std::nth_element(values.begin(), values.begin()+(len/2), values.end());
+            output[(z*volDim.y + y)*volDim.x + x] = values[len / 2];
+        }
+    }
+}
+
 typedef UniversalUnaryVolumeOperatorGeneric<VolumeOperatorMedianBase> VolumeOperatorMedian;
 
 } // namespace
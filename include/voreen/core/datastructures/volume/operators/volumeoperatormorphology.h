@@ -30,6 +30,134 @@
 
 namespace voreen {
 
+/**
+ * Separable box min/max filter used by erosion (DILATION = false) and dilation (DILATION = true).
+ *
+ * Each 1D pass uses the van Herk/Gil-Werman algorithm: the line is split into segments of kernel size,
+ * for which prefix and suffix minima/maxima are computed, so that each window result requires a single comparison
+ * regardless of the kernel size. The lines of each pass are processed in parallel (if OpenMP is available).
+ */
+template<typename T, bool DILATION>
+class VolumeMorphologyFilter {
+public:
+    /// Filters input into output. Both volumes must have the same dimensions.
+    static void apply(const VolumeAtomic<T>* input, VolumeAtomic<T>* output, int kernelSize, ProgressReporter* progressReporter);
+
+private:
+    /// Filters all lines along the passed axis of the input volume.
+    static void filterAxis(const T* input, T* output, const tgt::svec3& volDim, size_t axis, size_t halfKernelDim,
+        ProgressReporter* progressReporter, float progressOffset);
+
+    /// Filters the line of length n stored in the buffer "line", using the buffers as temporary storage.
+    static void filterLine(std::vector<T>& line, size_t n, size_t halfKernelDim, std::vector<T>& prefix, std::vector<T>& suffix);
+
+    static T combine(T a, T b) {
+        return DILATION ? std::max(a, b) : std::min(a, b);
+    }
+
+    /// Neutral element of combine(), used for padding the lines.
+    static T identity() {
+        if (DILATION)
+            return std::numeric_limits<T>::is_integer ? std::numeric_limits<T>::min() : -std::numeric_limits<T>::max();
+        else
+            return std::numeric_limits<T>::max();
+    }
+};
+
+template<typename T, bool DILATION>
+void VolumeMorphologyFilter<T, DILATION>::apply(const VolumeAtomic<T>* input, VolumeAtomic<T>* output, int kernelSize,
+    ProgressReporter* progressReporter)
+{
+    tgtAssert(input && output, "null pointer passed");
+    tgtAssert(input->getDimensions() == output->getDimensions(), "dimension mismatch");
+
+    const tgt::svec3 volDim = input->getDimensions();
+    const size_t halfKernelDim = static_cast<size_t>(std::max(kernelSize, 1) / 2);
+    VolumeAtomic<T>* temp = new VolumeAtomic<T>(volDim);
+
+    // kernel is separable => consecutively apply 1D kernel along each axis instead of a 3D kernel
+    filterAxis(input->voxel(), output->voxel(), volDim, 0, halfKernelDim, progressReporter, 0.f);
+    filterAxis(output->voxel(), temp->voxel(), volDim, 1, halfKernelDim, progressReporter, 1.f/3);
+    filterAxis(temp->voxel(), output->voxel(), volDim, 2, halfKernelDim, progressReporter, 2.f/3);
+
+    delete temp;
+}
+
+template<typename T, bool DILATION>
+void VolumeMorphologyFilter<T, DILATION>::filterAxis(const T* input, T* output, const tgt::svec3& volDim, size_t axis,
+    size_t halfKernelDim, ProgressReporter* progressReporter, float progressOffset)
+{
+    // lines along x and y are distributed slice-wise, lines along z row-wise
+    const size_t stride = (axis == 0 ? 1 : (axis == 1 ? volDim.x : volDim.x*volDim.y));
+    const size_t n = volDim[axis];
+    const size_t numLinesPerSlice = (axis == 0 ? volDim.y : volDim.x);
+    const size_t sliceStride = (axis == 0 ? volDim.x : 1);
+    const size_t sliceOffset = (axis == 2 ? volDim.x : volDim.x*volDim.y);
+    const int numSlices = static_cast<int>(axis == 2 ? volDim.y : volDim.z);
+
+    const int slabSize = getParallelSlabSize(numSlices);
+    for (int slabStart = 0; slabStart < numSlices; slabStart += slabSize) {
+        const int slabEnd = std::min(slabStart + slabSize, numSlices);
+
+        #ifdef VRN_MODULE_OPENMP
+        #pragma omp parallel
+        #endif
+        {
+            // per-thread line buffers
+            std::vector<T> line, prefix, suffix;
+
+            #ifdef VRN_MODULE_OPENMP
+            #pragma omp for schedule(dynamic)
+            #endif
+            for (int slice = slabStart; slice < slabEnd; slice++) {
+                for (size_t l = 0; l < numLinesPerSlice; l++) {
+                    const size_t lineStart = slice*sliceOffset + l*sliceStride;
+                    line.resize(n);
+                    for (size_t i = 0; i < n; i++)
+                        line[i] = input[lineStart + i*stride];
+                    filterLine(line, n, halfKernelDim, prefix, suffix);
+                    for (size_t i = 0; i < n; i++)
+                        output[lineStart + i*stride] = line[i];
+                }
+            }
+        }
+
+        if (progressReporter)
+            progressReporter->setProgress(progressOffset + (static_cast<float>(slabEnd) / static_cast<float>(numSlices)) / 3.f);
+    }
+}
+
+template<typename T, bool DILATION>
+void VolumeMorphologyFilter<T, DILATION>::filterLine(std::vector<T>& line, size_t n, size_t halfKernelDim,
+    std::vector<T>& prefix, std::vector<T>& suffix)
+{
+    const size_t kernelDim = 2*halfKernelDim + 1;
+    const size_t paddedLength = ((n + 2*halfKernelDim + kernelDim - 1) / kernelDim) * kernelDim;
+
+    // pad the line with the identity, so that windows exceeding the volume are clipped
+    line.insert(line.begin(), halfKernelDim, identity());
+    line.resize(paddedLength, identity());
+    prefix.resize(paddedLength);
+    suffix.resize(paddedLength);
+
+    for (size_t segment = 0; segment < paddedLength; segment += kernelDim) {
+        const size_t segmentEnd = segment + kernelDim;
+        prefix[segment] = line[segment];
+        for (size_t i = segment+1; i < segmentEnd; i++)
+            prefix[i] = combine(prefix[i-1], line[i]);
+        suffix[segmentEnd-1] = line[segmentEnd-1];
+        for (size_t i = segmentEnd-1; i > segment; i--)
+            suffix[i-1] = combine(suffix[i], line[i-1]);
+    }
+
+    // the window [i, i+kernelDim) of the padded line covers at most two segments
+    for (size_t i = 0; i < n; i++)
+        line[i] = combine(suffix[i], prefix[i + 2*halfKernelDim]);
+    line.resize(n);
+}
+
+// ========================================================================================
+
 // Base class, defines interface for the operator (-> apply):
 class VRN_CORE_API VolumeOperatorErosionBase : public UnaryVolumeOperatorBase {
 public:
@@ -55,52 +183,8 @@ Volume* VolumeOperatorErosionGeneric<T>::apply(const VolumeBase* vh, int kernelS
     if(!volume)
         return 0;
 
-    VolumeAtomic<T>* output = volume->clone();
-    VolumeAtomic<T>* pong = volume->clone();
-
-    size_t halfKernelDim = static_cast<size_t>(kernelSize / 2);
-    tgt::svec3 volDim = volume->getDimensions();
-
-    // kernel is separable => consecutively apply 1D kernel along each axis instead of a 3D kernel
-
-    // x-direction (volumeVol -> outputVol)
-    VRN_FOR_EACH_VOXEL_WITH_PROGRESS_SUB_TASK(pos, tgt::ivec3(0), volDim, progressReporter, 0.f, 1.f/3) {
-        size_t xmin = pos.x >= halfKernelDim ? pos.x - halfKernelDim : 0;
-        size_t xmax = std::min(pos.x+halfKernelDim, volDim.x-1);
-
-        T val = volume->voxel(pos);
-        tgt::svec3 npos = pos;
-        for (npos.x=xmin; npos.x<=xmax; npos.x++) {
-            val = std::min(val, volume->voxel(npos));
-        }
-        output->voxel(pos) = val;
-    }
-
-    // y-direction (outputVol -> volumeVol)
-    VRN_FOR_EACH_VOXEL_WITH_PROGRESS_SUB_TASK(pos, tgt::ivec3(0), volDim, progressReporter, 1.f/3, 1.f/3) {
-        size_t ymin = pos.y >= halfKernelDim ? pos.y - halfKernelDim : 0;
-        size_t ymax = std::min(pos.y+halfKernelDim, volDim.y-1);
-
-        T val = output->voxel(pos);
-        tgt::svec3 npos = pos;
-        for (npos.y=ymin; npos.y<=ymax; npos.y++) {
-            val = std::min(val, output->voxel(npos));
-        }
-        pong->voxel(pos) = val;
-    }
-
-    // z-direction (volumeVol -> outputVol)
-    VRN_FOR_EACH_VOXEL_WITH_PROGRESS_SUB_TASK(pos, tgt::ivec3(0), volDim, progressReporter, 2.f/3, 1.f/3) {
-        size_t zmin = pos.z >= halfKernelDim ? pos.z - halfKernelDim : 0;
-        size_t zmax = std::min(pos.z+halfKernelDim, volDim.z-1);
-
-        T val = pong->voxel(pos);
-        tgt::svec3 npos = pos;
-        for (npos.z=zmin; npos.z<=zmax; npos.z++) {
-            val = std::min(val, pong->voxel(npos));
-        }
-        output->voxel(pos) = val;
-    }
+    VolumeAtomic<T>* output = new VolumeAtomic<T>(volume->getDimensions());
+    VolumeMorphologyFilter<T, false>::apply(volume, output, kernelSize, progressReporter);
 
     if (progressReporter)
         progressReporter->setProgress(1.f);
@@ -137,52 +221,8 @@ Volume* VolumeOperatorDilationGeneric<T>::apply(const VolumeBase* vh, int kernel
     if(!volume)
         return 0;
 
-    VolumeAtomic<T>* output = volume->clone();
-    VolumeAtomic<T>* pong = volume->clone();
-
-    size_t halfKernelDim = kernelSize / 2;
-    tgt::svec3 volDim = volume->getDimensions();
-
-    // kernel is separable => consecutively apply 1D kernel along each axis instead of a 3D kernel
-
-    // x-direction (inputVol -> outputVol)
-    VRN_FOR_EACH_VOXEL_WITH_PROGRESS_SUB_TASK(pos, tgt::ivec3(0), volDim, progressReporter, 0.f, 1.f/3) {
-        size_t xmin = pos.x >= halfKernelDim ? pos.x - halfKernelDim : 0;
-        size_t xmax = std::min(pos.x+halfKernelDim, volDim.x-1);
-
-        T val = volume->voxel(pos);
-        tgt::svec3 npos = pos;
-        for (npos.x=xmin; npos.x<=xmax; npos.x++) {
-            val = std::max(val, volume->voxel(npos));
-        }
-        output->voxel(pos) = val;
-    }
-
-    // y-direction (outputVol -> inputVol)
-    VRN_FOR_EACH_VOXEL_WITH_PROGRESS_SUB_TASK(pos, tgt::ivec3(0), volDim, progressReporter, 1.f/3, 1.f/3) {
-        size_t ymin = pos.y >= halfKernelDim ? pos.y - halfKernelDim : 0;
-        size_t ymax = std::min(pos.y+halfKernelDim, volDim.y-1);
-
-        T val = output->voxel(pos);
-        tgt::svec3 npos = pos;
-        for (npos.y=ymin; npos.y<=ymax; npos.y++) {
-            val = std::max(val, output->voxel(npos));
-        }
-        pong->voxel(pos) = val;
-    }
-
-    // z-direction (inputVol -> outputVol)
-    VRN_FOR_EACH_VOXEL_WITH_PROGRESS_SUB_TASK(pos, tgt::ivec3(0), volDim, progressReporter, 2.f/3, 1.f/3) {
-        size_t zmin = pos.z >= halfKernelDim ? pos.z - halfKernelDim : 0;
-        size_t zmax = std::min(pos.z+halfKernelDim, volDim.z-1);
-
-        T val = pong->voxel(pos);
-        tgt::svec3 npos = pos;
-        for (npos.z=zmin; npos.z<=zmax; npos.z++) {
-            val = std::max(val, pong->voxel(npos));
-        }
-        output->voxel(pos) = val;
-    }
+    VolumeAtomic<T>* output = new VolumeAtomic<T>(volume->getDimensions());
+    VolumeMorphologyFilter<T, true>::apply(volume, output, kernelSize, progressReporter);
 
     if (progressReporter)
         progressReporter->setProgress(1.f);
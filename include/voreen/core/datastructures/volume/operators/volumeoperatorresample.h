@@ -27,6 +27,8 @@
 #define VRN_VOLUMEOPERATORRESAMPLE_H
 
 #include "voreen/core/datastructures/volume/volumeoperator.h"
+#include "voreen/core/datastructures/volume/volumedisk.h"
+#include "voreen/core/datastructures/volume/volumefactory.h"
 
 namespace voreen {
 
@@ -41,132 +43,205 @@ public:
     /**
      * @param newDims the target dimensions
      * @param filter The filtering mode to use for calculating the resampled values.
+     *
+     * @throw tgt::Exception if the input is streamed from disk and reading fails
      */
     virtual Volume* apply(const VolumeBase* volume, tgt::ivec3 newDims, VolumeRAM::Filter filter, ProgressReporter* progressReporter = 0) const = 0;
 };
 
-// Generic implementation:
+/**
+ * Type used for accumulating the weighted samples during resampling: 8/16 bit and float data is accumulated
+ * in float, so that the inner loops can be vectorized. All other types use their double type.
+ */
+template<typename T>
+struct VolumeResampleTraits {
+    typedef typename VolumeElement<T>::DoubleType Accumulator;
+    typedef double Weight;
+};
+
+template<>
+struct VolumeResampleTraits<uint8_t> {
+    typedef float Accumulator;
+    typedef float Weight;
+};
+
+template<>
+struct VolumeResampleTraits<int8_t> {
+    typedef float Accumulator;
+    typedef float Weight;
+};
+
+template<>
+struct VolumeResampleTraits<uint16_t> {
+    typedef float Accumulator;
+    typedef float Weight;
+};
+
+template<>
+struct VolumeResampleTraits<int16_t> {
+    typedef float Accumulator;
+    typedef float Weight;
+};
+
+template<>
+struct VolumeResampleTraits<float> {
+    typedef float Accumulator;
+    typedef float Weight;
+};
+
+/**
+ * Generic implementation. Since all filters are separable, the target volume is computed slice-wise
+ * by three 1D passes (z, y, x) with per-axis tables of source indices and weights,
+ * and the target slices are processed in parallel (if OpenMP is available).
+ *
+ * If the input volume only has a disk representation, it is not loaded into RAM entirely,
+ * but streamed in slabs of the z slices required by consecutive target slabs.
+ */
 template<typename T>
 class VolumeOperatorResampleGeneric : public VolumeOperatorResampleBase {
 public:
+    VolumeOperatorResampleGeneric();
+
     virtual Volume* apply(const VolumeBase* volume, tgt::ivec3 newDims, VolumeRAM::Filter filter, ProgressReporter* progressReporter = 0) const;
-    //Implement isCompatible using a handy macro:
-    IS_COMPATIBLE
-};
 
-template<typename T>
-Volume* VolumeOperatorResampleGeneric<T>::apply(const VolumeBase* vh, tgt::ivec3 newDims, VolumeRAM::Filter filter, ProgressReporter* progressReporter) const {
-    const VolumeRAM* vol = vh->getRepresentation<VolumeRAM>();
-    if(!vol)
-        return 0;
+    /// Accepts RAM volumes of type T and disk-only volumes of the corresponding format.
+    bool isCompatible(const VolumeBase* volume) const;
 
-    const VolumeAtomic<T>* volume = dynamic_cast<const VolumeAtomic<T>*>(vol);
-    if(!volume)
-        return 0;
+private:
+    typedef typename VolumeResampleTraits<T>::Accumulator Accumulator;
+    typedef typename VolumeResampleTraits<T>::Weight Weight;
 
-    using tgt::vec3;
-    using tgt::ivec3;
-    using tgt::svec3;
+    /// Source indices and weights of the samples contributing to each target position along one axis.
+    struct AxisWeights {
+        size_t numTaps_;
+        std::vector<size_t> indices_;
+        std::vector<Weight> weights_;
+    };
 
-    LDEBUGC("voreen.VolumeOperatorResample", "Resampling from dimensions " << volume->getDimensions() << " to " << newDims);
+    static AxisWeights computeAxisWeights(size_t targetDim, size_t sourceDim, float ratio, VolumeRAM::Filter filter);
 
-    vec3 ratio = vec3(volume->getDimensions()) / vec3(newDims);
+    /**
+     * Computes the target slice z from the source slab, which contains the source slices starting at sourceFirstSlice.
+     * The buffers are used as temporary storage.
+     */
+    static void resampleSlice(const T* source, const tgt::svec3& sourceDims, size_t sourceFirstSlice,
+        T* target, const tgt::svec3& targetDims, size_t z,
+        const AxisWeights& weightsX, const AxisWeights& weightsY, const AxisWeights& weightsZ, bool clampToRange,
+        std::vector<Accumulator>& bufferZ, std::vector<Accumulator>& bufferY);
 
-    ivec3 pos = ivec3::zero; // iteration variable
-    vec3 nearest; // knows the new position of the target volume
+    std::string format_;
+};
 
-    // build target volume
-    VolumeAtomic<T>* v;
-    try {
-         v = new VolumeAtomic<T>(newDims);
+template<typename T>
+VolumeOperatorResampleGeneric<T>::VolumeOperatorResampleGeneric() {
+    VolumeAtomic<T> dummy(tgt::svec3(1, 1, 1));
+    format_ = VolumeFactory().getFormat(&dummy);
+}
+
+template<typename T>
+bool VolumeOperatorResampleGeneric<T>::isCompatible(const VolumeBase* volume) const {
+    // do not load disk volumes into RAM
+    if (!volume->hasRepresentation<VolumeRAM>() && volume->hasRepresentation<VolumeDisk>())
+        return volume->getRepresentation<VolumeDisk>()->getFormat() == format_;
+
+    const VolumeRAM* v = volume->getRepresentation<VolumeRAM>();
+    if(!v)
+        return false;
+    return dynamic_cast<const VolumeAtomic<T>*>(v) != 0;
+}
+
+template<typename T>
+Volume* VolumeOperatorResampleGeneric<T>::apply(const VolumeBase* vh, tgt::ivec3 newDims, VolumeRAM::Filter filter, ProgressReporter* progressReporter) const {
+    const VolumeAtomic<T>* volume = 0;
+    const VolumeDisk* volumeDisk = 0;
+    if (!vh->hasRepresentation<VolumeRAM>() && vh->hasRepresentation<VolumeDisk>()) {
+        volumeDisk = vh->getRepresentation<VolumeDisk>();
+        if (volumeDisk->getFormat() != format_)
+            return 0;
     }
-    catch (std::bad_alloc) {
-        throw; // throw it to the caller
+    else {
+        const VolumeRAM* vol = vh->getRepresentation<VolumeRAM>();
+        if(!vol)
+            return 0;
+
+        volume = dynamic_cast<const VolumeAtomic<T>*>(vol);
+        if(!volume)
+            return 0;
     }
 
-    if (progressReporter)
-        progressReporter->setProgress(0.f);
+    using tgt::vec3;
+    using tgt::svec3;
 
-    /*
-        Filter from the source volume to the target volume.
-    */
-    switch (filter) {
-    case VolumeRAM::NEAREST:
-        for (pos.z = 0; pos.z < newDims.z; ++pos.z) {
+    const svec3 sourceDims = vh->getDimensions();
+    const svec3 targetDims = svec3(newDims);
+    LDEBUGC("voreen.VolumeOperatorResample", "Resampling from dimensions " << sourceDims << " to " << newDims
+        << (volumeDisk ? " (streaming from disk)" : ""));
 
-            if (progressReporter)
-                progressReporter->setProgress(static_cast<float>(pos.z) / static_cast<float>(newDims.z));
+    vec3 ratio = vec3(sourceDims) / vec3(newDims);
 
-            nearest.z = static_cast<float>(pos.z) * ratio.z;
+    // build target volume
+    VolumeAtomic<T>* v = new VolumeAtomic<T>(newDims); // bad_alloc is passed to the caller
 
-            for (pos.y = 0; pos.y < newDims.y; ++pos.y) {
-                nearest.y = static_cast<float>(pos.y) * ratio.y;
+    if (progressReporter)
+        progressReporter->setProgress(0.f);
 
-                for (pos.x = 0; pos.x < newDims.x; ++pos.x) {
-                    nearest.x = static_cast<float>(pos.x) * ratio.x;
+    const AxisWeights weightsX = computeAxisWeights(targetDims.x, sourceDims.x, ratio.x, filter);
+    const AxisWeights weightsY = computeAxisWeights(targetDims.y, sourceDims.y, ratio.y, filter);
+    const AxisWeights weightsZ = computeAxisWeights(targetDims.z, sourceDims.z, ratio.z, filter);
+    // cubic interpolation may overshoot, which would wrap around for integer types.
+    // Floating point data has no fixed range, so the overshoot is kept there.
+    const bool clampToRange = (filter == VolumeRAM::CUBIC) && VolumeElement<T>::isInteger();
+
+    const int numSlices = static_cast<int>(targetDims.z);
+    const int slabSize = getParallelSlabSize(numSlices);
+    for (int slabStart = 0; slabStart < numSlices; slabStart += slabSize) {
+        const int slabEnd = std::min(slabStart + slabSize, numSlices);
+
+        // source slices required by the target slab
+        size_t sourceFirst = sourceDims.z - 1;
+        size_t sourceLast = 0;
+        for (size_t i = slabStart*weightsZ.numTaps_; i < slabEnd*weightsZ.numTaps_; i++) {
+            sourceFirst = std::min(sourceFirst, weightsZ.indices_[i]);
+            sourceLast = std::max(sourceLast, weightsZ.indices_[i]);
+        }
 
-                    svec3 index = tgt::clamp(svec3(nearest + 0.5f), svec3(0, 0, 0), volume->getDimensions() - svec3(1, 1, 1));
-                    v->voxel(pos) = volume->voxel(index); // round and do the lookup
-                }
+        const T* source = 0;
+        VolumeRAM* sourceSlab = 0;
+        if (volumeDisk) {
+            try {
+                sourceSlab = volumeDisk->loadSlices(sourceFirst, sourceLast);
             }
-        }
-        break;
-
-    case VolumeRAM::LINEAR:
-        for (pos.z = 0; pos.z < newDims.z; ++pos.z) {
-
-            if (progressReporter)
-                progressReporter->setProgress(static_cast<float>(pos.z) / static_cast<float>(newDims.z));
-
-            nearest.z = static_cast<float>(pos.z) * ratio.z;
-
-            for (pos.y = 0; pos.y < newDims.y; ++pos.y) {
-                nearest.y = static_cast<float>(pos.y) * ratio.y;
-
-                for (pos.x = 0; pos.x < newDims.x; ++pos.x) {
-                    nearest.x = static_cast<float>(pos.x) * ratio.x;
-                    vec3 p = nearest - floor(nearest); // get decimal part
-                    ivec3 llb = ivec3(nearest);
-                    ivec3 urf = ivec3(ceil(nearest));
-                    urf = tgt::min(urf, ivec3(volume->getDimensions()) - 1); // clamp so the lookups do not exceed the dimensions
-
-                    /*
-                      interpolate linearly
-                    */
-                    typedef typename VolumeElement<T>::DoubleType Double;
-                    v->voxel(pos) =
-                        T(  Double(volume->voxel(llb.x, llb.y, llb.z)) * static_cast<double>((1.f-p.x)*(1.f-p.y)*(1.f-p.z))  // llB
-                          + Double(volume->voxel(urf.x, llb.y, llb.z)) * static_cast<double>((    p.x)*(1.f-p.y)*(1.f-p.z))  // lrB
-                          + Double(volume->voxel(urf.x, urf.y, llb.z)) * static_cast<double>((    p.x)*(    p.y)*(1.f-p.z))  // urB
-                          + Double(volume->voxel(llb.x, urf.y, llb.z)) * static_cast<double>((1.f-p.x)*(    p.y)*(1.f-p.z))  // ulB
-                          + Double(volume->voxel(llb.x, llb.y, urf.z)) * static_cast<double>((1.f-p.x)*(1.f-p.y)*(    p.z))  // llF
-                          + Double(volume->voxel(urf.x, llb.y, urf.z)) * static_cast<double>((    p.x)*(1.f-p.y)*(    p.z))  // lrF
-                          + Double(volume->voxel(urf.x, urf.y, urf.z)) * static_cast<double>((    p.x)*(    p.y)*(    p.z))  // urF
-                          + Double(volume->voxel(llb.x, urf.y, urf.z)) * static_cast<double>((1.f-p.x)*(    p.y)*(    p.z)));// ulF
-                }
+            catch (tgt::Exception&) {
+                delete v;
+                throw;
             }
+            source = static_cast<const T*>(sourceSlab->getData());
+        }
+        else {
+            source = volume->voxel();
+            sourceFirst = 0;
         }
-        break;
-
-    case VolumeRAM::CUBIC:
-        for (pos.z = 0; pos.z < newDims.z; ++pos.z) {
-
-            if (progressReporter)
-                progressReporter->setProgress(static_cast<float>(pos.z) / static_cast<float>(newDims.z));
-
-            nearest.z = static_cast<float>(pos.z) * ratio.z;
-
-            for (pos.y = 0; pos.y < newDims.y; ++pos.y) {
-                nearest.y = static_cast<float>(pos.y) * ratio.y;
-
-                for (pos.x = 0; pos.x < newDims.x; ++pos.x) {
-                    nearest.x = static_cast<float>(pos.x) * ratio.x;
 
-                    v->setVoxelNormalized(volume->getVoxelNormalizedCubic(nearest), pos);
-                }
+        #ifdef VRN_MODULE_OPENMP
+        #pragma omp parallel
+        #endif
+        {
+            // per-thread buffers
+            std::vector<Accumulator> bufferZ(sourceDims.x * sourceDims.y);
+            std::vector<Accumulator> bufferY(sourceDims.x * targetDims.y);
+
+            #ifdef VRN_MODULE_OPENMP
+            #pragma omp for schedule(dynamic)
+            #endif
+            for (int z = slabStart; z < slabEnd; z++) {
+                resampleSlice(source, sourceDims, sourceFirst, v->voxel(), targetDims, static_cast<size_t>(z),
+                    weightsX, weightsY, weightsZ, clampToRange, bufferZ, bufferY);
             }
         }
-        break;
+        delete sourceSlab;
+
+        if (progressReporter)
+            progressReporter->setProgress(static_cast<float>(slabEnd) / static_cast<float>(numSlices));
     }
 
     if (progressReporter)
@@ -177,6 +252,113 @@ Volume* VolumeOperatorResampleGeneric<T>::apply(const VolumeBase* vh, tgt::ivec3
     return h;
 }
 
+template<typename T>
+typename VolumeOperatorResampleGeneric<T>::AxisWeights VolumeOperatorResampleGeneric<T>::computeAxisWeights(
+    size_t targetDim, size_t sourceDim, float ratio, VolumeRAM::Filter filter)
+{
+    AxisWeights result;
+    result.numTaps_ = (filter == VolumeRAM::NEAREST ? 1 : (filter == VolumeRAM::LINEAR ? 2 : 4));
+    result.indices_.resize(targetDim * result.numTaps_);
+    result.weights_.resize(targetDim * result.numTaps_);
+
+    const int maxIndex = static_cast<int>(sourceDim) - 1;
+    for (size_t i = 0; i < targetDim; i++) {
+        const float pos = static_cast<float>(i) * ratio;
+        size_t* indices = &result.indices_[i * result.numTaps_];
+        Weight* weights = &result.weights_[i * result.numTaps_];
+
+        switch (filter) {
+        case VolumeRAM::NEAREST:
+            indices[0] = static_cast<size_t>(std::min(static_cast<int>(pos + 0.5f), maxIndex)); // round
+            weights[0] = Weight(1);
+            break;
+
+        case VolumeRAM::LINEAR: {
+            const float p = pos - std::floor(pos); // get decimal part
+            indices[0] = static_cast<size_t>(pos);
+            indices[1] = static_cast<size_t>(std::min(static_cast<int>(std::ceil(pos)), maxIndex)); // clamp so the lookups do not exceed the dimensions
+            weights[0] = static_cast<Weight>(1.f - p);
+            weights[1] = static_cast<Weight>(p);
+            break;
+        }
+
+        case VolumeRAM::CUBIC: {
+            // Catmull-Rom spline base functions, as used by VolumeRAM::getVoxelNormalizedCubic()
+            const float posCorrected = std::max(pos - 0.5f, 0.f);
+            const float p = posCorrected - std::floor(posCorrected);
+            const int llb = static_cast<int>(posCorrected) - 1;
+            weights[0] = static_cast<Weight>(p*((2.f-p)*p-1.f) / 2.f);
+            weights[1] = static_cast<Weight>((p*p*(3.f*p-5.f) + 2.f) / 2.f);
+            weights[2] = static_cast<Weight>(p*((4.f-3.f*p)*p+1.f) / 2.f);
+            weights[3] = static_cast<Weight>((p-1.f)*p*p / 2.f);
+            for (int k = 0; k < 4; k++)
+                indices[k] = static_cast<size_t>(tgt::clamp(llb + k, 0, maxIndex));
+            break;
+        }
+        }
+    }
+    return result;
+}
+
+template<typename T>
+void VolumeOperatorResampleGeneric<T>::resampleSlice(const T* source, const tgt::svec3& sourceDims, size_t sourceFirstSlice,
+    T* target, const tgt::svec3& targetDims, size_t z,
+    const AxisWeights& weightsX, const AxisWeights& weightsY, const AxisWeights& weightsZ, bool clampToRange,
+    std::vector<Accumulator>& bufferZ, std::vector<Accumulator>& bufferY)
+{
+    const size_t sourceSliceSize = sourceDims.x * sourceDims.y;
+
+    // z: weighted sum of source slices => bufferZ (sourceDims.x * sourceDims.y)
+    Accumulator* slice = &bufferZ[0];
+    for (size_t k = 0; k < weightsZ.numTaps_; k++) {
+        const T* sourceSlice = source + (weightsZ.indices_[z*weightsZ.numTaps_ + k] - sourceFirstSlice) * sourceSliceSize;
+        const Weight w = weightsZ.weights_[z*weightsZ.numTaps_ + k];
+        if (k == 0) {
+            for (size_t i = 0; i < sourceSliceSize; i++)
+                slice[i] = Accumulator(sourceSlice[i]) * w;
+        }
+        else {
+            for (size_t i = 0; i < sourceSliceSize; i++)
+                slice[i] += Accumulator(sourceSlice[i]) * w;
+        }
+    }
+
+    // y: weighted sum of rows => bufferY (sourceDims.x * targetDims.y)
+    for (size_t y = 0; y < targetDims.y; y++) {
+        Accumulator* row = &bufferY[y * sourceDims.x];
+        for (size_t k = 0; k < weightsY.numTaps_; k++) {
+            const Accumulator* sourceRow = slice + weightsY.indices_[y*weightsY.numTaps_ + k] * sourceDims.x;
+            const Weight w = weightsY.weights_[y*weightsY.numTaps_ + k];
+            if (k == 0) {
+                for (size_t x = 0; x < sourceDims.x; x++)
+                    row[x] = sourceRow[x] * w;
+            }
+            else {
+                for (size_t x = 0; x < sourceDims.x; x++)
+                    row[x] += sourceRow[x] * w;
+            }
+        }
+    }
+
+    // x: weighted sum of row elements => target slice
+    const Weight rangeMin = static_cast<Weight>(VolumeElement<T>::rangeMinElement());
+    const Weight rangeMax = static_cast<Weight>(VolumeElement<T>::rangeMaxElement());
+    for (size_t y = 0; y < targetDims.y; y++) {
+        const Accumulator* row = &bufferY[y * sourceDims.x];
+        T* targetRow = target + (z*targetDims.y + y) * targetDims.x;
+        for (size_t x = 0; x < targetDims.x; x++) {
+            const size_t* indices = &weightsX.indices_[x * weightsX.numTaps_];
+            const Weight* weights = &weightsX.weights_[x * weightsX.numTaps_];
+            Accumulator value = row[indices[0]] * weights[0];
+            for (size_t k = 1; k < weightsX.numTaps_; k++)
+                value += row[indices[k]] * weights[k];
+            if (clampToRange)
+                value = tgt::clamp(value, rangeMin, rangeMax);
+            targetRow[x] = T(value);
+        }
+    }
+}
+
 typedef UniversalUnaryVolumeOperatorGeneric<VolumeOperatorResampleBase> VolumeOperatorResample;
 
 } // namespace
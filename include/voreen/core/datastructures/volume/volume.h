@@ -312,6 +312,16 @@ public:
         derivedDataMutex_.unlock();
     }
 
+    /**
+     * Adds the given data item to the derived data associated with this handle, unless an item of the type T
+     * is already present or currently being computed by a derived data thread. In this case, the passed item is deleted.
+     * Is used for attaching derived data that has been computed as by-product of another item.
+     *
+     * @note The handle takes ownership of the passed data item.
+     */
+    template<class T>
+    void addDerivedDataIfMissing(T* data) const;
+
     /**
      * Removes and deletes the derived data item with the specified type T,
      * which must be a concrete subtype of VolumeDerivedData.
@@ -899,6 +909,34 @@ void VolumeBase::addDerivedDataInternal(T* data) const {
     derivedDataMutex_.unlock();
 }
 
+template<class T>
+void VolumeBase::addDerivedDataIfMissing(T* data) const {
+    tgtAssert(data, "null pointer passed");
+
+    derivedDataThreadMutex_.lock();
+    for (std::set<VolumeDerivedDataThreadBase*>::const_iterator it=derivedDataThreads_.begin(); it!=derivedDataThreads_.end(); ++it) {
+        if (typeid(**it) == typeid(VolumeDerivedDataThread<T>)) {
+            derivedDataThreadMutex_.unlock();
+            delete data;
+            return;
+        }
+    }
+
+    // keep the thread mutex locked, so that no thread computing T can be started meanwhile
+    derivedDataMutex_.lock();
+    for (std::set<VolumeDerivedData*>::const_iterator it=derivedData_.begin(); it!=derivedData_.end(); ++it) {
+        if (typeid(**it) == typeid(T)) {
+            derivedDataMutex_.unlock();
+            derivedDataThreadMutex_.unlock();
+            delete data;
+            return;
+        }
+    }
+    derivedData_.insert(static_cast<VolumeDerivedData*>(data));
+    derivedDataMutex_.unlock();
+    derivedDataThreadMutex_.unlock();
+}
+
 template<class T>
 void VolumeBase::removeDerivedDataInternal() const {
     if (!hasDerivedData<T>())
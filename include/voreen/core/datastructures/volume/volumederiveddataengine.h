@@ -0,0 +1,76 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef VRN_VOLUMEDERIVEDDATAENGINE_H
+#define VRN_VOLUMEDERIVEDDATAENGINE_H
+
+#include "voreen/core/datastructures/volume/volumederiveddata.h"
+
+#include <string>
+
+namespace voreen {
+
+class VolumeBase;
+
+/**
+ * Computes the statistical derived data of a volume in a single scan over its voxel data,
+ * instead of one scan per derived data class:
+ * - VolumeMinMax
+ * - VolumeHistogramIntensity (256 buckets per channel)
+ * - VolumeStatistics
+ * - VolumeHash, if the volume only has a RAM representation
+ *
+ * The voxel data is split into blocks of VoreenBlockHash::DEFAULT_BLOCK_SIZE bytes, which are processed
+ * in parallel (if OpenMP is available) with per-thread accumulators that are merged afterwards. Disk volumes
+ * are loaded in slabs of z slices. For 8 and 16 bit data, the occurrences of each value are counted, from which
+ * all items are derived. For all other data types, a second pass computes the histograms and the standard deviations.
+ *
+ * The computation can be interrupted between blocks by boost::thread::interrupt().
+ */
+class VRN_CORE_API VolumeDerivedDataEngine {
+public:
+    /// Number of buckets of the computed histograms, as used by VolumeHistogramIntensity::createFrom().
+    static const int HISTOGRAM_BUCKET_COUNT;
+
+    /// Maximum size of a slab that is loaded from a disk volume at once (64 MB).
+    static const size_t MAX_SLAB_SIZE;
+
+    /**
+     * Computes all derived data items of the passed volume and returns the one of the passed class.
+     * The other items are added to the volume, unless it already holds or currently computes them.
+     * If the volume data cannot be accessed, a default item is returned and nothing is added.
+     *
+     * @param className "VolumeMinMax", "VolumeHistogramIntensity" or "VolumeStatistics"
+     */
+    static VolumeDerivedData* createDerivedData(const VolumeBase* volume, const std::string& className);
+
+private:
+    static const std::string loggerCat_;
+};
+
+} // namespace voreen
+
+#endif
@@ -161,6 +161,40 @@ public:
     virtual VolumeRAM* loadBrick(const tgt::svec3& offset, const tgt::svec3& dimensions) const
         throw (tgt::Exception);
 
+    /**
+     * Loads a brick of the volume from disk directly into the passed VolumeRAM,
+     * which must match the brick dimensions and the volume's bytes per voxel.
+     *
+     * @param offset lower-left-front corner voxel of the brick to load
+     * @param dimensions dimension of the brick to load
+     * @param dest the VolumeRAM to read into
+     *
+     * @throw tgt::Exception if the brick could not be loaded
+     */
+    void loadBrick(const tgt::svec3& offset, const tgt::svec3& dimensions, VolumeRAM* dest) const
+        throw (tgt::Exception);
+
+    /**
+     * Reads a brick from a raw file into a buffer with as few system calls as possible:
+     * rows that are adjacent in the file and the buffer are merged into a single read
+     * (whole z plates, if the brick spans full rows), and rows separated by small gaps
+     * are read by a single vectored read directly into the buffer (pread/preadv).
+     *
+     * @param filename the raw file
+     * @param dataOffset byte offset of the volume data in the file. If negative, the data is assumed to be aligned to the end of the file.
+     * @param volumeDim dimensions of the volume stored in the file
+     * @param bytesPerVoxel size of a voxel in bytes
+     * @param brickOffset lower-left-front corner voxel of the brick
+     * @param brickDim dimensions of the brick, must lie within the volume
+     * @param dest buffer to read into
+     * @param destDim dimensions of the destination buffer, the brick is written to its lower-left-front corner
+     *
+     * @throw tgt::FileException if the file could not be read
+     */
+    static void readBrickFromFile(const std::string& filename, int64_t dataOffset, const tgt::svec3& volumeDim,
+        size_t bytesPerVoxel, const tgt::svec3& brickOffset, const tgt::svec3& brickDim, void* dest, const tgt::svec3& destDim)
+        throw (tgt::FileException);
+
 protected:
     std::string filename_;
     int64_t offset_;
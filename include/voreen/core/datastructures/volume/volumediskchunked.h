@@ -0,0 +1,149 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef VRN_VOLUMEDISKCHUNKED_H
+#define VRN_VOLUMEDISKCHUNKED_H
+
+#include "voreen/core/datastructures/volume/volumedisk.h"
+
+#include <vector>
+
+namespace voreen {
+
+class ProgressReporter;
+class VolumeBase;
+
+/**
+ * Disk volume that references a chunk file, which stores the volume as independently compressed
+ * chunks of fixed size together with a mip pyramid of halfsampled resolution levels.
+ *
+ * The file starts with a header and ends with a chunk index that stores the file offset and
+ * the encoded size of each chunk of each level. The chunks are compressed losslessly by
+ * splitting the chunk's values into byte planes and bit-packing each plane block-wise relative
+ * to the block's minimum (frame of reference). Chunks that do not shrink are stored raw.
+ *
+ * Loading a brick or a set of slices reads and decodes only the chunks touching the requested
+ * region, in parallel if the OpenMP module is enabled. The VolumeDisk interface refers to the
+ * full resolution level 0, the coarser levels are accessible via loadBrick(level, ...).
+ */
+class VRN_CORE_API VolumeDiskChunked : public VolumeDisk {
+public:
+    /**
+     * Reads the header and the chunk index of the passed chunk file.
+     *
+     * @param filename Absolute file name of the chunk file.
+     * @param format @see VolumeFactory
+     * @param dimensions voxel dimensions of the full resolution level
+     *
+     * @throw tgt::FileException if the file could not be read or does not match format and dimensions
+     */
+    VolumeDiskChunked(const std::string& filename, const std::string& format, tgt::svec3 dimensions)
+        throw (tgt::FileException);
+    virtual ~VolumeDiskChunked();
+
+    std::string getFileName() const { return filename_; }
+
+    /// Returns the dimensions of the chunks. Chunks at the upper volume borders may be smaller.
+    tgt::svec3 getChunkDimensions() const { return chunkDim_; }
+
+    /// Returns the number of resolution levels including the full resolution level 0.
+    size_t getNumLevels() const;
+
+    /// Returns the voxel dimensions of the passed level.
+    tgt::svec3 getLevelDimensions(size_t level) const;
+
+    /// Computes a hash string from the filename, its modification time and size, the format and the dimensions.
+    virtual std::string getHash() const;
+
+    virtual VolumeRAM* loadVolume() const
+        throw (tgt::Exception);
+
+    virtual VolumeRAM* loadSlices(const size_t firstZSlice, const size_t lastZSlice) const
+        throw (tgt::Exception);
+
+    virtual VolumeRAM* loadBrick(const tgt::svec3& offset, const tgt::svec3& dimensions) const
+        throw (tgt::Exception);
+
+    /**
+     * Loads a brick of the passed resolution level and returns it as VolumeRAM.
+     * The caller is responsible for deleting the returned object.
+     *
+     * @throw tgt::Exception if the brick could not be loaded
+     */
+    VolumeRAM* loadBrick(size_t level, const tgt::svec3& offset, const tgt::svec3& dimensions) const
+        throw (tgt::Exception);
+
+    /**
+     * Writes the passed volume into a chunk file that can be referenced by a VolumeDiskChunked.
+     *
+     * The volume is streamed slab-wise from its RAM representation, if present, or otherwise
+     * from its disk representation, so that volumes exceeding the main memory can be written.
+     * The chunks are encoded in parallel if the OpenMP module is enabled.
+     *
+     * @param filename the chunk file to write
+     * @param volume the volume to write
+     * @param chunkDim dimensions of the chunks
+     * @param numLevels number of resolution levels to store. If 0, levels are added until
+     *        the coarsest level fits into a single chunk.
+     * @param progressReporter optional progress reporter
+     *
+     * @throw tgt::IOException if the file could not be written
+     */
+    static void writeChunkFile(const std::string& filename, const VolumeBase* volume, const tgt::svec3& chunkDim,
+        size_t numLevels = 0, ProgressReporter* progressReporter = 0)
+        throw (tgt::IOException);
+
+    /// Default chunk dimensions used by the writers.
+    static const size_t DEFAULT_CHUNK_SIZE = 64;
+
+private:
+    /// Location of an encoded chunk within the chunk file.
+    struct ChunkEntry {
+        uint64_t offset_;
+        uint64_t size_;
+    };
+
+    /// Dimensions and chunk index of a resolution level.
+    struct Level {
+        tgt::svec3 dimensions_;
+        tgt::svec3 numChunks_;
+        std::vector<ChunkEntry> chunks_;
+    };
+
+    void readIndex()
+        throw (tgt::FileException);
+
+    std::string filename_;
+    tgt::svec3 chunkDim_;
+    size_t bytesPerValue_;  ///< size of a single channel value, i.e., the width of the byte planes
+    std::vector<Level> levels_;
+
+    static const std::string loggerCat_;
+};
+
+} // namespace voreen
+
+#endif // VRN_VOLUMEDISKCHUNKED_H
@@ -29,6 +29,7 @@
 #include "voreen/core/datastructures/volume/volumeram.h"
 #include "voreen/core/datastructures/volume/volume.h"
 #include "voreen/core/datastructures/volume/volumederiveddata.h"
+#include "voreen/core/utils/hashing.h"
 
 #include <string>
 #include <iostream>
@@ -36,11 +37,17 @@
 
 namespace voreen {
 
+/**
+ * Hash of the volume data. For RAM volumes, the hash is computed from the voxel data by a parallel block hash
+ * (@see VoreenBlockHash), for disk volumes it is obtained from VolumeDisk::getHash().
+ */
 class VRN_CORE_API VolumeHash : public VolumeDerivedData {
 public:
     /// Empty default constructor required by VolumeDerivedData interface.
     VolumeHash();
     VolumeHash(const std::string& hash);
+    /// Creates the hash from the passed block hashes of a RAM volume's data.
+    VolumeHash(const VoreenBlockHash& blockHash);
     virtual std::string getClassName() const { return "VolumeHash"; }
 
     virtual VolumeDerivedData* create() const;
@@ -38,6 +38,11 @@
 
 #include <vector>
 #include <limits>
+#include <algorithm>
+
+#ifdef VRN_MODULE_OPENMP
+#include "omp.h"
+#endif
 
 namespace voreen {
 
@@ -235,6 +240,19 @@ void UniversalBinaryVolumeOperatorGeneric<BASE_TYPE>::addInstance(BASE_TYPE* ins
         for ((INDEX).y = (POS).y; (INDEX).y < (SIZE).y; ++(INDEX).y)\
             for ((INDEX).x = (POS).x; (INDEX).x < (SIZE).x; ++(INDEX).x)
 
+/**
+ * Returns the number of slices (or lines) that operators processing their data in parallel
+ * should distribute among the threads between two progress updates: large enough to keep all threads busy,
+ * but small enough for a smooth progress bar. Progress reporters must only be updated from the calling thread.
+ */
+inline int getParallelSlabSize(int numSlices) {
+    int numThreads = 1;
+#ifdef VRN_MODULE_OPENMP
+    numThreads = std::max(omp_get_max_threads(), 1);
+#endif
+    return std::max(std::max(4*numThreads, (numSlices + 31) / 32), 1);
+}
+
 } // namespace
 
 #endif // VRN_VOLUMEOPERATOR_H
@@ -31,9 +31,15 @@
 
 #include "voreen/core/datastructures/volume/volumeram.h"
 #include "voreen/core/datastructures/volume/volume.h"
-#include "voreen/core/utils/backgroundthread.h"
+#include "voreen/core/utils/observer.h"
 
+#include <boost/thread/thread.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <list>
+#include <map>
+#include <deque>
 
 namespace voreen {
 
@@ -136,7 +142,16 @@ static VolumeSliceGL* getVolumeSlice(const VolumeBase* volume, SliceAlignment al
 
 /**
  * Extracts an arbitrarily aligned slice from the passed volume.
- * TODO: more doc
+ * The slice is sampled with trilinear filtering from the first channel of the RAM representation
+ * and stored as normalized float data. The texture is not created before the slice is bound,
+ * so this function may be called from a worker thread.
+ * The caller takes ownership of the returned object.
+ *
+ * @param pl the slice plane in world coordinates. If it coincides with an axis-aligned slice,
+ *        the aligned slice is extracted instead.
+ * @param samplingRate number of samples per voxel, with respect to the smallest voxel spacing
+ *
+ * @return the created slice, or 0 if the volume has no RAM representation
  */
 static VolumeSliceGL* getVolumeSlice(const VolumeBase* volume, tgt::plane pl, float samplingRate);
 
@@ -173,23 +188,31 @@ protected:
 //------------------------------------------------------------------------------------------------
 
 
-class SliceCreationBackgroundThread;
-
 /**
  * Fixed-size LRU cache for 2D volume slices. On each getVolumeSlice() call the VolumeSliceCache checks whether
  * a slice with the specified parameters is present in the cache and returns it, if this is the case.
  * If not, the slice is extracted from the underlying volume via the VolumeSliceHelper and stored in the cache.
+ *
+ * Slices can also be created in the background by a small pool of worker threads, either on an asynchronous
+ * getVolumeSlice() call or speculatively via prefetchSlices(). The cache observes the volumes of pending requests
+ * and discards them, if a volume is deleted or changed.
  */
-class VRN_CORE_API VolumeSliceCache {
-    friend class SliceCreationBackgroundThread;
+class VRN_CORE_API VolumeSliceCache : public VolumeObserver {
 public:
-    VolumeSliceCache(Processor* owner, size_t cacheSize);
+    VolumeSliceCache(Processor* owner, size_t cacheSize, size_t numPrefetchThreads = 2);
     ~VolumeSliceCache();
 
     size_t getCacheSize() const;
     void setCacheSize(size_t cacheSize);
+
+    /// Discards all pending requests and deletes all cached slices.
     void clear();
 
+    size_t getNumPrefetchThreads() const;
+
+    /// Sets the number of worker threads. Pending requests are discarded. 0 disables background creation.
+    void setNumPrefetchThreads(size_t numThreads);
+
     VolumeSliceGL* getVolumeSlice(const VolumeBase* volume, SliceAlignment alignment, size_t sliceIndex,
         size_t levelOfDetail = 0, clock_t timeLimit = 0, bool* complete = 0, bool asynchronous = false) const;
     VolumeSliceGL* getVolumeSlice(const VolumeBase* volume, tgt::plane pl, float samplingRate, bool asynchronous = false) const;
@@ -197,25 +220,101 @@ public:
     bool hasSliceInCache(const VolumeBase* volume, SliceAlignment alignment, size_t sliceIndex, size_t levelOfDetail = 0) const;
     bool hasSliceInCache(const VolumeBase* volume, tgt::plane pl, float samplingRate) const;
 
+    /**
+     * Schedules the background creation of the numSlices slices following sliceIndex in the passed direction.
+     * Slices that are already cached or being created are skipped. Previously scheduled prefetch requests
+     * are discarded, so the prefetched slices always follow the latest scroll position.
+     *
+     * @param direction +1 for increasing, -1 for decreasing slice indices
+     * @param numSlices number of slices to prefetch. At most half of the cache is used for prefetching.
+     */
+    void prefetchSlices(const VolumeBase* volume, SliceAlignment alignment, size_t sliceIndex, int direction,
+        size_t numSlices, size_t levelOfDetail = 0) const;
+
+    /**
+     * Schedules the background creation of the numSlices unaligned slices parallel to the passed plane,
+     * with the plane distance being shifted by multiples of planeDistance (world coordinates, signed).
+     *
+     * @see prefetchSlices
+     */
+    void prefetchSlices(const VolumeBase* volume, tgt::plane pl, float samplingRate, float planeDistance, size_t numSlices) const;
+
+    /// Discards pending requests for the deleted volume and waits for the running ones.
+    virtual void volumeDelete(const VolumeBase* source);
+
+    /// Discards pending requests for the changed volume and waits for the running ones.
+    virtual void volumeChange(const VolumeBase* source);
+
 private:
+    /// Identifies a slice: the volume's hash and the slice parameters. Aligned slices have an undefined plane/sampling rate.
+    struct SliceKey {
+        std::string volumeHash_;
+        SliceAlignment alignment_;
+        size_t sliceIndex_;
+        size_t levelOfDetail_;
+        tgt::vec4 plane_;       //< normal and distance of unaligned slices
+        float samplingRate_;    //< unaligned slices only
+
+        bool operator<(const SliceKey& other) const;
+        bool operator==(const SliceKey& other) const;
+    };
+
     struct CacheEntry {
-        std::string hash_;  //< consisting of the input volume hash and a hash of the slice parameters
+        SliceKey key_;
         VolumeSliceGL* slice_;
     };
 
-    void addSliceToCache(VolumeSliceGL* slice, const std::string& hash) const;
+    struct SliceRequest {
+        const VolumeBase* volume_;
+        SliceKey key_;
+        bool prefetch_;     //< speculative request, may be discarded by the next prefetchSlices() call
+    };
+
+    typedef std::list<CacheEntry> CacheList;
+
+    SliceKey getKey(const VolumeBase* volume, SliceAlignment alignment, size_t sliceIndex, size_t levelOfDetail) const;
+    SliceKey getKey(const VolumeBase* volume, tgt::plane pl, float samplingRate) const;
+
+    /// Enqueues an asynchronous request in front of the pending ones, a prefetch request behind them. Expects the cache mutex to be locked.
+    void enqueueRequest(const VolumeBase* volume, const SliceKey& key, bool prefetch) const;
+
+    /// Adds the slice to the cache, returns false if it has not been stored. Expects the cache mutex to be locked.
+    bool addSliceToCache(VolumeSliceGL* slice, const SliceKey& key) const;
+
+    /// Evicts the least recently used slices exceeding the cache size. Expects the cache mutex to be locked.
     void cleanupCache() const;
-    VolumeSliceGL* findSliceInCache(const std::string& hash, bool updateUsage) const;
 
-    std::string getHash(const VolumeBase* volume, SliceAlignment alignment, size_t sliceIndex, size_t levelOfDetail) const;
-    std::string getHash(const VolumeBase* volume, tgt::plane pl, float samplingRate) const;
+    /// Returns the cached slice for the key (or 0). Expects the cache mutex to be locked.
+    VolumeSliceGL* findSliceInCache(const SliceKey& key, bool updateUsage) const;
+
+    /// The following functions expect the cache mutex to be locked.
+    bool isRequestRunning(const SliceKey& key) const;
+    void removePendingRequest(const SliceKey& key) const;
+    void discardPrefetchRequests() const;
+
+    /// Discards the pending requests for the volume and waits for the running ones.
+    void discardRequests(const VolumeBase* volume);
+
+    static VolumeSliceGL* createSlice(const VolumeBase* volume, const SliceKey& key);
+
+    void prefetchThreadMain() const;
+    void startPrefetchThreads() const;
+    void stopPrefetchThreads();
 
     Processor* owner_;
 
-    mutable std::list<CacheEntry> slices_;
+    mutable CacheList slices_;                                      //< most recently used first
+    mutable std::map<SliceKey, CacheList::iterator> sliceMap_;      //< maps the keys to the entries of slices_
     size_t cacheSize_;
 
-    mutable SliceCreationBackgroundThread* currentBackgroundThread_;
+    size_t numPrefetchThreads_;
+    mutable std::vector<boost::thread*> prefetchThreads_;   //< started on the first background request
+    mutable std::deque<SliceRequest> requestQueue_;         //< pending requests, asynchronous requests first
+    mutable std::vector<SliceRequest> runningRequests_;     //< requests currently processed by the worker threads
+    mutable bool stopPrefetching_;                          //< signals the worker threads to terminate
+    mutable boost::condition_variable prefetchCond_;        //< wakes up the worker threads
+    mutable boost::condition_variable requestFinishedCond_; //< signaled, if a worker thread has finished a request
+
     mutable boost::mutex cacheAccessMutex_; ///< mutex for synchronizing cache accesses
 };
 
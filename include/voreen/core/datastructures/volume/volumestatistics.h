@@ -0,0 +1,81 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef VRN_VOLUMESTATISTICS_H
+#define VRN_VOLUMESTATISTICS_H
+
+#include "voreen/core/datastructures/volume/volumederiveddata.h"
+
+#include <vector>
+
+namespace voreen {
+
+/**
+ * Mean and standard deviation of the voxel values of each channel.
+ *
+ * Is computed together with VolumeMinMax and VolumeHistogramIntensity by the VolumeDerivedDataEngine.
+ */
+class VRN_CORE_API VolumeStatistics : public VolumeDerivedData {
+public:
+    /// Empty default constructor required by VolumeDerivedData interface.
+    VolumeStatistics();
+    VolumeStatistics(const std::vector<float>& means, const std::vector<float>& stdDevs,
+        const std::vector<float>& meansNormalized, const std::vector<float>& stdDevsNormalized);
+    virtual std::string getClassName() const { return "VolumeStatistics"; }
+
+    virtual VolumeDerivedData* create() const;
+
+    virtual VolumeDerivedData* createFrom(const VolumeBase* handle) const;
+
+    /// @see VolumeDerivedData
+    virtual void serialize(XmlSerializer& s) const;
+
+    /// @see VolumeDerivedData
+    virtual void deserialize(XmlDeserializer& s);
+
+    /// Returns the number of channels saved in this derived data.
+    size_t getNumChannels() const;
+
+    /// Mean (RealWorld)
+    float getMean(size_t channel = 0) const;
+
+    /// Standard deviation (RealWorld)
+    float getStdDev(size_t channel = 0) const;
+
+    float getMeanNormalized(size_t channel = 0) const;
+
+    float getStdDevNormalized(size_t channel = 0) const;
+
+protected:
+    std::vector<float> means_;
+    std::vector<float> stdDevs_;
+    std::vector<float> meansNormalized_;
+    std::vector<float> stdDevsNormalized_;
+};
+
+} // namespace voreen
+
+#endif
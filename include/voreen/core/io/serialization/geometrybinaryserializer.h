@@ -0,0 +1,187 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef VRN_GEOMETRYBINARYSERIALIZER_H
+#define VRN_GEOMETRYBINARYSERIALIZER_H
+
+#include "voreen/core/voreencoreapi.h"
+#include "voreen/core/io/serialization/serializationexceptions.h"
+
+#include "tgt/types.h"
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstring>
+
+namespace voreen {
+
+class Geometry;
+
+/**
+ * Writes geometries to the binary Voreen geometry format (.vgb), which is intended for
+ * large geometries that are slow to serialize as XML.
+ *
+ * A binary geometry file consists of a header followed by the data written by the geometry's
+ * Geometry::serializeBinary() method, which typically stores the geometry's vertex and index arrays
+ * as contiguous blobs:
+ *  - magic number "VRNGEOMB", format version (uint32), byte order mark (uint32)
+ *  - class name of the geometry (uint32 length followed by the characters)
+ *  - transformation matrix (16 floats, row-major)
+ *  - geometry data
+ *
+ * Each blob written by writeVector() is preceded by its element size and element count (both uint64),
+ * which allows the reader to detect incompatible element types.
+ *
+ * @see GeometryBinaryDeserializer
+ */
+class VRN_CORE_API GeometryBinarySerializer {
+public:
+    /// Writes the binary geometry data to the passed stream, which has to be opened in binary mode.
+    GeometryBinarySerializer(std::ostream& stream);
+
+    /**
+     * Writes the passed geometry to a binary geometry file.
+     *
+     * @throw SerializationException if the geometry does not support binary serialization or the file could not be written
+     */
+    static void writeGeometry(const Geometry* geometry, const std::string& filename)
+        throw (SerializationException);
+
+    /// Returns true, if the passed filename has the extension of binary geometry files.
+    static bool isBinaryGeometryFile(const std::string& filename);
+
+    /// Writes a single value of plain-old-data type.
+    template<class T>
+    void write(const T& value)
+        throw (SerializationException);
+
+    /// Writes the element size, the element count and the elements of the vector as one contiguous blob.
+    template<class T>
+    void writeVector(const std::vector<T>& data)
+        throw (SerializationException);
+
+    void writeBlob(const void* data, size_t numBytes)
+        throw (SerializationException);
+
+    static const std::string FILE_EXTENSION;    ///< "vgb"
+
+private:
+    std::ostream& stream_;
+};
+
+/**
+ * Reads geometries from the binary Voreen geometry format. The file is memory-mapped and the
+ * blobs are copied directly into the containers of the geometry.
+ *
+ * @see GeometryBinarySerializer
+ */
+class VRN_CORE_API GeometryBinaryDeserializer {
+public:
+    /// Reads from the passed memory region. @param source name of the data source used in error messages
+    GeometryBinaryDeserializer(const char* data, size_t size, const std::string& source);
+
+    /**
+     * Reads a geometry from a binary geometry file. The geometry is instantiated by its class name
+     * via the VoreenApplication, therefore its module has to be registered.
+     *
+     * @return the read geometry, never null
+     * @throw SerializationException if the file could not be read or is corrupted
+     */
+    static Geometry* readGeometry(const std::string& filename)
+        throw (SerializationException);
+
+    /// Reads a single value of plain-old-data type.
+    template<class T>
+    void read(T& value)
+        throw (SerializationException);
+
+    /// Reads a blob written by GeometryBinarySerializer::writeVector() into the passed vector.
+    template<class T>
+    void readVector(std::vector<T>& data)
+        throw (SerializationException);
+
+    /// Returns a pointer to the next numBytes bytes of the data and advances the read position.
+    const char* readBlob(size_t numBytes)
+        throw (SerializationException);
+
+    /// Returns the number of bytes that have not been read yet.
+    size_t getNumRemainingBytes() const;
+
+private:
+    const char* data_;
+    size_t size_;
+    size_t position_;
+    std::string source_;
+};
+
+//-------------------------------------------------------------------------------------------------
+
+template<class T>
+void GeometryBinarySerializer::write(const T& value)
+    throw (SerializationException)
+{
+    writeBlob(&value, sizeof(T));
+}
+
+template<class T>
+void GeometryBinarySerializer::writeVector(const std::vector<T>& data)
+    throw (SerializationException)
+{
+    write<uint64_t>(sizeof(T));
+    write<uint64_t>(data.size());
+    if (!data.empty())
+        writeBlob(&data[0], sizeof(T) * data.size());
+}
+
+template<class T>
+void GeometryBinaryDeserializer::read(T& value)
+    throw (SerializationException)
+{
+    memcpy(&value, readBlob(sizeof(T)), sizeof(T));
+}
+
+template<class T>
+void GeometryBinaryDeserializer::readVector(std::vector<T>& data)
+    throw (SerializationException)
+{
+    uint64_t elementSize = 0;
+    uint64_t numElements = 0;
+    read(elementSize);
+    read(numElements);
+    if (elementSize != sizeof(T))
+        throw SerializationException("Element size mismatch in binary geometry " + source_ + ": file has incompatible element type");
+    if (numElements > getNumRemainingBytes() / sizeof(T))
+        throw SerializationException("Unexpected end of binary geometry " + source_);
+
+    data.resize(static_cast<size_t>(numElements));
+    if (!data.empty())
+        memcpy(&data[0], readBlob(sizeof(T) * data.size()), sizeof(T) * data.size());
+}
+
+} // namespace
+
+#endif // VRN_GEOMETRYBINARYSERIALIZER_H
@@ -226,6 +226,18 @@ public:
      */
     void clearPerformanceRecords();
 
+    /**
+     * Writes the spans recorded by the Tracer to the passed file in the Chrome trace event format.
+     * The spans comprise the profiling blocks of the processors' performance records
+     * (\sa collectPerformanceRecords), port data assignments and brick I/O.
+     *
+     * @note Spans are only recorded while tracing is enabled (\sa Tracer::setEnabled).
+     *
+     * @throw VoreenException if the file could not be written
+     */
+    void writeChromeTrace(const std::string& filename) const
+        throw (VoreenException);
+
     /**
      * Marks the assigned network as modified, which causes
      * onNetworkChanged() to be called during next process() call.
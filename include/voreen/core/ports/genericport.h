@@ -27,6 +27,7 @@
 #define VRN_GENERICPORT_H
 
 #include "voreen/core/ports/port.h"
+#include "voreen/core/utils/tracing.h"
 #include "voreen/core/datastructures/imagesequence.h"
 #include "voreen/core/datastructures/volume/volumelist.h"
 
@@ -58,6 +59,15 @@ public:
      */
     virtual void setData(const T* data, bool takeOwnership = true);
 
+    /// Returns true, if the port deletes its data when new data is assigned or on destruction.
+    bool ownsData() const;
+
+    /**
+     * Passes the ownership of the port data to the caller, who becomes responsible for deleting it.
+     * The data remains assigned to the port. Can only be called on outports.
+     */
+    void releaseDataOwnership();
+
     /// Return the data stored in this port (if this is an outport) or the data of the first connected outport (if this is an inport).
     virtual const T* getData() const;
     /// Returns a non-const pointer to the data. Can only be used on outports.
@@ -177,6 +187,8 @@ void GenericPort<T>::forwardData() const{
 template <typename T>
 void GenericPort<T>::setData(const T* data, bool takeOwnership) {
     tgtAssert(isOutport(), "called setData on inport!");
+    // the span name is only built, if tracing is enabled
+    const uint64_t traceStart = (Tracer::isEnabled() ? Tracer::getTimestamp() : 0);
 
     //delete previous data:
     if(ownsData_)
@@ -186,6 +198,20 @@ void GenericPort<T>::setData(const T* data, bool takeOwnership) {
     ownsData_ = takeOwnership;
 
     invalidatePort();
+
+    if (traceStart != 0)
+        Tracer::recordSpan("port", getQualifiedName() + ".setData", traceStart, Tracer::getTimestamp());
+}
+
+template <typename T>
+bool GenericPort<T>::ownsData() const {
+    return ownsData_;
+}
+
+template <typename T>
+void GenericPort<T>::releaseDataOwnership() {
+    tgtAssert(isOutport(), "called releaseDataOwnership on inport!");
+    ownsData_ = false;
 }
 
 template <typename T>
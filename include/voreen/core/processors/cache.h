@@ -28,14 +28,43 @@
 
 #include <vector>
 #include <string>
+#include <list>
 
 #include "voreen/core/processors/processor.h"
 
 namespace voreen {
 
+class VolumeBase;
+
+/**
+ * Caches the outport data of a processor for combinations of inport data and property state.
+ *
+ * The cache consists of two independent tiers: a size-bounded memory tier holding the most recently used
+ * outport volumes (storeToMemory(), restoreFromMemory()), and a persistent tier storing the outport data
+ * in the processor's cache directory (store(), restore()).
+ * The memory tier is only used for processors whose outports are all volume ports. It takes over
+ * the ownership of the outport volumes and assigns them to the ports without ownership,
+ * so it must only be used for processors that never modify their output volumes after assigning them.
+ */
 class VRN_CORE_API Cache {
 public:
+    /// Counters of the memory tier.
+    struct MemoryCacheStatistics {
+        size_t numEntries_;
+        uint64_t sizeInBytes_;
+        uint64_t limitInBytes_;
+        uint64_t numHits_;
+        uint64_t numMisses_;
+        uint64_t numEvictions_;
+
+        MemoryCacheStatistics();
+
+        /// Returns a short description of the statistics, e.g. for displaying it in the GUI.
+        std::string toString() const;
+    };
+
     Cache(Processor* proc);
+    ~Cache();
 
     void addInport(Port* inport);
     void addAllInports();
@@ -50,15 +79,29 @@ public:
     bool isInitialized() const { return initialized_; }
 
     std::string getCurrentCacheDir();
+
+    /// Clears both tiers. Memory cache entries currently assigned to the outports are kept.
     void clearCache();
 
+    /// Sets the byte budget of the memory tier and evicts entries exceeding it. Zero disables the memory tier.
+    void setMemoryCacheLimit(uint64_t limitInBytes);
+    MemoryCacheStatistics getMemoryCacheStatistics() const;
+    void clearMemoryCache();
+
     std::string getAllInportHashes();
     std::string getPropertyState();
     std::string getPropertyStateHash();
 
+    /// Stores the outport data in the persistent tier.
     bool store();
+    /// Restores the outport data from the persistent tier.
     bool restore();
 
+    /// Takes over the outport volumes into the memory tier, if it is enabled and the ports own them.
+    void storeToMemory();
+    /// Assigns the volumes of the matching memory tier entry to the outports. Returns false, if there is none.
+    bool restoreFromMemory();
+
     bool restoreOutportsFromDir(const std::string& dir);
     bool storeOutportsToDir(const std::string& dir);
 protected:
@@ -68,6 +111,13 @@ protected:
     bool updateLastAccess(std::string dir);
     bool writePropertyState(std::string dir);
 
+    /// Assigns the data of the memory cache entry matching the key to the outports.
+    bool restoreFromMemory(const std::string& key, const std::string& propertyState);
+    /// Takes over the outport volumes into the memory cache, if the ports own them.
+    void storeToMemory(const std::string& key, const std::string& propertyState);
+    /// Evicts least recently used entries that are not assigned to the outports until the budget is met.
+    void limitMemoryCache(uint64_t limitInBytes);
+
     /// category used in logging
     static const std::string loggerCat_;
 
@@ -79,6 +129,20 @@ private:
     std::vector<std::string> outports_;
 
     std::vector<std::string> properties_;
+
+    /// Memory tier entry, owns the outport volumes.
+    struct MemoryCacheEntry {
+        std::string key_;                           ///< inport hashes + property state hash
+        std::string propertyState_;                 ///< for detecting hash collisions
+        std::vector<const VolumeBase*> volumes_;    ///< one per outport, may be null
+        uint64_t size_;
+    };
+
+    bool isInUse(const MemoryCacheEntry& entry) const;
+    void deleteEntry(std::list<MemoryCacheEntry>::iterator entry);
+
+    std::list<MemoryCacheEntry> memoryCache_;       ///< ordered from most to least recently used
+    mutable MemoryCacheStatistics memoryCacheStatistics_;
 };
 
 /// Cleans up the cache dir, will usually be called by VoreenApplication.
@@ -26,17 +26,12 @@
 #ifndef VRN_PROFILING_H
 #define VRN_PROFILING_H
 
-#ifdef WIN32
-#include <windows.h>
-#include <winbase.h>
-#endif
-
 #include <string>
 #include <vector>
 #include <stack>
-#include <time.h>
 
 #include "voreen/core/voreencoreapi.h"
+#include "tgt/types.h"
 
 namespace voreen {
 
@@ -84,10 +79,15 @@ class ProfilingBlock;
 
 /**
  * @brief Holds profiling info for an object.
+ *
+ * Only the most recent MAX_SAMPLES samples are kept.
  */
 class VRN_CORE_API PerformanceRecord {
     friend class ProfilingBlock;
 public:
+    /// Maximum number of samples kept in the history.
+    static const size_t MAX_SAMPLES;
+
     PerformanceRecord();
     ~PerformanceRecord();
 
@@ -111,6 +111,10 @@ protected:
 /**
  * @brief The constructor/destructor of this class is used to time blocks.
  *
+ * Measures the wall time of the block with a monotonic high-resolution clock.
+ * If tracing is enabled, the block is additionally recorded as a span
+ * named "<record name>.<block name>" (\sa Tracer).
+ *
  * Use macro PROFILING_BLOCK("NAME") to measure runtime of a block.
  */
 class VRN_CORE_API ProfilingBlock {
@@ -118,31 +122,21 @@ public:
     ProfilingBlock(std::string name, PerformanceRecord& pr);
     ~ProfilingBlock();
 
+    /// Returns the measured time in seconds.
     float getTime() const;
     std::string getName() const;
 protected:
     std::string name_;
     PerformanceRecord& pr_;
 
-    clock_t start_;
-    clock_t end_;
-
-#ifdef _MSC_VER  // use high-performance counter on windows systems
-    bool useHpf_;
-    LARGE_INTEGER hpfTicksPerSecond_;
-    LARGE_INTEGER hpfStart_;
-    LARGE_INTEGER hpfEnd_;
-#endif
+    uint64_t start_;    ///< in nanoseconds
+    uint64_t end_;      ///< in nanoseconds
 
     //static const std::string loggerCat_;
 };
 
-#ifdef VRN_PRINT_PROFILING
 #define PROFILING_BLOCK(name) \
     ProfilingBlock block(name, performanceRecord_);
-#else
-#define PROFILING_BLOCK(name)
-#endif
 
 } // namespace
 
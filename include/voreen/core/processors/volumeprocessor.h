@@ -31,6 +31,8 @@
 
 #include "voreen/core/properties/boolproperty.h"
 #include "voreen/core/properties/buttonproperty.h"
+#include "voreen/core/properties/intproperty.h"
+#include "voreen/core/properties/stringproperty.h"
 
 #include "voreen/core/processors/cache.h"
 
@@ -52,20 +54,34 @@ protected:
     tgt::mat4 computeConversionMatrix(const VolumeBase* originVolume, const VolumeBase* destinationVolume) const;
 };
 
+/**
+ * Base class for volume processors whose results are cached. The persistent cache tier is only used,
+ * if caching is enabled in the application, the memory tier only for processors with immutable output.
+ */
 class VRN_CORE_API CachingVolumeProcessor : public VolumeProcessor {
 public:
     CachingVolumeProcessor();
     virtual ~CachingVolumeProcessor();
 
 protected:
+    /**
+     * Returns true, if the processor never modifies an output volume after assigning it to an outport,
+     * so that the memory cache tier may take over the output volumes. The default implementation returns false.
+     */
+    virtual bool hasImmutableOutput() const;
+
     void initialize() throw (tgt::Exception);
     void clearCache();
+    void updateMemoryCacheSize();
+    void updateMemoryCacheInfo();
 
     virtual void beforeProcess();
     virtual void afterProcess();
 
     BoolProperty useCaching_;
     ButtonProperty clearCache_;
+    IntProperty memoryCacheSize_;       ///< byte budget of the in-memory cache tier (MB)
+    StringProperty memoryCacheInfo_;    ///< displays the memory cache statistics
 
     Cache cache_;
 };
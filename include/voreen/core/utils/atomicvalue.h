@@ -0,0 +1,93 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef VRN_ATOMICVALUE_H
+#define VRN_ATOMICVALUE_H
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace voreen {
+
+/**
+ * Word-sized value with atomic load, store and exchange.
+ *
+ * Loads have acquire and stores have release semantics, so a value published by store()
+ * makes all writes preceding the store visible to a thread that observes it via load().
+ * This is sufficient for lock-free readers of data that is only appended under a mutex.
+ *
+ * @note T has to be an integral or pointer type of 4 or 8 bytes.
+ */
+template<typename T>
+class AtomicValue {
+public:
+    explicit AtomicValue(T value = T())
+        : value_(value)
+    {}
+
+    T load() const {
+#ifdef _MSC_VER
+        // volatile accesses have acquire/release semantics on MSVC
+        T value = value_;
+        _ReadWriteBarrier();
+        return value;
+#else
+        return __atomic_load_n(&value_, __ATOMIC_ACQUIRE);
+#endif
+    }
+
+    void store(T value) {
+#ifdef _MSC_VER
+        _ReadWriteBarrier();
+        value_ = value;
+#else
+        __atomic_store_n(&value_, value, __ATOMIC_RELEASE);
+#endif
+    }
+
+    /// Atomically replaces the value and returns the previous one (full barrier).
+    T exchange(T value) {
+#ifdef _MSC_VER
+        if (sizeof(T) == 8)
+            return (T)_InterlockedExchange64(reinterpret_cast<volatile __int64*>(&value_), (__int64)value);
+        else
+            return (T)_InterlockedExchange(reinterpret_cast<volatile long*>(&value_), (long)value);
+#else
+        return __atomic_exchange_n(&value_, value, __ATOMIC_ACQ_REL);
+#endif
+    }
+
+private:
+    // not copyable
+    AtomicValue(const AtomicValue&);
+    AtomicValue& operator=(const AtomicValue&);
+
+    volatile T value_;
+};
+
+} // namespace
+
+#endif // VRN_ATOMICVALUE_H
@@ -0,0 +1,198 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef VRN_CPURAYCASTINGENGINE_H
+#define VRN_CPURAYCASTINGENGINE_H
+
+#include "voreen/core/voreencoreapi.h"
+#include "voreen/core/datastructures/volume/volumeram.h"
+#include "voreen/core/datastructures/meta/realworldmappingmetadata.h"
+#include "voreen/core/utils/exception.h"
+
+#include "tgt/camera.h"
+#include "tgt/matrix.h"
+#include "tgt/vector.h"
+
+#include <vector>
+
+namespace voreen {
+
+class VolumeBase;
+class TransFunc1DKeys;
+
+/**
+ * Software direct volume renderer that does not require an OpenGL context.
+ *
+ * Rays are either computed analytically from a camera by intersecting them with the
+ * volume's bounding box, or are read from entry/exit point buffers in texture coordinates.
+ * The image plane is split into tiles that are distributed dynamically among the
+ * threads (if the OpenMP module is enabled). The volume is sampled through
+ * type-specialized accessors for the common VolumeAtomic formats and classified by a
+ * lookup table derived from a 1D transfer function, which has the real world mapping,
+ * the TF domain and the opacity correction folded in.
+ *
+ * Rays are terminated as soon as their opacity exceeds a threshold, and empty regions
+ * are skipped using an implicit min/max octree over blocks of 8^3 voxels, which is
+ * evaluated against the current transfer function on each frame.
+ *
+ * The output is an RGBA float buffer with the origin at the lower left. As with the GPU
+ * raycasters, the color channels are composited front-to-back and hence premultiplied by alpha.
+ */
+class VRN_CORE_API CPURaycastingEngine {
+public:
+    enum FilterMode {
+        FILTER_NEAREST,
+        FILTER_LINEAR
+    };
+
+    CPURaycastingEngine();
+    ~CPURaycastingEngine();
+
+    /**
+     * Assigns the volume to render and builds the min/max octree used for empty space skipping.
+     * Passing a null pointer releases the current volume.
+     *
+     * @throws VoreenException if the volume has no RAM representation
+     */
+    void setVolume(const VolumeBase* volume)
+        throw (VoreenException);
+
+    /// Returns the currently assigned volume (may be null).
+    const VolumeBase* getVolume() const;
+
+    /// Assigns the transfer function. The classification table is rebuilt on each render call.
+    void setTransFunc(const TransFunc1DKeys* transFunc);
+
+    void setFilterMode(FilterMode mode);
+    FilterMode getFilterMode() const;
+
+    /// Sampling rate relative to the largest volume dimension. Default: 2.0
+    void setSamplingRate(float samplingRate);
+    float getSamplingRate() const;
+
+    /// Opacity at which rays are terminated. Default: 0.95
+    void setEarlyRayTerminationThreshold(float threshold);
+
+    void setEmptySpaceSkipping(bool enabled);
+    bool getEmptySpaceSkipping() const;
+
+    /// Edge length of the image tiles that are assigned to the threads. Default: 16
+    void setTileSize(int tileSize);
+
+    /**
+     * Renders the volume from the passed camera into the output buffer.
+     *
+     * @param output buffer of imageSize.x*imageSize.y elements, row by row starting at the bottom
+     */
+    void render(const tgt::Camera& camera, const tgt::ivec2& imageSize, tgt::vec4* output)
+        throw (VoreenException);
+
+    /**
+     * Renders the volume for the passed entry/exit points given in texture coordinates,
+     * as generated by the MeshEntryExitPoints processor. Pixels whose entry and exit point
+     * are both zero are treated as background.
+     */
+    void render(const tgt::vec4* entryPoints, const tgt::vec4* exitPoints, const tgt::ivec2& imageSize, tgt::vec4* output)
+        throw (VoreenException);
+
+    /// Number of samples that were skipped during the last render call due to empty space skipping.
+    size_t getNumSkippedSamples() const;
+
+private:
+    /// Min/max values of one level of the implicit octree over the voxel blocks.
+    struct MinMaxLevel {
+        tgt::ivec3 dim_;            ///< number of nodes per dimension
+        std::vector<float> min_;
+        std::vector<float> max_;
+    };
+
+    /// Ray parameters passed to the per-tile loop.
+    struct RaySetup {
+        const tgt::vec4* entryPoints_;
+        const tgt::vec4* exitPoints_;
+        tgt::mat4 ndcToTexture_;
+        tgt::ivec2 imageSize_;
+    };
+
+    void renderImage(const RaySetup& setup, tgt::vec4* output)
+        throw (VoreenException);
+
+    /// Computes the classification table and the mapping from raw voxel values to table indices.
+    void buildClassificationTable(float samplingStepSize);
+
+    /// Marches all rays of the image using the passed voxel accessor.
+    template<class ACCESS, bool LINEAR>
+    void renderTiles(const ACCESS& access, const RaySetup& setup, float samplingStepSize, tgt::vec4* output);
+
+    template<class ACCESS>
+    void dispatchFilter(const ACCESS& access, const RaySetup& setup, float samplingStepSize, tgt::vec4* output);
+
+    template<class ACCESS>
+    void buildMinMaxOctree(const ACCESS& access);
+
+    /// Returns false for background pixels.
+    bool computeRay(const RaySetup& setup, int x, int y, tgt::vec3& entry, tgt::vec3& direction, float& rayLength) const;
+
+    /// Maps a raw voxel value to an index into the classification table.
+    inline int getTableIndex(float rawValue) const;
+
+    /// Returns true, if all values in [minValue, maxValue] are mapped to zero opacity.
+    inline bool isTransparent(float minValue, float maxValue) const;
+
+    const VolumeBase* volume_;
+    const VolumeRAM* volumeRAM_;
+    tgt::ivec3 volumeDim_;
+    tgt::mat4 textureToWorld_;
+    RealWorldMapping realWorldMapping_;
+
+    /// Factor that converts raw values to normalized [0,1] values (1 for the generic accessor).
+    float rawToNormalized_;
+
+    const TransFunc1DKeys* transFunc_;
+    FilterMode filterMode_;
+    float samplingRate_;
+    float ertThreshold_;
+    bool emptySpaceSkipping_;
+    int tileSize_;
+
+    /// Classification table: premultiplied color and opacity-corrected alpha.
+    std::vector<tgt::vec4> classificationTable_;
+    /// For each table index i, the smallest index j >= i with non-zero alpha (or table size).
+    std::vector<int> nextVisibleIndex_;
+    float tableIndexScale_;
+    float tableIndexOffset_;
+
+    /// Implicit min/max octree: level 0 stores one node per block.
+    std::vector<MinMaxLevel> minMaxOctree_;
+
+    size_t numSkippedSamples_;
+
+    static const int BLOCK_SIZE;
+    static const std::string loggerCat_;
+};
+
+} // namespace
+
+#endif // VRN_CPURAYCASTINGENGINE_H
@@ -28,7 +28,10 @@
 
 #include "voreen/core/voreencoreapi.h"
 
+#include "tgt/types.h"
+
 #include <string>
+#include <vector>
 
 namespace voreen {
 
@@ -39,6 +42,54 @@ public:
 
     /// Compute md5 hash.
     static std::string getHash(const std::string& s);
+
+    /// Compute 64 bit xxHash (XXH64). Considerably faster than md5, but not cryptographically secure.
+    static uint64_t getFastHash(const void* data, size_t size, uint64_t seed = 0);
+};
+
+/**
+ * Tree hash over a data stream that is split into fixed-size blocks: each block is hashed separately
+ * with VoreenHash::getFastHash() and the resulting hash string is computed from the list of block hashes.
+ *
+ * The blocks are hashed in parallel (if OpenMP is available). Alternatively, the blocks can be passed
+ * one by one via hashBlock(), so that the hashing can be combined with other passes over the data.
+ */
+class VRN_CORE_API VoreenBlockHash {
+public:
+    static const size_t DEFAULT_BLOCK_SIZE;     ///< 4 MB
+
+    VoreenBlockHash(size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+    /// Hashes the passed data.
+    void compute(const void* data, size_t size);
+
+    /**
+     * Prepares the computation of the hash of data with the passed size, whose blocks are then
+     * to be hashed by hashBlock(). Allows to combine the hashing with other passes over the data.
+     */
+    void reset(uint64_t size);
+
+    /**
+     * Hashes the block with the passed index, which has to start at blockData.
+     * Blocks with different indices may be hashed concurrently.
+     */
+    void hashBlock(const void* blockData, size_t blockIndex);
+
+    /// Returns the hash string (32 hex digits) computed from the block hashes and the data size.
+    std::string getHash() const;
+
+    size_t getBlockSize() const;
+    size_t getNumBlocks() const;
+    uint64_t getDataSize() const;
+    const std::vector<uint64_t>& getBlockHashes() const;
+
+private:
+    /// Hashes the blocks [firstBlock, lastBlock] of the passed data.
+    void hashBlocks(const char* data, size_t firstBlock, size_t lastBlock);
+
+    size_t blockSize_;
+    uint64_t dataSize_;
+    std::vector<uint64_t> blockHashes_;
 };
 
 }  // namespace voreen
@@ -0,0 +1,124 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef VRN_TRACING_H
+#define VRN_TRACING_H
+
+#include "voreen/core/voreencoreapi.h"
+#include "voreen/core/utils/exception.h"
+
+#include "tgt/types.h"
+
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+namespace voreen {
+
+/**
+ * Low-overhead tracing of time spans, intended for analyzing where the time of a network
+ * evaluation is spent. Spans are usually recorded by creating a TraceSpan object.
+ *
+ * Each thread records its spans into a ring buffer of its own, which bounds the memory consumption
+ * and prevents contention between threads. Once a buffer is full, the oldest spans are overwritten.
+ * The recorded spans can be exported in the Chrome trace event format, which can be viewed
+ * with chrome://tracing.
+ *
+ * Tracing is disabled by default. In this state, a TraceSpan only costs a flag check.
+ */
+class VRN_CORE_API Tracer {
+public:
+    /// A recorded span.
+    struct TraceEvent {
+        std::string name_;
+        const char* category_;  ///< static string
+        uint64_t start_;        ///< start timestamp in nanoseconds
+        uint64_t duration_;     ///< in nanoseconds
+        size_t threadID_;       ///< index of the recording thread's buffer
+    };
+
+    /// Maximum number of spans kept per thread.
+    static const size_t BUFFER_CAPACITY;
+
+    /// Enables or disables the recording of spans. Already recorded spans are kept.
+    static void setEnabled(bool enabled);
+
+    static bool isEnabled() {
+        return enabled_;
+    }
+
+    /// Returns the time in nanoseconds from a monotonic high-resolution clock.
+    static uint64_t getTimestamp();
+
+    /**
+     * Records a span into the calling thread's buffer, if tracing is enabled.
+     *
+     * @param category name of the span's category. Must be a static string.
+     * @param start timestamp returned by getTimestamp()
+     * @param end timestamp returned by getTimestamp()
+     */
+    static void recordSpan(const char* category, const std::string& name, uint64_t start, uint64_t end);
+
+    /// Returns the recorded spans of all threads, sorted by their start time.
+    static std::vector<TraceEvent> getEvents();
+
+    /// Discards the recorded spans of all threads.
+    static void clear();
+
+    /// Writes the recorded spans to the passed stream in the Chrome trace event format (JSON).
+    static void writeChromeTrace(std::ostream& stream);
+
+    /// Writes the recorded spans to the passed file in the Chrome trace event format (JSON).
+    static void writeChromeTrace(const std::string& filename)
+        throw (VoreenException);
+
+private:
+    static volatile bool enabled_;
+};
+
+/**
+ * Records a span from its construction to its destruction, if tracing is enabled.
+ *
+ * @see Tracer
+ */
+class VRN_CORE_API TraceSpan {
+public:
+    /**
+     * @param category name of the span's category, e.g., "processor" or "io". Must be a static string.
+     * @param name name of the span. Is only copied, if tracing is enabled.
+     */
+    TraceSpan(const char* category, const char* name);
+    ~TraceSpan();
+
+private:
+    const char* category_;
+    std::string name_;
+    uint64_t start_;    ///< 0, if tracing has been disabled at construction
+};
+
+} // namespace
+
+#endif // VRN_TRACING_H
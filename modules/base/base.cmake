@@ -25,6 +25,7 @@ SET(MOD_CORE_SOURCES
     ${MOD_DIR}/processors/geometry/quadricrenderer.cpp
     ${MOD_DIR}/processors/geometry/slicepositionrenderer.cpp
     ${MOD_DIR}/processors/geometry/trianglemeshconverter.cpp
+    ${MOD_DIR}/processors/geometry/volumeisosurface.cpp
     
     ${MOD_DIR}/processors/image/background.cpp
     ${MOD_DIR}/processors/image/binaryimageprocessor.cpp
@@ -63,6 +64,7 @@ SET(MOD_CORE_SOURCES
     ${MOD_DIR}/processors/proxygeometry/optimizedproxygeometry.cpp
     
     ${MOD_DIR}/processors/render/cpuraycaster.cpp
+    ${MOD_DIR}/processors/render/headlessraycaster.cpp
     ${MOD_DIR}/processors/render/multiplanarslicerenderer.cpp
     ${MOD_DIR}/processors/render/multivolumeraycaster.cpp
     ${MOD_DIR}/processors/render/rgbraycaster.cpp
@@ -149,6 +151,7 @@ SET(MOD_CORE_HEADERS
     ${MOD_DIR}/processors/geometry/quadricrenderer.h
     ${MOD_DIR}/processors/geometry/slicepositionrenderer.h
     ${MOD_DIR}/processors/geometry/trianglemeshconverter.h
+    ${MOD_DIR}/processors/geometry/volumeisosurface.h
     
     ${MOD_DIR}/processors/image/background.h
     ${MOD_DIR}/processors/image/binaryimageprocessor.h
@@ -187,6 +190,7 @@ SET(MOD_CORE_HEADERS
     ${MOD_DIR}/processors/proxygeometry/optimizedproxygeometry.h
     
     ${MOD_DIR}/processors/render/cpuraycaster.h
+    ${MOD_DIR}/processors/render/headlessraycaster.h
     ${MOD_DIR}/processors/render/multiplanarslicerenderer.h
     ${MOD_DIR}/processors/render/multivolumeraycaster.h
     ${MOD_DIR}/processors/render/rgbraycaster.h
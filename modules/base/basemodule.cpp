@@ -50,6 +50,7 @@
 #include "processors/geometry/quadricrenderer.h"
 #include "processors/geometry/slicepositionrenderer.h"
 #include "processors/geometry/trianglemeshconverter.h"
+#include "processors/geometry/volumeisosurface.h"
 
 // image
 #include "processors/image/background.h"
@@ -91,6 +92,7 @@
 
 // render
 #include "processors/render/cpuraycaster.h"
+#include "processors/render/headlessraycaster.h"
 #include "processors/render/multiplanarslicerenderer.h"
 #include "processors/render/rgbraycaster.h"
 #include "processors/render/segmentationraycaster.h"
@@ -189,6 +191,7 @@ BaseModule::BaseModule(const std::string& modulePath) : VoreenModule(modulePath)
     registerSerializableType(new QuadricRenderer());
     registerSerializableType(new SlicePositionRenderer());
     registerSerializableType(new TriangleMeshConverter());
+    registerSerializableType(new VolumeIsosurface());
 
     // image
     registerSerializableType(new Background());
@@ -229,6 +232,7 @@ BaseModule::BaseModule(const std::string& modulePath) : VoreenModule(modulePath)
 
     // render
     registerSerializableType(new CPURaycaster());
+    registerSerializableType(new HeadlessRaycaster());
     registerSerializableType(new MultiplanarSliceRenderer());
     registerSerializableType(new MultiVolumeRaycaster());
     registerSerializableType(new SegmentationRaycaster());
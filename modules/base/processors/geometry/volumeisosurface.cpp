@@ -0,0 +1,899 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "volumeisosurface.h"
+
+#include "voreen/core/datastructures/volume/volume.h"
+#include "voreen/core/datastructures/volume/volumeram.h"
+#include "voreen/core/datastructures/volume/volumedisk.h"
+#include "voreen/core/datastructures/volume/volumeoperator.h"
+#include "voreen/core/datastructures/octree/volumeoctreebase.h"
+#include "voreen/core/datastructures/geometry/trianglemeshgeometryindexed.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+using namespace voreen;
+
+/**
+ * Marching cubes triangle table: for each of the 256 cube configurations, up to five triangles given as
+ * edge triples, terminated by -1. Bit i of the configuration is set if corner i lies inside the isosurface
+ * (value >= isovalue). On ambiguous faces the inside corners are always separated, which keeps the surface
+ * of adjacent cells consistent and therefore watertight. Triangles are oriented counter-clockwise when seen
+ * from the outside, i.e., from the region below the isovalue.
+ */
+const int MC_TRIANGLE_TABLE[256][16] = {
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  9,  5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  4,  9,  5,  4,  8,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  1, 10,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 10,  8,  0,  1, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  9,  5,  1, 10,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  9,  5,  1,  8,  9,  1, 10,  8, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  5, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8,  1,  5, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 11,  1,  0,  9, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  9, 11,  1,  8,  9,  1,  4,  8, -1, -1, -1, -1, -1, -1, -1 },
+    {  4, 11, 10,  4,  5, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 10,  8,  0, 11, 10,  0,  5, 11, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 10,  4,  0, 11, 10,  0,  9, 11, -1, -1, -1, -1, -1, -1, -1 },
+    {  8, 11, 10,  8,  9, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  2,  8,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  6,  2,  0,  4,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  9,  5,  2,  8,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  2,  4,  6,  2,  5,  4,  2,  9,  5, -1, -1, -1, -1, -1, -1, -1 },
+    {  1, 10,  4,  2,  8,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  6,  2,  0, 10,  6,  0,  1, 10, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  9,  5,  1, 10,  4,  2,  8,  6, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  9,  5,  1,  2,  9,  1,  6,  2,  1, 10,  6, -1, -1, -1, -1 },
+    {  1,  5, 11,  2,  8,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  6,  2,  0,  4,  6,  1,  5, 11, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 11,  1,  0,  9, 11,  2,  8,  6, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  9, 11,  1,  2,  9,  1,  6,  2,  1,  4,  6, -1, -1, -1, -1 },
+    {  2,  8,  6,  4, 11, 10,  4,  5, 11, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  6,  2,  0, 10,  6,  0, 11, 10,  0,  5, 11, -1, -1, -1, -1 },
+    {  0, 10,  4,  0, 11, 10,  0,  9, 11,  2,  8,  6, -1, -1, -1, -1 },
+    {  2, 10,  6,  2, 11, 10,  2,  9, 11, -1, -1, -1, -1, -1, -1, -1 },
+    {  2,  7,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8,  2,  7,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  7,  5,  0,  2,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  2,  4,  8,  2,  5,  4,  2,  7,  5, -1, -1, -1, -1, -1, -1, -1 },
+    {  1, 10,  4,  2,  7,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 10,  8,  0,  1, 10,  2,  7,  9, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  7,  5,  0,  2,  7,  1, 10,  4, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  7,  5,  1,  2,  7,  1,  8,  2,  1, 10,  8, -1, -1, -1, -1 },
+    {  1,  5, 11,  2,  7,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8,  1,  5, 11,  2,  7,  9, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 11,  1,  0,  7, 11,  0,  2,  7, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  7, 11,  1,  2,  7,  1,  8,  2,  1,  4,  8, -1, -1, -1, -1 },
+    {  2,  7,  9,  4, 11, 10,  4,  5, 11, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 10,  8,  0, 11, 10,  0,  5, 11,  2,  7,  9, -1, -1, -1, -1 },
+    {  0, 10,  4,  0, 11, 10,  0,  7, 11,  0,  2,  7, -1, -1, -1, -1 },
+    {  2, 10,  8,  2, 11, 10,  2,  7, 11, -1, -1, -1, -1, -1, -1, -1 },
+    {  6,  9,  8,  6,  7,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  7,  9,  0,  6,  7,  0,  4,  6, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  7,  5,  0,  6,  7,  0,  8,  6, -1, -1, -1, -1, -1, -1, -1 },
+    {  4,  7,  5,  4,  6,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  1, 10,  4,  6,  9,  8,  6,  7,  9, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  7,  9,  0,  6,  7,  0, 10,  6,  0,  1, 10, -1, -1, -1, -1 },
+    {  0,  7,  5,  0,  6,  7,  0,  8,  6,  1, 10,  4, -1, -1, -1, -1 },
+    {  1,  7,  5,  1,  6,  7,  1, 10,  6, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  5, 11,  6,  9,  8,  6,  7,  9, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  7,  9,  0,  6,  7,  0,  4,  6,  1,  5, 11, -1, -1, -1, -1 },
+    {  0, 11,  1,  0,  7, 11,  0,  6,  7,  0,  8,  6, -1, -1, -1, -1 },
+    {  1,  7, 11,  1,  6,  7,  1,  4,  6, -1, -1, -1, -1, -1, -1, -1 },
+    {  4, 11, 10,  4,  5, 11,  6,  9,  8,  6,  7,  9, -1, -1, -1, -1 },
+    {  0,  7,  9,  0,  6,  7,  0, 10,  6,  0, 11, 10,  0,  5, 11, -1 },
+    {  0, 10,  4,  0, 11, 10,  0,  7, 11,  0,  6,  7,  0,  8,  6, -1 },
+    {  6, 11, 10,  6,  7, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  3,  6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  9,  5,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  3,  6, 10,  4,  9,  5,  4,  8,  9, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  6,  4,  1,  3,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  6,  8,  0,  3,  6,  0,  1,  3, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  9,  5,  1,  6,  4,  1,  3,  6, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  9,  5,  1,  8,  9,  1,  6,  8,  1,  3,  6, -1, -1, -1, -1 },
+    {  1,  5, 11,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8,  1,  5, 11,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 11,  1,  0,  9, 11,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  9, 11,  1,  8,  9,  1,  4,  8,  3,  6, 10, -1, -1, -1, -1 },
+    {  3,  5, 11,  3,  4,  5,  3,  6,  4, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  6,  8,  0,  3,  6,  0, 11,  3,  0,  5, 11, -1, -1, -1, -1 },
+    {  0,  6,  4,  0,  3,  6,  0, 11,  3,  0,  9, 11, -1, -1, -1, -1 },
+    {  3,  9, 11,  3,  8,  9,  3,  6,  8, -1, -1, -1, -1, -1, -1, -1 },
+    {  2, 10,  3,  2,  8, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  3,  2,  0, 10,  3,  0,  4, 10, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  9,  5,  2, 10,  3,  2,  8, 10, -1, -1, -1, -1, -1, -1, -1 },
+    {  2, 10,  3,  2,  4, 10,  2,  5,  4,  2,  9,  5, -1, -1, -1, -1 },
+    {  1,  8,  4,  1,  2,  8,  1,  3,  2, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  3,  2,  0,  1,  3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  9,  5,  1,  8,  4,  1,  2,  8,  1,  3,  2, -1, -1, -1, -1 },
+    {  1,  9,  5,  1,  2,  9,  1,  3,  2, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  5, 11,  2, 10,  3,  2,  8, 10, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  3,  2,  0, 10,  3,  0,  4, 10,  1,  5, 11, -1, -1, -1, -1 },
+    {  0, 11,  1,  0,  9, 11,  2, 10,  3,  2,  8, 10, -1, -1, -1, -1 },
+    {  9,  3,  2,  9, 10,  3,  9,  4, 10,  9,  1,  4,  9, 11,  1, -1 },
+    {  2, 11,  3,  2,  5, 11,  2,  4,  5,  2,  8,  4, -1, -1, -1, -1 },
+    {  0,  3,  2,  0, 11,  3,  0,  5, 11, -1, -1, -1, -1, -1, -1, -1 },
+    {  4,  2,  8,  4,  3,  2,  4, 11,  3,  4,  9, 11,  4,  0,  9, -1 },
+    {  2, 11,  3,  2,  9, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  2,  7,  9,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8,  2,  7,  9,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  7,  5,  0,  2,  7,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1 },
+    {  2,  4,  8,  2,  5,  4,  2,  7,  5,  3,  6, 10, -1, -1, -1, -1 },
+    {  1,  6,  4,  1,  3,  6,  2,  7,  9, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  6,  8,  0,  3,  6,  0,  1,  3,  2,  7,  9, -1, -1, -1, -1 },
+    {  0,  7,  5,  0,  2,  7,  1,  6,  4,  1,  3,  6, -1, -1, -1, -1 },
+    {  1,  7,  5,  1,  2,  7,  1,  8,  2,  1,  6,  8,  1,  3,  6, -1 },
+    {  1,  5, 11,  2,  7,  9,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8,  1,  5, 11,  2,  7,  9,  3,  6, 10, -1, -1, -1, -1 },
+    {  0, 11,  1,  0,  7, 11,  0,  2,  7,  3,  6, 10, -1, -1, -1, -1 },
+    {  1,  7, 11,  1,  2,  7,  1,  8,  2,  1,  4,  8,  3,  6, 10, -1 },
+    {  2,  7,  9,  3,  5, 11,  3,  4,  5,  3,  6,  4, -1, -1, -1, -1 },
+    {  0,  6,  8,  0,  3,  6,  0, 11,  3,  0,  5, 11,  2,  7,  9, -1 },
+    {  0,  6,  4,  0,  3,  6,  0, 11,  3,  0,  7, 11,  0,  2,  7, -1 },
+    {  8,  3,  6,  8, 11,  3,  8,  7, 11,  8,  2,  7, -1, -1, -1, -1 },
+    {  3,  8, 10,  3,  9,  8,  3,  7,  9, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  7,  9,  0,  3,  7,  0, 10,  3,  0,  4, 10, -1, -1, -1, -1 },
+    {  0,  7,  5,  0,  3,  7,  0, 10,  3,  0,  8, 10, -1, -1, -1, -1 },
+    {  3,  4, 10,  3,  5,  4,  3,  7,  5, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  8,  4,  1,  9,  8,  1,  7,  9,  1,  3,  7, -1, -1, -1, -1 },
+    {  0,  7,  9,  0,  3,  7,  0,  1,  3, -1, -1, -1, -1, -1, -1, -1 },
+    {  7,  1,  3,  7,  4,  1,  7,  8,  4,  7,  0,  8,  7,  5,  0, -1 },
+    {  1,  7,  5,  1,  3,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  5, 11,  3,  8, 10,  3,  9,  8,  3,  7,  9, -1, -1, -1, -1 },
+    {  0,  7,  9,  0,  3,  7,  0, 10,  3,  0,  4, 10,  1,  5, 11, -1 },
+    {  0, 11,  1,  0,  7, 11,  0,  3,  7,  0, 10,  3,  0,  8, 10, -1 },
+    {  7, 10,  3,  7,  4, 10,  7,  1,  4,  7, 11,  1, -1, -1, -1, -1 },
+    {  3,  5, 11,  3,  4,  5,  3,  8,  4,  3,  9,  8,  3,  7,  9, -1 },
+    {  0,  7,  9,  0,  3,  7,  0, 11,  3,  0,  5, 11, -1, -1, -1, -1 },
+    {  0,  8,  4,  3,  7, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  3,  7, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  3, 11,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  9,  5,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  3, 11,  7,  4,  9,  5,  4,  8,  9, -1, -1, -1, -1, -1, -1, -1 },
+    {  1, 10,  4,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 10,  8,  0,  1, 10,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  9,  5,  1, 10,  4,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  9,  5,  1,  8,  9,  1, 10,  8,  3, 11,  7, -1, -1, -1, -1 },
+    {  1,  7,  3,  1,  5,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8,  1,  7,  3,  1,  5,  7, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  3,  1,  0,  7,  3,  0,  9,  7, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  7,  3,  1,  9,  7,  1,  8,  9,  1,  4,  8, -1, -1, -1, -1 },
+    {  3,  5,  7,  3,  4,  5,  3, 10,  4, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 10,  8,  0,  3, 10,  0,  7,  3,  0,  5,  7, -1, -1, -1, -1 },
+    {  0, 10,  4,  0,  3, 10,  0,  7,  3,  0,  9,  7, -1, -1, -1, -1 },
+    {  3,  9,  7,  3,  8,  9,  3, 10,  8, -1, -1, -1, -1, -1, -1, -1 },
+    {  2,  8,  6,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  6,  2,  0,  4,  6,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  9,  5,  2,  8,  6,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1 },
+    {  2,  4,  6,  2,  5,  4,  2,  9,  5,  3, 11,  7, -1, -1, -1, -1 },
+    {  1, 10,  4,  2,  8,  6,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  6,  2,  0, 10,  6,  0,  1, 10,  3, 11,  7, -1, -1, -1, -1 },
+    {  0,  9,  5,  1, 10,  4,  2,  8,  6,  3, 11,  7, -1, -1, -1, -1 },
+    {  1,  9,  5,  1,  2,  9,  1,  6,  2,  1, 10,  6,  3, 11,  7, -1 },
+    {  1,  7,  3,  1,  5,  7,  2,  8,  6, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  6,  2,  0,  4,  6,  1,  7,  3,  1,  5,  7, -1, -1, -1, -1 },
+    {  0,  3,  1,  0,  7,  3,  0,  9,  7,  2,  8,  6, -1, -1, -1, -1 },
+    {  1,  7,  3,  1,  9,  7,  1,  2,  9,  1,  6,  2,  1,  4,  6, -1 },
+    {  2,  8,  6,  3,  5,  7,  3,  4,  5,  3, 10,  4, -1, -1, -1, -1 },
+    {  0,  6,  2,  0, 10,  6,  0,  3, 10,  0,  7,  3,  0,  5,  7, -1 },
+    {  0, 10,  4,  0,  3, 10,  0,  7,  3,  0,  9,  7,  2,  8,  6, -1 },
+    { 10,  7,  3, 10,  9,  7, 10,  2,  9, 10,  6,  2, -1, -1, -1, -1 },
+    {  2, 11,  9,  2,  3, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8,  2, 11,  9,  2,  3, 11, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 11,  5,  0,  3, 11,  0,  2,  3, -1, -1, -1, -1, -1, -1, -1 },
+    {  2,  4,  8,  2,  5,  4,  2, 11,  5,  2,  3, 11, -1, -1, -1, -1 },
+    {  1, 10,  4,  2, 11,  9,  2,  3, 11, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 10,  8,  0,  1, 10,  2, 11,  9,  2,  3, 11, -1, -1, -1, -1 },
+    {  0, 11,  5,  0,  3, 11,  0,  2,  3,  1, 10,  4, -1, -1, -1, -1 },
+    {  5,  3, 11,  5,  2,  3,  5,  8,  2,  5, 10,  8,  5,  1, 10, -1 },
+    {  1,  2,  3,  1,  9,  2,  1,  5,  9, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8,  1,  2,  3,  1,  9,  2,  1,  5,  9, -1, -1, -1, -1 },
+    {  0,  3,  1,  0,  2,  3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  2,  3,  1,  8,  2,  1,  4,  8, -1, -1, -1, -1, -1, -1, -1 },
+    {  2,  5,  9,  2,  4,  5,  2, 10,  4,  2,  3, 10, -1, -1, -1, -1 },
+    { 10,  2,  3, 10,  9,  2, 10,  5,  9, 10,  0,  5, 10,  8,  0, -1 },
+    {  0, 10,  4,  0,  3, 10,  0,  2,  3, -1, -1, -1, -1, -1, -1, -1 },
+    {  2, 10,  8,  2,  3, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  3,  8,  6,  3,  9,  8,  3, 11,  9, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 11,  9,  0,  3, 11,  0,  6,  3,  0,  4,  6, -1, -1, -1, -1 },
+    {  0, 11,  5,  0,  3, 11,  0,  6,  3,  0,  8,  6, -1, -1, -1, -1 },
+    {  3,  4,  6,  3,  5,  4,  3, 11,  5, -1, -1, -1, -1, -1, -1, -1 },
+    {  1, 10,  4,  3,  8,  6,  3,  9,  8,  3, 11,  9, -1, -1, -1, -1 },
+    {  0, 11,  9,  0,  3, 11,  0,  6,  3,  0, 10,  6,  0,  1, 10, -1 },
+    {  0, 11,  5,  0,  3, 11,  0,  6,  3,  0,  8,  6,  1, 10,  4, -1 },
+    {  5,  3, 11,  5,  6,  3,  5, 10,  6,  5,  1, 10, -1, -1, -1, -1 },
+    {  1,  6,  3,  1,  8,  6,  1,  9,  8,  1,  5,  9, -1, -1, -1, -1 },
+    {  9,  1,  5,  9,  3,  1,  9,  6,  3,  9,  4,  6,  9,  0,  4, -1 },
+    {  0,  3,  1,  0,  6,  3,  0,  8,  6, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  6,  3,  1,  4,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  3,  8,  6,  3,  9,  8,  3,  5,  9,  3,  4,  5,  3, 10,  4, -1 },
+    {  0,  5,  9,  3, 10,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 10,  4,  0,  3, 10,  0,  6,  3,  0,  8,  6, -1, -1, -1, -1 },
+    {  3, 10,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  6, 11,  7,  6, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8,  6, 11,  7,  6, 10, 11, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  9,  5,  6, 11,  7,  6, 10, 11, -1, -1, -1, -1, -1, -1, -1 },
+    {  4,  9,  5,  4,  8,  9,  6, 11,  7,  6, 10, 11, -1, -1, -1, -1 },
+    {  1,  6,  4,  1,  7,  6,  1, 11,  7, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  6,  8,  0,  7,  6,  0, 11,  7,  0,  1, 11, -1, -1, -1, -1 },
+    {  0,  9,  5,  1,  6,  4,  1,  7,  6,  1, 11,  7, -1, -1, -1, -1 },
+    {  1,  9,  5,  1,  8,  9,  1,  6,  8,  1,  7,  6,  1, 11,  7, -1 },
+    {  1,  6, 10,  1,  7,  6,  1,  5,  7, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8,  1,  6, 10,  1,  7,  6,  1,  5,  7, -1, -1, -1, -1 },
+    {  0, 10,  1,  0,  6, 10,  0,  7,  6,  0,  9,  7, -1, -1, -1, -1 },
+    {  1,  6, 10,  1,  7,  6,  1,  9,  7,  1,  8,  9,  1,  4,  8, -1 },
+    {  4,  7,  6,  4,  5,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  6,  8,  0,  7,  6,  0,  5,  7, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  6,  4,  0,  7,  6,  0,  9,  7, -1, -1, -1, -1, -1, -1, -1 },
+    {  6,  9,  7,  6,  8,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  2, 11,  7,  2, 10, 11,  2,  8, 10, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  7,  2,  0, 11,  7,  0, 10, 11,  0,  4, 10, -1, -1, -1, -1 },
+    {  0,  9,  5,  2, 11,  7,  2, 10, 11,  2,  8, 10, -1, -1, -1, -1 },
+    {  2, 11,  7,  2, 10, 11,  2,  4, 10,  2,  5,  4,  2,  9,  5, -1 },
+    {  1,  8,  4,  1,  2,  8,  1,  7,  2,  1, 11,  7, -1, -1, -1, -1 },
+    {  0,  7,  2,  0, 11,  7,  0,  1, 11, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  9,  5,  1,  8,  4,  1,  2,  8,  1,  7,  2,  1, 11,  7, -1 },
+    {  1,  9,  5,  1,  2,  9,  1,  7,  2,  1, 11,  7, -1, -1, -1, -1 },
+    {  1,  8, 10,  1,  2,  8,  1,  7,  2,  1,  5,  7, -1, -1, -1, -1 },
+    {  2,  5,  7,  2,  1,  5,  2, 10,  1,  2,  4, 10,  2,  0,  4, -1 },
+    {  1,  8, 10,  1,  2,  8,  1,  7,  2,  1,  9,  7,  1,  0,  9, -1 },
+    {  1,  4, 10,  2,  9,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  2,  5,  7,  2,  4,  5,  2,  8,  4, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  7,  2,  0,  5,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  4,  2,  8,  4,  7,  2,  4,  9,  7,  4,  0,  9, -1, -1, -1, -1 },
+    {  2,  9,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  2, 11,  9,  2, 10, 11,  2,  6, 10, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  4,  8,  2, 11,  9,  2, 10, 11,  2,  6, 10, -1, -1, -1, -1 },
+    {  0, 11,  5,  0, 10, 11,  0,  6, 10,  0,  2,  6, -1, -1, -1, -1 },
+    {  2,  4,  8,  2,  5,  4,  2, 11,  5,  2, 10, 11,  2,  6, 10, -1 },
+    {  1,  6,  4,  1,  2,  6,  1,  9,  2,  1, 11,  9, -1, -1, -1, -1 },
+    {  6,  9,  2,  6, 11,  9,  6,  1, 11,  6,  0,  1,  6,  8,  0, -1 },
+    { 11,  4,  1, 11,  6,  4, 11,  2,  6, 11,  0,  2, 11,  5,  0, -1 },
+    {  1, 11,  5,  2,  6,  8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  6, 10,  1,  2,  6,  1,  9,  2,  1,  5,  9, -1, -1, -1, -1 },
+    {  0,  4,  8,  1,  6, 10,  1,  2,  6,  1,  9,  2,  1,  5,  9, -1 },
+    {  0, 10,  1,  0,  6, 10,  0,  2,  6, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  6, 10,  1,  2,  6,  1,  8,  2,  1,  4,  8, -1, -1, -1, -1 },
+    {  2,  5,  9,  2,  4,  5,  2,  6,  4, -1, -1, -1, -1, -1, -1, -1 },
+    {  6,  9,  2,  6,  5,  9,  6,  0,  5,  6,  8,  0, -1, -1, -1, -1 },
+    {  0,  6,  4,  0,  2,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  2,  6,  8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  8, 11,  9,  8, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 11,  9,  0, 10, 11,  0,  4, 10, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 11,  5,  0, 10, 11,  0,  8, 10, -1, -1, -1, -1, -1, -1, -1 },
+    {  4, 11,  5,  4, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  8,  4,  1,  9,  8,  1, 11,  9, -1, -1, -1, -1, -1, -1, -1 },
+    {  0, 11,  9,  0,  1, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    { 11,  4,  1, 11,  8,  4, 11,  0,  8, 11,  5,  0, -1, -1, -1, -1 },
+    {  1, 11,  5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  8, 10,  1,  9,  8,  1,  5,  9, -1, -1, -1, -1, -1, -1, -1 },
+    {  9,  1,  5,  9, 10,  1,  9,  4, 10,  9,  0,  4, -1, -1, -1, -1 },
+    {  0, 10,  1,  0,  8, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  1,  4, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  4,  9,  8,  4,  5,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  5,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    {  0,  8,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+    { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 }
+};
+
+/// Corners connected by the twelve cell edges. Corner i is located at (i&1, (i>>1)&1, (i>>2)&1) within the cell.
+const int MC_EDGE_CORNERS[12][2] = {
+    { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },     // x edges
+    { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },     // y edges
+    { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }      // z edges
+};
+
+/// Number of cell layers that are extracted as one slab by a single thread.
+const int LAYERS_PER_SLAB = 8;
+
+/// Upper bound for the memory occupied by the slices that are loaded at once from a disk volume.
+const size_t MAX_DISK_CHUNK_SIZE = 256 << 20;
+
+/// Marks a vertex slot whose vertex has not been created (yet).
+const uint32_t INVALID_VERTEX = 0xFFFFFFFF;
+
+/// Flags a vertex index that refers to an edge on the bottom slice of a slab, whose vertex is owned by the slab below.
+const uint32_t EXTERNAL_VERTEX = 0x80000000;
+
+/// Classification of a volume region with respect to the isovalue.
+enum RegionClass {
+    REGION_BELOW = 0,
+    REGION_ABOVE = 1,
+    REGION_MIXED = 2
+};
+
+/**
+ * Coarse block grid marking the regions of the volume that may intersect the isosurface.
+ * Derived from the min/max values of the volume's octree. An empty mask marks everything as active.
+ */
+struct BlockMask {
+    BlockMask() : blockSize_(0) {}
+
+    bool isEmpty() const { return blockSize_ == 0; }
+
+    size_t blockSize_;
+    tgt::svec3 numBlocks_;
+    std::vector<uint8_t> classes_;       ///< RegionClass per block
+    std::vector<uint8_t> active_;        ///< true, if the cells with their lower corner in the block have to be processed
+    std::vector<uint8_t> layerActive_;   ///< true, if any block of the z layer is active
+};
+
+/// Maps the uint16 min/max values of an octree node to the normalized value range of the voxel format.
+bool getNormalizedNodeRange(const std::string& format, uint16_t minValue, uint16_t maxValue, float& low, float& high) {
+    if (format == "uint8") {
+        low = getTypeAsFloat<uint8_t>(static_cast<uint8_t>(minValue >> 8));
+        high = getTypeAsFloat<uint8_t>(static_cast<uint8_t>(maxValue >> 8));
+    }
+    else if (format == "uint16") {
+        low = getTypeAsFloat<uint16_t>(minValue);
+        high = getTypeAsFloat<uint16_t>(maxValue);
+    }
+    else if (format == "uint32") {
+        // the octree only stores the 16 most significant bits
+        low = getTypeAsFloat<uint32_t>(static_cast<uint32_t>(minValue) << 16);
+        high = getTypeAsFloat<uint32_t>((static_cast<uint32_t>(maxValue) << 16) | 0xFFFF);
+    }
+    else
+        return false;
+    return true;
+}
+
+void classifyOctreeNode(const VolumeOctreeNode* node, const tgt::svec3& llf, const tgt::svec3& nodeDim,
+                        const std::string& format, float isoValue, BlockMask& mask)
+{
+    if (!node || !node->inVolume())
+        return;
+
+    float low = 0.f, high = 0.f;
+    getNormalizedNodeRange(format, node->getMinValue(), node->getMaxValue(), low, high);
+    RegionClass regionClass = REGION_MIXED;
+    if (high < isoValue)
+        regionClass = REGION_BELOW;
+    else if (low >= isoValue)
+        regionClass = REGION_ABOVE;
+
+    if (regionClass == REGION_MIXED && !node->isLeaf()) {
+        const tgt::svec3 childDim = nodeDim / static_cast<size_t>(2);
+        for (size_t i = 0; i < 8; i++) {
+            const tgt::svec3 childLlf = llf + childDim*tgt::svec3(i & 1, (i >> 1) & 1, (i >> 2) & 1);
+            classifyOctreeNode(node->children_[i], childLlf, childDim, format, isoValue, mask);
+        }
+        return;
+    }
+
+    const tgt::svec3 blockStart = llf / mask.blockSize_;
+    const tgt::svec3 blockEnd = tgt::min((llf + nodeDim + mask.blockSize_ - static_cast<size_t>(1)) / mask.blockSize_, mask.numBlocks_);
+    for (size_t z = blockStart.z; z < blockEnd.z; z++)
+        for (size_t y = blockStart.y; y < blockEnd.y; y++)
+            for (size_t x = blockStart.x; x < blockEnd.x; x++)
+                mask.classes_[(z*mask.numBlocks_.y + y)*mask.numBlocks_.x + x] = static_cast<uint8_t>(regionClass);
+}
+
+/**
+ * Derives the block mask from the octree of the volume. A block is skipped, if it and its upper neighbors,
+ * which are touched by the cells of its last voxel row, lie uniformly below or above the isovalue.
+ * Only unsigned integer formats are supported, for which the octree value mapping can be inverted exactly.
+ */
+void createBlockMask(const VolumeOctreeBase* octree, float isoValue, BlockMask& mask) {
+    float low, high;
+    if (!octree->getRootNode() || octree->getNumChannels() != 1 ||
+            !getNormalizedNodeRange(octree->getFormat(), 0, 0, low, high))
+        return;
+
+    const tgt::svec3 dims = octree->getVolumeDim();
+    mask.blockSize_ = octree->getBrickDim().x;
+    mask.numBlocks_ = (dims + mask.blockSize_ - static_cast<size_t>(1)) / mask.blockSize_;
+    mask.classes_.assign(tgt::hmul(mask.numBlocks_), static_cast<uint8_t>(REGION_MIXED));
+    classifyOctreeNode(octree->getRootNode(), tgt::svec3::zero, octree->getOctreeDim(), octree->getFormat(), isoValue, mask);
+
+    const tgt::svec3& n = mask.numBlocks_;
+    mask.active_.assign(mask.classes_.size(), 0);
+    mask.layerActive_.assign(n.z, 0);
+    for (size_t z = 0; z < n.z; z++) {
+        for (size_t y = 0; y < n.y; y++) {
+            for (size_t x = 0; x < n.x; x++) {
+                const size_t index = (z*n.y + y)*n.x + x;
+                const uint8_t regionClass = mask.classes_[index];
+                bool active = (regionClass == REGION_MIXED);
+                for (size_t neighbor = 1; neighbor < 8 && !active; neighbor++) {
+                    const tgt::svec3 pos(x + (neighbor & 1), y + ((neighbor >> 1) & 1), z + ((neighbor >> 2) & 1));
+                    if (tgt::hor(tgt::greaterThanEqual(pos, n)))
+                        continue;
+                    active = (mask.classes_[(pos.z*n.y + pos.y)*n.x + pos.x] != regionClass);
+                }
+                mask.active_[index] = active;
+                if (active)
+                    mask.layerActive_[z] = 1;
+            }
+        }
+    }
+}
+
+/// Converts a z slice of a volume of type T to normalized floats. Returns false, if the volume is of another type.
+template<typename T>
+bool convertSliceTyped(const VolumeRAM* volume, size_t z, float* slice) {
+    const VolumeAtomic<T>* typedVolume = dynamic_cast<const VolumeAtomic<T>*>(volume);
+    if (!typedVolume)
+        return false;
+
+    const size_t sliceSize = volume->getDimensions().x * volume->getDimensions().y;
+    const T* data = typedVolume->voxel() + z*sliceSize;
+    for (size_t i = 0; i < sliceSize; i++)
+        slice[i] = getTypeAsFloat(data[i]);
+    return true;
+}
+
+void convertSlice(const VolumeRAM* volume, size_t z, float* slice) {
+    if (convertSliceTyped<uint8_t>(volume, z, slice) || convertSliceTyped<int8_t>(volume, z, slice) ||
+        convertSliceTyped<uint16_t>(volume, z, slice) || convertSliceTyped<int16_t>(volume, z, slice) ||
+        convertSliceTyped<uint32_t>(volume, z, slice) || convertSliceTyped<int32_t>(volume, z, slice) ||
+        convertSliceTyped<float>(volume, z, slice) || convertSliceTyped<double>(volume, z, slice))
+        return;
+
+    // multi-channel and other formats: use first channel
+    const tgt::svec3 dims = volume->getDimensions();
+    for (size_t y = 0; y < dims.y; y++)
+        for (size_t x = 0; x < dims.x; x++)
+            slice[y*dims.x + x] = volume->getVoxelNormalized(x, y, z, 0);
+}
+
+/// Result of the extraction of one slab of cell layers.
+struct IsosurfaceSlab {
+    std::vector<VertexVec3> vertices_;
+    std::vector<uint32_t> indices_;     ///< three per triangle, possibly flagged by EXTERNAL_VERTEX
+    std::vector<std::pair<uint32_t, uint32_t> > topEdgeVertices_;  ///< (edge id, vertex index) on the top slice, sorted by edge id
+};
+
+/**
+ * Extracts the isosurface from a slab of cell layers. Caches the normalized float slices the current
+ * layer and its gradients depend on. Not thread-safe: each thread uses its own extractor.
+ */
+class SlabExtractor {
+public:
+    SlabExtractor(const tgt::svec3& dims, float isoValue, const tgt::vec3& spacing, const tgt::mat4& voxelToPhysical,
+                  const BlockMask& mask)
+        : dims_(dims)
+        , dx_(static_cast<int>(dims.x))
+        , dy_(static_cast<int>(dims.y))
+        , isoValue_(isoValue)
+        , spacing_(spacing)
+        , voxelToPhysical_(voxelToPhysical)
+        , mask_(mask)
+        , source_(0)
+        , firstSourceSlice_(0)
+        , slab_(0)
+    {
+        const size_t sliceSize = dims.x*dims.y;
+        for (int i = 0; i < 4; i++) {
+            slices_[i].resize(sliceSize);
+            sliceIndices_[i] = -1;
+        }
+        xEdgesBottom_.resize((dims.x - 1)*dims.y);
+        xEdgesTop_.resize((dims.x - 1)*dims.y);
+        yEdgesBottom_.resize(dims.x*(dims.y - 1));
+        yEdgesTop_.resize(dims.x*(dims.y - 1));
+        zEdges_.resize(sliceSize);
+    }
+
+    /**
+     * Extracts the cell layers [z0, z1) into the passed slab.
+     *
+     * @param source RAM volume containing at least the slices z0-1 to z1+1 (clamped to the volume)
+     * @param firstSourceSlice index of the first slice of the source volume within the entire volume
+     */
+    void extract(const VolumeRAM* source, size_t firstSourceSlice, int z0, int z1, IsosurfaceSlab& slab) {
+        source_ = source;
+        firstSourceSlice_ = static_cast<int>(firstSourceSlice);
+        slab_ = &slab;
+        for (int i = 0; i < 4; i++)
+            sliceIndices_[i] = -1;
+
+        std::fill(xEdgesBottom_.begin(), xEdgesBottom_.end(), INVALID_VERTEX);
+        std::fill(yEdgesBottom_.begin(), yEdgesBottom_.end(), INVALID_VERTEX);
+        for (int k = z0; k < z1; k++) {
+            if (k > z0) {
+                xEdgesBottom_.swap(xEdgesTop_);
+                yEdgesBottom_.swap(yEdgesTop_);
+            }
+            std::fill(xEdgesTop_.begin(), xEdgesTop_.end(), INVALID_VERTEX);
+            std::fill(yEdgesTop_.begin(), yEdgesTop_.end(), INVALID_VERTEX);
+            std::fill(zEdges_.begin(), zEdges_.end(), INVALID_VERTEX);
+
+            if (!mask_.isEmpty() && !mask_.layerActive_[k / mask_.blockSize_])
+                continue;
+            extractLayer(k, k == z0 && z0 > 0);
+        }
+
+        // edges on the top slice are shared with the slab above
+        slab.topEdgeVertices_.clear();
+        for (size_t i = 0; i < xEdgesTop_.size(); i++) {
+            if (xEdgesTop_[i] != INVALID_VERTEX)
+                slab.topEdgeVertices_.push_back(std::make_pair(static_cast<uint32_t>(i), xEdgesTop_[i]));
+        }
+        for (size_t i = 0; i < yEdgesTop_.size(); i++) {
+            if (yEdgesTop_[i] != INVALID_VERTEX)
+                slab.topEdgeVertices_.push_back(std::make_pair(static_cast<uint32_t>(xEdgesTop_.size() + i), yEdgesTop_[i]));
+        }
+        slab_ = 0;
+    }
+
+private:
+    /// Returns the normalized float slice z (clamped), converting it if it is not cached.
+    const float* getSlice(int z) {
+        z = tgt::clamp(z, 0, static_cast<int>(dims_.z) - 1);
+        int replace = 0;
+        for (int i = 0; i < 4; i++) {
+            if (sliceIndices_[i] == z)
+                return &slices_[i][0];
+            if (sliceIndices_[i] < sliceIndices_[replace])
+                replace = i;
+        }
+        convertSlice(source_, static_cast<size_t>(z - firstSourceSlice_), &slices_[replace][0]);
+        sliceIndices_[replace] = z;
+        return &slices_[replace][0];
+    }
+
+    /// Central-difference gradient at voxel (x, y) of the layer slice s (0: bottom, 1: top).
+    tgt::vec3 gradient(int x, int y, int s) const {
+        const float* slice = layerSlices_[s + 1];
+        const int x0 = std::max(x - 1, 0), x1 = std::min(x + 1, dx_ - 1);
+        const int y0 = std::max(y - 1, 0), y1 = std::min(y + 1, dy_ - 1);
+        const int index = y*dx_ + x;
+        const int z0 = layerZ_ + s - 1, z1 = layerZ_ + s + 1;
+        const int dz = std::min(z1, static_cast<int>(dims_.z) - 1) - std::max(z0, 0);
+        return tgt::vec3((slice[y*dx_ + x1] - slice[y*dx_ + x0]) / (static_cast<float>(x1 - x0) * spacing_.x),
+                         (slice[y1*dx_ + x] - slice[y0*dx_ + x]) / (static_cast<float>(y1 - y0) * spacing_.y),
+                         (layerSlices_[s + 2][index] - layerSlices_[s][index]) / (static_cast<float>(dz) * spacing_.z));
+    }
+
+    /// Returns the index of the vertex on the passed edge of cell (x, y) in the current layer, creating it if necessary.
+    uint32_t getEdgeVertex(int edge, int x, int y, const float* values, bool externalBottom) {
+        const int a = MC_EDGE_CORNERS[edge][0];
+        const int b = MC_EDGE_CORNERS[edge][1];
+        const int ex = x + (a & 1);
+        const int ey = y + ((a >> 1) & 1);
+
+        uint32_t* slot;
+        uint32_t edgeId = 0;
+        bool bottomSlice = false;
+        if (edge < 4) {
+            edgeId = static_cast<uint32_t>(ey*(dx_ - 1) + ex);
+            bottomSlice = (edge < 2);
+            slot = &(bottomSlice ? xEdgesBottom_ : xEdgesTop_)[edgeId];
+        }
+        else if (edge < 8) {
+            edgeId = static_cast<uint32_t>(ey*dx_ + ex);
+            bottomSlice = (edge < 6);
+            slot = &(bottomSlice ? yEdgesBottom_ : yEdgesTop_)[edgeId];
+            edgeId += static_cast<uint32_t>(xEdgesBottom_.size());
+        }
+        else {
+            slot = &zEdges_[ey*dx_ + ex];
+        }
+
+        if (*slot != INVALID_VERTEX)
+            return *slot;
+
+        if (bottomSlice && externalBottom) {
+            *slot = EXTERNAL_VERTEX | edgeId;
+            return *slot;
+        }
+
+        // interpolate position and gradient between the two corners
+        const int ez = (a >> 2) & 1;
+        const float t = (isoValue_ - values[a]) / (values[b] - values[a]);
+        const tgt::vec3 dir(static_cast<float>((b & 1) - (a & 1)), static_cast<float>(((b >> 1) & 1) - ((a >> 1) & 1)),
+                            static_cast<float>(((b >> 2) & 1) - ez));
+        const tgt::vec3 pos = tgt::vec3(static_cast<float>(ex), static_cast<float>(ey), static_cast<float>(layerZ_ + ez)) + t*dir;
+
+        const tgt::vec3 gradA = gradient(ex, ey, ez);
+        const tgt::vec3 gradB = gradient(ex + (b & 1) - (a & 1), ey + ((b >> 1) & 1) - ((a >> 1) & 1), (b >> 2) & 1);
+        const tgt::vec3 grad = gradA + t*(gradB - gradA);
+        const float gradLength = tgt::length(grad);
+        const tgt::vec3 normal = (gradLength > 0.f ? -grad / gradLength : tgt::vec3(0.f));
+
+        *slot = static_cast<uint32_t>(slab_->vertices_.size());
+        slab_->vertices_.push_back(VertexVec3(voxelToPhysical_ * pos, normal));
+        return *slot;
+    }
+
+    /**
+     * Extracts the cells of layer k.
+     *
+     * @param externalBottom if true, vertices on the bottom slice are referenced as external vertices of the slab below
+     */
+    void extractLayer(int k, bool externalBottom) {
+        layerZ_ = k;
+        for (int i = 0; i < 4; i++)
+            layerSlices_[i] = getSlice(k - 1 + i);
+        const float* bottom = layerSlices_[1];
+        const float* top = layerSlices_[2];
+
+        const uint8_t* activeBlocks = 0;
+        int blockSize = std::numeric_limits<int>::max();
+        if (!mask_.isEmpty()) {
+            blockSize = static_cast<int>(mask_.blockSize_);
+            activeBlocks = &mask_.active_[(k / blockSize)*mask_.numBlocks_.y*mask_.numBlocks_.x];
+        }
+
+        float values[8];
+        for (int y = 0; y < dy_ - 1; y++) {
+            const uint8_t* rowBlocks = (activeBlocks ? activeBlocks + (y / blockSize)*mask_.numBlocks_.x : 0);
+            for (int x = 0; x < dx_ - 1; x++) {
+                if (rowBlocks && !rowBlocks[x / blockSize]) {
+                    x = (x / blockSize + 1)*blockSize - 1;
+                    continue;
+                }
+
+                const int index = y*dx_ + x;
+                values[0] = bottom[index];
+                values[1] = bottom[index + 1];
+                values[2] = bottom[index + dx_];
+                values[3] = bottom[index + dx_ + 1];
+                values[4] = top[index];
+                values[5] = top[index + 1];
+                values[6] = top[index + dx_];
+                values[7] = top[index + dx_ + 1];
+
+                int cubeIndex = 0;
+                for (int i = 0; i < 8; i++) {
+                    if (values[i] >= isoValue_)
+                        cubeIndex |= (1 << i);
+                }
+                if (cubeIndex == 0 || cubeIndex == 255)
+                    continue;
+
+                const int* edges = MC_TRIANGLE_TABLE[cubeIndex];
+                for (int i = 0; edges[i] != -1; i++)
+                    slab_->indices_.push_back(getEdgeVertex(edges[i], x, y, values, externalBottom));
+            }
+        }
+    }
+
+    const tgt::svec3 dims_;
+    const int dx_;
+    const int dy_;
+    const float isoValue_;
+    const tgt::vec3 spacing_;
+    const tgt::mat4 voxelToPhysical_;
+    const BlockMask& mask_;
+
+    const VolumeRAM* source_;
+    int firstSourceSlice_;
+    IsosurfaceSlab* slab_;
+
+    std::vector<float> slices_[4];
+    int sliceIndices_[4];
+
+    int layerZ_;
+    const float* layerSlices_[4];       ///< slices k-1 to k+2 of the current layer k
+
+    std::vector<uint32_t> xEdgesBottom_;
+    std::vector<uint32_t> xEdgesTop_;
+    std::vector<uint32_t> yEdgesBottom_;
+    std::vector<uint32_t> yEdgesTop_;
+    std::vector<uint32_t> zEdges_;
+};
+
+} // namespace anonymous
+
+namespace voreen {
+
+const std::string VolumeIsosurface::loggerCat_("voreen.base.VolumeIsosurface");
+
+VolumeIsosurface::VolumeIsosurface()
+    : Processor()
+    , inport_(Port::INPORT, "volume.input", "Volume Input")
+    , outport_(Port::OUTPORT, "geometry.output", "Isosurface Output")
+    , enableProcessing_("enableProcessing", "Enable", true)
+    , isoValue_("isoValue", "Isovalue (normalized)", 0.5f, 0.f, 1.f)
+{
+    addPort(inport_);
+    addPort(outport_);
+
+    addProperty(enableProcessing_);
+    addProperty(isoValue_);
+}
+
+Processor* VolumeIsosurface::create() const {
+    return new VolumeIsosurface();
+}
+
+void VolumeIsosurface::process() {
+    if (!enableProcessing_.get()) {
+        outport_.setData(0);
+        return;
+    }
+
+    tgtAssert(inport_.hasData(), "Inport has no data");
+    outport_.setData(extractIsosurface(inport_.getData(), isoValue_.get()));
+}
+
+TriangleMeshGeometryUInt32IndexedVec3* VolumeIsosurface::extractIsosurface(const VolumeBase* volume, float isoValue) {
+    tgtAssert(volume, "null pointer passed");
+
+    const tgt::svec3 dims = volume->getDimensions();
+    if (tgt::hor(tgt::lessThan(dims, tgt::svec3(2)))) {
+        LERROR("Volume must have at least two voxels in each dimension");
+        return 0;
+    }
+    if (2 * dims.x * dims.y >= static_cast<size_t>(EXTERNAL_VERTEX)) {
+        LERROR("Volume slices are too large: " << dims.x << "x" << dims.y);
+        return 0;
+    }
+
+    // use the RAM representation, if present, otherwise stream the volume from disk
+    const VolumeRAM* volumeRAM = 0;
+    const VolumeDisk* volumeDisk = 0;
+    if (volume->hasRepresentation<VolumeRAM>())
+        volumeRAM = volume->getRepresentation<VolumeRAM>();
+    else if (volume->hasRepresentation<VolumeDisk>())
+        volumeDisk = volume->getRepresentation<VolumeDisk>();
+    else
+        volumeRAM = volume->getRepresentation<VolumeRAM>();
+    if (!volumeRAM && !volumeDisk) {
+        LERROR("Neither RAM nor disk representation available");
+        return 0;
+    }
+
+    BlockMask mask;
+    if (volume->hasRepresentation<VolumeOctreeBase>())
+        createBlockMask(volume->getRepresentation<VolumeOctreeBase>(), isoValue, mask);
+
+    const int numLayers = static_cast<int>(dims.z) - 1;
+    const int numSlabs = (numLayers + LAYERS_PER_SLAB - 1) / LAYERS_PER_SLAB;
+    int slabsPerChunk = getParallelSlabSize(numSlabs);
+    if (volumeDisk) {
+        const size_t sliceBytes = std::max<size_t>(volume->getBytesPerVoxel() * dims.x * dims.y, 1);
+        const int maxSlabs = static_cast<int>(MAX_DISK_CHUNK_SIZE / (sliceBytes * LAYERS_PER_SLAB));
+        int numThreads = 1;
+#ifdef VRN_MODULE_OPENMP
+        numThreads = std::max(omp_get_max_threads(), 1);
+#endif
+        slabsPerChunk = std::min(slabsPerChunk, std::max(maxSlabs, numThreads));
+    }
+
+    // extract slabs chunk-wise
+    std::vector<IsosurfaceSlab> slabs(numSlabs);
+    const tgt::vec3 spacing = volume->getSpacing();
+    const tgt::mat4 voxelToPhysical = volume->getVoxelToPhysicalMatrix();
+    setProgress(0.f);
+    for (int chunkStart = 0; chunkStart < numSlabs; chunkStart += slabsPerChunk) {
+        const int chunkEnd = std::min(chunkStart + slabsPerChunk, numSlabs);
+
+        const VolumeRAM* source = volumeRAM;
+        VolumeRAM* loadedSlices = 0;
+        size_t firstSourceSlice = 0;
+        if (volumeDisk) {
+            firstSourceSlice = static_cast<size_t>(std::max(chunkStart*LAYERS_PER_SLAB - 1, 0));
+            const size_t lastSourceSlice = std::min(static_cast<size_t>(chunkEnd*LAYERS_PER_SLAB + 1), dims.z - 1);
+            try {
+                loadedSlices = volumeDisk->loadSlices(firstSourceSlice, lastSourceSlice);
+            }
+            catch (tgt::Exception& e) {
+                LERROR("Failed to load slices from disk: " << e.what());
+                return 0;
+            }
+            source = loadedSlices;
+        }
+
+        #ifdef VRN_MODULE_OPENMP
+        #pragma omp parallel
+        #endif
+        {
+            SlabExtractor extractor(dims, isoValue, spacing, voxelToPhysical, mask);
+            #ifdef VRN_MODULE_OPENMP
+            #pragma omp for schedule(dynamic)
+            #endif
+            for (int s = chunkStart; s < chunkEnd; s++) {
+                extractor.extract(source, firstSourceSlice, s*LAYERS_PER_SLAB,
+                    std::min((s + 1)*LAYERS_PER_SLAB, numLayers), slabs[s]);
+            }
+        }
+
+        delete loadedSlices;
+        setProgress(0.9f * static_cast<float>(chunkEnd) / static_cast<float>(numSlabs));
+    }
+
+    // determine the offsets of the slabs in the output mesh
+    std::vector<uint64_t> vertexOffsets(numSlabs + 1, 0);
+    std::vector<uint64_t> triangleOffsets(numSlabs + 1, 0);
+    for (int s = 0; s < numSlabs; s++) {
+        if (slabs[s].vertices_.size() >= static_cast<size_t>(EXTERNAL_VERTEX)) {
+            LERROR("Too many vertices in a single slab");
+            return 0;
+        }
+        vertexOffsets[s + 1] = vertexOffsets[s] + slabs[s].vertices_.size();
+        triangleOffsets[s + 1] = triangleOffsets[s] + slabs[s].indices_.size() / 3;
+    }
+    if (vertexOffsets.back() > static_cast<uint64_t>(std::numeric_limits<uint32_t>::max())) {
+        LERROR("Isosurface has too many vertices for 32 bit indices: " << vertexOffsets.back());
+        return 0;
+    }
+
+    std::vector<VertexVec3> vertices;
+    std::vector<TriangleMeshGeometryUInt32IndexedVec3::TriangleType> triangles;
+    try {
+        vertices.resize(static_cast<size_t>(vertexOffsets.back()));
+        triangles.resize(static_cast<size_t>(triangleOffsets.back()));
+    }
+    catch (std::bad_alloc&) {
+        LERROR("Failed to allocate isosurface mesh: " << vertexOffsets.back() << " vertices, "
+            << triangleOffsets.back() << " triangles");
+        return 0;
+    }
+
+    // merge the slabs: resolve the references to vertices owned by the slab below
+    #ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+    #endif
+    for (int s = 0; s < numSlabs; s++) {
+        IsosurfaceSlab& slab = slabs[s];
+        std::copy(slab.vertices_.begin(), slab.vertices_.end(), vertices.begin() + static_cast<size_t>(vertexOffsets[s]));
+
+        const uint32_t vertexOffset = static_cast<uint32_t>(vertexOffsets[s]);
+        TriangleMeshGeometryUInt32IndexedVec3::TriangleType* slabTriangles = &triangles[0] + static_cast<size_t>(triangleOffsets[s]);
+        for (size_t i = 0; i < slab.indices_.size(); i++) {
+            uint32_t index = slab.indices_[i];
+            if (index & EXTERNAL_VERTEX) {
+                tgtAssert(s > 0, "external vertex in first slab");
+                const std::vector<std::pair<uint32_t, uint32_t> >& below = slabs[s - 1].topEdgeVertices_;
+                const std::pair<uint32_t, uint32_t> key(index & ~EXTERNAL_VERTEX, 0);
+                std::vector<std::pair<uint32_t, uint32_t> >::const_iterator it = std::lower_bound(below.begin(), below.end(), key);
+                tgtAssert(it != below.end() && it->first == key.first, "shared vertex not found in slab below");
+                index = static_cast<uint32_t>(vertexOffsets[s - 1]) + it->second;
+            }
+            else
+                index += vertexOffset;
+            slabTriangles[i / 3].v_[i % 3] = index;
+        }
+
+        // the vertices are not needed anymore, but the top edges are still referenced by the slab above
+        std::vector<VertexVec3>().swap(slab.vertices_);
+        std::vector<uint32_t>().swap(slab.indices_);
+    }
+    slabs.clear();
+
+    TriangleMeshGeometryUInt32IndexedVec3* mesh = new TriangleMeshGeometryUInt32IndexedVec3();
+    if (!vertices.empty()) {
+        mesh->setVertices(vertices);
+        mesh->setTriangles(triangles);
+    }
+    mesh->setTransformationMatrix(volume->getPhysicalToWorldMatrix());
+    setProgress(1.f);
+
+    LINFO("Extracted isosurface: " << vertices.size() << " vertices, " << triangles.size() << " triangles");
+    return mesh;
+}
+
+}   // namespace
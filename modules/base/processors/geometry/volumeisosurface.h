@@ -0,0 +1,88 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef VRN_VOLUMEISOSURFACE_H
+#define VRN_VOLUMEISOSURFACE_H
+
+#include "voreen/core/processors/processor.h"
+#include "voreen/core/ports/geometryport.h"
+#include "voreen/core/ports/volumeport.h"
+
+#include "voreen/core/properties/boolproperty.h"
+#include "voreen/core/properties/floatproperty.h"
+
+namespace voreen {
+
+class TriangleMeshGeometryUInt32IndexedVec3;
+
+/**
+ * Extracts an isosurface from a volume by marching cubes and outputs it as indexed triangle mesh
+ * with shared (welded) vertices and per-vertex normals.
+ *
+ * The cell layers of the volume are processed as independent slabs in parallel. If the volume
+ * has an octree representation, the node min/max values are used to skip regions that do not
+ * intersect the isosurface. Disk volumes are streamed slab-wise, so that the input volume does not
+ * need to fit into the main memory.
+ */
+class VRN_CORE_API VolumeIsosurface : public Processor {
+public:
+    VolumeIsosurface();
+    virtual Processor* create() const;
+
+    virtual std::string getClassName() const { return "VolumeIsosurface"; }
+    virtual std::string getCategory() const  { return "Geometry";         }
+    virtual CodeState getCodeState() const   { return CODE_STATE_TESTING; }
+    virtual bool usesExpensiveComputation() const { return true; }
+
+protected:
+    virtual void setDescriptions() {
+        setDescription("Extracts the isosurface of the input volume at the specified normalized isovalue by marching cubes. "
+                       "The result is an indexed triangle mesh in world coordinates whose vertices are shared between adjacent "
+                       "triangles and carry the normalized, negative gradient of the volume as normal.");
+    }
+
+    virtual void process();
+
+private:
+    /**
+     * Extracts the isosurface of the passed volume.
+     *
+     * @return the resulting mesh, or null if the extraction has failed (error is logged)
+     */
+    TriangleMeshGeometryUInt32IndexedVec3* extractIsosurface(const VolumeBase* volume, float isoValue);
+
+    VolumePort inport_;
+    GeometryPort outport_;
+
+    BoolProperty enableProcessing_;
+    FloatProperty isoValue_;
+
+    static const std::string loggerCat_;
+};
+
+}   //namespace
+
+#endif // VRN_VOLUMEISOSURFACE_H
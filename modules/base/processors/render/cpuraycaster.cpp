@@ -26,6 +26,8 @@
 #include "cpuraycaster.h"
 #include "voreen/core/datastructures/transfunc/transfunc2dprimitives.h"
 
+#include <algorithm>
+
 #ifdef VRN_MODULE_OPENMP
 #include "omp.h"
 #endif
@@ -49,6 +51,10 @@ CPURaycaster::CPURaycaster()
   , transferFunc_("transferFunction", "Transfer function")
   , texFilterMode_("textureFilterMode_", "Texture Filtering")
   , preIntegrationTableSize_("preIntegrationTableSize", "Width of pre-integration table")
+  , emptySpaceSkipping_("emptySpaceSkipping", "Empty Space Skipping", true)
+  , intensityGradientTF_(false)
+  , preIntegration_(false)
+  , tfClassification_(false)
 {
     addPort(volumePort_);
     addPort(gradientVolumePort_);
@@ -73,6 +79,7 @@ CPURaycaster::CPURaycaster()
     preIntegrationTableSize_.select("deriveFromBitDepth");
     addProperty(preIntegrationTableSize_);
 
+    addProperty(emptySpaceSkipping_);
 }
 
 Processor* CPURaycaster::create() const {
@@ -90,6 +97,10 @@ void CPURaycaster::process() {
     transferFunc_.setVolumeHandle(volumePort_.getData());
     LGL_ERROR;
 
+    // determine classification once per frame instead of once per sample
+    preIntegration_ = startsWith(classificationMode_.getKey(), "pre-integrated");
+    tfClassification_ = (classificationMode_.getKey() == "transfer-function");
+
     // determine TF type
     TransFunc1DKeys* tfi = 0;
     TransFunc2DPrimitives* tfig = 0;
@@ -119,7 +130,7 @@ void CPURaycaster::process() {
             LERROR("Gradient volume dimensions differ from intensity volume dimensions");
             return;
         }
-        if (startsWith(classificationMode_.getKey(), "pre-integrated")) {
+        if (preIntegration_) {
             LERROR("Pre-integration cannot be used with 2D tfs.");
             return;
         }
@@ -157,29 +168,38 @@ void CPURaycaster::process() {
         exitPort_.getColorTexture()->downloadTextureToBuffer(GL_RGBA, GL_FLOAT));
     LGL_ERROR;
 
-    // retrieve tf texture
-    tgt::Texture* tfTexture = transferFunc_.get()->getTexture();
-    tfTexture->downloadTexture();
+    if (tfi && tfClassification_) {
+        renderWithEngine(tfi, entryBuffer, exitBuffer, output);
+    }
+    else {
+        // retrieve tf texture
+        tgt::Texture* tfTexture = transferFunc_.get()->getTexture();
+        tfTexture->downloadTexture();
 
-    // iterate over viewport and perform ray casting for each fragment
-    for (int y=0; y < entryPort_.getSize().y; ++y) {
-#pragma omp parallel for schedule(dynamic) shared(volume,samplingStepSize,table,output,entryBuffer,exitBuffer,tfTexture,y)
-        for (int x=0; x < entryPort_.getSize().x; ++x) {
-            vec4 gl_FragColor = vec4(0.f);
-            int p = (y * entryPort_.getSize().x + x);
+        // iterate over viewport and perform ray casting for each fragment
+        const int width = entryPort_.getSize().x;
+        const int height = entryPort_.getSize().y;
+#ifdef VRN_MODULE_OPENMP
+        #pragma omp parallel for schedule(dynamic)
+#endif
+        for (int y=0; y < height; ++y) {
+            for (int x=0; x < width; ++x) {
+                vec4 gl_FragColor = vec4(0.f);
+                int p = (y * width + x);
 
-            vec4 frontPos = entryBuffer[p];
-            vec4 backPos = exitBuffer[p];
+                vec4 frontPos = entryBuffer[p];
+                vec4 backPos = exitBuffer[p];
 
-            if ((frontPos == vec4(0.0)) && (backPos == vec4(0.0))) {
-                //background needs no raycasting
-            }
-            else {
-                //fragCoords are lying inside the boundingbox
-                gl_FragColor = directRendering(frontPos.xyz(), backPos.xyz(), tfTexture, volume, samplingStepSize, table);
-            }
+                if ((frontPos == vec4(0.0)) && (backPos == vec4(0.0))) {
+                    //background needs no raycasting
+                }
+                else {
+                    //fragCoords are lying inside the boundingbox
+                    gl_FragColor = directRendering(frontPos.xyz(), backPos.xyz(), tfTexture, volume, samplingStepSize, table);
+                }
 
-            output[p] = gl_FragColor;
+                output[p] = gl_FragColor;
+            }
         }
     }
     delete[] entryBuffer;
@@ -195,6 +215,23 @@ void CPURaycaster::process() {
     LGL_ERROR;
 }
 
+void CPURaycaster::renderWithEngine(TransFunc1DKeys* transFunc, const vec4* entryBuffer, const vec4* exitBuffer, vec4* output) {
+    try {
+        if (volumePort_.hasChanged() || engine_.getVolume() != volumePort_.getData())
+            engine_.setVolume(volumePort_.getData());
+
+        engine_.setTransFunc(transFunc);
+        engine_.setFilterMode(texFilterMode_.getValue() == GL_NEAREST ? CPURaycastingEngine::FILTER_NEAREST : CPURaycastingEngine::FILTER_LINEAR);
+        engine_.setSamplingRate(samplingRate_.get());
+        engine_.setEmptySpaceSkipping(emptySpaceSkipping_.get());
+        engine_.render(entryBuffer, exitBuffer, entryPort_.getSize(), output);
+    }
+    catch (VoreenException& e) {
+        LERROR(e.what());
+        std::fill(output, output + tgt::hmul(entryPort_.getSize()), vec4(0.f));
+    }
+}
+
 vec4 CPURaycaster::directRendering(const vec3& first, const vec3& last, tgt::Texture* tfTexture, const VolumeRAM* volume, float samplingStepSize, const PreIntegrationTable* table) {
 
     tgtAssert(transferFunc_.get(), "no transfunc");
@@ -249,7 +286,7 @@ vec4 CPURaycaster::directRendering(const vec3& first, const vec3& last, tgt::Tex
         vec4 color = vec4(intensity);
 
         //pre-integration
-        if (startsWith(classificationMode_.getKey(), "pre-integrated")) {
+        if (preIntegration_) {
             if (!table)
                 return vec4(0.f);
 
@@ -261,7 +298,7 @@ vec4 CPURaycaster::directRendering(const vec3& first, const vec3& last, tgt::Tex
 
             lastIntensity = intensity;
         }
-        else if (classificationMode_.getKey() == "transfer-function") {
+        else if (tfClassification_) {
             if (!intensityGradientTF_) {
                 //apply realworld mapping and TF domain
                 intensity = rwm.normalizedToRealWorld(intensity);
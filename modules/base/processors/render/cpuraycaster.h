@@ -31,10 +31,12 @@
 #include "voreen/core/properties/optionproperty.h"
 #include "voreen/core/properties/intproperty.h"
 #include "voreen/core/properties/buttonproperty.h"
+#include "voreen/core/properties/boolproperty.h"
 
 #include "voreen/core/ports/volumeport.h"
 
 #include "voreen/core/datastructures/transfunc/preintegrationtable.h"
+#include "voreen/core/utils/cpuraycastingengine.h"
 
 namespace voreen {
 
@@ -42,6 +44,9 @@ namespace voreen {
  * This is a simple CPURaycaster.
  * The processor allows the use of pre-integration for 1D transfer functions.
  * OpenMP is used for multithreading, if the OpenMP module is activated.
+ *
+ * Regular classification with a 1D transfer function is delegated to the CPURaycastingEngine,
+ * which performs empty space skipping on typed volume data.
  */
 class VRN_CORE_API CPURaycaster : public VolumeRaycaster {
 public:
@@ -73,6 +78,9 @@ private:
     tgt::vec4 apply1DTF(tgt::Texture* tfTexture, float intensity);
     tgt::vec4 apply2DTF(tgt::Texture* tfTexture, float intensity, float gradientMagnitude);
 
+    /// Renders the image by the CPURaycastingEngine (1D TF without pre-integration).
+    void renderWithEngine(TransFunc1DKeys* transFunc, const tgt::vec4* entryBuffer, const tgt::vec4* exitBuffer, tgt::vec4* output);
+
     VolumePort volumePort_;
     VolumePort gradientVolumePort_;
     RenderPort entryPort_;
@@ -83,7 +91,13 @@ private:
     IntOptionProperty texFilterMode_;  ///< texture filtering mode to use for volume access
 
     IntOptionProperty preIntegrationTableSize_; ///< sets the width of the Pre-Integration table
+    BoolProperty emptySpaceSkipping_;           ///< skip transparent regions (1D transfer functions only)
+
     bool intensityGradientTF_;
+    bool preIntegration_;       ///< classification mode is one of the pre-integrated modes
+    bool tfClassification_;     ///< classification mode is "transfer-function"
+
+    CPURaycastingEngine engine_;
 };
 
 } // namespace voreen
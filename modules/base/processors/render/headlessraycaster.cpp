@@ -0,0 +1,222 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "headlessraycaster.h"
+
+#include "voreen/core/datastructures/volume/volume.h"
+#include "voreen/core/datastructures/volume/volumeatomic.h"
+#include "voreen/core/datastructures/transfunc/transfunc1dkeys.h"
+
+#include "tgt/filesystem.h"
+#include "tgt/stopwatch.h"
+
+#ifdef VRN_MODULE_DEVIL
+#include <IL/il.h>
+#include "modules/devil/devilmodule.h"
+#endif
+
+#include <vector>
+
+namespace voreen {
+
+using tgt::ivec2;
+using tgt::vec3;
+using tgt::vec4;
+
+const std::string HeadlessRaycaster::loggerCat_("voreen.base.HeadlessRaycaster");
+
+HeadlessRaycaster::HeadlessRaycaster()
+    : VolumeProcessor()
+    , inport_(Port::INPORT, "volumehandle.volumehandle", "Volume Input")
+    , outport_(Port::OUTPORT, "volumehandle.output", "Rendered Image", false)
+    , transferFunc_("transferFunction", "Transfer function")
+    , camera_("camera", "Camera", tgt::Camera(vec3(0.f, 0.f, 3.5f), vec3(0.f, 0.f, 0.f), vec3(0.f, 1.f, 0.f)))
+    , imageSize_("imageSize", "Image Size", ivec2(512), ivec2(1), ivec2(8192))
+    , samplingRate_("samplingRate", "Sampling Rate", 2.f, 0.01f, 20.f)
+    , filterMode_("filterMode", "Filtering")
+    , emptySpaceSkipping_("emptySpaceSkipping", "Empty Space Skipping", true)
+    , backgroundColor_("backgroundColor", "Background Color", vec4(0.f, 0.f, 0.f, 1.f))
+    , imageFile_("imageFile", "Image File", "Select file...", "", "PNG image (*.png);;JPEG image (*.jpg);;TIFF image (*.tif)",
+            FileDialogProperty::SAVE_FILE, Processor::VALID)
+    , saveButton_("save", "Save Image")
+    , continousSave_("continousSave", "Save on change", false)
+{
+    addPort(inport_);
+    addPort(outport_);
+
+    addProperty(transferFunc_);
+    addProperty(camera_);
+    addProperty(imageSize_);
+    addProperty(samplingRate_);
+    filterMode_.addOption("nearest", "Nearest");
+    filterMode_.addOption("linear", "Linear");
+    filterMode_.select("linear");
+    addProperty(filterMode_);
+    addProperty(emptySpaceSkipping_);
+    backgroundColor_.setViews(Property::COLOR);
+    addProperty(backgroundColor_);
+
+    saveButton_.onChange(CallMemberAction<HeadlessRaycaster>(this, &HeadlessRaycaster::saveImage));
+    addProperty(imageFile_);
+    addProperty(saveButton_);
+    addProperty(continousSave_);
+}
+
+HeadlessRaycaster::~HeadlessRaycaster() {
+}
+
+Processor* HeadlessRaycaster::create() const {
+    return new HeadlessRaycaster();
+}
+
+void HeadlessRaycaster::deinitialize() throw (tgt::Exception) {
+    engine_.setVolume(0);
+    VolumeProcessor::deinitialize();
+}
+
+void HeadlessRaycaster::process() {
+    const VolumeBase* volume = inport_.getData();
+    tgtAssert(volume, "no input volume");
+
+    if (inport_.hasChanged() || engine_.getVolume() != volume) {
+        transferFunc_.setVolumeHandle(volume);
+        camera_.adaptInteractionToScene(volume->getBoundingBox().getBoundingBox());
+        try {
+            engine_.setVolume(volume);
+        }
+        catch (VoreenException& e) {
+            LERROR(e.what());
+            outport_.setData(0);
+            return;
+        }
+    }
+
+    TransFunc1DKeys* transFunc = dynamic_cast<TransFunc1DKeys*>(transferFunc_.get());
+    if (!transFunc) {
+        LWARNING("Only 1D transfer functions are supported");
+        outport_.setData(0);
+        return;
+    }
+
+    engine_.setTransFunc(transFunc);
+    engine_.setFilterMode(filterMode_.isSelected("nearest") ? CPURaycastingEngine::FILTER_NEAREST : CPURaycastingEngine::FILTER_LINEAR);
+    engine_.setSamplingRate(samplingRate_.get());
+    engine_.setEmptySpaceSkipping(emptySpaceSkipping_.get());
+
+    const ivec2 imageSize = imageSize_.get();
+    VolumeRAM_4xUInt8* image = 0;
+    try {
+        std::vector<vec4> buffer(tgt::hmul(imageSize));
+        tgt::Stopwatch stopwatch;
+        stopwatch.start();
+        engine_.render(camera_.get(), imageSize, &buffer[0]);
+        stopwatch.stop();
+        LDEBUG("Rendered " << imageSize.x << "x" << imageSize.y << " image in " << stopwatch.getRuntime() << " ms ("
+            << engine_.getNumSkippedSamples() << " samples skipped)");
+
+        // composite the rendering over the background and quantize it
+        image = new VolumeRAM_4xUInt8(tgt::svec3(imageSize.x, imageSize.y, 1));
+        const vec4 background = backgroundColor_.get();
+        for (size_t i=0; i<buffer.size(); i++) {
+            float transparency = (1.f - buffer[i].a) * background.a;
+            vec4 color(buffer[i].xyz() + transparency * background.xyz(), buffer[i].a + transparency);
+            image->voxel(i) = tgt::Vector4<uint8_t>(tgt::iround(tgt::clamp(color, vec4(0.f), vec4(1.f)) * 255.f));
+        }
+    }
+    catch (VoreenException& e) {
+        LERROR(e.what());
+        outport_.setData(0);
+        return;
+    }
+    catch (std::bad_alloc&) {
+        LERROR("Bad allocation: unable to allocate image of size " << imageSize);
+        outport_.setData(0);
+        return;
+    }
+
+    outport_.setData(new Volume(image, vec3(1.f), vec3(0.f)));
+
+    if (continousSave_.get() && !imageFile_.get().empty())
+        saveImage();
+}
+
+void HeadlessRaycaster::saveImage() {
+    if (!isInitialized())
+        return;
+    if (imageFile_.get().empty()) {
+        LWARNING("no filename specified");
+        return;
+    }
+
+    try {
+        writeImage(imageFile_.get());
+        LINFO("Saved rendering to " << imageFile_.get());
+    }
+    catch (VoreenException& e) {
+        LERROR(e.what());
+    }
+}
+
+#ifdef VRN_MODULE_DEVIL
+
+void HeadlessRaycaster::writeImage(const std::string& filename) const
+    throw (VoreenException)
+{
+    if (tgt::FileSystem::fileExtension(filename).empty())
+        throw VoreenException("filename has no extension");
+
+    const VolumeBase* rendering = outport_.getData();
+    if (!rendering)
+        throw VoreenException("no rendering available");
+    const VolumeRAM_4xUInt8* image = dynamic_cast<const VolumeRAM_4xUInt8*>(rendering->getRepresentation<VolumeRAM>());
+    tgtAssert(image, "rendering is not an RGBA volume");
+    tgt::svec3 dim = image->getDimensions();
+
+    // create Devil image from the rendering and write it to file
+    ILuint img;
+    ilGenImages(1, &img);
+    ilBindImage(img);
+    ilTexImage(static_cast<ILuint>(dim.x), static_cast<ILuint>(dim.y), 1, 4, IL_RGBA, IL_UNSIGNED_BYTE,
+        const_cast<tgt::Vector4<uint8_t>*>(image->voxel()));
+    ilEnable(IL_FILE_OVERWRITE);
+    ilResetWrite();
+    ILboolean success = ilSaveImage(const_cast<char*>(filename.c_str()));
+    ilDeleteImages(1, &img);
+
+    if (!success)
+        throw VoreenException(DevILModule::getDevILError());
+}
+
+#else
+
+void HeadlessRaycaster::writeImage(const std::string& /*filename*/) const
+    throw (VoreenException)
+{
+    throw VoreenException("Unable to write rendering to file: Voreen was compiled without Devil module.");
+}
+
+#endif // VRN_MODULE_DEVIL
+
+} // namespace
@@ -0,0 +1,107 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#ifndef VRN_HEADLESSRAYCASTER_H
+#define VRN_HEADLESSRAYCASTER_H
+
+#include "voreen/core/processors/volumeprocessor.h"
+#include "voreen/core/ports/volumeport.h"
+
+#include "voreen/core/properties/boolproperty.h"
+#include "voreen/core/properties/buttonproperty.h"
+#include "voreen/core/properties/cameraproperty.h"
+#include "voreen/core/properties/filedialogproperty.h"
+#include "voreen/core/properties/floatproperty.h"
+#include "voreen/core/properties/optionproperty.h"
+#include "voreen/core/properties/transfuncproperty.h"
+#include "voreen/core/properties/vectorproperty.h"
+
+#include "voreen/core/utils/cpuraycastingengine.h"
+
+namespace voreen {
+
+/**
+ * Renders a volume on the CPU without requiring an OpenGL context.
+ *
+ * Rays are computed from the camera property, so no entry/exit point textures are needed.
+ * The rendering is put out as two-dimensional RGBA volume (depth 1) and can optionally
+ * be written to an image file (requires the DevIL module). This makes it possible to
+ * produce renderings with voreentool on machines without GPU, for example:
+ *   voreentool --workspace render.vws -c HeadlessRaycaster.imageFile=out.png -a HeadlessRaycaster.save
+ */
+class VRN_CORE_API HeadlessRaycaster : public VolumeProcessor {
+public:
+    HeadlessRaycaster();
+    virtual ~HeadlessRaycaster();
+    virtual Processor* create() const;
+
+    virtual std::string getClassName() const  { return "HeadlessRaycaster"; }
+    virtual std::string getCategory() const   { return "Raycasting";        }
+    virtual CodeState getCodeState() const    { return CODE_STATE_TESTING;  }
+
+    virtual bool usesExpensiveComputation() const { return true; }
+
+    /// Writes the last rendering to the file specified by the imageFile property.
+    void saveImage();
+
+protected:
+    virtual void setDescriptions() {
+        setDescription("Software raycaster that renders the input volume from the specified camera "
+                       "into an RGBA image volume, without using OpenGL. Supports 1D transfer functions, "
+                       "early ray termination and empty space skipping, and is parallelized by OpenMP "
+                       "(if the OpenMP module is enabled). The rendering can be saved as image file, "
+                       "if the DevIL module is enabled.");
+    }
+
+    virtual void process();
+    virtual void deinitialize() throw (tgt::Exception);
+
+private:
+    void writeImage(const std::string& filename) const
+        throw (VoreenException);
+
+    VolumePort inport_;
+    VolumePort outport_;
+
+    TransFuncProperty transferFunc_;
+    CameraProperty camera_;
+    IntVec2Property imageSize_;
+    FloatProperty samplingRate_;
+    StringOptionProperty filterMode_;
+    BoolProperty emptySpaceSkipping_;
+    FloatVec4Property backgroundColor_;
+
+    FileDialogProperty imageFile_;
+    ButtonProperty saveButton_;
+    BoolProperty continousSave_;
+
+    CPURaycastingEngine engine_;
+
+    static const std::string loggerCat_;
+};
+
+} // namespace
+
+#endif // VRN_HEADLESSRAYCASTER_H
@@ -79,6 +79,7 @@ SliceViewer::SliceViewer()
     , voxelOffset_("voxelOffset", "Voxel Offset", tgt::vec2(0.f), tgt::vec2(-10000.f), tgt::vec2(10000.f))
     , zoomFactor_("zoomFactor", "Zoom Factor", 1.f, 0.01f, 1.f)
     , pickingMatrix_("pickingMatrix", "Picking Matrix", tgt::mat4::createIdentity(), tgt::mat4(-1e6f), tgt::mat4(1e6f), Processor::VALID)
+    , numPrefetchSlices_("numPrefetchSlices", "Prefetched Slices", 4, 0, 50, Processor::VALID)
     , mwheelCycleHandler_("mouseWheelHandler", "Slice Cycling", &sliceIndex_)
     , mwheelZoomHandler_("zoomHandler", "Slice Zoom", &zoomFactor_, tgt::MouseEvent::CTRL)
     , sliceShader_(0)
@@ -90,6 +91,7 @@ SliceViewer::SliceViewer()
     , mouseIsPressed_(false)
     , lastPickingPosition_(-1, -1, -1)
     , sliceComplete_(true)
+    , lastSliceIndex_(-1)
 {
     boundaryColor_.setViews(Property::COLOR);
 
@@ -109,6 +111,8 @@ SliceViewer::SliceViewer()
     sliceCacheSize_.setGroupID(inport_.getID());
     sliceCacheSize_.onChange(CallMemberAction<SliceViewer>(this, &SliceViewer::updatePropertyConfiguration));
     addProperty(sliceCacheSize_);
+    numPrefetchSlices_.setGroupID(inport_.getID());
+    addProperty(numPrefetchSlices_);
 
     inport_.addCondition(new PortConditionVolumeTypeGL());
     inport_.showTextureAccessProperties(true);
@@ -308,6 +312,7 @@ void SliceViewer::updatePropertyConfiguration() {
     interactionLevelOfDetail_.setWidgetsEnabled(sliceMode2D);
     sliceExtractionTimeLimit_.setWidgetsEnabled(sliceMode2D);
     sliceCacheSize_.setWidgetsEnabled(sliceMode2D);
+    numPrefetchSlices_.setWidgetsEnabled(sliceMode2D);
 
     if (sliceCacheSize_.get() != sliceCache_.getCacheSize())
         sliceCache_.setCacheSize(sliceCacheSize_.get());
@@ -652,6 +657,16 @@ void SliceViewer::process() {
 
     }   // textured slices
 
+    // prefetch the slices following the visible ones in scroll direction
+    if (texMode_.isSelected("2d-texture") && numPrefetchSlices_.get() > 0 && sliceIndex_.get() != lastSliceIndex_) {
+        int direction = (sliceIndex_.get() > lastSliceIndex_ ? 1 : -1);
+        int lastVisibleSlice = std::min(static_cast<int>(sliceIndex) + numSlicesCol*numSlicesRow - 1, numSlices - 1);
+        size_t prefetchStart = static_cast<size_t>(direction > 0 ? lastVisibleSlice : static_cast<int>(sliceIndex));
+        sliceCache_.prefetchSlices(volume, alignment, prefetchStart, direction, numPrefetchSlices_.get(),
+            interactionMode() ? interactionLevelOfDetail_.get() : sliceLevelOfDetail_.get());
+    }
+    lastSliceIndex_ = sliceIndex_.get();
+
     tgtAssert(sliceShader_, "no slice shader");
     sliceShader_->deactivate();
 
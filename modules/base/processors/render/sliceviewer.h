@@ -189,6 +189,7 @@ protected:
     IntProperty interactionLevelOfDetail_;  ///< level of detail during user interaction
     IntProperty sliceExtractionTimeLimit_;  ///< timelimit in milliseconds for 2D slice extraction
     IntProperty sliceCacheSize_;            ///< size of the 2D slice cache (0 means no cache).
+    IntProperty numPrefetchSlices_;         ///< number of slices created in the background in scroll direction (0 disables prefetching)
 
     EventProperty<SliceViewer>* mouseEventPress_;
     EventProperty<SliceViewer>* mouseEventMove_;
@@ -207,6 +208,7 @@ protected:
     tgt::mat4 textureMatrix_;           ///< matrix that is currently applied to texture coordinates
     bool sliceComplete_;                ///< is set in process() and specifies whether the current slice has been created in full LOD,
                                         ///< if not, an invalidation is triggered in afterProcess().
+    int lastSliceIndex_;                ///< slice index of the previous process() call, determines the prefetch direction
 
     static const std::string fontName_; ///< path and name of the font used for text-rendering
 
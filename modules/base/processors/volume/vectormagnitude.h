@@ -50,6 +50,7 @@ protected:
     }
 
     virtual void process();
+    virtual bool hasImmutableOutput() const { return true; }
     virtual void deinitialize() throw (tgt::Exception);
 
 private:
@@ -54,6 +54,7 @@ protected:
     }
 
     virtual void process();
+    virtual bool hasImmutableOutput() const { return true; }
     virtual void adjustPropertiesToInput();
 
 private:
@@ -28,19 +28,31 @@
 #include "voreen/core/datastructures/volume/volume.h"
 #include "voreen/core/datastructures/volume/volumeoperator.h"
 
+#include <cmath>
+#include <limits>
+#include <vector>
+
 namespace voreen {
 
+const std::string VolumeDistanceTransform::loggerCat_("voreen.VolumeDistanceTransform");
+
 VolumeDistanceTransform::VolumeDistanceTransform()
     : CachingVolumeProcessor()
     , inport_(Port::INPORT, "volumehandle.input", "Volume Input")
     , outport_(Port::OUTPORT, "volumehandle.output", "Volume Output", false)
     , enableProcessing_("enableProcessing", "Enable")
-
+    , mode_("mode", "Output Mode")
+    , threshold_("threshold", "Foreground Threshold", 0.5f, 0.f, 1.f)
 {
     addPort(inport_);
     addPort(outport_);
 
+    mode_.addOption("unsigned", "Unsigned Distance");
+    mode_.addOption("signed", "Signed Distance");
+
     addProperty(enableProcessing_);
+    addProperty(mode_);
+    addProperty(threshold_);
 }
 
 Processor* VolumeDistanceTransform::create() const {
@@ -60,105 +72,174 @@ void VolumeDistanceTransform::process() {
 void VolumeDistanceTransform::distanceTransform() {
     tgtAssert(inport_.hasData(), "Inport has not data");
 
-    VolumeRAM_UInt16* v = 0;
     const VolumeBase* inputHandle = inport_.getData();
-    const VolumeRAM* vol = inport_.getData()->getRepresentation<VolumeRAM>();
-
-    if (!dynamic_cast<const VolumeRAM_UInt16*>(vol)) {
-        v = new VolumeRAM_UInt16(vol->getDimensions());
-        for (size_t z=0; z<v->getDimensions().z ; z++) {
-            for (size_t x=0; x<v->getDimensions().x ; x++)
-                for (size_t y=0 ;y<v->getDimensions().y ; y++)
-                    if (vol->getVoxelNormalized(x,y,z) > 0.5) {
-                        v->voxel(x,y,z) = 65535;
-                    }
-                    else
-                        v->voxel(x,y,z) = 0;
-        }
-        //LWARNING("Currently only 16 bit volumes supported.");
-        //return;
+    const VolumeRAM* vol = inputHandle->getRepresentation<VolumeRAM>();
+    if (!vol) {
+        LERROR("No RAM representation available");
+        outport_.setData(0);
+        return;
     }
-    else {
-        v = dynamic_cast<VolumeRAM_UInt16*>(inport_.getData()->getRepresentation<VolumeRAM>()->clone());
-    }
-
-    uint16_t val = 65535;
-    uint16_t dist = 0;
-
-    for (size_t z=1; z<v->getDimensions().z-1 ; z++){
-        for (size_t x=1; x<v->getDimensions().x-1 ; x++)
-            for (size_t y=1 ;y<v->getDimensions().y-1 ; y++)
-                if (v->voxel(x,y,z) > 0) {
-
-                    dist = 0;
-                    val =  255;
-
-                    if (v->voxel(x-1,y,z) + 1 < val + dist)         {   val = v->voxel(x-1,y,z);  dist = 3; }
-                    if (v->voxel(x,y-1,z) + 3 < val + dist)         {   val = v->voxel(x,y-1,z);  dist = 3; }
-                    if (v->voxel(x-1,y-1,z) + 4 < val + dist )      {   val = v->voxel(x-1,y-1,z); dist = 4; }
-                    if (v->voxel(x+1,y-1,z) + 4 < val + dist )      {   val = v->voxel(x+1,y-1,z); dist = 4; }
-                    if (v->voxel(x,y,z-1) + 3 < val + dist)         {   val = v->voxel(x,y,z-1);  dist = 3; }
 
-                    if (v->voxel(x-1,y,z-1) + 4  < val + dist){ val = v->voxel(x-1,y,z-1); dist = 4; }
-                    if (v->voxel(x,y-1,z-1) + 4  < val + dist){ val = v->voxel(x,y-1,z-1); dist = 4; }
-
-                    if (v->voxel(x-1,y,z+1) + 4  < val + dist){ val = v->voxel(x-1,y,z+1); dist = 4; }
-                    if (v->voxel(x,y-1,z+1) + 4  < val + dist){ val = v->voxel(x,y-1,z+1); dist = 4; }
-
-
-                    if (v->voxel(x-1,y-1,z+1) + 5 < val + dist){ val = v->voxel(x-1,y-1,z+1); dist = 5; }
-                    if (v->voxel(x-1,y-1,z-1) + 5 < val + dist){ val = v->voxel(x-1,y-1,z-1); dist = 5; }
-
-                    if (v->voxel(x+1,y-1,z-1) + 5 < val + dist){ val = v->voxel(x+1,y-1,z-1); dist = 5; }
-                    if (v->voxel(x+1,y-1,z+1) + 5 < val + dist){ val = v->voxel(x+1,y-1,z+1); dist = 5; }
-
-                    v->voxel(x,y,z) = val + dist;
-                }
+    const tgt::svec3 dims = vol->getDimensions();
+    const tgt::vec3 spacing = inputHandle->getSpacing();
+    const bool signedDistance = (mode_.get() == "signed");
+    const float threshold = threshold_.get();
+    const float infinity = std::numeric_limits<float>::infinity();
+    const size_t numVoxels = vol->getNumVoxels();
+    const size_t sliceSize = dims.x*dims.y;
+
+    VolumeRAM_Float* distances = 0;
+    VolumeRAM_Float* outsideDistances = 0;
+    try {
+        distances = new VolumeRAM_Float(dims);
+        if (signedDistance)
+            outsideDistances = new VolumeRAM_Float(dims);
+    }
+    catch (std::bad_alloc&) {
+        LERROR("Failed to allocate output volume");
+        delete distances;
+        outport_.setData(0);
+        return;
     }
 
-    for (size_t z=v->getDimensions().z-2; z>2; z--){
-        for (size_t x=v->getDimensions().x-2; x>2; x--)
-            for (size_t y=v->getDimensions().y-2; y>2; y--)
-                if (v->voxel(x,y,z) > 0) {
-                    dist = 0;
-                    val = v->voxel(x,y,z);
-
-                    if (v->voxel(x+1,y,z) + 3 < val + dist)          { val = v->voxel(x+1,y,z); dist = 3; }
-                    if (v->voxel(x,y+1,z) + 3 < val + dist)          { val = v->voxel(x,y+1,z); dist = 3; }
-                    if (v->voxel(x+1,y+1,z) + 4 < val + dist)        { val = v->voxel(x+1,y+1,z); dist = 4; }
-                    if (v->voxel(x,y,z+1) + 3  < val + dist)         { val = v->voxel(x,y,z+1); dist = 3; }
-
-                    if (v->voxel(x-1,y+1,z) + 4 < val + dist){ val = v->voxel(x-1,y+1,z); dist = 4; }
-                    if (v->voxel(x-1,y+1,z+1) + 5 < val + dist){ val = v->voxel(x-1,y+1,z+1); dist = 5; }
-                    if (v->voxel(x-1,y+1,z-1) + 5 < val + dist){ val = v->voxel(x-1,y+1,z-1); dist = 5; }
-
-                    if (v->voxel(x+1,y,z+1) + 4 < val + dist){ val = v->voxel(x+1,y,z+1); dist = 4; }
-                    if (v->voxel(x,y+1,z+1) + 4 < val + dist){ val = v->voxel(x,y+1,z+1); dist = 4; }
-                    if (v->voxel(x+1,y+1,z+1) + 5 < val + dist){ val = v->voxel(x+1,y+1,z+1); dist = 5; }
-
-                    if (v->voxel(x+1,y,z-1) + 4 < val + dist){ val = v->voxel(x+1,y,z-1); dist = 4; }
-                    if (v->voxel(x,y+1,z-1) + 4 < val + dist){ val = v->voxel(x,y,z-1); dist = 4; }
-                    if (v->voxel(x+1,y+1,z-1)+ 5 < val + dist){ val = v->voxel(x+1,y+1,z-1); dist = 5; }
+    // background voxels are the features of the distance transform of the foreground and vice versa
+    float* inside = distances->voxel();
+    float* outside = (signedDistance ? outsideDistances->voxel() : 0);
+    // the voxels are distributed slice-wise, since the voxel count may exceed the int range
+    std::vector<size_t> numSliceForeground(dims.z, 0);
+    #ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for
+    #endif
+    for (int z = 0; z < static_cast<int>(dims.z); z++) {
+        for (size_t i = z*sliceSize; i < (z+1)*sliceSize; i++) {
+            const bool foreground = vol->getVoxelNormalized(i) > threshold;
+            inside[i] = (foreground ? infinity : 0.f);
+            if (outside)
+                outside[i] = (foreground ? 0.f : infinity);
+            if (foreground)
+                numSliceForeground[z]++;
+        }
+    }
+    size_t numForeground = 0;
+    for (size_t z = 0; z < dims.z; z++)
+        numForeground += numSliceForeground[z];
+
+    if (numForeground == numVoxels)
+        LWARNING("Input volume contains no background voxels: all distances are infinite");
+    if (signedDistance && numForeground == 0)
+        LWARNING("Input volume contains no foreground voxels: all distances are infinite");
+
+    const float passScale = (signedDistance ? 0.5f : 1.f);
+    squaredDistanceTransform(inside, dims, spacing, 0.f, passScale);
+    if (signedDistance)
+        squaredDistanceTransform(outside, dims, spacing, 0.5f, passScale);
+
+    #ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for
+    #endif
+    for (int z = 0; z < static_cast<int>(dims.z); z++) {
+        for (size_t i = z*sliceSize; i < (z+1)*sliceSize; i++) {
+            inside[i] = std::sqrt(inside[i]);
+            if (outside)
+                inside[i] -= std::sqrt(outside[i]);
+        }
+    }
+    delete outsideDistances;
+    setProgress(1.f);
 
-                    if ((val + dist) <  v->voxel(x,y,z)) v->voxel(x,y,z) =  val + dist;
+    Volume* outputHandle = new Volume(distances, inputHandle);
+    outputHandle->setRealWorldMapping(RealWorldMapping());
+    outport_.setData(outputHandle);
+}
 
+void VolumeDistanceTransform::squaredDistanceTransform(float* volume, const tgt::svec3& dims, const tgt::vec3& spacing,
+    float progressOffset, float progressScale)
+{
+    // lines along x and y are distributed slice-wise, lines along z row-wise
+    for (size_t axis = 0; axis < 3; axis++) {
+        const size_t stride = (axis == 0 ? 1 : (axis == 1 ? dims.x : dims.x*dims.y));
+        const size_t n = dims[axis];
+        const size_t numLinesPerSlice = (axis == 0 ? dims.y : dims.x);
+        const size_t sliceStride = (axis == 0 ? dims.x : 1);
+        const size_t sliceOffset = (axis == 2 ? dims.x : dims.x*dims.y);
+        const int numSlices = static_cast<int>(axis == 2 ? dims.y : dims.z);
+
+        const int slabSize = getParallelSlabSize(numSlices);
+        for (int slabStart = 0; slabStart < numSlices; slabStart += slabSize) {
+            const int slabEnd = std::min(slabStart + slabSize, numSlices);
+
+            #ifdef VRN_MODULE_OPENMP
+            #pragma omp parallel
+            #endif
+            {
+                // per-thread line buffers
+                std::vector<float> line(n);
+                std::vector<size_t> parabolas(n);
+                std::vector<double> boundaries(n + 1);
+                std::vector<float> distances(n);
+
+                #ifdef VRN_MODULE_OPENMP
+                #pragma omp for schedule(dynamic)
+                #endif
+                for (int slice = slabStart; slice < slabEnd; slice++) {
+                    for (size_t l = 0; l < numLinesPerSlice; l++) {
+                        float* lineStart = volume + slice*sliceOffset + l*sliceStride;
+                        for (size_t i = 0; i < n; i++)
+                            line[i] = lineStart[i*stride];
+                        distanceTransformLine(&line[0], n, spacing[axis], parabolas, boundaries, distances);
+                        for (size_t i = 0; i < n; i++)
+                            lineStart[i*stride] = line[i];
+                    }
                 }
+            }
 
+            float passProgress = (axis + static_cast<float>(slabEnd) / static_cast<float>(numSlices)) / 3.f;
+            setProgress(progressOffset + passProgress*progressScale);
+        }
     }
+}
 
-    //border cleaning, it was not transformed by distance mapping, property of the algorithm
-    for (size_t x =0; x< v->getDimensions().x;x++)
-        for (size_t y =0; y< v->getDimensions().y;y++)
-            for (size_t z =0; z< v->getDimensions().z;z++) {
-                if ( (x < 3) || (x > v->getDimensions().x-3) || (y < 3) || (y > v->getDimensions().y-3)
-                        || (z < 3) || (z > v->getDimensions().z-3))
-                   v->voxel(x,y,z) = 0;
-
-            }
+void VolumeDistanceTransform::distanceTransformLine(float* line, size_t n, float spacing,
+    std::vector<size_t>& parabolas, std::vector<double>& boundaries, std::vector<float>& distances)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    // compute lower envelope of the parabolas rooted at the finite samples
+    int k = -1;
+    for (size_t q = 0; q < n; q++) {
+        if (line[q] == std::numeric_limits<float>::infinity())
+            continue;
+
+        const double posQ = q * static_cast<double>(spacing);
+        const double valueQ = line[q] + posQ*posQ;
+        double intersection = -infinity;
+        while (k >= 0) {
+            const double posP = parabolas[k] * static_cast<double>(spacing);
+            intersection = (valueQ - (line[parabolas[k]] + posP*posP)) / (2.0 * (posQ - posP));
+            if (intersection > boundaries[k])
+                break;
+            k--;
+        }
+        k++;
+        parabolas[k] = q;
+        boundaries[k] = (k == 0 ? -infinity : intersection);
+        boundaries[k+1] = infinity;
+    }
 
-    Volume* outputHandle = new Volume(v, inputHandle);
-    outputHandle->setRealWorldMapping(RealWorldMapping());
-    outport_.setData(outputHandle);
+    // no feature within the line: distances remain infinite
+    if (k < 0)
+        return;
+
+    // sample lower envelope
+    k = 0;
+    for (size_t q = 0; q < n; q++) {
+        const double posQ = q * static_cast<double>(spacing);
+        while (boundaries[k+1] < posQ)
+            k++;
+        const double diff = posQ - parabolas[k] * static_cast<double>(spacing);
+        distances[q] = static_cast<float>(diff*diff + line[parabolas[k]]);
+    }
+    std::copy(distances.begin(), distances.begin() + n, line);
 }
 
 }   // namespace
@@ -27,14 +27,26 @@
 #define VRN_VOLUMEDISTANCETRANSFORM_H
 
 #include <string>
+#include <vector>
 #include "voreen/core/processors/volumeprocessor.h"
 #include "voreen/core/properties/boolproperty.h"
+#include "voreen/core/properties/floatproperty.h"
+#include "voreen/core/properties/optionproperty.h"
 
 
 namespace voreen {
 
 class Volume;
 
+/**
+ * Computes the exact Euclidean distance transform of the binarized input volume, taking the voxel spacing into account.
+ * The squared distances are computed by separable 1D lower envelope passes (Felzenszwalb/Huttenlocher) along
+ * each axis, whose lines are processed in parallel (if OpenMP is available).
+ *
+ * Output is a float volume containing world space distances:
+ * - unsigned: distance of each foreground voxel to the nearest background voxel, 0 for background voxels
+ * - signed: additionally the negated distance of each background voxel to the nearest foreground voxel
+ */
 class VRN_CORE_API VolumeDistanceTransform : public CachingVolumeProcessor {
 public:
     VolumeDistanceTransform();
@@ -43,22 +55,41 @@ public:
     virtual std::string getClassName() const  { return "VolumeDistanceTransform"; }
     virtual std::string getCategory() const   { return "Volume Processing";       }
     virtual CodeState getCodeState() const    { return CODE_STATE_TESTING;        }
+    virtual bool usesExpensiveComputation() const { return true; }
 
 protected:
     virtual void setDescriptions() {
-        setDescription("Performs a 3D distance transform of the input volume.");
+        setDescription("Performs an exact 3D Euclidean distance transform of the input volume, respecting the voxel spacing. "
+            "Voxels with a normalized intensity above the threshold are considered foreground. In unsigned mode, each foreground voxel "
+            "is assigned its distance to the nearest background voxel. In signed mode, background voxels are additionally assigned the negated "
+            "distance to the nearest foreground voxel.");
     }
 
     virtual void process();
+    virtual bool hasImmutableOutput() const { return true; }
 
 private:
     void distanceTransform();
 
+    /**
+     * Replaces the values of the passed volume, which have to be 0 for feature voxels and infinity otherwise,
+     * by the squared distances to the nearest feature voxel.
+     */
+    void squaredDistanceTransform(float* volume, const tgt::svec3& dims, const tgt::vec3& spacing, float progressOffset, float progressScale);
+
+    /// Computes the 1D squared distance transform of the line in place, using the passed buffers.
+    static void distanceTransformLine(float* line, size_t n, float spacing,
+        std::vector<size_t>& parabolas, std::vector<double>& boundaries, std::vector<float>& distances);
+
 private:
     VolumePort inport_;
     VolumePort outport_;
 
     BoolProperty enableProcessing_;
+    StringOptionProperty mode_;
+    FloatProperty threshold_;
+
+    static const std::string loggerCat_;
 };
 
 }   //namespace
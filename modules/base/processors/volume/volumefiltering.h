@@ -49,6 +49,7 @@ protected:
     }
 
     virtual void process();
+    virtual bool hasImmutableOutput() const { return true; }
 private:
     void forceUpdate();
     void applyOperator();
@@ -53,6 +53,7 @@ protected:
     }
 
     virtual void process();
+    virtual bool hasImmutableOutput() const { return true; }
 
 private:
     VolumePort inport_;
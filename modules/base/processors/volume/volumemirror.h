@@ -51,6 +51,7 @@ protected:
     }
 
     virtual void process();
+    virtual bool hasImmutableOutput() const { return true; }
 
 private:
     BoolProperty mirrorX_;
@@ -111,7 +111,7 @@ void VolumeResample::process() {
         adjustDimensionProperties();
 
     // update output size properties
-    const VolumeRAM* inputVolume = inport_.getData()->getRepresentation<VolumeRAM>();
+    const VolumeBase* inputVolume = inport_.getData();
     tgtAssert(inputVolume, "No input volume");
     tgt::svec3 inputDim = inputVolume->getDimensions();
     tgt::svec3 outputDim(resampleDimensionX_.get(), resampleDimensionY_.get(), resampleDimensionZ_.get());
@@ -137,7 +137,8 @@ void VolumeResample::resampleVolume() {
     tgtAssert(inport_.hasData(), "Inport has not data");
     forceUpdate_ = false;
 
-    if (inport_.getData()->getRepresentation<VolumeRAM>()) {
+    // disk-only volumes are streamed by the resample operator
+    if (inport_.getData()->hasRepresentation<VolumeRAM>() || inport_.getData()->hasRepresentation<VolumeDisk>()) {
 
         VolumeRAM::Filter filter;
         if (filteringMode_.isSelected("nearest"))
@@ -160,6 +161,10 @@ void VolumeResample::resampleVolume() {
             LERROR("resampleVolume(): bad allocation");
             outport_.setData(0);
         }
+        catch (const tgt::Exception& e) {
+            LERROR("resampleVolume(): " << e.what());
+            outport_.setData(0);
+        }
     }
     else {
         outport_.setData(0);
@@ -167,10 +172,10 @@ void VolumeResample::resampleVolume() {
 }
 
 void VolumeResample::adjustDimensionProperties() {
-    if (!inport_.hasData() || !inport_.getData()->getRepresentation<VolumeRAM>())
+    if (!inport_.hasData())
         return;
 
-    tgt::ivec3 volDim = inport_.getData()->getRepresentation<VolumeRAM>()->getDimensions();
+    tgt::ivec3 volDim = inport_.getData()->getDimensions();
 
     if (!allowUpsampling_.get()) {
         resampleDimensionX_.setMaxValue(volDim.x);
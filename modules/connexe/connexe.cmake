@@ -12,6 +12,7 @@ SET(MOD_INSTALL_FILES
 SET(MOD_CORE_SOURCES
     ${MOD_DIR}/processors/connectedcomponents2d.cpp
     ${MOD_DIR}/processors/connectedcomponents3d.cpp
+    ${MOD_DIR}/utils/connectedcomponentlabeler3d.cpp
 # ext
     ${MOD_DIR}/ext/connexe/connexe.cpp
 )
@@ -19,4 +20,5 @@ SET(MOD_CORE_SOURCES
 SET(MOD_CORE_HEADERS
     ${MOD_DIR}/processors/connectedcomponents2d.h
     ${MOD_DIR}/processors/connectedcomponents3d.h
+    ${MOD_DIR}/utils/connectedcomponentlabeler3d.h
 )
@@ -25,9 +25,16 @@
 
 #include "connectedcomponents3d.h"
 
+#include "../utils/connectedcomponentlabeler3d.h"
+
 #include "voreen/core/datastructures/volume/volumeatomic.h"
 
-#include "connexe.h"
+#ifdef VRN_MODULE_PLOTTING
+#include "modules/plotting/datastructures/plotdata.h"
+#endif
+
+#include <cmath>
+#include <limits>
 
 namespace voreen {
 
@@ -37,16 +44,22 @@ ConnectedComponents3D::ConnectedComponents3D()
     : CachingVolumeProcessor(),
       inport_(Port::INPORT, "inport", "Volume Input"),
       outport_(Port::OUTPORT, "outport", "Volume Output"),
+#ifdef VRN_MODULE_PLOTTING
+      statisticsOutport_(Port::OUTPORT, "statisticsOutport", "Component Statistics"),
+#endif
       enableProcessing_("enabled", "Enable", true),
       connectivity_("connectivity", "Connectivity"),
       minComponentSize_("minComponentSize", "Min Component Size", 1, 1, 10000000),
-      maxComponents_("maxComponents", "Max Components", (1<<16)-1, 1, (1<<16)-1),
+      maxComponents_("maxComponents", "Max Components", std::numeric_limits<int>::max(), 1, std::numeric_limits<int>::max()),
       componentSorting_("sorting", "Component Sorting"),
       binarizeOutput_("binarizeOutput", "Binarize Output", false),
       stretchLabels_("stretchLabels", "Stretch Labels", true)
 {
     addPort(inport_);
     addPort(outport_);
+#ifdef VRN_MODULE_PLOTTING
+    addPort(statisticsOutport_);
+#endif
 
     connectivity_.addOption("6-neighborhood", "6 Neighborhood", 6);
     connectivity_.addOption("10-neighborhood", "10 Neighborhood", 10);
@@ -74,57 +87,96 @@ Processor* ConnectedComponents3D::create() const {
     return new ConnectedComponents3D();
 }
 
+void ConnectedComponents3D::beforeProcess() {
+#ifdef VRN_MODULE_PLOTTING
+    // the component statistics are not cached, so the cache must not be restored if they are requested
+    if (statisticsOutport_.isConnected()) {
+        VolumeProcessor::beforeProcess();
+        return;
+    }
+#endif
+    CachingVolumeProcessor::beforeProcess();
+}
+
 void ConnectedComponents3D::process() {
 
-    tgtAssert(inport_.getData() && inport_.getData()->getRepresentation<VolumeRAM>(), "No volume");
+    tgtAssert(inport_.getData(), "No volume");
 
     if (!enableProcessing_.get()) {
         outport_.setData(const_cast<VolumeBase*>(inport_.getData()), false);
-        return;
-    }
-
-    const VolumeRAM* volume = inport_.getData()->getRepresentation<VolumeRAM>();
-    tgt::ivec3 volDim = volume->getDimensions();
-
-    const VolumeRAM_UInt8* volUint8 = dynamic_cast<const VolumeRAM_UInt8*>(volume);
-    const VolumeRAM_UInt16* volUint16 = dynamic_cast<const VolumeRAM_UInt16*>(volume);
-    const VolumeRAM_Float* volFloat = dynamic_cast<const VolumeRAM_Float*>(volume);
-    if (!volUint8 && !volUint16 && !volFloat) {
-        LERROR("Unsupported volume type: VolumeRAM_UInt8, VolumeRAM_UInt16 or VolumeRAM_Float expected.");
-        outport_.setData(0);
+#ifdef VRN_MODULE_PLOTTING
+        statisticsOutport_.setData(0);
+#endif
         return;
     }
 
     // compute connected component labels
-    uint16_t* labels = 0;
+    ConnectedComponentLabeler3D::ComponentSorting sorting = ConnectedComponentLabeler3D::SORT_NONE;
+    if (componentSorting_.isSelected("decreasing"))
+        sorting = ConnectedComponentLabeler3D::SORT_DECREASING_SIZE;
+    else if (componentSorting_.isSelected("increasing"))
+        sorting = ConnectedComponentLabeler3D::SORT_INCREASING_SIZE;
+
+    ConnectedComponentLabeler3D labeler(connectivity_.getValue(), minComponentSize_.get(), maxComponents_.get(),
+        sorting, binarizeOutput_.get());
+    VolumeRAM_UInt32* labelVolume = 0;
     try {
-        labels = new uint16_t[volume->getNumVoxels()];
+        labelVolume = labeler.label(inport_.getData(), this);
     }
-    catch (std::bad_alloc) {
-        LERROR("Failed to create label volume: bad allocation");
+    catch (VoreenException& e) {
+        LERROR(e.what());
         outport_.setData(0);
+#ifdef VRN_MODULE_PLOTTING
+        statisticsOutport_.setData(0);
+#endif
         return;
     }
-    int numLabels = CountConnectedComponentsWithAllParams(
-        const_cast<void*>(reinterpret_cast<const void*>(volume->getData())), (volUint8 ? UCHAR_TYPE : (volUint16 ? USHORT_TYPE : FLOAT_TYPE)),
-        reinterpret_cast<void*>(labels), USHORT_TYPE, tgt::ivec3(volume->getDimensions()).elem, 1.0,
-        connectivity_.getValue(),minComponentSize_.get(), maxComponents_.get(), binarizeOutput_.get() ? 1 : 0);
-
-    // sort components
-    if ((numLabels > 0) && !componentSorting_.isSelected("none") && !binarizeOutput_.get()) {
-        int decreasing = componentSorting_.isSelected("decreasing") ? 1 : 0;
-        RelabelConnectedComponentsBySize(labels, USHORT_TYPE, volDim.elem, decreasing);
-    }
+    const std::vector<ConnectedComponentLabeler3D::ComponentStatistics>& statistics = labeler.getComponentStatistics();
+    const size_t numLabels = statistics.size();
+    LINFO("Found " << numLabels << " connected components");
 
     // stretch labels to use full range
+    double scale = 1.0;
     if ((numLabels > 0) && stretchLabels_.get() && !binarizeOutput_.get()) {
-        float scale = static_cast<float>((1<<16) - 2) / numLabels;
-        for (size_t i=0; i<volume->getNumVoxels(); i++)
-            labels[i] = tgt::ifloor(labels[i]*scale);
+        scale = static_cast<double>(std::numeric_limits<uint32_t>::max() - 1) / numLabels;
+        uint32_t* labels = labelVolume->voxel();
+        for (size_t i=0; i<labelVolume->getNumVoxels(); i++)
+            labels[i] = static_cast<uint32_t>(std::floor(labels[i]*scale));
+    }
+
+#ifdef VRN_MODULE_PLOTTING
+    // put out the component statistics, one row per component
+    PlotData* statisticsData = new PlotData(1, 10);
+    statisticsData->setColumnLabel(0, "Label");
+    statisticsData->setColumnLabel(1, "Voxel Count");
+    statisticsData->setColumnLabel(2, "LLF x");
+    statisticsData->setColumnLabel(3, "LLF y");
+    statisticsData->setColumnLabel(4, "LLF z");
+    statisticsData->setColumnLabel(5, "URB x");
+    statisticsData->setColumnLabel(6, "URB y");
+    statisticsData->setColumnLabel(7, "URB z");
+    statisticsData->setColumnLabel(8, "Centroid x");
+    statisticsData->setColumnLabel(9, "Centroid y");
+    statisticsData->setColumnLabel(10, "Centroid z");
+    std::vector<plot_t> row(11);
+    for (size_t i=0; i<numLabels; i++) {
+        const ConnectedComponentLabeler3D::ComponentStatistics& stats = statistics[i];
+        if (binarizeOutput_.get())
+            row[0] = static_cast<plot_t>(std::numeric_limits<uint32_t>::max());
+        else
+            row[0] = std::floor((i+1)*scale);
+        row[1] = static_cast<plot_t>(stats.numVoxels_);
+        for (size_t c=0; c<3; c++) {
+            row[2+c] = static_cast<plot_t>(stats.llf_[c]);
+            row[5+c] = static_cast<plot_t>(stats.urb_[c]);
+            row[8+c] = stats.centroid_[c];
+        }
+        statisticsData->insert(row);
     }
+    statisticsOutport_.setData(statisticsData);
+#endif
 
     // assign label volume to outport
-    VolumeRAM_UInt16* labelVolume = new VolumeRAM_UInt16(labels, volume->getDimensions());
     outport_.setData(new Volume(labelVolume, inport_.getData()));
 
 }
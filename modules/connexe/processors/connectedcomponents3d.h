@@ -32,13 +32,18 @@
 #include "voreen/core/properties/optionproperty.h"
 #include "voreen/core/properties/intproperty.h"
 
+#ifdef VRN_MODULE_PLOTTING
+#include "modules/plotting/ports/plotport.h"
+#endif
+
 namespace voreen {
 
 /**
  * Detects connected components in a volume data set and intensity-codes the assigned labels
- * in a 16 bit output volume of the same dimensions.
+ * in a 32 bit output volume of the same dimensions. If the plotting module is enabled,
+ * the voxel count, bounding box and centroid of each component are put out as PlotData.
  *
- * @see ConnectedComponents2D
+ * @see ConnectedComponentLabeler3D, ConnectedComponents2D
  */
 class ConnectedComponents3D : public CachingVolumeProcessor {
 public:
@@ -52,7 +57,9 @@ public:
 
 protected:
     virtual void setDescriptions() {
-        setDescription("Detects connected components in a volume data set and intensity-codes the assigned labels in a 16 bit output volume of the same dimensions.\
+        setDescription("Detects connected components in a volume data set and intensity-codes the assigned labels in a 32 bit output volume of the same dimensions. \
+Volumes without a RAM representation are read slab-wise from disk. \
+If the plotting module is enabled, the voxel count, bounding box and centroid of each component are put out as plot data.\
 <p><strong>Properties</strong>:\
 <ul>\
  <li>Connectivity: voxel neighborhood to consider.</li>\
@@ -65,11 +72,15 @@ protected:
 <p>See: ConnectedComponents2D</p>");
     }
 
+    virtual void beforeProcess();
     virtual void process();
 
 private:
     VolumePort inport_;     ///< Volume to analyze.
     VolumePort outport_;    ///< Output volume storing the components' labels.
+#ifdef VRN_MODULE_PLOTTING
+    PlotPort statisticsOutport_;    ///< Voxel count, bounding box and centroid of each component.
+#endif
 
     BoolProperty enableProcessing_;         ///< If set to false, the input volume is passed through.
     IntOptionProperty connectivity_;        ///< Voxel neighborhood to consider for the analysis.
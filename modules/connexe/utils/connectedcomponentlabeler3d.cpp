@@ -0,0 +1,473 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "connectedcomponentlabeler3d.h"
+
+#include "voreen/core/datastructures/volume/volume.h"
+#include "voreen/core/datastructures/volume/volumedisk.h"
+#include "voreen/core/io/progressreporter.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef VRN_MODULE_OPENMP
+#include "omp.h"
+#endif
+
+namespace voreen {
+
+namespace {
+
+typedef ConnectedComponentLabeler3D::ComponentStatistics ComponentStatistics;
+
+/// Labeling state of a block of slices within a slab.
+struct LabelBlock {
+    size_t zStart_;                 ///< first slice of the block within the slab
+    size_t zEnd_;                   ///< slice behind the last slice of the block
+    std::vector<uint32_t> compact_; ///< maps the block-local labels to the block's components (1-based)
+    uint32_t numComponents_;
+    uint32_t offset_;               ///< provisional label of the block's first component minus one
+};
+
+/// Returns the root of the set containing i. The root of a set is always its smallest element.
+inline uint32_t findRoot(std::vector<uint32_t>& parents, uint32_t i) {
+    while (parents[i] != i) {
+        parents[i] = parents[parents[i]];
+        i = parents[i];
+    }
+    return i;
+}
+
+/// Merges the sets containing a and b and returns the root of the merged set.
+inline uint32_t unite(std::vector<uint32_t>& parents, uint32_t a, uint32_t b) {
+    a = findRoot(parents, a);
+    b = findRoot(parents, b);
+    if (a < b) {
+        parents[b] = a;
+        return a;
+    }
+    else {
+        parents[a] = b;
+        return b;
+    }
+}
+
+ComponentStatistics emptyStatistics() {
+    ComponentStatistics stats;
+    stats.numVoxels_ = 0;
+    stats.llf_ = tgt::svec3(std::numeric_limits<size_t>::max());
+    stats.urb_ = tgt::svec3::zero;
+    stats.centroid_ = tgt::dvec3(0.0);
+    return stats;
+}
+
+/// Adds the statistics of src to dst. The centroids are still expected to hold the coordinate sums.
+void mergeStatistics(ComponentStatistics& dst, const ComponentStatistics& src) {
+    dst.numVoxels_ += src.numVoxels_;
+    dst.llf_ = tgt::min(dst.llf_, src.llf_);
+    dst.urb_ = tgt::max(dst.urb_, src.urb_);
+    dst.centroid_ += src.centroid_;
+}
+
+/**
+ * Assigns block-local labels to the foreground voxels of the block by union-find
+ * and determines the block's components. Only neighbors within the block are considered.
+ */
+template<class T>
+void labelBlock(const VolumeRAM* slab, const std::vector<tgt::ivec3>& neighbors, uint32_t* labels, LabelBlock& block) {
+    const T* data = reinterpret_cast<const T*>(slab->getData());
+    const tgt::ivec3 dim(slab->getDimensions());
+    const size_t sliceSize = static_cast<size_t>(dim.x) * dim.y;
+
+    std::vector<ptrdiff_t> offsets(neighbors.size());
+    for (size_t n = 0; n < neighbors.size(); ++n)
+        offsets[n] = (static_cast<ptrdiff_t>(neighbors[n].z) * dim.y + neighbors[n].y) * dim.x + neighbors[n].x;
+
+    std::vector<uint32_t> parents(1, 0);
+    for (int z = static_cast<int>(block.zStart_); z < static_cast<int>(block.zEnd_); ++z) {
+        for (int y = 0; y < dim.y; ++y) {
+            size_t i = z * sliceSize + static_cast<size_t>(y) * dim.x;
+            for (int x = 0; x < dim.x; ++x, ++i) {
+                if (!(data[i] >= T(1))) {
+                    labels[i] = 0;
+                    continue;
+                }
+
+                uint32_t label = 0;
+                for (size_t n = 0; n < neighbors.size(); ++n) {
+                    const tgt::ivec3& d = neighbors[n];
+                    if (x + d.x < 0 || x + d.x >= dim.x || y + d.y < 0 || y + d.y >= dim.y || z + d.z < static_cast<int>(block.zStart_))
+                        continue;
+                    const uint32_t neighborLabel = labels[i + offsets[n]];
+                    if (neighborLabel == 0)
+                        continue;
+                    label = (label == 0 ? neighborLabel : unite(parents, label, neighborLabel));
+                }
+                if (label == 0) {
+                    label = static_cast<uint32_t>(parents.size());
+                    parents.push_back(label);
+                }
+                labels[i] = label;
+            }
+        }
+    }
+
+    // number the components, a root always precedes the other elements of its set
+    block.compact_.assign(parents.size(), 0);
+    block.numComponents_ = 0;
+    for (uint32_t l = 1; l < parents.size(); ++l) {
+        const uint32_t root = findRoot(parents, l);
+        block.compact_[l] = (root == l ? ++block.numComponents_ : block.compact_[root]);
+    }
+}
+
+typedef void (*LabelBlockFunction)(const VolumeRAM*, const std::vector<tgt::ivec3>&, uint32_t*, LabelBlock&);
+
+LabelBlockFunction getLabelBlockFunction(const VolumeRAM* volume) {
+    if (dynamic_cast<const VolumeRAM_UInt8*>(volume))
+        return &labelBlock<uint8_t>;
+    else if (dynamic_cast<const VolumeRAM_Int8*>(volume))
+        return &labelBlock<int8_t>;
+    else if (dynamic_cast<const VolumeRAM_UInt16*>(volume))
+        return &labelBlock<uint16_t>;
+    else if (dynamic_cast<const VolumeRAM_Int16*>(volume))
+        return &labelBlock<int16_t>;
+    else if (dynamic_cast<const VolumeRAM_UInt32*>(volume))
+        return &labelBlock<uint32_t>;
+    else if (dynamic_cast<const VolumeRAM_Int32*>(volume))
+        return &labelBlock<int32_t>;
+    else if (dynamic_cast<const VolumeRAM_Float*>(volume))
+        return &labelBlock<float>;
+    else if (dynamic_cast<const VolumeRAM_Double*>(volume))
+        return &labelBlock<double>;
+    else
+        return 0;
+}
+
+/// Replaces the block-local labels by provisional labels and accumulates the components' statistics.
+void relabelBlock(uint32_t* labels, const tgt::svec3& slabDim, size_t zOffset, const LabelBlock& block,
+    std::vector<ComponentStatistics>& statistics)
+{
+    size_t i = block.zStart_ * slabDim.x * slabDim.y;
+    for (size_t z = block.zStart_; z < block.zEnd_; ++z) {
+        for (size_t y = 0; y < slabDim.y; ++y) {
+            for (size_t x = 0; x < slabDim.x; ++x, ++i) {
+                if (labels[i] == 0)
+                    continue;
+                labels[i] = block.offset_ + block.compact_[labels[i]];
+
+                ComponentStatistics& stats = statistics[labels[i]];
+                const tgt::svec3 pos(x, y, zOffset + z);
+                ++stats.numVoxels_;
+                stats.llf_ = tgt::min(stats.llf_, pos);
+                stats.urb_ = tgt::max(stats.urb_, pos);
+                stats.centroid_ += tgt::dvec3(pos);
+            }
+        }
+    }
+}
+
+/// Collects the label pairs of neighboring voxels across the border between slice z and its predecessor.
+void collectBorderEquivalences(const uint32_t* labels, const tgt::svec3& dim, size_t z,
+    const std::vector<tgt::ivec3>& neighbors, std::vector<std::pair<uint32_t, uint32_t> >& equivalences)
+{
+    const int dimX = static_cast<int>(dim.x);
+    const int dimY = static_cast<int>(dim.y);
+    const uint32_t* slice = labels + z * dim.x * dim.y;
+    for (int y = 0; y < dimY; ++y) {
+        for (int x = 0; x < dimX; ++x) {
+            const uint32_t label = slice[static_cast<size_t>(y) * dimX + x];
+            if (label == 0)
+                continue;
+            for (size_t n = 0; n < neighbors.size(); ++n) {
+                const tgt::ivec3& d = neighbors[n];
+                if (d.z == 0 || x + d.x < 0 || x + d.x >= dimX || y + d.y < 0 || y + d.y >= dimY)
+                    continue;
+                const uint32_t neighborLabel = slice[(static_cast<ptrdiff_t>(y + d.y) - dimY) * dimX + (x + d.x)];
+                if (neighborLabel == 0 || neighborLabel == label)
+                    continue;
+                std::pair<uint32_t, uint32_t> equivalence(label, neighborLabel);
+                if (equivalences.empty() || equivalences.back() != equivalence)
+                    equivalences.push_back(equivalence);
+            }
+        }
+    }
+}
+
+/// Orders provisional labels by the size of their components. Ties are resolved by the labels.
+struct ComponentSizeComparator {
+    ComponentSizeComparator(const std::vector<ComponentStatistics>& statistics, bool decreasing)
+        : statistics_(statistics), decreasing_(decreasing)
+    {}
+
+    bool operator()(uint32_t a, uint32_t b) const {
+        const uint64_t sizeA = statistics_[a].numVoxels_;
+        const uint64_t sizeB = statistics_[b].numVoxels_;
+        if (sizeA != sizeB)
+            return (decreasing_ ? sizeA > sizeB : sizeA < sizeB);
+        return a < b;
+    }
+
+    const std::vector<ComponentStatistics>& statistics_;
+    bool decreasing_;
+};
+
+} // namespace
+
+const std::string ConnectedComponentLabeler3D::loggerCat_("voreen.connexe.ConnectedComponentLabeler3D");
+
+ConnectedComponentLabeler3D::ConnectedComponentLabeler3D(int connectivity, size_t minComponentSize, size_t maxComponents,
+        ComponentSorting sorting, bool binarize, size_t slabDepth)
+    : minComponentSize_(minComponentSize)
+    , maxComponents_(maxComponents)
+    , sorting_(sorting)
+    , binarize_(binarize)
+    , slabDepth_(std::max<size_t>(slabDepth, 1))
+{
+    tgtAssert(connectivity == 6 || connectivity == 10 || connectivity == 18 || connectivity == 26, "invalid connectivity");
+
+    // causal neighbors, i.e., those preceding a voxel in raster order
+    neighbors_.push_back(tgt::ivec3(-1,  0,  0));
+    neighbors_.push_back(tgt::ivec3( 0, -1,  0));
+    neighbors_.push_back(tgt::ivec3( 0,  0, -1));
+    if (connectivity >= 10) {
+        neighbors_.push_back(tgt::ivec3(-1, -1,  0));
+        neighbors_.push_back(tgt::ivec3( 1, -1,  0));
+    }
+    if (connectivity >= 18) {
+        neighbors_.push_back(tgt::ivec3( 0, -1, -1));
+        neighbors_.push_back(tgt::ivec3(-1,  0, -1));
+        neighbors_.push_back(tgt::ivec3( 1,  0, -1));
+        neighbors_.push_back(tgt::ivec3( 0,  1, -1));
+    }
+    if (connectivity >= 26) {
+        neighbors_.push_back(tgt::ivec3(-1, -1, -1));
+        neighbors_.push_back(tgt::ivec3( 1, -1, -1));
+        neighbors_.push_back(tgt::ivec3(-1,  1, -1));
+        neighbors_.push_back(tgt::ivec3( 1,  1, -1));
+    }
+}
+
+VolumeRAM_UInt32* ConnectedComponentLabeler3D::label(const VolumeBase* volume, ProgressReporter* progressReporter)
+    throw (VoreenException)
+{
+    tgtAssert(volume, "null pointer passed");
+    componentStatistics_.clear();
+
+    if (volume->getNumChannels() != 1)
+        throw VoreenException("Single-channel volume expected");
+
+    // use the RAM representation, if present, and fall back to slab-wise reading from disk otherwise
+    const VolumeRAM* volumeRAM = 0;
+    const VolumeDisk* volumeDisk = 0;
+    if (!volume->hasRepresentation<VolumeRAM>() && volume->hasRepresentation<VolumeDisk>())
+        volumeDisk = volume->getRepresentation<VolumeDisk>();
+    else
+        volumeRAM = volume->getRepresentation<VolumeRAM>();
+    if (!volumeRAM && !volumeDisk)
+        throw VoreenException("Neither RAM nor disk representation available");
+    if (volumeRAM && !getLabelBlockFunction(volumeRAM))
+        throw VoreenException("Unsupported volume format: " + volume->getFormat());
+
+    const tgt::svec3 dim = volume->getDimensions();
+    VolumeRAM_UInt32* labelVolume = 0;
+    try {
+        labelVolume = new VolumeRAM_UInt32(dim);
+    }
+    catch (std::bad_alloc&) {
+        throw VoreenException("Failed to create label volume: bad allocation");
+    }
+    uint32_t* labels = labelVolume->voxel();
+
+    // label the volume slab-wise, the provisional labels refer to the union-find forest
+    // and to the statistics, whose centroids hold the coordinate sums during labeling
+    std::vector<uint32_t> parents(1, 0);
+    std::vector<ComponentStatistics> statistics(1, emptyStatistics());
+    try {
+        if (volumeRAM) {
+            labelSlab(volumeRAM, 0, labels, dim, parents, statistics);
+        }
+        else {
+            for (size_t z = 0; z < dim.z; z += slabDepth_) {
+                const size_t zEnd = std::min(z + slabDepth_, dim.z);
+                VolumeRAM* slab = 0;
+                try {
+                    slab = volumeDisk->loadSlices(z, zEnd - 1);
+                }
+                catch (tgt::Exception& e) {
+                    throw VoreenException("Failed to load slices from disk: " + std::string(e.what()));
+                }
+                if (!getLabelBlockFunction(slab)) {
+                    delete slab;
+                    throw VoreenException("Unsupported volume format: " + volume->getFormat());
+                }
+                try {
+                    labelSlab(slab, z, labels, dim, parents, statistics);
+                }
+                catch (...) {
+                    delete slab;
+                    throw;
+                }
+                delete slab;
+
+                if (progressReporter)
+                    progressReporter->setProgress(0.8f * zEnd / dim.z);
+            }
+        }
+    }
+    catch (...) {
+        delete labelVolume;
+        throw;
+    }
+    if (progressReporter)
+        progressReporter->setProgress(0.8f);
+
+    // accumulate the statistics in the roots, which are the components in raster order
+    const uint32_t numProvisional = static_cast<uint32_t>(parents.size() - 1);
+    std::vector<uint32_t> components;
+    for (uint32_t l = 1; l <= numProvisional; ++l) {
+        parents[l] = parents[parents[l]];
+        if (parents[l] != l)
+            mergeStatistics(statistics[parents[l]], statistics[l]);
+    }
+    for (uint32_t l = 1; l <= numProvisional; ++l) {
+        if (parents[l] == l && statistics[l].numVoxels_ >= minComponentSize_)
+            components.push_back(l);
+    }
+
+    // keep the largest components and sort them
+    if (maxComponents_ > 0 && components.size() > maxComponents_) {
+        std::sort(components.begin(), components.end(), ComponentSizeComparator(statistics, true));
+        components.resize(maxComponents_);
+        if (sorting_ == SORT_NONE)
+            std::sort(components.begin(), components.end());
+    }
+    if (sorting_ != SORT_NONE)
+        std::sort(components.begin(), components.end(), ComponentSizeComparator(statistics, sorting_ == SORT_DECREASING_SIZE));
+
+    std::vector<uint32_t> finalLabels(numProvisional + 1, 0);
+    componentStatistics_.resize(components.size());
+    for (size_t i = 0; i < components.size(); ++i) {
+        finalLabels[components[i]] = (binarize_ ? std::numeric_limits<uint32_t>::max() : static_cast<uint32_t>(i + 1));
+        componentStatistics_[i] = statistics[components[i]];
+        componentStatistics_[i].centroid_ /= static_cast<double>(componentStatistics_[i].numVoxels_);
+    }
+    for (uint32_t l = 1; l <= numProvisional; ++l)
+        finalLabels[l] = finalLabels[parents[l]];
+    if (progressReporter)
+        progressReporter->setProgress(0.9f);
+
+    // assign the final labels
+    const int numSlices = static_cast<int>(dim.z);
+    const size_t sliceSize = dim.x * dim.y;
+#ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for
+#endif
+    for (int z = 0; z < numSlices; ++z) {
+        uint32_t* slice = labels + z * sliceSize;
+        for (size_t i = 0; i < sliceSize; ++i)
+            slice[i] = finalLabels[slice[i]];
+    }
+    if (progressReporter)
+        progressReporter->setProgress(1.f);
+
+    LDEBUG("Labeled " << components.size() << " components (" << numProvisional << " provisional labels)");
+    return labelVolume;
+}
+
+const std::vector<ConnectedComponentLabeler3D::ComponentStatistics>& ConnectedComponentLabeler3D::getComponentStatistics() const {
+    return componentStatistics_;
+}
+
+void ConnectedComponentLabeler3D::labelSlab(const VolumeRAM* slab, size_t zOffset, uint32_t* labels, const tgt::svec3& volumeDim,
+    std::vector<uint32_t>& parents, std::vector<ComponentStatistics>& statistics) const
+    throw (VoreenException)
+{
+    const tgt::svec3 slabDim = slab->getDimensions();
+    tgtAssert(slabDim.xy() == volumeDim.xy(), "slab dimensions do not match");
+    LabelBlockFunction labelBlockFunction = getLabelBlockFunction(slab);
+    tgtAssert(labelBlockFunction, "unsupported slab format");
+    uint32_t* slabLabels = labels + zOffset * volumeDim.x * volumeDim.y;
+
+    // split the slab into blocks of slices
+    size_t numBlocks = 1;
+#ifdef VRN_MODULE_OPENMP
+    numBlocks = std::min<size_t>(slabDim.z, 4 * std::max(omp_get_max_threads(), 1));
+#endif
+    std::vector<LabelBlock> blocks(numBlocks);
+    for (size_t b = 0; b < numBlocks; ++b) {
+        blocks[b].zStart_ = b * slabDim.z / numBlocks;
+        blocks[b].zEnd_ = (b + 1) * slabDim.z / numBlocks;
+    }
+    const int numBlocksInt = static_cast<int>(numBlocks);
+
+    // label the blocks independently
+#ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int b = 0; b < numBlocksInt; ++b)
+        labelBlockFunction(slab, neighbors_, slabLabels, blocks[b]);
+
+    // assign consecutive provisional labels to the blocks' components
+    uint64_t numProvisional = parents.size() - 1;
+    for (size_t b = 0; b < numBlocks; ++b) {
+        blocks[b].offset_ = static_cast<uint32_t>(std::min<uint64_t>(numProvisional, std::numeric_limits<uint32_t>::max()));
+        numProvisional += blocks[b].numComponents_;
+    }
+    if (numProvisional >= std::numeric_limits<uint32_t>::max())
+        throw VoreenException("Number of connected components exceeds the 32 bit label range");
+
+    const size_t firstNewLabel = parents.size();
+    parents.resize(static_cast<size_t>(numProvisional) + 1);
+    for (size_t l = firstNewLabel; l < parents.size(); ++l)
+        parents[l] = static_cast<uint32_t>(l);
+    statistics.resize(parents.size(), emptyStatistics());
+
+#ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int b = 0; b < numBlocksInt; ++b) {
+        relabelBlock(slabLabels, slabDim, zOffset, blocks[b], statistics);
+        std::vector<uint32_t>().swap(blocks[b].compact_);
+    }
+
+    // merge the equivalences across the block borders, including the border to the preceding slab
+    std::vector<std::vector<std::pair<uint32_t, uint32_t> > > equivalences(numBlocks);
+#ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int b = 0; b < numBlocksInt; ++b) {
+        const size_t z = zOffset + blocks[b].zStart_;
+        if (z > 0 && blocks[b].zStart_ < blocks[b].zEnd_)
+            collectBorderEquivalences(labels, volumeDim, z, neighbors_, equivalences[b]);
+    }
+    for (size_t b = 0; b < numBlocks; ++b) {
+        for (size_t i = 0; i < equivalences[b].size(); ++i)
+            unite(parents, equivalences[b][i].first, equivalences[b][i].second);
+    }
+}
+
+} // namespace
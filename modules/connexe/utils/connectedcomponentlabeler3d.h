@@ -0,0 +1,118 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef VRN_CONNECTEDCOMPONENTLABELER3D_H
+#define VRN_CONNECTEDCOMPONENTLABELER3D_H
+
+#include "voreen/core/datastructures/volume/volumeatomic.h"
+#include "voreen/core/utils/exception.h"
+
+#include "tgt/vector.h"
+
+#include <vector>
+
+namespace voreen {
+
+class VolumeBase;
+class ProgressReporter;
+
+/**
+ * Labels the connected components of a single-channel volume in a 32 bit label volume
+ * and determines voxel count, bounding box and centroid of each component in the same pass.
+ * All voxels with a value greater or equal 1 are considered as foreground.
+ *
+ * The volume is split into blocks of z-slices, which are labeled independently by
+ * union-find (in parallel, if the OpenMP module is enabled). Afterwards, the equivalences
+ * across the block borders are merged. If the input volume has no RAM representation,
+ * it is read slab-wise from its disk representation, so that only the label volume
+ * has to fit into main memory.
+ */
+class ConnectedComponentLabeler3D {
+public:
+    /// Determines the order in which the labels are assigned to the components.
+    enum ComponentSorting {
+        SORT_NONE,              ///< raster order of the components
+        SORT_DECREASING_SIZE,
+        SORT_INCREASING_SIZE
+    };
+
+    /// Statistics of a single connected component.
+    struct ComponentStatistics {
+        uint64_t numVoxels_;
+        tgt::svec3 llf_;        ///< lower-left-front voxel of the bounding box
+        tgt::svec3 urb_;        ///< upper-right-back voxel of the bounding box (inclusive)
+        tgt::dvec3 centroid_;   ///< center of mass in voxel coordinates
+    };
+
+    /**
+     * @param connectivity voxel neighborhood to consider: 6, 10, 18 or 26.
+     *        The 10-neighborhood consists of the 8-neighborhood within the xy-plane and the two z-neighbors.
+     * @param minComponentSize components consisting of less voxels are discarded
+     * @param maxComponents if more components are found, only the largest ones are kept. 0 disables the limit.
+     * @param sorting order in which the labels are assigned
+     * @param binarize if true, all kept components are assigned the same label (max intensity)
+     * @param slabDepth number of slices that are loaded at once from a disk volume
+     */
+    ConnectedComponentLabeler3D(int connectivity = 26, size_t minComponentSize = 1, size_t maxComponents = 0,
+        ComponentSorting sorting = SORT_NONE, bool binarize = false, size_t slabDepth = 64);
+
+    /**
+     * Labels the connected components of the passed volume. The background is labeled 0,
+     * the kept components are labeled 1..n. The caller takes ownership of the returned volume.
+     *
+     * @throw VoreenException if the volume format is not supported, the volume has neither
+     *        a RAM nor a disk representation or the label volume could not be allocated
+     */
+    VolumeRAM_UInt32* label(const VolumeBase* volume, ProgressReporter* progressReporter = 0)
+        throw (VoreenException);
+
+    /**
+     * Returns the statistics of the components found by the last call of label().
+     * The i-th entry belongs to the component with label i+1.
+     */
+    const std::vector<ComponentStatistics>& getComponentStatistics() const;
+
+private:
+    /// Labels the slab, whose first slice is the slice zOffset of the volume, block-wise and merges the block borders.
+    void labelSlab(const VolumeRAM* slab, size_t zOffset, uint32_t* labels, const tgt::svec3& volumeDim,
+        std::vector<uint32_t>& parents, std::vector<ComponentStatistics>& statistics) const
+        throw (VoreenException);
+
+    std::vector<tgt::ivec3> neighbors_;     ///< causal neighborhood, i.e., neighbors preceding a voxel in raster order
+    size_t minComponentSize_;
+    size_t maxComponents_;
+    ComponentSorting sorting_;
+    bool binarize_;
+    size_t slabDepth_;
+
+    std::vector<ComponentStatistics> componentStatistics_;
+
+    static const std::string loggerCat_;
+};
+
+} // namespace
+
+#endif // VRN_CONNECTEDCOMPONENTLABELER3D_H
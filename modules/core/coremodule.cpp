@@ -104,6 +104,7 @@
 #include "voreen/core/datastructures/octree/volumeoctree.h"
 #include "voreen/core/datastructures/octree/octreebrickpoolmanager.h"
 #include "voreen/core/datastructures/octree/octreebrickpoolmanagerdisk.h"
+#include "voreen/core/datastructures/octree/octreebrickpoolmanagermmap.h"
 
 // transfer functions
 #include "voreen/core/datastructures/transfunc/transfunc.h"
@@ -115,6 +116,7 @@
 // volume derived data
 #include "voreen/core/datastructures/volume/volumehash.h"
 #include "voreen/core/datastructures/volume/volumeminmax.h"
+#include "voreen/core/datastructures/volume/volumestatistics.h"
 #include "voreen/core/datastructures/volume/volumepreview.h"
 #include "voreen/core/datastructures/volume/histogram.h"
 
@@ -356,6 +358,7 @@ CoreModule::CoreModule(const std::string& modulePath)
     // volume derived data
     registerSerializableType(new VolumeMinMax());
     registerSerializableType(new VolumeHash());
+    registerSerializableType(new VolumeStatistics());
     registerSerializableType(new VolumePreview());
     registerSerializableType(new VolumeHistogramIntensity());
     registerSerializableType(new VolumeHistogramIntensityGradient());
@@ -388,6 +391,7 @@ CoreModule::CoreModule(const std::string& modulePath)
     registerSerializableType(new VolumeOctree());
     registerSerializableType(new OctreeBrickPoolManagerRAM());
     registerSerializableType(new OctreeBrickPoolManagerDisk(64<<20, 512<<20, ""));
+    registerSerializableType(new OctreeBrickPoolManagerMmap(64<<20, ""));
 
     // transfer functions
     registerSerializableType("TransFuncIntensity", new TransFunc1DKeys());
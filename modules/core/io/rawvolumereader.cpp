@@ -36,6 +36,7 @@
 
 #include "voreen/core/io/progressbar.h"
 #include "voreen/core/datastructures/volume/volumeatomic.h"
+#include "voreen/core/datastructures/volume/volumedisk.h"
 #include "voreen/core/datastructures/volume/volumefusion.h"
 #include "voreen/core/datastructures/volume/volumepreview.h"
 #include "voreen/core/datastructures/volume/operators/volumeoperatorresize.h"
@@ -517,12 +518,6 @@ VolumeList* RawVolumeReader::readBrick(const std::string &url, tgt::ivec3 brickS
         throw tgt::CorruptedFileException("No readHints set.", fileName);
     }
 
-    FILE* fin;
-    fin = fopen(fileName.c_str(),"rb");
-
-    if (fin == 0)
-        throw tgt::IOException("Unable to open raw file for reading", fileName);
-
     VolumeRAM* volume;
 
     if (h.objectModel_ == "I") {
@@ -539,7 +534,6 @@ VolumeList* RawVolumeReader::readBrick(const std::string &url, tgt::ivec3 brickS
             volume = v;
         }
         else {
-            fclose(fin);
             throw tgt::CorruptedFileException("Format '" + h.format_ + "' not supported", fileName);
         }
     }
@@ -555,7 +549,6 @@ VolumeList* RawVolumeReader::readBrick(const std::string &url, tgt::ivec3 brickS
             volume = v;
         }
         else {
-            fclose(fin);
             throw tgt::CorruptedFileException("Format '" + h.format_ + "' not supported for object model RGBA", fileName);
         }
     }
@@ -573,7 +566,6 @@ VolumeList* RawVolumeReader::readBrick(const std::string &url, tgt::ivec3 brickS
             VolumeRAM_3xFloat* v = new VolumeRAM_3xFloat(h.dimensions_);
             volume = v;
         } else {
-            fclose(fin);
             throw tgt::CorruptedFileException("Format '" + h.format_ + "' not supported for object model RGB", fileName);
         }
     }
@@ -583,46 +575,28 @@ VolumeList* RawVolumeReader::readBrick(const std::string &url, tgt::ivec3 brickS
         volume = v;
     }
     else {
-        fclose(fin);
         throw tgt::CorruptedFileException("unsupported ObjectModel '" + h.objectModel_ + "'", fileName);
     }
 
     volume->clear();
 
-    int voxelSize = static_cast<int>(volume->getBitsAllocated() / 8);
-
-    uint64_t initialSeekPos = (brickStartPos.z *(datasetDims.x*datasetDims.y)*brickSize*voxelSize )+
-        (brickStartPos.y * datasetDims.x*brickSize*voxelSize) + (brickStartPos.x*brickSize*voxelSize);
-
-    // add header skip
-    initialSeekPos += h.headerskip_;
-
-    #ifdef _MSC_VER
-        _fseeki64(fin, initialSeekPos, SEEK_SET);
-    #else
-        fseek(fin, initialSeekPos, SEEK_SET);
-    #endif
-
-        for (int i=0; i < brickSize; i++) {
-            for (int j=0; j < brickSize; j++) {
-                int volumePos = brickSize*j + (i*brickSize*brickSize);
-                volumePos = volumePos*voxelSize;
-                if (fread(reinterpret_cast<char*>(volume->getData()) + volumePos, 1, brickSize*voxelSize, fin) == 0)
-                    LWARNING("fread() failed");
-                #ifdef _MSC_VER
-                    _fseeki64(fin, (datasetDims.x - brickSize)*voxelSize, SEEK_CUR);
-                #else
-                    fseek(fin, (datasetDims.x - brickSize)*voxelSize, SEEK_CUR);
-                #endif
-            }
-            #ifdef _MSC_VER
-                _fseeki64(fin, (datasetDims.y - brickSize)*datasetDims.x*voxelSize, SEEK_CUR);
-            #else
-                fseek(fin, (datasetDims.y - brickSize)*datasetDims.x*voxelSize, SEEK_CUR);
-            #endif
+    // read the part of the brick lying within the dataset by coalesced reads
+    tgt::svec3 brickOffset = tgt::svec3(brickStartPos) * static_cast<size_t>(brickSize);
+    tgt::svec3 brickDim = volume->getDimensions();
+    if (tgt::hand(tgt::lessThan(brickOffset, tgt::svec3(datasetDims)))) {
+        brickDim = tgt::min(brickDim, tgt::svec3(datasetDims) - brickOffset);
+        try {
+            VolumeDiskRaw::readBrickFromFile(fileName, h.headerskip_, tgt::svec3(datasetDims), volume->getBytesPerVoxel(),
+                brickOffset, brickDim, volume->getData(), volume->getDimensions());
         }
-
-    fclose(fin);
+        catch (tgt::FileException&) {
+            delete volume;
+            throw;
+        }
+    }
+    else {
+        LWARNING("Brick lies outside the dataset");
+    }
 
     VolumeList* volumeList = new VolumeList();
     Volume* volumeHandle = new Volume(volume, h.spacing_, vec3(0.0f), h.transformation_);
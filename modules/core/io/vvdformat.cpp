@@ -30,13 +30,15 @@
 #include "voreen/core/datastructures/volume/histogram.h"
 #include "voreen/core/datastructures/volume/volumepreview.h"
 #include "voreen/core/datastructures/volume/volumefactory.h"
+#include "voreen/core/datastructures/volume/volumediskchunked.h"
 #include "voreen/core/datastructures/meta/primitivemetadata.h"
 
 namespace voreen {
 
-VvdRawDataObject::VvdRawDataObject(const VolumeRAM* volume, std::string filename) : filename_(filename), dimensions_(volume->getDimensions()) {
-    VolumeFactory vf;
-    format_ = vf.getFormat(volume);
+VvdRawDataObject::VvdRawDataObject(const VolumeBase* volume, std::string filename, bool chunked)
+    : filename_(filename), dimensions_(volume->getDimensions()), chunked_(chunked)
+{
+    format_ = volume->getFormat();
     if(format_ == "")
         LERRORC("voreen.VvdRawDataObject", "Format currently not supported");
 }
@@ -50,6 +52,8 @@ void VvdRawDataObject::serialize(XmlSerializer& s) const {
     s.serialize("x", x);
     s.serialize("y", y);
     s.serialize("z", z);
+    if (chunked_)
+        s.serialize("storage", std::string("chunked"));
 }
 
 void VvdRawDataObject::deserialize(XmlDeserializer& s) {
@@ -62,6 +66,15 @@ void VvdRawDataObject::deserialize(XmlDeserializer& s) {
     s.deserialize("y", y);
     s.deserialize("z", z);
     dimensions_ = tgt::ivec3(x,y,z);
+
+    std::string storage;
+    try {
+        s.deserialize("storage", storage);
+    }
+    catch (XmlSerializationNoSuchDataException& /*e*/) {
+        s.removeLastError();
+    }
+    chunked_ = (storage == "chunked");
 }
 
 //-----------------------------------------------------------------------------------------------------
@@ -74,7 +87,9 @@ VvdObject::~VvdObject() {
     //}
 }
 
-VvdObject::VvdObject(const VolumeBase* vh, std::string rawFilename) : rawData_(vh->getRepresentation<VolumeRAM>(), rawFilename) {
+VvdObject::VvdObject(const VolumeBase* vh, std::string rawFilename, bool chunked)
+    : rawData_(vh, rawFilename, chunked)
+{
     std::vector<std::string> keys = vh->getMetaDataKeys();
     for(size_t i=0; i<keys.size(); i++) {
         const MetaDataBase* md = vh->getMetaData(keys[i]);
@@ -127,9 +142,14 @@ VvdObject::VvdObject(const VolumeBase* vh, std::string rawFilename) : rawData_(v
     //TODO: removed hard-coded classes
 }
 
-Volume* VvdObject::createVolume(std::string directory) {
+Volume* VvdObject::createVolume(std::string directory)
+    throw (tgt::FileException)
+{
     VolumeRepresentation* volume;
-    volume = (VolumeRAM*) new VolumeDiskRaw(directory+"/"+rawData_.getFilename(), rawData_.getFormat(), rawData_.getDimensions());
+    if (rawData_.isChunked())
+        volume = new VolumeDiskChunked(directory+"/"+rawData_.getFilename(), rawData_.getFormat(), rawData_.getDimensions());
+    else
+        volume = (VolumeRAM*) new VolumeDiskRaw(directory+"/"+rawData_.getFilename(), rawData_.getFormat(), rawData_.getDimensions());
 
     Volume* vh = new Volume(volume, &metaData_, derivedData_);
 
@@ -36,30 +36,35 @@ namespace voreen {
 ///Helper class to save .vvd files.
 class VRN_CORE_API VvdRawDataObject : public Serializable {
 public:
-    VvdRawDataObject() {}
-    VvdRawDataObject(const VolumeRAM* volume, std::string filename);
+    VvdRawDataObject() : chunked_(false) {}
+    VvdRawDataObject(const VolumeBase* volume, std::string filename, bool chunked = false);
 
     tgt::ivec3 getDimensions() { return dimensions_; }
     std::string getFilename() { return filename_; }
     std::string getFormat() { return format_; }
 
+    /// Returns true, if the data file is a chunk file (@see VolumeDiskChunked) instead of a flat raw file.
+    bool isChunked() { return chunked_; }
+
     virtual void serialize(XmlSerializer& s) const;
     virtual void deserialize(XmlDeserializer& s);
 private:
     std::string filename_;
     tgt::ivec3 dimensions_;
     std::string format_;
+    bool chunked_;
 };
 
 ///Helper class to save .vvd files.
 class VRN_CORE_API VvdObject : public Serializable {
 public:
     VvdObject() {}
-    VvdObject(const VolumeBase* vh, std::string rawFilename);
+    VvdObject(const VolumeBase* vh, std::string rawFilename, bool chunked = false);
     ~VvdObject();
 
     ///Because the filename is relative to the vvd file we need the directory
-    Volume* createVolume(std::string directory);
+    Volume* createVolume(std::string directory)
+        throw (tgt::FileException);
 
     virtual void serialize(XmlSerializer& s) const;
     virtual void deserialize(XmlDeserializer& s);
@@ -28,6 +28,7 @@
 
 #include "voreen/core/datastructures/volume/volumeatomic.h"
 #include "voreen/core/datastructures/volume/volume.h"
+#include "voreen/core/datastructures/volume/volumediskchunked.h"
 
 #include "tgt/filesystem.h"
 #include "tgt/matrix.h"
@@ -36,7 +37,10 @@ namespace voreen {
 
 const std::string VvdVolumeWriter::loggerCat_("voreen.io.VvdVolumeWriter");
 
-VvdVolumeWriter::VvdVolumeWriter() {
+VvdVolumeWriter::VvdVolumeWriter()
+    : chunkDim_(tgt::svec3::zero)
+    , numLevels_(0)
+{
     extensions_.push_back("vvd");
 }
 
@@ -44,14 +48,10 @@ void VvdVolumeWriter::write(const std::string& filename, const VolumeBase* volum
     throw (tgt::IOException)
 {
     tgtAssert(volumeHandle, "No volume");
-    const VolumeRAM* volume = volumeHandle->getRepresentation<VolumeRAM>();
-    if (!volume) {
-        LWARNING("No volume");
-        return;
-    }
 
+    bool chunked = (tgt::hmul(chunkDim_) > 0);
     std::string vvdname = tgt::FileSystem::cleanupPath(filename);
-    std::string rawname = tgt::FileSystem::fullBaseName(vvdname) + ".raw";
+    std::string rawname = tgt::FileSystem::fullBaseName(vvdname) + (chunked ? ".chunks" : ".raw");
     LINFO("saving " << vvdname << " and " << rawname);
 
     // VVD: ---------------------------
@@ -59,7 +59,7 @@ void VvdVolumeWriter::write(const std::string& filename, const VolumeBase* volum
     XmlSerializer s(vvdname);
     s.setUseAttributes(true);
 
-    VvdObject o = VvdObject(volumeHandle, tgt::FileSystem::fileName(rawname));
+    VvdObject o = VvdObject(volumeHandle, tgt::FileSystem::fileName(rawname), chunked);
     std::vector<VvdObject> vec;
     vec.push_back(o);
 
@@ -100,6 +100,19 @@ void VvdVolumeWriter::write(const std::string& filename, const VolumeBase* volum
     }
     fileStream.close();
 
+    // CHUNKS: ------------------------
+    // streamed from the volume's disk representation, if it is not present in RAM
+    if (chunked) {
+        VolumeDiskChunked::writeChunkFile(rawname, volumeHandle, chunkDim_, numLevels_);
+        return;
+    }
+
+    const VolumeRAM* volume = volumeHandle->getRepresentation<VolumeRAM>();
+    if (!volume) {
+        LWARNING("No volume");
+        return;
+    }
+
     std::fstream rawout(rawname.c_str(), std::ios::out | std::ios::binary);
 
     if (!rawout.is_open() || rawout.bad())
@@ -120,4 +133,20 @@ VolumeWriter* VvdVolumeWriter::create(ProgressBar* /*progress*/) const {
     return new VvdVolumeWriter();
 }
 
+void VvdVolumeWriter::setChunkDimensions(const tgt::svec3& chunkDim) {
+    chunkDim_ = chunkDim;
+}
+
+tgt::svec3 VvdVolumeWriter::getChunkDimensions() const {
+    return chunkDim_;
+}
+
+void VvdVolumeWriter::setNumLevels(size_t numLevels) {
+    numLevels_ = numLevels;
+}
+
+size_t VvdVolumeWriter::getNumLevels() const {
+    return numLevels_;
+}
+
 } // namespace voreen
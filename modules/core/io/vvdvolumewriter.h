@@ -27,12 +27,16 @@
 #define VRN_VVDVOLUMEWRITER_H
 
 #include "voreen/core/io/volumewriter.h"
+#include "tgt/vector.h"
 #include <sstream>
 
 namespace voreen {
 
 /**
  * Writes the volume into a .vvd and a .raw file (Voreen Volume Data, new Voreen format).
+ *
+ * If chunk dimensions are set, the volume data is written into a .chunks file instead,
+ * which stores the data as compressed chunks together with a mip pyramid (@see VolumeDiskChunked).
  */
 class VRN_CORE_API VvdVolumeWriter : public VolumeWriter {
 public:
@@ -50,7 +54,25 @@ public:
      */
     virtual void write(const std::string& filename, const VolumeBase* volumeHandle)
         throw (tgt::IOException);
+
+    /**
+     * Sets the dimensions of the chunks the volume data is split into.
+     * Zero dimensions (default) select the flat .raw file.
+     */
+    void setChunkDimensions(const tgt::svec3& chunkDim);
+    tgt::svec3 getChunkDimensions() const;
+
+    /**
+     * Sets the number of resolution levels written into the chunk file.
+     * 0 (default) adds levels until the coarsest level fits into a single chunk.
+     */
+    void setNumLevels(size_t numLevels);
+    size_t getNumLevels() const;
+
 private:
+    tgt::svec3 chunkDim_;
+    size_t numLevels_;
+
     static const std::string loggerCat_;
 };
 
@@ -30,6 +30,7 @@
 #include "voreen/core/datastructures/geometry/pointlistgeometry.h"
 #include "voreen/core/datastructures/geometry/pointsegmentlistgeometry.h"
 #include "voreen/core/datastructures/geometry/trianglemeshgeometryindexed.h"
+#include "voreen/core/io/serialization/geometrybinaryserializer.h"
 
 #include "voreen/core/properties/callmemberaction.h"
 #include "tgt/filesystem.h"
@@ -58,7 +59,7 @@ GeometrySource::GeometrySource()
     calculateNormals_("calcNormals", "Calculate Normals (.ply)", false),
     outport_(Port::OUTPORT, "geometry.pointlist", "PointList Output")
 {
-    geometryType_.addOption("geometry", "Voreen Geometry (.vge)");
+    geometryType_.addOption("geometry", "Voreen Geometry (.vge, .vgb)");
     geometryType_.addOption("pointlist", "Pointlist");
     geometryType_.addOption("segmentlist", "Segmented Pointlist");
 
@@ -112,6 +113,16 @@ void GeometrySource::readGeometry() {
                 LERROR(e.what());
             }
         }
+        else if (GeometryBinarySerializer::isBinaryGeometryFile(filename)) {
+            try {
+                Geometry* geometry = GeometryBinaryDeserializer::readGeometry(filename);
+                tgtAssert(geometry, "null pointer returned (exception expected)");
+                outport_.setData(geometry);
+            }
+            catch (VoreenException& e) {
+                LERROR(e.what());
+            }
+        }
         else {
             try {
                 Geometry* geometry = readVoreenGeometry(geometryFile_.get());
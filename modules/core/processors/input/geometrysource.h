@@ -50,7 +50,7 @@ public:
 
 protected:
     virtual void setDescriptions() {
-        setDescription("Loads a serialized Voreen Geometry (.vge), a point list or a segmented point list from a file. \
+        setDescription("Loads a serialized Voreen Geometry (.vge or binary .vgb), a point list or a segmented point list from a file. \
 \
 <p>In point lists, each point is expected to consist of three components that are separated by white space.\
 For a segmented point list, each point is expected to be followed by a numeric segment identifier. The segments have to be listed in ascending order. Additionally, the number of items that are to be skipped after each point can be specified.</p>");
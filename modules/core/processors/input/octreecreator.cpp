@@ -28,6 +28,7 @@
 #include "voreen/core/datastructures/octree/volumeoctree.h"
 #include "voreen/core/datastructures/octree/octreebrickpoolmanager.h"
 #include "voreen/core/datastructures/octree/octreebrickpoolmanagerdisk.h"
+#include "voreen/core/datastructures/octree/octreebrickpoolmanagermmap.h"
 #include "voreen/core/datastructures/octree/octreeutils.h"
 
 #include "voreen/core/voreenapplication.h"
@@ -129,6 +130,8 @@ OctreeCreator::OctreeCreator()
     , useRelativeThreshold_("useRelativeThreshold", "Relative Threshold", true)
     , brickPoolManager_("brickPoolManager", "Brick Pool Manager")
     , singleBufferMemorySize_("singleBufferMemorySize", "Page File Size (MB)", 32, 1, 256)
+    , cachePolicy_("cachePolicy", "Page Cache Policy")
+    , compressBricks_("compressBricks", "Compress Page Files", true)
     , numThreads_("numThreads", "Num Threads", 8, 1, 16, VALID)
     , clearOctree_("clearOctree", "Clear Octree")
     , forceGenerate_(false)
@@ -174,12 +177,21 @@ OctreeCreator::OctreeCreator()
 
     brickPoolManager_.addOption("brickPoolManagerRAM",  "RAM (non-persistent)");
     brickPoolManager_.addOption("brickPoolManagerDisk", "Disk");
+    brickPoolManager_.addOption("brickPoolManagerMmap", "Disk (memory-mapped)");
     brickPoolManager_.select("brickPoolManagerDisk");
     addProperty(brickPoolManager_);
     brickPoolManager_.onChange(CallMemberAction<OctreeCreator>(this, &OctreeCreator::updatePropertyConfiguration));
     addProperty(singleBufferMemorySize_);
+    cachePolicy_.addOption("clock", "CLOCK");
+    cachePolicy_.addOption("2q",    "2Q (scan-resistant)");
+    cachePolicy_.addOption("arc",   "ARC (adaptive)");
+    cachePolicy_.select("2q");
+    addProperty(cachePolicy_);
+    addProperty(compressBricks_);
     brickPoolManager_.setGroupID("configuration");
     singleBufferMemorySize_.setGroupID("configuration");
+    cachePolicy_.setGroupID("configuration");
+    compressBricks_.setGroupID("configuration");
     numThreads_.setGroupID("configuration");
     addProperty(numThreads_);
     setPropertyGroupGuiName("configuration", "Octree Configuration");
@@ -285,11 +297,12 @@ void OctreeCreator::process() {
     if (octree) {
         currentConfigurationHash_ = configHash;
 
-        // assign RAM limit
+        // assign RAM limit and cache policy
         size_t ramLimit = VoreenApplication::app()->getCpuRamLimit();
         if (const OctreeBrickPoolManagerDisk* brickPoolManager =
             dynamic_cast<const OctreeBrickPoolManagerDisk*>(static_cast<VolumeOctree*>(octree)->getBrickPoolManager())) {
                 const_cast<OctreeBrickPoolManagerDisk*>(brickPoolManager)->setRAMLimit(ramLimit);
+                const_cast<OctreeBrickPoolManagerDisk*>(brickPoolManager)->setCachePolicy(cachePolicy_.get());
         }
 
         octree->logDescription();
@@ -384,8 +397,17 @@ VolumeOctreeBase* OctreeCreator::generateOctree() throw (VoreenException) {
         std::string brickPoolPath = tgt::FileSystem::cleanupPath(getOctreeStoragePath() + "/" + BRICK_BUFFER_SUBDIR);
         if (!tgt::FileSystem::dirExists(brickPoolPath))
             tgt::FileSystem::createDirectoryRecursive(brickPoolPath);
-        brickPoolManager = new OctreeBrickPoolManagerDisk(static_cast<size_t>(singleBufferMemorySize_.get()) << 20,
+        OctreeBrickPoolManagerDisk* brickPoolManagerDisk = new OctreeBrickPoolManagerDisk(static_cast<size_t>(singleBufferMemorySize_.get()) << 20,
             VoreenApplication::app()->getCpuRamLimit(), brickPoolPath, BRICK_BUFFER_FILE_PREFIX);
+        brickPoolManagerDisk->setBrickCompression(compressBricks_.get());
+        brickPoolManager = brickPoolManagerDisk;
+    }
+    else if (brickPoolManager_.isSelected("brickPoolManagerMmap")) {
+        std::string brickPoolPath = tgt::FileSystem::cleanupPath(getOctreeStoragePath() + "/" + BRICK_BUFFER_SUBDIR);
+        if (!tgt::FileSystem::dirExists(brickPoolPath))
+            tgt::FileSystem::createDirectoryRecursive(brickPoolPath);
+        brickPoolManager = new OctreeBrickPoolManagerMmap(static_cast<size_t>(singleBufferMemorySize_.get()) << 20,
+            brickPoolPath, BRICK_BUFFER_FILE_PREFIX);
     }
     else {
         throw VoreenException("Unknown brick pool manager: " + brickPoolManager_.get());
@@ -600,6 +622,7 @@ std::string OctreeCreator::getConfigurationHash() const {
     propertyMap[useRelativeThreshold_.getID()] = &useRelativeThreshold_;
     propertyMap[brickPoolManager_.getID()] = &brickPoolManager_;
     propertyMap[singleBufferMemorySize_.getID()] = &singleBufferMemorySize_;
+    propertyMap[compressBricks_.getID()] = &compressBricks_;
 
     XmlSerializer s;
     const bool usePointerContentSerialization = s.getUsePointerContentSerialization();
@@ -628,6 +651,8 @@ void OctreeCreator::updatePropertyConfiguration() {
     //generateOctreeButton_.setWidgetsEnabled(!autogenerateOctree_.get());
 
     treeDepth_.setWidgetsEnabled(brickDimensions_.isSelected("treeDepth"));
+    cachePolicy_.setWidgetsEnabled(brickPoolManager_.isSelected("brickPoolManagerDisk"));
+    compressBricks_.setWidgetsEnabled(brickPoolManager_.isSelected("brickPoolManagerDisk"));
 
     if (volumeInport_.hasData()) {
         tgt::svec3 volumeDim = volumeInport_.getData()->getDimensions();
@@ -117,6 +117,8 @@ private:
 
     StringOptionProperty brickPoolManager_;
     IntProperty singleBufferMemorySize_;
+    StringOptionProperty cachePolicy_;
+    BoolProperty compressBricks_;
 
     IntProperty numThreads_;
 
@@ -25,6 +25,8 @@
 
 #include "geometrysave.h"
 
+#include "voreen/core/io/serialization/geometrybinaryserializer.h"
+
 #include <fstream>
 
 namespace voreen {
@@ -35,7 +37,7 @@ GeometrySave::GeometrySave()
     : Processor()
     ,  inport_(Port::INPORT, "inport", "Geometry Input")
     ,  fileProp_("file", "Geometry File", "Select Voreen geometry file...", "./",
-            "Voreen Geometry files (*.vge)", FileDialogProperty::SAVE_FILE, Processor::INVALID_PATH)
+            "Voreen Geometry files (*.vge);;Voreen Binary Geometry files (*.vgb)", FileDialogProperty::SAVE_FILE, Processor::INVALID_PATH)
     ,  saveButton_("save", "Save")
     ,  continousSave_("continousSave", "Save continuously", false)
 {
@@ -74,6 +76,18 @@ void GeometrySave::saveFile() {
         return;
     }
 
+    // large meshes are written to the binary format, which is much faster to read and write than XML
+    if (GeometryBinarySerializer::isBinaryGeometryFile(filename)) {
+        LINFO("Saving binary Voreen Geometry to file: " << filename);
+        try {
+            GeometryBinarySerializer::writeGeometry(geometry, filename);
+        }
+        catch (SerializationException& e) {
+            LERROR("Failed to save binary geometry: " << e.what());
+        }
+        return;
+    }
+
     LINFO("Saving Voreen Geometry to file: " << filename);
 
     XmlSerializer s;
@@ -50,7 +50,7 @@ public:
 
 protected:
     virtual void setDescriptions() {
-        setDescription("Writes the input geometry to a Voreen Geometry file (.vge).");
+        setDescription("Writes the input geometry to a Voreen Geometry file (.vge). Triangle meshes and point lists can also be written to the binary Voreen Geometry format (.vgb), which is considerably smaller and faster to load for large geometries. The format is chosen by the file extension.");
     }
 
     virtual void process();
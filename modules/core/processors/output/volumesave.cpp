@@ -28,6 +28,9 @@
 #include "voreen/core/io/volumeserializerpopulator.h"
 #include "voreen/core/io/volumewriter.h"
 #include "voreen/core/utils/stringutils.h"
+#include "modules/core/io/vvdvolumewriter.h"
+
+#include "tgt/filesystem.h"
 
 namespace voreen {
 
@@ -42,6 +45,8 @@ VolumeSave::VolumeSave()
     , saveOnPathChange_("saveOnPathChange","Save on path change",true)
     , continousSave_("continousSave", "Save on inport change", false)
     , volumeInfo_("volumeInfo","info")
+    , chunkSize_("chunkSize", "Chunk Size (0: raw file)", 0, 0, 1024, Processor::VALID)
+    , numLevels_("numLevels", "Resolution Levels (0: auto)", 0, 0, 16, Processor::VALID)
     , saveVolume_(false)
     , volSerializerPopulator_(0)
 {
@@ -54,6 +59,8 @@ VolumeSave::VolumeSave()
     addProperty(saveOnPathChange_);
     addProperty(continousSave_);
     addProperty(volumeInfo_);
+    addProperty(chunkSize_);
+    addProperty(numLevels_);
 }
 
 VolumeSave::~VolumeSave() {
@@ -113,9 +120,17 @@ void VolumeSave::saveVolume() {
     }
 
     try {
-        tgtAssert(volSerializerPopulator_, "VolumeSerializerPopulator not instantiated");
-        tgtAssert(volSerializerPopulator_->getVolumeSerializer(), "no VolumeSerializer");
-        volSerializerPopulator_->getVolumeSerializer()->write(filename_.get(), inport_.getData());
+        if (chunkSize_.get() > 0 && tgt::FileSystem::fileExtension(filename_.get(), true) == "vvd") {
+            VvdVolumeWriter writer;
+            writer.setChunkDimensions(tgt::svec3(static_cast<size_t>(chunkSize_.get())));
+            writer.setNumLevels(static_cast<size_t>(numLevels_.get()));
+            writer.write(filename_.get(), inport_.getData());
+        }
+        else {
+            tgtAssert(volSerializerPopulator_, "VolumeSerializerPopulator not instantiated");
+            tgtAssert(volSerializerPopulator_->getVolumeSerializer(), "no VolumeSerializer");
+            volSerializerPopulator_->getVolumeSerializer()->write(filename_.get(), inport_.getData());
+        }
     }
     catch(tgt::FileException e) {
         LERROR(e.what());
@@ -31,6 +31,7 @@
 
 #include "voreen/core/properties/filedialogproperty.h"
 #include "voreen/core/properties/boolproperty.h"
+#include "voreen/core/properties/intproperty.h"
 #include "voreen/core/properties/buttonproperty.h"
 #include "voreen/core/properties/volumeinfoproperty.h"
 
@@ -55,7 +56,9 @@ public:
 
 protected:
     virtual void setDescriptions() {
-        setDescription("Saves a volume to disk.");
+        setDescription("Saves a volume to disk. <p>If a chunk size is set, .vvd files store the volume data as compressed chunks "
+                       "together with a mip pyramid of the given number of resolution levels (0: until the coarsest level fits into a single chunk). "
+                       "The chunks are streamed from disk, if the volume is not present in main memory.</p>");
     }
 
     virtual void process();
@@ -73,6 +76,8 @@ private:
     BoolProperty saveOnPathChange_;
     BoolProperty continousSave_;
     VolumeInfoProperty volumeInfo_;
+    IntProperty chunkSize_;         ///< edge length of the chunks of a .vvd file, 0 for a flat .raw file
+    IntProperty numLevels_;         ///< number of resolution levels of a chunked .vvd file, 0 for automatic
 
     bool saveVolume_;
 
@@ -113,7 +113,16 @@ T* StreamlineTexture<T>::integrateDraw(const Flow2D& flow, const size_t textureS
 
     size_t numStreamlines = 0;
 
+    std::vector<tgt::ivec2> seedPositions;
+    std::vector<tgt::ivec2> seedErrors;
+    std::vector<tgt::vec2> seeds;
+    StreamlineList<tgt::vec2> streamlines;
     for (int y = 0; y < outputTexSize.y; y += delta) {
+        // trace the streamlines of all seeds within this row at once
+        //
+        seedPositions.clear();
+        seedErrors.clear();
+        seeds.clear();
         for (int x = 0; x < outputTexSize.x; x += delta) {
             tgt::ivec2 ir0(x, y);
             if (outputTexture[ir0].counter_ > 0)
@@ -124,9 +133,17 @@ T* StreamlineTexture<T>::integrateDraw(const Flow2D& flow, const size_t textureS
             if (flow.lookupFlow(r0) == tgt::vec2::zero)
                 continue;
 
-            std::deque<tgt::vec2> streamline =
-                FlowMath::computeStreamlineRungeKutta(flow, r0, length, stepSize, 0, thresholds);
-            if (streamline.size() <= 1)
+            seedPositions.push_back(ir0);
+            seedErrors.push_back(error);
+            seeds.push_back(r0);
+        }   // for (x
+        FlowMath::computeStreamlines(flow, seeds, streamlines, length, stepSize, thresholds);
+
+        // draw them in seeding order, skipping seeds already hit by a preceding streamline
+        //
+        for (size_t n = 0; n < seeds.size(); ++n) {
+            const size_t numVertices = streamlines.getNumVertices(n);
+            if ((outputTexture[seedPositions[n]].counter_ > 0) || (numVertices <= 1))
                 continue;
 
             ++numStreamlines;
@@ -135,16 +152,12 @@ T* StreamlineTexture<T>::integrateDraw(const Flow2D& flow, const size_t textureS
             if (typeid(T) == typeid(unsigned char))
                 gray = T(uniRand * 255.0f);
 
-            std::deque<tgt::ivec2> streamlineVP =
-                flow.flowPosToSlicePos(streamline, outputTexSize, error);
-
-            for (std::deque<tgt::ivec2>::const_iterator it = streamlineVP.begin();
-                it != streamlineVP.end(); ++it)
-            {
-                const tgt::ivec2& p = *it;
+            const tgt::vec2* streamline = streamlines.getVertices(n);
+            for (size_t k = 0; k < numVertices; ++k) {
+                const tgt::ivec2 p = flow.flowPosToSlicePos(streamline[k], outputTexSize, seedErrors[n]);
                 outputTexture[p].elem_ += static_cast<unsigned char>((++(outputTexture[p].counter_) * gray));
-            }   // for (it
-        }   // for (x
+            }   // for (k
+        }   // for (n
     }   // for (y
 
     size_t unhitPixels = 0;
@@ -175,8 +188,17 @@ T* StreamlineTexture<T>::integrateDraw(const Flow3D& flow, const size_t textureS
 
     size_t numStreamlines = 0;
 
+    std::vector<tgt::ivec3> seedPositions;
+    std::vector<tgt::ivec3> seedErrors;
+    std::vector<tgt::vec3> seeds;
+    StreamlineList<tgt::vec3> streamlines;
     for (int z = 0; z < outputTexSize.z; z += delta) {
         for (int y = 0; y < outputTexSize.y; y += delta) {
+            // trace the streamlines of all seeds within this row at once
+            //
+            seedPositions.clear();
+            seedErrors.clear();
+            seeds.clear();
             for (int x = 0; x < outputTexSize.x; x += delta) {
                 tgt::ivec3 ir0(x, y, z);
                 if (outputTexture[ir0].counter_ > 0)
@@ -187,9 +209,17 @@ T* StreamlineTexture<T>::integrateDraw(const Flow3D& flow, const size_t textureS
                 if (flow.lookupFlow(r0) == tgt::vec3::zero)
                     continue;
 
-                std::deque<tgt::vec3> streamline =
-                    FlowMath::computeStreamlineRungeKutta(flow, r0, length, stepSize, 0, thresholds);
-                if (streamline.size() <= 1)
+                seedPositions.push_back(ir0);
+                seedErrors.push_back(error);
+                seeds.push_back(r0);
+            }   // for (x
+            FlowMath::computeStreamlines(flow, seeds, streamlines, length, stepSize, thresholds);
+
+            // draw them in seeding order, skipping seeds already hit by a preceding streamline
+            //
+            for (size_t n = 0; n < seeds.size(); ++n) {
+                const size_t numVertices = streamlines.getNumVertices(n);
+                if ((outputTexture[seedPositions[n]].counter_ > 0) || (numVertices <= 1))
                     continue;
 
                 ++numStreamlines;
@@ -198,16 +228,12 @@ T* StreamlineTexture<T>::integrateDraw(const Flow3D& flow, const size_t textureS
                 if (typeid(T) == typeid(unsigned char))
                     gray = T(uniRand * 255.0f);
 
-                std::deque<tgt::ivec3> streamlineTexture =
-                    flow.toTexturePosition(streamline, outputTexSize, error);
-
-                for (std::deque<tgt::ivec3>::const_iterator it = streamlineTexture.begin();
-                    it != streamlineTexture.end(); ++it)
-                {
-                    const tgt::ivec3& p = *it;
+                const tgt::vec3* streamline = streamlines.getVertices(n);
+                for (size_t k = 0; k < numVertices; ++k) {
+                    const tgt::ivec3 p = flow.toTexturePosition(streamline[k], outputTexSize, seedErrors[n]);
                     outputTexture[p].elem_ += static_cast<unsigned char>(++(outputTexture[p].counter_) * gray);
-                }   // for (it
-            }   // for (x
+                }   // for (k
+            }   // for (n
         }   // for (y
     } // for (z
 
@@ -249,7 +275,19 @@ T* StreamlineTexture<T>::fastLIC(const Flow2D& flow, const SimpleTexture<float>&
     const float length = static_cast<float>(tgt::max(flow.dimensions_)) * 1.10f;
 
     size_t numStreamlines = 0;
+
+    std::vector<tgt::ivec2> seedPositions;
+    std::vector<tgt::ivec2> seedErrors;
+    std::vector<tgt::vec2> seeds;
+    StreamlineList<tgt::vec2> streamlines;
+    std::vector<tgt::ivec2> streamlineInput;
+    std::vector<tgt::ivec2> streamlineOutput;
     for (int y = 0; y < outputTexSize.y; y += delta) {
+        // trace the streamlines of all seeds within this row at once
+        //
+        seedPositions.clear();
+        seedErrors.clear();
+        seeds.clear();
         for (int x = 0; x < outputTexSize.x; x += delta) {
             tgt::ivec2 ir0(x, y);
             if (outputTexture[ir0].counter_ > 0)
@@ -262,17 +300,19 @@ T* StreamlineTexture<T>::fastLIC(const Flow2D& flow, const SimpleTexture<float>&
             tgt::ivec2 r0Input(ir0 / static_cast<int>(textureScaling));
             tgt::ivec2 errorInput(0, 0);
             tgt::vec2 r0 = flow.slicePosToFlowPos(r0Input, inputTexSize, &errorInput);
-            const tgt::vec2 v = flow.lookupFlow(r0);
-
-            if (v == tgt::vec2::zero)
+            if (flow.lookupFlow(r0) == tgt::vec2::zero)
                 continue;
 
-            // start streamline computation
-            //
-            int indexR0 = 0;
-            std::deque<tgt::vec2> streamlineD =
-                FlowMath::computeStreamlineRungeKutta(flow, r0, length, stepSize, &indexR0, thresholds);
-            if (streamlineD.size() <= 1)
+            seedPositions.push_back(ir0);
+            seedErrors.push_back(errorInput);
+            seeds.push_back(r0);
+        }   // for (x
+        FlowMath::computeStreamlines(flow, seeds, streamlines, length, stepSize, thresholds);
+
+        for (size_t n = 0; n < seeds.size(); ++n) {
+            const tgt::ivec2& ir0 = seedPositions[n];
+            const int numPoints = static_cast<int>(streamlines.getNumVertices(n));
+            if ((outputTexture[ir0].counter_ > 0) || (numPoints <= 1))
                 continue;
 
             // also determine the round-off error which occurs if the flow positions was
@@ -282,21 +322,19 @@ T* StreamlineTexture<T>::fastLIC(const Flow2D& flow, const SimpleTexture<float>&
             flow.slicePosToFlowPos(ir0, outputTexSize, &errorOutput);
 
             ++numStreamlines;
-            std::vector<tgt::vec2> streamline = FlowMath::dequeToVector(streamlineD);
+            const int indexR0 = static_cast<int>(streamlines.seedIndices_[n]);
+            const tgt::vec2 v = flow.lookupFlow(seeds[n]);
 
-            // copy the streamline for second coordinate conversion
+            // convert the streamline into dimensions of the input texture and
+            // of the output texture
             //
-            std::vector<tgt::vec2> streamlineCopy(streamline);
-
-            // convert the streamline into dimensions of the input texture
-            //
-            std::vector<tgt::ivec2> streamlineInput =
-                flow.flowPosToSlicePos(streamline, inputTexSize, errorInput);
-
-            // also convert the streamline into dimensions of the output texture
-            //
-            std::vector<tgt::ivec2> streamlineOutput =
-                flow.flowPosToSlicePos(streamlineCopy, outputTexSize, errorOutput);
+            const tgt::vec2* streamline = streamlines.getVertices(n);
+            streamlineInput.resize(numPoints);
+            streamlineOutput.resize(numPoints);
+            for (int i = 0; i < numPoints; ++i) {
+                streamlineInput[i] = flow.flowPosToSlicePos(streamline[i], inputTexSize, seedErrors[n]);
+                streamlineOutput[i] = flow.flowPosToSlicePos(streamline[i], outputTexSize, errorOutput);
+            }
 
             // calculate initial intensity for the starting pixel
             //
@@ -309,7 +347,7 @@ T* StreamlineTexture<T>::fastLIC(const Flow2D& flow, const SimpleTexture<float>&
             // determine the affected pixel in the output texture and add the
             // initial intensity
             //
-            tgt::ivec2& outputTexCoord = streamlineOutput[indexR0];
+            tgt::ivec2 outputTexCoord = streamlineOutput[indexR0];
             outputTexture[outputTexCoord].elem_ += T(intensity0);
             ++(outputTexture[outputTexCoord].counter_);
 
@@ -318,7 +356,6 @@ T* StreamlineTexture<T>::fastLIC(const Flow2D& flow, const SimpleTexture<float>&
             float intensity = intensity0;
             int left = indexR0 + L + 1;
             int right = indexR0 - L;
-            const int numPoints = static_cast<int>(streamlineInput.size());
 
             for (int i = (indexR0 + 1); i < numPoints; ++i, ++left, ++right) {
                 int l = (left >= numPoints) ? (numPoints - 1) : left;
@@ -346,7 +383,7 @@ T* StreamlineTexture<T>::fastLIC(const Flow2D& flow, const SimpleTexture<float>&
                 outputTexture[outputTexCoord].elem_ += T(intensity);
                 ++(outputTexture[outputTexCoord].counter_);
             }   // for (i
-        }   // for (x
+        }   // for (n
     }   // for (y
 
     size_t unhitPixels = 0;
@@ -33,6 +33,10 @@
 
 #include <limits>
 
+#ifdef VRN_MODULE_OPENMP
+#include "omp.h"
+#endif
+
 namespace voreen {
 
 const std::string PathlineRenderer3D::loggerCat_("Processor.PathlineRenderer3D");
@@ -418,15 +422,12 @@ void PathlineRenderer3D::initPathlines(const size_t numPoints)
     if (numPathlines_ == 0)
         return;
 
-    const float deltaT = integrationStepProp_.get();
     tgt::vec3 dim = static_cast<tgt::vec3>(flowDimensions_);
     pathlines_ = new std::vector<tgt::vec3>[numPathlines_];
-    float length = 0.0f;
-    for (size_t i = 0; i < numPathlines_; ++i) {
-        tgt::vec3 r0 = FlowMath::uniformRandomVec3() * dim;
-        pathlines_[i] = FlowMath::computePathline(flows_, r0, deltaT, &length);
-        applyThresholds(pathlines_[i], length);
-    }
+    std::vector<tgt::vec3> seeds(numPathlines_);
+    for (size_t i = 0; i < numPathlines_; ++i)
+        seeds[i] = FlowMath::uniformRandomVec3() * dim;
+    computePathlines(seeds);
 }
 
 void PathlineRenderer3D::initPathlinesGrid(const size_t spacing)
@@ -442,8 +443,8 @@ void PathlineRenderer3D::initPathlinesGrid(const size_t spacing)
     if (numPathlines_ == 0)
         return;
 
-    const float deltaT = integrationStepProp_.get();
     pathlines_ = new std::vector<tgt::vec3>[numPathlines_];
+    std::vector<tgt::vec3> seeds(numPathlines_);
     for (size_t z = 0; z < grid.z; ++z) {
         float fz = static_cast<float>(z * spacing);
         for (size_t y = 0; y < grid.y; ++y) {
@@ -452,12 +453,11 @@ void PathlineRenderer3D::initPathlinesGrid(const size_t spacing)
                 float fx = static_cast<float>(x * spacing);
                 tgt::vec3 pos(fx, fy, fz);
                 size_t n = z * (grid.x * grid.y) + y * (grid.x) + x;
-                float length = 0.0f;
-                pathlines_[n] = FlowMath::computePathline(flows_, pos, deltaT, &length);
-                applyThresholds(pathlines_[n], length);
+                seeds[n] = pos;
             }   // for (x
         }   // for (y
     }   // for (z
+    computePathlines(seeds);
 }
 
 void PathlineRenderer3D::initPathlinesSliceGrid(const size_t spacing)
@@ -482,7 +482,7 @@ void PathlineRenderer3D::initPathlinesSliceGrid(const size_t spacing)
 
     pathlines_ = new std::vector<tgt::vec3>[numPathlines_];
 
-    const float deltaT = integrationStepProp_.get();
+    std::vector<tgt::vec3> seeds(numPathlines_);
     float fx = 0.0f, fy = 0.0f, fz = 0.0f;
     size_t n = 0;
     if ((slicePositions_.x >= 0) && (seedOnYZSliceProp_.get() == true)) {
@@ -491,10 +491,7 @@ void PathlineRenderer3D::initPathlinesSliceGrid(const size_t spacing)
             fz = static_cast<float>(z * spacing);
             for (size_t y = 0; y < grid.y; ++y, ++n) {
                 fy = static_cast<float>(y * spacing);
-                tgt::vec3 pos(fx, fy, fz);
-                float length = 0.0f;
-                pathlines_[n] = FlowMath::computePathline(flows_, pos, deltaT, &length);
-                applyThresholds(pathlines_[n], length);
+                seeds[n] = tgt::vec3(fx, fy, fz);
             }   // for (y
         }   // for (z
     }
@@ -505,10 +502,7 @@ void PathlineRenderer3D::initPathlinesSliceGrid(const size_t spacing)
             fz = static_cast<float>(z * spacing);
             for (size_t x = 0; x < grid.x; ++x, ++n) {
                 fx = static_cast<float>(x * spacing);
-                tgt::vec3 pos(fx, fy, fz);
-                float length = 0.0f;
-                pathlines_[n] = FlowMath::computePathline(flows_, pos, deltaT, &length);
-                applyThresholds(pathlines_[n], length);
+                seeds[n] = tgt::vec3(fx, fy, fz);
             }   // for (x
         }   // for (z
     }
@@ -519,13 +513,29 @@ void PathlineRenderer3D::initPathlinesSliceGrid(const size_t spacing)
             fy = static_cast<float>(y * spacing);
             for (size_t x = 0; x < grid.x; ++x, ++n) {
                 fx = static_cast<float>(x * spacing);
-                tgt::vec3 pos(fx, fy, fz);
-                float length = 0.0f;
-                pathlines_[n] = FlowMath::computePathline(flows_, pos, deltaT, &length);
-                applyThresholds(pathlines_[n], length);
+                seeds[n] = tgt::vec3(fx, fy, fz);
             }   // for (x
         }   // for (y
     }
+    computePathlines(seeds);
+}
+
+void PathlineRenderer3D::computePathlines(const std::vector<tgt::vec3>& seeds) {
+    // make sure the RAM representations of the intensity masks exist before
+    // they are accessed concurrently by applyThresholds()
+    for (size_t i = 0; i < intensityMasks_.size(); ++i)
+        intensityMasks_[i]->getRepresentation<VolumeRAM>();
+
+    const float deltaT = integrationStepProp_.get();
+    const int numSeeds = static_cast<int>(seeds.size());
+#ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for (int i = 0; i < numSeeds; ++i) {
+        float length = 0.0f;
+        pathlines_[i] = FlowMath::computePathline(flows_, seeds[i], deltaT, &length);
+        applyThresholds(pathlines_[i], length);
+    }
 }
 
 void PathlineRenderer3D::adjustTimestepProperty() {
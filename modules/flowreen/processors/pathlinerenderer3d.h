@@ -88,6 +88,13 @@ private:
     void initPathlines(const size_t numPoints);
     void initPathlinesGrid(const size_t spacing);
     void initPathlinesSliceGrid(const size_t spacing);
+
+    /**
+     * Computes the pathlines starting at the given seeds and stores them in
+     * pathlines_, which must provide space for seeds.size() lines. The pathlines
+     * are integrated in parallel if the OpenMP module is enabled.
+     */
+    void computePathlines(const std::vector<tgt::vec3>& seeds);
     void onIntensityChange();
     void onLineStyleChange();
     void onSeedingStrategyChange();
@@ -230,50 +230,68 @@ void StreamlineRenderer3D::buildDisplayLists(const Flow3D& flow, const tgt::vec2
         glDeleteLists(displayLists_, static_cast<GLsizei>(numStreamlines_));
 
     displayLists_ = glGenLists(static_cast<GLsizei>(numStreamlines_));
-    GLuint i = 0;
+
+    // All streamlines without a display list are traced at once. In case of flow at the
+    // seeding position being zero or with its magnitude not fitting into the range defined
+    // by thresholds, the random position leads to no useful streamline so that another
+    // position is taken for the next round.
+    //
+    std::vector<GLuint> pending;
+    for (GLuint i = 0; i < numStreamlines_; ++i)
+        pending.push_back(i);
+
+    std::vector<size_t> validSeeds;
     size_t numTries = 0;
     const size_t maxNumTries = numStreamlines_ * 5; // HACK: tries per streamline
-    for (; ((i < numStreamlines_) && (numTries < maxNumTries)); ++numTries) {
-        const tgt::vec3& r0 = seedingPositions_[i];
-
-        // in case of flow at r0 being zero or with its magnitude not fitting
-        // into the range defined by thresholds, the random position leads to no
-        // useful streamline so that another position has to be taken
-        //
-        std::deque<tgt::vec3> streamlineDeque =
-            FlowMath::computeStreamlineRungeKutta(flow, r0, integrationLength, stepwidth, 0, thresholds);
-
-        if (streamlineDeque.size() <= 1) {
-            seedingPositions_[i] = reseedPosition(dim, i);
-            continue;
+    std::vector<tgt::vec3> seeds;
+    StreamlineList<tgt::vec3> streamlines;
+    while ((pending.empty() == false) && (numTries < maxNumTries)) {
+        if (pending.size() > (maxNumTries - numTries))
+            pending.resize(maxNumTries - numTries);
+
+        seeds.clear();
+        for (size_t n = 0; n < pending.size(); ++n)
+            seeds.push_back(seedingPositions_[pending[n]]);
+        FlowMath::computeStreamlines(flow, seeds, streamlines, integrationLength, stepwidth, thresholds);
+        numTries += pending.size();
+
+        std::vector<GLuint> failed;
+        for (size_t n = 0; n < pending.size(); ++n) {
+            const size_t numVertices = streamlines.getNumVertices(n);
+            if (numVertices <= 1) {
+                failed.push_back(pending[n]);
+                continue;
+            }
+
+            const tgt::vec3* vertices = streamlines.getVertices(n);
+            std::vector<tgt::vec3> streamline(vertices, vertices + numVertices);
+
+            glNewList(displayLists_ + pending[n], GL_COMPILE);
+            switch (currentStyle_) {
+                case STYLE_LINES:
+                    renderStreamlineLines(streamline, flow);
+                    break;
+                case STYLE_TUBES:
+                    renderStreamlineTubes(streamline);
+                    break;
+                case STYLE_ARROWS:
+                    renderStreamlineArrows(streamline);
+                    break;
+                default:
+                    break;
+            }
+            glEndList();
+            validSeeds.push_back(pending[n]);
         }
 
-        std::vector<tgt::vec3> streamline = FlowMath::dequeToVector(streamlineDeque);
-
-        glNewList(displayLists_ + i, GL_COMPILE);
-        //glColor4fv(fancyColors_[i % NUM_COLORS].elem);
-
-        switch (currentStyle_) {
-            case STYLE_LINES:
-                renderStreamlineLines(streamline, flow);
-                break;
-            case STYLE_TUBES:
-                renderStreamlineTubes(streamline);
-                break;
-            case STYLE_ARROWS:
-                renderStreamlineArrows(streamline);
-                break;
-            default:
-                break;
-        }
-
-        glEndList();
-        streamline.clear();
-        ++i;
-    }   // for (i
+        // reseed the failed streamlines, preferably close to valid seeding positions
+        for (size_t n = 0; n < failed.size(); ++n)
+            seedingPositions_[failed[n]] = reseedPosition(dim, validSeeds);
+        pending.swap(failed);
+    }
 
-    if (numTries >= maxNumTries) {
-        LINFO("Only " << i << " streamlines could be created from valid random seeding positions. \
+    if (validSeeds.size() < numStreamlines_) {
+        LINFO("Only " << validSeeds.size() << " streamlines could be created from valid random seeding positions. \
 Giving up after " << numTries << " tries.\n");
     }
 
@@ -446,7 +464,7 @@ void StreamlineRenderer3D::renderStreamlineTubes(const std::vector<tgt::vec3>& s
 }
 
 tgt::vec3 StreamlineRenderer3D::reseedPosition(const tgt::vec3& flowDimensions,
-                                               const size_t validPositions)
+                                               const std::vector<size_t>& validSeeds)
 {
     tgt::vec3 randVec = FlowMath::uniformRandomVec3();
 
@@ -456,7 +474,7 @@ tgt::vec3 StreamlineRenderer3D::reseedPosition(const tgt::vec3& flowDimensions,
     // seem be prone to cluster at single location.
     //
     int die = rand() % 6;
-    if ((die < 3) || (validPositions <= 1) || (seedingPositions_ == 0))
+    if ((die < 3) || (validSeeds.size() <= 1) || (seedingPositions_ == 0))
         return randVec * flowDimensions;
 
     // if there are already random positions which lead to a vector-field value not being
@@ -464,7 +482,7 @@ tgt::vec3 StreamlineRenderer3D::reseedPosition(const tgt::vec3& flowDimensions,
     // position to generate another.
     // Use the position and add some random offset to it.
     //
-    size_t index = rand() % validPositions;
+    size_t index = validSeeds[rand() % validSeeds.size()];
     randVec *= static_cast<float>((rand() % 10) + 1);
 
     return tgt::clamp((seedingPositions_[index] + randVec), tgt::vec3::zero, flowDimensions);
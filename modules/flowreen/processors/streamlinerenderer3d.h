@@ -79,7 +79,11 @@ private:
     void renderStreamlineLines(const std::vector<tgt::vec3>& streamline, const Flow3D& flow) const;
     void renderStreamlineTubes(const std::vector<tgt::vec3>& streamline) const;
 
-    tgt::vec3 reseedPosition(const tgt::vec3& flowDimensions, const size_t validPositions = 0);
+    /**
+     * Returns a new random seeding position, which is either chosen uniformly or close to one of
+     * the seeding positions with the indices \a validSeeds that led to valid streamlines.
+     */
+    tgt::vec3 reseedPosition(const tgt::vec3& flowDimensions, const std::vector<size_t>& validSeeds);
 
     void setPropertyVisibilities();
 
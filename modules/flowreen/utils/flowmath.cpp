@@ -28,6 +28,13 @@
 #include "modules/flowreen/utils/flowmath.h"
 //#include "modules/flowreen/include/streamlinetexture.h"
 
+#include <cmath>
+#include <algorithm>
+
+#ifdef VRN_MODULE_OPENMP
+#include "omp.h"
+#endif
+
 using tgt::vec3;
 
 namespace voreen {
@@ -275,6 +282,79 @@ template std::deque<tgt::vec3> FlowMath::computeStreamlineRungeKutta(
 
 // ----------------------------------------------------------------------------
 
+template<class Flow, class Vector>
+void FlowMath::computeStreamlines(const Flow& flow, const std::vector<Vector>& seeds,
+                                  StreamlineList<Vector>& streamlines, const float length,
+                                  const float stepwidth, const tgt::vec2& thresholds,
+                                  const float tolerance)
+{
+    const int numSeeds = static_cast<int>(seeds.size());
+    streamlines.vertices_.clear();
+    streamlines.offsets_.assign(numSeeds + 1, 0);
+    streamlines.seedIndices_.assign(numSeeds, 0);
+
+    // each thread appends its streamlines to its own buffer, the buffers
+    // are gathered in the order of the seeds afterwards
+    int numThreads = 1;
+#ifdef VRN_MODULE_OPENMP
+    numThreads = omp_get_max_threads();
+#endif
+    std::vector< std::vector<Vector> > threadVertices(numThreads);
+    std::vector<int> lineThreads(numSeeds, 0);
+    std::vector<size_t> lineStarts(numSeeds, 0);
+
+#ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel
+#endif
+    {
+        int thread = 0;
+#ifdef VRN_MODULE_OPENMP
+        thread = omp_get_thread_num();
+#endif
+        std::vector<Vector>& buffer = threadVertices[thread];
+        std::vector<Vector> forward, backward;
+
+#ifdef VRN_MODULE_OPENMP
+        #pragma omp for schedule(dynamic, 16)
+#endif
+        for (int i = 0; i < numSeeds; ++i) {
+            traceStreamlineRungeKuttaFehlberg(flow, seeds[i], -1.0f, length, stepwidth, thresholds, tolerance, backward);
+            traceStreamlineRungeKuttaFehlberg(flow, seeds[i], 1.0f, length, stepwidth, thresholds, tolerance, forward);
+
+            lineThreads[i] = thread;
+            lineStarts[i] = buffer.size();
+            buffer.insert(buffer.end(), backward.rbegin(), backward.rend());
+            buffer.push_back(seeds[i]);
+            buffer.insert(buffer.end(), forward.begin(), forward.end());
+
+            streamlines.seedIndices_[i] = backward.size();
+            streamlines.offsets_[i + 1] = backward.size() + 1 + forward.size();
+        }
+    }
+
+    for (int i = 0; i < numSeeds; ++i)
+        streamlines.offsets_[i + 1] += streamlines.offsets_[i];
+    streamlines.vertices_.resize(streamlines.offsets_[numSeeds]);
+
+#ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for
+#endif
+    for (int i = 0; i < numSeeds; ++i) {
+        typename std::vector<Vector>::const_iterator start = threadVertices[lineThreads[i]].begin() + lineStarts[i];
+        std::copy(start, start + streamlines.getNumVertices(i), streamlines.vertices_.begin() + streamlines.offsets_[i]);
+    }
+}
+
+template void FlowMath::computeStreamlines(const Flow2D& flow, const std::vector<tgt::vec2>& seeds,
+    StreamlineList<tgt::vec2>& streamlines, const float length, const float stepwidth,
+    const tgt::vec2& thresholds, const float tolerance);
+
+template void FlowMath::computeStreamlines(const Flow3D& flow, const std::vector<tgt::vec3>& seeds,
+    StreamlineList<tgt::vec3>& streamlines, const float length, const float stepwidth,
+    const tgt::vec2& thresholds, const float tolerance);
+
+// ----------------------------------------------------------------------------
+
 tgt::mat4 FlowMath::getTransformationMatrix(const std::vector<tgt::vec3>& streamline,
                                                         const size_t& index, const float scaling)
 {
@@ -373,6 +453,91 @@ template tgt::vec4 FlowMath::normalize(const tgt::vec4& v);
 
 // ----------------------------------------------------------------------------
 
+template<class Flow, class Vector>
+void FlowMath::traceStreamlineRungeKuttaFehlberg(const Flow& flow, const Vector& r0, const float direction,
+                                                 const float length, const float stepwidth,
+                                                 const tgt::vec2& thresholds, const float tolerance,
+                                                 std::vector<Vector>& points)
+{
+    points.clear();
+
+    const float hMax = fabsf(stepwidth);
+    const float hMin = hMax / 8.0f;
+    const float maxLength = fabsf(length);
+    const bool useThresholds = (thresholds != tgt::vec2::zero);
+
+    // without a length limit, stop after a fixed number of steps to end closed orbits
+    const size_t maxSteps = (maxLength > 0.0f) ? static_cast<size_t>(ceilf(maxLength / hMin)) + 1 : (1 << 20);
+
+    Vector r(r0);
+    float h = hMax;
+    float tracedLength = 0.0f;
+    for (size_t step = 0; step < maxSteps; ++step) {
+        const Vector& v = flow.lookupFlow(r);
+        if (v == Vector::zero)
+            break;
+        if (useThresholds == true) {
+            float magnitude = tgt::length(v);
+            if ((magnitude < thresholds.x) || (magnitude > thresholds.y))
+                break;
+        }
+        if (maxLength > 0.0f) {
+            if (tracedLength >= maxLength)
+                break;
+            h = std::min(h, maxLength - tracedLength);
+        }
+
+        // Runge-Kutta-Fehlberg step on the normalized flow, retried with a smaller
+        // step size as long as the error estimate exceeds the tolerance
+        //
+        const Vector k1 = normalize(v) * direction;
+        Vector r5(r);
+        float error = 0.0f;
+        for (;;) {
+            const Vector k2 = normalize(flow.lookupFlow(r + k1 * (h / 4.0f))) * direction;
+            const Vector k3 = normalize(flow.lookupFlow(r + (k1 * (3.0f / 32.0f) + k2 * (9.0f / 32.0f)) * h)) * direction;
+            const Vector k4 = normalize(flow.lookupFlow(r + (k1 * (1932.0f / 2197.0f) - k2 * (7200.0f / 2197.0f)
+                + k3 * (7296.0f / 2197.0f)) * h)) * direction;
+            const Vector k5 = normalize(flow.lookupFlow(r + (k1 * (439.0f / 216.0f) - k2 * 8.0f
+                + k3 * (3680.0f / 513.0f) - k4 * (845.0f / 4104.0f)) * h)) * direction;
+            const Vector k6 = normalize(flow.lookupFlow(r + (k1 * (-8.0f / 27.0f) + k2 * 2.0f
+                - k3 * (3544.0f / 2565.0f) + k4 * (1859.0f / 4104.0f) - k5 * (11.0f / 40.0f)) * h)) * direction;
+
+            const Vector r4 = r + (k1 * (25.0f / 216.0f) + k3 * (1408.0f / 2565.0f)
+                + k4 * (2197.0f / 4104.0f) - k5 * (1.0f / 5.0f)) * h;
+            r5 = r + (k1 * (16.0f / 135.0f) + k3 * (6656.0f / 12825.0f) + k4 * (28561.0f / 56430.0f)
+                - k5 * (9.0f / 50.0f) + k6 * (2.0f / 55.0f)) * h;
+
+            error = tgt::length(r5 - r4);
+            if ((error <= tolerance) || (h <= hMin))
+                break;
+            h = std::max(hMin, h * std::max(0.1f, 0.84f * std::pow(tolerance / error, 0.25f)));
+        }
+
+        if ((flow.isInsideBoundings(r5) == false) || (r5 == r))   // left the flow or no progress
+            break;
+
+        tracedLength += tgt::length(r5 - r);
+        points.push_back(r5);
+        r = r5;
+
+        if (error > 0.0f)
+            h = std::min(hMax, h * std::min(4.0f, 0.84f * std::pow(tolerance / error, 0.25f)));
+        else
+            h = hMax;
+    }
+}
+
+template void FlowMath::traceStreamlineRungeKuttaFehlberg(const Flow2D& flow, const tgt::vec2& r0,
+    const float direction, const float length, const float stepwidth, const tgt::vec2& thresholds,
+    const float tolerance, std::vector<tgt::vec2>& points);
+
+template void FlowMath::traceStreamlineRungeKuttaFehlberg(const Flow3D& flow, const tgt::vec3& r0,
+    const float direction, const float length, const float stepwidth, const tgt::vec2& thresholds,
+    const float tolerance, std::vector<tgt::vec3>& points);
+
+// ----------------------------------------------------------------------------
+
 template<class Flow, class Vector>
 Vector FlowMath::lintTime(const std::vector<Flow>& flows, const Vector& r, const float time) {
     if (flows.empty() == true)
@@ -37,6 +37,23 @@ namespace voreen {
 class Flow2D;
 class Flow3D;
 
+/**
+ * Set of streamlines stored in one flat vertex buffer: the vertices of streamline i are
+ * vertices_[offsets_[i]] to vertices_[offsets_[i + 1] - 1] and seedIndices_[i] is the index
+ * of its seeding position relative to offsets_[i]. Each streamline contains at least its
+ * seeding position, a streamline consisting of that position only could not be traced.
+ */
+template<class Vector>
+struct StreamlineList {
+    std::vector<Vector> vertices_;
+    std::vector<size_t> offsets_;
+    std::vector<size_t> seedIndices_;
+
+    size_t getNumStreamlines() const { return seedIndices_.size(); }
+    size_t getNumVertices(size_t i) const { return offsets_[i + 1] - offsets_[i]; }
+    const Vector* getVertices(size_t i) const { return &vertices_[offsets_[i]]; }
+};
+
 class FlowMath {
 public:
     template<class Flow, class Vector>
@@ -53,6 +70,22 @@ public:
         const Vector& r0, const float length = 150.0f, const float stepwidth = 0.5f,
         int* const startIndex = 0, const tgt::vec2& thresholds = tgt::vec2(0.0f));
 
+    /**
+     * Traces the streamlines through all passed seeding positions in both directions, using
+     * the Runge-Kutta-Fehlberg method (RK45) with adaptive step size control: the step size
+     * is at most \a stepwidth and is reduced down to stepwidth / 8 where the estimated local
+     * error exceeds \a tolerance (in voxels). Each direction is traced until its length
+     * reaches \a length (unlimited for 0), the streamline leaves the flow or stagnates, or
+     * the flow magnitude leaves the range given by \a thresholds (ignored if zero).
+     *
+     * The seeds are processed in parallel if OpenMP is available. The streamlines are stored
+     * in the order of the seeds, independently of the number of threads.
+     */
+    template<class Flow, class Vector>
+    static void computeStreamlines(const Flow& flow, const std::vector<Vector>& seeds,
+        StreamlineList<Vector>& streamlines, const float length = 150.0f, const float stepwidth = 0.5f,
+        const tgt::vec2& thresholds = tgt::vec2(0.0f), const float tolerance = 0.01f);
+
     static tgt::mat4 getTransformationMatrix(const std::vector<tgt::vec3>& streamline,
         const size_t& index, const float scaling = 1.0f);
 
@@ -89,6 +122,15 @@ private:
     FlowMath(const FlowMath&);
     FlowMath& operator=(const FlowMath&);
 
+    /**
+     * Traces a streamline from \a r0 in the given direction (1 or -1) by RK45 integration
+     * and stores the positions reached, excluding \a r0, in \a points.
+     */
+    template<class Flow, class Vector>
+    static void traceStreamlineRungeKuttaFehlberg(const Flow& flow, const Vector& r0, const float direction,
+        const float length, const float stepwidth, const tgt::vec2& thresholds, const float tolerance,
+        std::vector<Vector>& points);
+
     template<class Flow, class Vector>
     static Vector lintTime(const std::vector<Flow>& flows, const Vector& r, const float time);
 };
@@ -38,6 +38,7 @@
 #include <gdcm-2.2/gdcmDirectory.h>
 #include <gdcm-2.2/gdcmSystem.h>
 #include <gdcm-2.2/gdcmRescaler.h>
+#include <gdcm-2.2/gdcmImageHelper.h>
 //#include <gdcm-2.2/gdcmIPPSorter.h> //currently not in use
 #else
 #include <gdcm-2.0/gdcmGlobal.h>
@@ -49,6 +50,7 @@
 #include <gdcm-2.0/gdcmDirectory.h>
 #include <gdcm-2.0/gdcmSystem.h>
 #include <gdcm-2.0/gdcmRescaler.h>
+#include <gdcm-2.0/gdcmImageHelper.h>
 //#include <gdcm-2.0/gdcmIPPSorter.h> //currently not in use
 #endif
 
@@ -59,11 +61,18 @@
 #include "voreen/core/datastructures/meta/primitivemetadata.h"
 #include "voreen/core/datastructures/meta/filelistmetadata.h"
 #include "voreen/core/datastructures/volume/volumefactory.h"
+#include "voreen/core/utils/hashing.h"
 
 #include <algorithm>
+#include <fstream>
+#include <sstream>
 
 #include "dicomdirparser.h"
 
+#ifdef VRN_MODULE_OPENMP
+#include "omp.h"
+#endif
+
 namespace voreen {
 
 using std::vector;
@@ -72,6 +81,91 @@ using std::string;
 
 const std::string GdcmVolumeReader::loggerCat_ = "voreen.gdcm.GdcmVolumeReader";
 
+namespace {
+
+/// Reading of DICOM headers stops at this tag.
+const gdcm::Tag PIXEL_DATA_TAG(0x7fe0, 0x0010);
+
+/// Version of the header index format, indices of other versions are ignored.
+const int HEADER_INDEX_VERSION = 2;
+
+/// Returns true, if called by the thread that has invoked the parallel region (or if OpenMP is not available).
+bool isMainThread() {
+#ifdef VRN_MODULE_OPENMP
+    return (omp_get_thread_num() == 0);
+#else
+    return true;
+#endif
+}
+
+} // namespace
+
+class GdcmVolumeReader::DicomHeaderIndex : public Serializable {
+public:
+    DicomHeaderIndex() : version_(HEADER_INDEX_VERSION) {}
+
+    virtual void serialize(XmlSerializer& s) const {
+        s.serialize("version", version_);
+        s.serialize("directoryTime", directoryTime_);
+        s.serialize("Files", files_, "File", "name");
+        s.serialize("SliceHeaders", sliceHeaders_, "Slice", "name");
+        s.serialize("NonDicomFiles", nonDicomFiles_, "File");
+    }
+
+    virtual void deserialize(XmlDeserializer& s) {
+        s.deserialize("version", version_);
+        if (version_ != HEADER_INDEX_VERSION)
+            return;
+        s.deserialize("directoryTime", directoryTime_);
+        s.deserialize("Files", files_, "File", "name");
+        s.deserialize("SliceHeaders", sliceHeaders_, "Slice", "name");
+        s.deserialize("NonDicomFiles", nonDicomFiles_, "File");
+    }
+
+    int version_;
+    std::string directoryTime_;     ///< modification time of the directory the index has been created for
+    std::map<std::string, MetaDataContainer> files_;
+    std::map<std::string, SliceHeader> sliceHeaders_;
+    std::vector<std::string> nonDicomFiles_;
+};
+
+GdcmVolumeReader::SliceHeader::SliceHeader()
+    : origin_(0.0)
+    , distance_(0.0)
+    , numDimensions_(2)
+    , slope_(1.f)
+    , intercept_(0.f)
+{}
+
+void GdcmVolumeReader::SliceHeader::serialize(XmlSerializer& s) const {
+    s.serialize("filename", filename_);
+    s.serialize("origin", origin_);
+    s.serialize("numDimensions", numDimensions_);
+    s.serialize("samplesPerPixel", static_cast<int>(pixelFormat_.GetSamplesPerPixel()));
+    s.serialize("bitsAllocated", static_cast<int>(pixelFormat_.GetBitsAllocated()));
+    s.serialize("bitsStored", static_cast<int>(pixelFormat_.GetBitsStored()));
+    s.serialize("highBit", static_cast<int>(pixelFormat_.GetHighBit()));
+    s.serialize("pixelRepresentation", static_cast<int>(pixelFormat_.GetPixelRepresentation()));
+    s.serialize("slope", slope_);
+    s.serialize("intercept", intercept_);
+}
+
+void GdcmVolumeReader::SliceHeader::deserialize(XmlDeserializer& s) {
+    s.deserialize("filename", filename_);
+    s.deserialize("origin", origin_);
+    s.deserialize("numDimensions", numDimensions_);
+    int samplesPerPixel, bitsAllocated, bitsStored, highBit, pixelRepresentation;
+    s.deserialize("samplesPerPixel", samplesPerPixel);
+    s.deserialize("bitsAllocated", bitsAllocated);
+    s.deserialize("bitsStored", bitsStored);
+    s.deserialize("highBit", highBit);
+    s.deserialize("pixelRepresentation", pixelRepresentation);
+    pixelFormat_ = gdcm::PixelFormat(static_cast<unsigned short>(samplesPerPixel), static_cast<unsigned short>(bitsAllocated),
+        static_cast<unsigned short>(bitsStored), static_cast<unsigned short>(highBit), static_cast<unsigned short>(pixelRepresentation));
+    s.deserialize("slope", slope_);
+    s.deserialize("intercept", intercept_);
+}
+
 GdcmVolumeReader::GdcmVolumeReader(ProgressBar* progress)
     : VolumeReader(progress)
 {
@@ -156,13 +250,6 @@ vector<CustomDicomDict> GdcmVolumeReader::getCustomDicts() const {
     return specialDicts;
 }
 
-/*
- * Sorts strings according to a double value interpreted as the distance of the Image Origin to the Volume Origin
- */
-bool slices_cmp_dist(std::pair<string, double> a, std::pair<string, double> b) {
-   return a.second < b.second;
-}
-
 /*
  * Removes slashes as well as backslaches within a std::string
  */
@@ -181,18 +268,27 @@ std::string GdcmVolumeReader::constructLocalPathFromNetworkOrigin(const VolumeUR
     return path;
 }
 
+bool GdcmVolumeReader::readFileHeader(gdcm::Reader& reader, const std::string& filename) {
+    reader.SetFileName(filename.c_str());
+    std::set<gdcm::Tag> skipTags;
+    return reader.ReadUpToTag(PIXEL_DATA_TAG, skipTags);
+}
+
 bool GdcmVolumeReader::isDicomFile(const string &url) const {
+    //files that have already been scanned
+    if (fileInfoBuffer_.find(url) != fileInfoBuffer_.end())
+        return true;
+    if (nonDicomFiles_.find(url) != nonDicomFiles_.end())
+        return false;
+
     gdcm::Reader reader;
-    reader.SetFileName(url.c_str());
-    return reader.Read();
+    return readFileHeader(reader, url);
 }
 
 bool GdcmVolumeReader::isDicomDir(const string &url) const {
-    if (!isDicomFile(url)) return false;
-
     gdcm::Reader reader;
-    reader.SetFileName(url.c_str());
-    reader.Read();
+    if (!readFileHeader(reader, url))
+        return false;
 
     gdcm::MediaStorage ms;
     ms.SetFromFile(reader.GetFile());
@@ -207,12 +303,19 @@ void GdcmVolumeReader::setMetaDataFromDict(MetaDataContainer* container, const D
         return;
 
     gdcm::Reader reader;
-    reader.SetFileName(file.c_str());
-    if ((!reader.Read()) || (!reader.GetFile().GetHeader().IsValid()))
+    if ((!readFileHeader(reader, file)) || (!reader.GetFile().GetHeader().IsValid()))
         throw tgt::FileException("Cannot extract meta data from file " + file, file);
 
+    setMetaDataFromDict(container, dict, reader.GetFile(), setAll);
+}
+
+void GdcmVolumeReader::setMetaDataFromDict(MetaDataContainer* container, const DicomDict* dict, const gdcm::File& file, bool setAll) {
+
+    if ((!container) || (!dict))
+        return;
+
     gdcm::StringFilter sf;
-    sf.SetFile(reader.GetFile());
+    sf.SetFile(file);
 
     const vector<string> keys = dict->getKeywordVector();
 
@@ -270,6 +373,177 @@ std::string GdcmVolumeReader::getMetaDataFromFile(const std::string& filename, c
         return "";
 }
 
+vector<string> GdcmVolumeReader::scanDirectory(const string& dirName) const {
+    vector<string> filenames = getFileNamesInDir(dirName);
+    if (filenames.empty())
+        return filenames;
+
+    if (!dict_)
+        loadStandardDict();
+
+    loadHeaderIndex(dirName);
+    if (scanFileHeaders(filenames) > 0)
+        saveHeaderIndex(dirName, filenames);
+
+    return filenames;
+}
+
+size_t GdcmVolumeReader::scanFileHeaders(const vector<string>& filenames) const {
+    //determine the files that have not been scanned before
+    vector<string> newFiles;
+    for (size_t i = 0; i < filenames.size(); i++) {
+        if (fileInfoBuffer_.find(filenames[i]) == fileInfoBuffer_.end() && nonDicomFiles_.find(filenames[i]) == nonDicomFiles_.end())
+            newFiles.push_back(filenames[i]);
+    }
+    if (newFiles.empty())
+        return 0;
+
+    //buffer the meta data of the Standard Dictionary and all CustomDicomDicts
+    vector<CustomDicomDict> customDicts = getCustomDicts();
+    vector<const DicomDict*> dicts;
+    if (dict_)
+        dicts.push_back(dict_);
+    for (size_t i = 0; i < customDicts.size(); i++)
+        dicts.push_back(customDicts[i].getDict());
+
+    if (getProgressBar()) {
+        getProgressBar()->setTitle("Scanning files");
+        getProgressBar()->setProgressMessage("Reading DICOM headers...");
+    }
+
+    vector<MetaDataContainer> containers(newFiles.size());
+    vector<SliceHeader> sliceHeaders(newFiles.size());
+    vector<char> valid(newFiles.size(), 0);
+    vector<char> validSliceHeader(newFiles.size(), 0);
+    int numFiles = static_cast<int>(newFiles.size());
+
+    #ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 8)
+    #endif
+    for (int i = 0; i < numFiles; i++) {
+        try {
+            gdcm::Reader reader;
+            if (readFileHeader(reader, newFiles[i]) && reader.GetFile().GetHeader().IsValid()) {
+                for (size_t d = 0; d < dicts.size(); d++)
+                    setMetaDataFromDict(&containers[i], dicts[d], reader.GetFile(), true);
+                valid[i] = 1;
+
+                //non-image files (e.g., DICOMDIRs) have no slice header
+                try {
+                    readSliceHeader(reader.GetFile(), newFiles[i], sliceHeaders[i]);
+                    validSliceHeader[i] = 1;
+                }
+                catch (...) {
+                    validSliceHeader[i] = 0;
+                }
+            }
+        }
+        catch (...) {
+            valid[i] = 0;
+        }
+
+        if (getProgressBar() && isMainThread())
+            getProgressBar()->setProgress(static_cast<float>(i) / static_cast<float>(numFiles));
+    }
+
+    for (size_t i = 0; i < newFiles.size(); i++) {
+        if (valid[i])
+            fileInfoBuffer_[newFiles[i]] = containers[i];
+        else
+            nonDicomFiles_.insert(newFiles[i]);
+        if (validSliceHeader[i])
+            sliceHeaderBuffer_[newFiles[i]] = sliceHeaders[i];
+    }
+    lastBufferMod_ = DateTime::now();
+
+    if (getProgressBar())
+        getProgressBar()->hide();
+
+    return newFiles.size();
+}
+
+string GdcmVolumeReader::getHeaderIndexFileName(const string& dirName) const {
+    if (!VoreenApplication::app() || !VoreenApplication::app()->useCaching())
+        return "";
+    return VoreenApplication::app()->getCachePath("gdcm") + "/" + VoreenHash::getHash(tgt::FileSystem::cleanupPath(dirName)) + ".xml";
+}
+
+void GdcmVolumeReader::loadHeaderIndex(const string& dirName) const {
+    string indexFile = getHeaderIndexFileName(dirName);
+    if (indexFile.empty() || !tgt::FileSystem::fileExists(indexFile))
+        return;
+
+    DicomHeaderIndex index;
+    try {
+        std::fstream fileStream(indexFile.c_str(), std::ios_base::in);
+        if (fileStream.fail())
+            throw tgt::FileException("Failed to open file for reading", indexFile);
+
+        XmlDeserializer d(indexFile);
+        d.setUseAttributes(true);
+        d.read(fileStream);
+        index.deserialize(d);
+    }
+    catch (std::exception& e) {
+        LWARNING("Failed to read DICOM header index " << indexFile << ": " << e.what());
+        return;
+    }
+
+    //the index is outdated if files have been added to or removed from the directory
+    if (index.version_ != HEADER_INDEX_VERSION || index.directoryTime_ != genericToString(tgt::FileSystem::fileTime(dirName))) {
+        LDEBUG("Ignoring outdated DICOM header index " << indexFile);
+        return;
+    }
+
+    fileInfoBuffer_.insert(index.files_.begin(), index.files_.end());
+    sliceHeaderBuffer_.insert(index.sliceHeaders_.begin(), index.sliceHeaders_.end());
+    nonDicomFiles_.insert(index.nonDicomFiles_.begin(), index.nonDicomFiles_.end());
+    lastBufferMod_ = DateTime::now();
+}
+
+void GdcmVolumeReader::saveHeaderIndex(const string& dirName, const vector<string>& filenames) const {
+    string indexFile = getHeaderIndexFileName(dirName);
+    if (indexFile.empty())
+        return;
+
+    DicomHeaderIndex index;
+    index.directoryTime_ = genericToString(tgt::FileSystem::fileTime(dirName));
+    for (size_t i = 0; i < filenames.size(); i++) {
+        std::map<string, MetaDataContainer>::const_iterator it = fileInfoBuffer_.find(filenames[i]);
+        std::map<string, SliceHeader>::const_iterator sliceIt = sliceHeaderBuffer_.find(filenames[i]);
+        if (sliceIt != sliceHeaderBuffer_.end())
+            index.sliceHeaders_.insert(*sliceIt);
+        if (it != fileInfoBuffer_.end())
+            index.files_.insert(*it);
+        else if (nonDicomFiles_.find(filenames[i]) != nonDicomFiles_.end())
+            index.nonDicomFiles_.push_back(filenames[i]);
+    }
+
+    try {
+        string indexDir = tgt::FileSystem::dirName(indexFile);
+        if (!tgt::FileSystem::dirExists(indexDir) && !tgt::FileSystem::createDirectoryRecursive(indexDir))
+            throw tgt::IOException("Failed to create directory " + indexDir);
+
+        XmlSerializer s(indexFile);
+        s.setUseAttributes(true);
+        index.serialize(s);
+
+        std::ostringstream textStream;
+        s.write(textStream);
+        if (textStream.fail())
+            throw tgt::IOException("Failed to write serialization data to string stream.");
+
+        std::fstream fileStream(indexFile.c_str(), std::ios_base::out);
+        if (fileStream.fail())
+            throw tgt::IOException("Failed to open file for writing.");
+        fileStream << textStream.str();
+        fileStream.close();
+    }
+    catch (std::exception& e) {
+        LWARNING("Failed to write DICOM header index " << indexFile << ": " << e.what());
+    }
+}
+
 MetaDataBase* GdcmVolumeReader::constructMetaData(const DicomDictEntry &entry, const std::string &valueString) {
 
     string vr = entry.getValueRepresentation();
@@ -972,6 +1246,8 @@ VolumeList* GdcmVolumeReader::read(const string& url)
     if ((!fileInfoBuffer_.empty()) && (secondsSinceLastBufferMod >= 600.0)) {
         LINFO("Clearing buffer (last modification was " + dtos(secondsSinceLastBufferMod / 60.0) + " minutes ago)");
         fileInfoBuffer_.clear();
+        nonDicomFiles_.clear();
+        sliceHeaderBuffer_.clear();
         lastBufferMod_ = DateTime::now();
     }
 
@@ -1072,7 +1348,7 @@ VolumeList* GdcmVolumeReader::read(const string& url)
     //check if url is a file or a directory
     if (tgt::FileSystem::dirExists(fileName)) {
         //url is a directory
-        collection = selectAndLoadDicomFiles(getFileNamesInDir(fileName), origin);
+        collection = selectAndLoadDicomFiles(scanDirectory(fileName), origin);
     }
     else if (tgt::FileSystem::fileExists(fileName)){
         //url is a file -> check if it is a Dicom file
@@ -1089,8 +1365,7 @@ VolumeList* GdcmVolumeReader::read(const string& url)
 
             //read SeriesInstanceUID from file if possible
             gdcm::Reader reader;
-            reader.SetFileName(fileName.c_str());
-            if (!reader.Read())
+            if (!readFileHeader(reader, fileName))
                 throw tgt::FileAccessException("Could not read Dicom File", fileName);
 
             gdcm::StringFilter sf = gdcm::StringFilter();
@@ -1106,7 +1381,7 @@ VolumeList* GdcmVolumeReader::read(const string& url)
             if (!(seriesInstanceUID == origin.getSearchParameter("SeriesInstanceUID")))
                 throw tgt::FileException("SeriesInstanceUID in VolumeURL does not correspond to file: " + origin.getPath(), origin.getPath());
 
-            collection = selectAndLoadDicomFiles(getFileNamesInDir(tgt::FileSystem::dirName(fileName)), origin);
+            collection = selectAndLoadDicomFiles(scanDirectory(tgt::FileSystem::dirName(fileName)), origin);
         }
     }
     else {
@@ -1159,20 +1434,15 @@ VolumeList* GdcmVolumeReader::selectAndLoadDicomFiles(const std::vector<std::str
             LINFO("Skipping file: " + (*i));
         }
         else {
-            gdcm::Reader iReader;
-
             if (!filter) {
-                //if there is no SeriesInstanceUID until now, get it from the first file
-                //Read file
-                iReader.SetFileName((*i).c_str());
-                iReader.Read();
-
-                //check if meta information is valid
-                if (!iReader.GetFile().GetHeader().IsValid())
+                //if there is no SeriesInstanceUID until now, get it from the first file (header has already been scanned and validated)
+                string seriesInstanceUID;
+                try {
+                    seriesInstanceUID = getMetaDataFromFile(*i, *dict_, "SeriesInstanceUID");
+                }
+                catch (tgt::FileException&) {
                     throw tgt::FileAccessException("GdcmVolumeReader: File Header not valid! ", (*i));
-
-                //get SeriesInstanceUID
-                string seriesInstanceUID = getMetaDataFromFile(*i, *dict_, "SeriesInstanceUID");
+                }
 
                 if (seriesInstanceUID.empty())
                     LERROR("File has no SeriesInstanceUID: " << (*i));
@@ -1534,11 +1804,79 @@ VolumeList* GdcmVolumeReader::subdivideAndLoadDicomFiles(const std::vector<std::
     return vc;
 }
 
+void GdcmVolumeReader::readSliceHeader(const gdcm::File& file, const string& filename, SliceHeader& slice) {
+    slice.filename_ = filename;
+
+    //get position of image
+    std::vector<double> origin = gdcm::ImageHelper::GetOriginValue(file);
+    slice.origin_ = tgt::dvec3(origin[0], origin[1], origin[2]);
+
+    std::vector<unsigned int> dimensions = gdcm::ImageHelper::GetDimensionsValue(file);
+    slice.numDimensions_ = (dimensions.size() > 2 && dimensions[2] > 1) ? 3 : 2;
+
+    slice.pixelFormat_ = gdcm::ImageHelper::GetPixelFormatValue(file);
+
+    std::vector<double> interceptSlope = gdcm::ImageHelper::GetRescaleInterceptSlopeValue(file);
+    slice.intercept_ = static_cast<float>(interceptSlope[0]);
+    slice.slope_ = static_cast<float>(interceptSlope[1]);
+}
+
+std::vector<GdcmVolumeReader::SliceHeader> GdcmVolumeReader::readSliceHeaders(const vector<string>& filenames, const tgt::dvec3& sliceNormal) const
+    throw (tgt::FileException)
+{
+    vector<SliceHeader> slices(filenames.size());
+
+    //take the slice headers from the buffer (filled by scanning the directory or from its header index) and read the others
+    vector<int> unbuffered;
+    for (size_t i = 0; i < filenames.size(); i++) {
+        std::map<string, SliceHeader>::const_iterator it = sliceHeaderBuffer_.find(filenames[i]);
+        if (it != sliceHeaderBuffer_.end())
+            slices[i] = it->second;
+        else
+            unbuffered.push_back(static_cast<int>(i));
+    }
+
+    vector<char> valid(unbuffered.size(), 0);
+    int numFiles = static_cast<int>(unbuffered.size());
+
+    #ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 8)
+    #endif
+    for (int i = 0; i < numFiles; i++) {
+        try {
+            gdcm::Reader reader;
+            //check if file could be read and meta information is valid -> should always be the case due to earlier checks
+            if (readFileHeader(reader, filenames[unbuffered[i]]) && reader.GetFile().GetHeader().IsValid()) {
+                readSliceHeader(reader.GetFile(), filenames[unbuffered[i]], slices[unbuffered[i]]);
+                valid[i] = 1;
+            }
+        }
+        catch (...) {
+            valid[i] = 0;
+        }
+
+        if (getProgressBar() && isMainThread()) {
+            getProgressBar()->setProgressMessage("Reading slice headers...");
+            getProgressBar()->setProgress(static_cast<float>(i) / static_cast<float>(numFiles));
+        }
+    }
+
+    for (size_t i = 0; i < unbuffered.size(); i++) {
+        if (!valid[i])
+            throw tgt::FileAccessException("Could not read File which should be readable!", filenames[unbuffered[i]]);
+        sliceHeaderBuffer_[filenames[unbuffered[i]]] = slices[unbuffered[i]];
+    }
+
+    //calculate the distance of the image positions along the slice normal
+    for (size_t i = 0; i < slices.size(); i++)
+        slices[i].distance_ = tgt::dot(sliceNormal, slices[i].origin_);
+
+    return slices;
+}
+
 Volume* GdcmVolumeReader::readDicomFiles(const vector<string> &fileNames, const VolumeURL &origin)
             throw (tgt::FileException, std::bad_alloc){
 
-    vector<pair<string, double> > slices; //filename, distance
-
     //take first file as reference, since all files belong to the same SeriesInstanceUID
     gdcm::ImageReader reader;
     reader.SetFileName(fileNames.begin()->c_str());
@@ -1607,56 +1945,19 @@ Volume* GdcmVolumeReader::readDicomFiles(const vector<string> &fileNames, const
 
     info_.setSliceNormal(sliceNormal);
 
-    //Read ImagePositionPatient from all files and calculate distance along slice normal
-    vector<string>::const_iterator it_files = fileNames.begin();
-    int i = 0;
+    //Read the headers of all files and calculate the distance of the ImagePositionPatient along the slice normal
     if (getProgressBar() && !fileNames.empty())
         getProgressBar()->setTitle("Loading DICOM Data Set");
 
-    while (it_files != fileNames.end()) {
-        if (getProgressBar()) {
-            getProgressBar()->setProgressMessage("Reading slice '" + tgt::FileSystem::fileName(*it_files) + "' ...");
-            getProgressBar()->setProgress(static_cast<float>(i) / static_cast<float>(fileNames.size()));
-        }
-        i++;
-
-        //Read file
-        gdcm::ImageReader reader;
-        reader.SetFileName((*it_files).c_str());
-
-        //check if file could be read -> should always be the case due to earlier checks
-        if (!reader.Read()){
-            if (getProgressBar())
-                getProgressBar()->hide();
-            throw tgt::FileAccessException("Could not read File which should be readable!", (*it_files));
-        }
-
-        //check if meta information is valid -> should always be the case due to earlier checks
-        if (!reader.GetFile().GetHeader().IsValid()){
-            if (getProgressBar())
-                getProgressBar()->hide();
-            throw tgt::FileAccessException("GdcmVolumeReader: File Header not valid! ", (*it_files));
-        }
-
-        gdcm::StringFilter sf = gdcm::StringFilter();
-        sf.SetFile(reader.GetFile());
-
-        //get position of image
-        tgt::dvec3 imagePositionPatient;
-        const double* origin = reader.GetImage().GetOrigin();
-        imagePositionPatient.x = origin[0];
-        imagePositionPatient.y = origin[1];
-        imagePositionPatient.z = origin[2];
-
-        //calculate distance
-        double dist = tgt::dot(info_.getSliceNormal(),imagePositionPatient);
-
-        //add image
-        slices.push_back(make_pair(*it_files,dist));
-
-        it_files++;
+    vector<SliceHeader> slices;
+    try {
+        slices = readSliceHeaders(fileNames, info_.getSliceNormal());
+    }
+    catch (tgt::FileException&) {
+        if (getProgressBar())
+            getProgressBar()->hide();
+        throw;
     }
-
 
     if (slices.size() == 0) {
         if (getProgressBar())
@@ -1695,7 +1996,7 @@ Volume* GdcmVolumeReader::readDicomFiles(const vector<string> &fileNames, const
         else {
             if (getProgressBar())
                 getProgressBar()->hide();
-            throw tgt::FileException("Unexpected Number of Dimensions in Image File (Not supported): " + reader.GetImage().GetNumberOfDimensions(), slices.begin()->first);
+            throw tgt::FileException("Unexpected Number of Dimensions in Image File (Not supported): " + itos(reader.GetImage().GetNumberOfDimensions()), slices.begin()->filename_);
         }
 
         //check samples per pixel and warn, if != 1
@@ -1711,41 +2012,34 @@ Volume* GdcmVolumeReader::readDicomFiles(const vector<string> &fileNames, const
     //sort slices by their distance from the origin, calculate Z spacing and do some additional checks
     if (slices.size() > 1) {
         //sort slices by distance from origin
-        std::sort(slices.begin(), slices.end(), slices_cmp_dist);
+        std::sort(slices.begin(), slices.end());
 
         //check, if all images files are of dimension 2
         //also check if rescale intercept and slope are uniform and samples per pixel = 1 in all images
         int samplesPerPixel = 1;
         for (unsigned int i = 0; i < slices.size(); i++) {
-            gdcm::ImageReader imR;
-            imR.SetFileName(slices[i].first.c_str());
-            imR.Read();
-            if (imR.GetImage().GetNumberOfDimensions() != 2) {
+            if (slices[i].numDimensions_ != 2) {
                 if (getProgressBar())
                     getProgressBar()->hide();
-                throw tgt::FileException("Image file has unexpected Dimensions (Multiple slices are required to have Dimension 2): " + imR.GetImage().GetNumberOfDimensions(), slices[i].first);
+                throw tgt::FileException("Image file has unexpected Dimensions (Multiple slices are required to have Dimension 2): " + itos(slices[i].numDimensions_), slices[i].filename_);
             }
 
             //check if PixelRepresentation is uniform
-            if (imR.GetImage().GetPixelFormat().GetScalarType() != scalarType_) {
+            if (slices[i].pixelFormat_.GetScalarType() != scalarType_) {
                 if (getProgressBar())
                     getProgressBar()->hide();
                 throw tgt::FileException("Image files do not have uniform scalar type!");
             }
 
             //check if rescale slope and intercept are the same for alle images, otherwise: warning
-            if (info_.getIntercept() != static_cast<float>(imR.GetImage().GetIntercept())) {
+            if (info_.getIntercept() != slices[i].intercept_)
                 interceptDiffers = true;
-                //LERROR("Intercept: " + ftos(static_cast<float>(imR.GetImage().GetIntercept())));
-            }
-            if (info_.getSlope() != static_cast<float>(imR.GetImage().GetSlope())) {
+            if (info_.getSlope() != slices[i].slope_)
                 slopeDiffers = true;
-                //LERROR("Slope: " + ftos(static_cast<float>(imR.GetImage().GetSlope())));
-            }
 
             //check if samples per pixel are uniformly = 1
-            if ((imR.GetImage().GetPixelFormat().GetSamplesPerPixel() != samplesPerPixel) && (imR.GetImage().GetPixelFormat().GetSamplesPerPixel() != 1)) {
-                samplesPerPixel = imR.GetImage().GetPixelFormat().GetSamplesPerPixel();
+            if ((slices[i].pixelFormat_.GetSamplesPerPixel() != samplesPerPixel) && (slices[i].pixelFormat_.GetSamplesPerPixel() != 1)) {
+                samplesPerPixel = slices[i].pixelFormat_.GetSamplesPerPixel();
                 LWARNING("Found image files with unsupported Pixel Format: " + itos(samplesPerPixel) + " Samples per Pixel instead of 1! Might lead to unexpected results.");
                 info_.setSamplesPerPixel(samplesPerPixel);
             }
@@ -1758,7 +2052,7 @@ Volume* GdcmVolumeReader::readDicomFiles(const vector<string> &fileNames, const
             LWARNING("Rescale Slope differs within the image files!");
 
         //calculate Z-Spacing
-        info_.setZSpacing(slices[1].second - slices[0].second);
+        info_.setZSpacing(slices[1].distance_ - slices[0].distance_);
         if (info_.getZSpacing() == 0){
             if (getProgressBar())
                 getProgressBar()->hide();
@@ -1767,9 +2061,9 @@ Volume* GdcmVolumeReader::readDicomFiles(const vector<string> &fileNames, const
 
         //check, if slice spacing remains constant (with 10% tolerance)
         for (unsigned int i = 0; i < slices.size()-1; i++) {
-            if (((slices[i+1].second - slices[i].second) < 0.9*info_.getZSpacing()) || ((slices[i+1].second - slices[i].second) > 1.1*info_.getZSpacing())) {
+            if (((slices[i+1].distance_ - slices[i].distance_) < 0.9*info_.getZSpacing()) || ((slices[i+1].distance_ - slices[i].distance_) > 1.1*info_.getZSpacing())) {
                 //LERROR("Spacing between slices is not steady (10% tolerance)!");
-                if ((slices[i+1].second - slices[i].second) == 0) {
+                if ((slices[i+1].distance_ - slices[i].distance_) == 0) {
                     if (getProgressBar())
                         getProgressBar()->hide();
                     throw tgt::FileException("Slice Spacing is 0: Found two or more Slices with the same Position! (Either not a Volume or Slices have to be subdivided by additional Attributes)");
@@ -1791,13 +2085,12 @@ Volume* GdcmVolumeReader::readDicomFiles(const vector<string> &fileNames, const
     }
 
     //get position of first image to calculate offset
-    gdcm::ImageReader yar;
-    yar.SetFileName(slices[0].first.c_str());
-    yar.Read();
+    gdcm::Reader yar;
+    readFileHeader(yar, slices[0].filename_);
     sf.SetFile(yar.GetFile()); //set file to gdcm::StringFilter for later use
 
     tgt::dvec3 offset;
-    const double* volumeOrigin = yar.GetImage().GetOrigin();
+    std::vector<double> volumeOrigin = gdcm::ImageHelper::GetOriginValue(yar.GetFile());
     offset.x = volumeOrigin[0];
     offset.y = volumeOrigin[1];
     offset.z = volumeOrigin[2];
@@ -1805,7 +2098,7 @@ Volume* GdcmVolumeReader::readDicomFiles(const vector<string> &fileNames, const
     info_.setOffset(offset);
 
     //get pixel representation
-    info_.setPixelRepresentation(yar.GetImage().GetPixelFormat().GetPixelRepresentation());
+    info_.setPixelRepresentation(slices[0].pixelFormat_.GetPixelRepresentation());
 
     LINFO("We have " << info_.getDz() << " slices. [" << info_.getDx() << "x" << info_.getDy() << "]");
     LINFO("Spacing: (" << info_.getXSpacing() << "; " << info_.getYSpacing() << "; " << info_.getZSpacing() << ")");
@@ -1925,7 +2218,7 @@ Volume* GdcmVolumeReader::readDicomFiles(const vector<string> &fileNames, const
     //copy slices into new vector for disk representation
     std::vector<std::string> sliceFilenamesOnly(slices.size());
     for (size_t i = 0; i < slices.size(); ++i)
-        sliceFilenamesOnly.at(i) = slices.at(i).first;
+        sliceFilenamesOnly.at(i) = slices.at(i).filename_;
 
     Volume* vh;
 
@@ -1986,7 +2279,7 @@ Volume* GdcmVolumeReader::readDicomFiles(const vector<string> &fileNames, const
     LINFO("Setting Meta Information:");
     //add all Tags that are found in the Standard Dictionary to the MetaInformation of the Volume,
     //if the attribute metaData is set to true and if the value is not empty
-    setMetaDataFromDict(&(vh->getMetaDataContainer()), dict_, slices[0].first);
+    setMetaDataFromDict(&(vh->getMetaDataContainer()), dict_, slices[0].filename_);
 
     //Set VolumeDateTime, depending on the tags found in the file
     MetaDataBase* volumeDateTime = constructVolumeDateTime(dict_, &sf);
@@ -2046,11 +2339,15 @@ VolumeRAM* GdcmVolumeReader::loadMultiframeDicomFile(const DicomInfo& info, cons
     }
 
     size_t posScalar = 0;
-    int slicesize = loadSlice(reinterpret_cast<char*>(dataset->getData()), sliceFiles.at(0), posScalar, info);
+    std::string message;
+    int slicesize = loadSlice(reinterpret_cast<char*>(dataset->getData()), sliceFiles.at(0), posScalar, info, message);
 
     if (getProgressBar())
         getProgressBar()->hide();
 
+    if (!message.empty())
+        LERROR(message);
+
     if (slicesize == 0) {
         //obviously an error in loadSlice method
         delete dataset;
@@ -2088,30 +2385,53 @@ VolumeRAM* GdcmVolumeReader::loadDicomSlices(DicomInfo info, std::vector<std::st
 
     LINFO("Reading slice data from " << sliceFiles.size() << " files...");
 
-    size_t posScalar = 0;
-
-    std::vector<std::string>::iterator it_slices = sliceFiles.begin();
-    size_t i = 0;
-    while (it_slices != sliceFiles.end()) {
-        if (getProgressBar()) {
-            getProgressBar()->setProgressMessage("Loading slice '" + tgt::FileSystem::fileName(*it_slices) + "' ...");
-            getProgressBar()->setProgress(static_cast<float>(i) / static_cast<float>(sliceFiles.size()));
-            i++;
+    if (getProgressBar())
+        getProgressBar()->setProgressMessage("Loading slices...");
+
+    //the slices are decoded concurrently, each one into its own part of the data set
+    const size_t sliceScalars = static_cast<size_t>(info.getDx()) * static_cast<size_t>(info.getDy()) * static_cast<size_t>(info.getNumberOfFrames());
+    const int numSlices = static_cast<int>(sliceFiles.size());
+    char* data = reinterpret_cast<char*>(dataset->getData());
+    int failedSlice = numSlices;
+    int messageSlice = numSlices;
+    std::string firstMessage;
+
+    //the workers must not log, so the message of the first slice that reported one is logged after the loop
+    #ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+    #endif
+    for (int i = 0; i < numSlices; i++) {
+        std::string message;
+        bool failed = (loadSlice(data, sliceFiles[i], i * sliceScalars, info, message) == 0);
+        if (failed || !message.empty()) {
+            #ifdef VRN_MODULE_OPENMP
+            #pragma omp critical(GdcmVolumeReader_loadDicomSlices)
+            #endif
+            {
+                //obviously an error in loadSlice method
+                if (failed)
+                    failedSlice = std::min(failedSlice, i);
+                if (!message.empty() && i < messageSlice) {
+                    messageSlice = i;
+                    firstMessage = message;
+                }
+            }
         }
 
-        int slicesize = loadSlice(reinterpret_cast<char*>(dataset->getData()), *it_slices, posScalar, info);
+        if (getProgressBar() && isMainThread())
+            getProgressBar()->setProgress(static_cast<float>(i) / static_cast<float>(numSlices));
+    }
 
-        if (slicesize == 0) {
-            //obviously an error in loadSlice method
-            delete[] dataset;
-            if (getProgressBar())
-                getProgressBar()->hide();
-            throw tgt::FileException("Failed to read Pixel data.", *it_slices);
-        }
+    if (!firstMessage.empty())
+        LERROR(firstMessage);
 
-        posScalar += slicesize;
-        it_slices++;
+    if (failedSlice < numSlices) {
+        delete dataset;
+        if (getProgressBar())
+            getProgressBar()->hide();
+        throw tgt::FileException("Failed to read Pixel data.", sliceFiles[failedSlice]);
     }
+
     if (getProgressBar())
         getProgressBar()->hide();
 
@@ -2120,39 +2440,26 @@ VolumeRAM* GdcmVolumeReader::loadDicomSlices(DicomInfo info, std::vector<std::st
     return dataset;
 }
 
-void GdcmVolumeReader::computeCorrectRescaleValues(std::vector<pair<string, double> > slices) {
+void GdcmVolumeReader::computeCorrectRescaleValues(const std::vector<SliceHeader>& slices) {
     //for every slice, it is assumed that the whole domain of the scalar type values is used
     float rwmMin = std::numeric_limits<float>::max();
-    float rwmMax = std::numeric_limits<float>::min();
-
-    float dataTypeMin, dataTypeMax;
+    float rwmMax = -std::numeric_limits<float>::max();
 
-    //get max and min real world values
-    std::vector<pair<string, double> >::iterator it_slices = slices.begin();
+    float dataTypeMin = 0.f;
+    float dataTypeMax = 0.f;
 
-    int i = 0;
-    while (it_slices != slices.end()) {
-        if (getProgressBar()) {
-            getProgressBar()->setProgressMessage("Calculating pixel rescaling...");
-            getProgressBar()->setProgress(static_cast<float>(i) / static_cast<float>(slices.size()));
-        }
-        i++;
-
-        gdcm::ImageReader reader;
-        reader.SetFileName(it_slices->first.c_str());
-        reader.Read();
-        float slope = static_cast<float>(reader.GetImage().GetSlope());
-        float intercept = static_cast<float>(reader.GetImage().GetIntercept());
+    //get max and min real world values from the slice headers
+    for (size_t i = 0; i < slices.size(); i++) {
+        float slope = slices[i].slope_;
+        float intercept = slices[i].intercept_;
 
-        dataTypeMin = static_cast<float>(reader.GetImage().GetPixelFormat().GetMin());
-        dataTypeMax = static_cast<float>(reader.GetImage().GetPixelFormat().GetMax());
+        dataTypeMin = static_cast<float>(slices[i].pixelFormat_.GetMin());
+        dataTypeMax = static_cast<float>(slices[i].pixelFormat_.GetMax());
         float sliceMin = dataTypeMin * slope + intercept;
         float sliceMax = dataTypeMax * slope + intercept;
 
         rwmMin = std::min(rwmMin, sliceMin);
         rwmMax = std::max(rwmMax, sliceMax);
-
-        it_slices++;
     }
 
     //Calculate correct global slope and intercept values
@@ -2161,19 +2468,16 @@ void GdcmVolumeReader::computeCorrectRescaleValues(std::vector<pair<string, doub
 
     info_.setSlope(globalSlope);
     info_.setIntercept(globalIntercept);
-
-    if (getProgressBar())
-        getProgressBar()->hide();
 }
 
 
-int GdcmVolumeReader::loadSlice(char* dataStorage, const std::string& fileName, size_t posScalar, DicomInfo info){
+int GdcmVolumeReader::loadSlice(char* dataStorage, const std::string& fileName, size_t posScalar, DicomInfo info, std::string& message){
 
     gdcm::ImageReader reader;
     reader.SetFileName(fileName.c_str());
 
     if (!reader.Read()){
-        LERROR("Error loading file " << fileName);
+        message = "Error loading file " + fileName;
         return 0;
     }
 
@@ -2181,7 +2485,7 @@ int GdcmVolumeReader::loadSlice(char* dataStorage, const std::string& fileName,
                         * static_cast<size_t>(info.getBytesPerVoxel()) * static_cast<size_t>(info.getNumberOfFrames()));
 
     if (reader.GetImage().GetBufferLength() != dataLength){
-        LERROR("Failed to read Pixel data from file " << fileName << " because of unexpected Buffer Length!");
+        message = "Failed to read Pixel data from file " + fileName + " because of unexpected Buffer Length!";
         return 0;
     }
 
@@ -2316,7 +2620,7 @@ int GdcmVolumeReader::loadSlice(char* dataStorage, const std::string& fileName,
                     }
                     break;
                 default:
-                    LERROR("Unexpected datatype while rescaling... no rescaling applied!");
+                    message = "Unexpected datatype while rescaling... no rescaling applied!";
             }
 
             //copy the rescaled values into the scalar buffer
@@ -2442,8 +2746,8 @@ std::vector<VolumeURL> GdcmVolumeReader::listVolumesDirectory(const VolumeURL& o
 {
     vector<VolumeURL> result;
 
-    //get all SeriesInstanceUID values of the DICOM files in the Directory
-    vector<string> filenames = getFileNamesInDir(origin.getPath());
+    //get all SeriesInstanceUID values of the DICOM files in the Directory (headers are scanned in parallel and buffered)
+    vector<string> filenames = scanDirectory(origin.getPath());
 
     std::set<string> seriesInstanceUIDvalues;
 
@@ -2460,23 +2764,19 @@ std::vector<VolumeURL> GdcmVolumeReader::listVolumesDirectory(const VolumeURL& o
             getProgressBar()->setProgress(static_cast<float>(itemused)/static_cast<float>(filenames.size()));
             itemused++;
         }
-        //try to read the file
-        gdcm::Reader reader;
-        reader.SetFileName(fileIterator->c_str());
-        if (!reader.Read())
+        //skip files that are not readable DICOM files
+        if (!isDicomFile(*fileIterator))
             continue;
         else {
-            //check for valid File Header
-            if (!reader.GetFile().GetHeader().IsValid()) {
+            //get the SeriesInstanceUID of the file
+            string seriesInstanceUID;
+            try {
+                seriesInstanceUID = getMetaDataFromFile(*fileIterator, *dict_, "SeriesInstanceUID");
+            }
+            catch (tgt::FileException&) {
                 LERROR("File Header not valid: " << *fileIterator);
                 continue;
             }
-
-            //get the SeriesInstanceUID of the file
-            gdcm::StringFilter sf;
-            sf.SetFile(reader.GetFile());
-
-            string seriesInstanceUID = sf.ToString(getTagFromDictEntry(dict_->getDictEntryByKeyword("SeriesInstanceUID")));
             seriesInstanceUID = trim(seriesInstanceUID, " ");
 
             if (seriesInstanceUID.empty()) {
@@ -48,6 +48,7 @@
 
 #include <string>
 #include <vector>
+#include <set>
 
 #include "./volumediskdicom.h"
 
@@ -158,6 +159,7 @@ protected:
     /**
      * Used by VolumeDiskDicom class to load several dicom slices of a volume.
      * Does not support multiframe files, only one slice per file.
+     * The slices are decoded in parallel, if the OpenMP module is enabled.
      *
      * @param info the DicomInfo object containing the necessary meta information (e.g. what the GdcmVolumeReader returns in a VolumeDiskDicom object)
      * @param sliceFiles the list of (correctly ordered!) slices (e.g. what the GdcmVolumeReader returns in a VolumeDiskDicom object)
@@ -175,11 +177,85 @@ protected:
 
 private:
 
+    /**
+     * Header information of a single slice file, read without reading the pixel data.
+     * Buffered and stored in the header index of the directory (@see scanDirectory).
+     */
+    struct SliceHeader : public Serializable {
+        SliceHeader();
+
+        std::string filename_;
+        tgt::dvec3 origin_;             ///< image position (patient)
+        double distance_;               ///< distance of the image position along the slice normal, not serialized
+        int numDimensions_;             ///< 3 for multiframe images, 2 otherwise
+        gdcm::PixelFormat pixelFormat_;
+        float slope_;
+        float intercept_;
+
+        /// Orders slices by their distance along the slice normal.
+        bool operator<(const SliceHeader& other) const { return distance_ < other.distance_; }
+
+        virtual void serialize(XmlSerializer& s) const;
+        virtual void deserialize(XmlDeserializer& s);
+    };
+
+    /// Persistent meta data and slice headers of the DICOM files in a directory (@see scanDirectory).
+    class DicomHeaderIndex;
+
     /**
      * Helper method that returns all filenames contained in a given directory.
      */
     virtual std::vector<std::string> getFileNamesInDir(const std::string& dirName) const;
 
+    /**
+     * Helper method that returns all filenames contained in a given directory and reads the headers
+     * of the files into the file info buffer and the slice header buffer (@see scanFileHeaders). The
+     * buffers are initialized from and written back to a persistent header index of the directory,
+     * which is valid as long as the directory's modification time does not change. It is only used
+     * if caching is enabled.
+     */
+    std::vector<std::string> scanDirectory(const std::string& dirName) const;
+
+    /**
+     * Reads the headers of all passed files that are not yet in the file info buffer in parallel (if the
+     * OpenMP module is enabled) and puts their meta data and slice headers into the buffers. Stops reading before
+     * the pixel data. The meta data of the Standard Dictionary and of all CustomDicomDicts is buffered.
+     *
+     * @return the number of files that have been read
+     */
+    size_t scanFileHeaders(const std::vector<std::string>& filenames) const;
+
+    /// Returns the file name of the persistent header index of the passed directory, or an empty string if caching is disabled.
+    std::string getHeaderIndexFileName(const std::string& dirName) const;
+
+    /// Adds the content of the header index of the passed directory to the file info buffer, if the index is up to date.
+    void loadHeaderIndex(const std::string& dirName) const;
+
+    /// Writes the buffered meta data and slice headers of the passed files into the header index of the passed directory.
+    void saveHeaderIndex(const std::string& dirName, const std::vector<std::string>& filenames) const;
+
+    /**
+     * Helper method that reads a DICOM file up to (excluding) the pixel data.
+     *
+     * @return true, if the file is a readable DICOM file
+     */
+    static bool readFileHeader(gdcm::Reader& reader, const std::string& filename);
+
+    /// Reads the slice header information from the passed file header. The distance is not computed.
+    static void readSliceHeader(const gdcm::File& file, const std::string& filename, SliceHeader& slice);
+
+    /**
+     * Returns the slice headers of the passed files. Headers that are not in the slice header buffer
+     * are read in parallel (if the OpenMP module is enabled) without reading the pixel data.
+     *
+     * @param filenames the slice files
+     * @param sliceNormal the normal used to compute the distance of each slice's position
+     *
+     * @throw tgt::FileException if a file could not be read
+     */
+    std::vector<SliceHeader> readSliceHeaders(const std::vector<std::string>& filenames, const tgt::dvec3& sliceNormal) const
+        throw (tgt::FileException);
+
     /**
      * Helper method that determines if a file exists and is a readable Dicom file.
      *
@@ -219,6 +295,12 @@ private:
      */
     static void setMetaDataFromDict(MetaDataContainer* container, const DicomDict* dict, const std::string& file, bool setAll = false) throw (tgt::FileException);
 
+    /**
+     * Extracts the meta data of an already read DICOM file to the MetaDataContainer.
+     * @see setMetaDataFromDict
+     */
+    static void setMetaDataFromDict(MetaDataContainer* container, const DicomDict* dict, const gdcm::File& file, bool setAll = false);
+
     /**
      * Helper method that returns all CustomDicomDicts in the directory <Gdcm-Module>/Dicts/CustomDicts
      */
@@ -285,18 +367,22 @@ private:
      * @param fileName name of the file to be loaded
      * @param posScalar offset into the dataStorage array where this particular slice's pixel data should begin
      * @param info DicomInfo object containig meta information about the volume (e.g. for rescaling)
+     * @param message receives a description of the problem, if the slice could not be loaded or not be rescaled
+     *
+     * @note Is called concurrently for different slices by loadDicomSlices and must therefore neither modify
+     *       the reader's state nor log messages. The caller is responsible for logging the returned message.
      *
-     * @return returns the number of voxels rendered
+     * @return returns the number of voxels rendered, 0 if the slice could not be loaded
      */
-    virtual int loadSlice(char* dataStorage, const std::string& fileName, size_t posScalar, DicomInfo info);
+    virtual int loadSlice(char* dataStorage, const std::string& fileName, size_t posScalar, DicomInfo info, std::string& message);
 
     /**
      * Helper method that finds the correct rescale slope and intercept values for a list of slices where these differ.
      * The correct values are set to info_
      *
-     * @param slices a vector of pairs of a filename and the distance from the origin position of the volume
+     * @param slices the headers of the slice files
      */
-    void computeCorrectRescaleValues(std::vector<std::pair<std::string, double> > slices);
+    void computeCorrectRescaleValues(const std::vector<SliceHeader>& slices);
 
 
 
@@ -360,6 +446,8 @@ private:
 
     mutable std::map<std::string, MetaDataContainer> fileInfoBuffer_; ///< used to buffer information about files to reduce file I/Os, buffer is cleared when reading a new dataset and the buffer has not been modified for 10 minutes
     mutable DateTime lastBufferMod_; ///< used as a heuristic to check when to clear the buffer
+    mutable std::set<std::string> nonDicomFiles_; ///< files found not to be readable DICOM files, cleared with the file info buffer
+    mutable std::map<std::string, SliceHeader> sliceHeaderBuffer_; ///< slice headers of the buffered files, cleared with the file info buffer
 };
 
 }
@@ -0,0 +1,82 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "plotcolumn.h"
+#include "plotrow.h"
+
+#include <map>
+#include <limits>
+
+namespace voreen {
+
+const uint32_t PlotColumn::VALUE_CODE = 0xFFFFFFFF;
+const uint32_t PlotColumn::NULL_CODE = 0xFFFFFFFE;
+
+PlotColumn::PlotColumn(const std::vector<PlotRowValue>& rows, int column)
+    : values_(rows.size(), std::numeric_limits<plot_t>::quiet_NaN())
+    , codes_(rows.size(), NULL_CODE)
+{
+    std::map<std::string, uint32_t> dictionaryIndex;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const PlotCellValue& cell = rows[i].getCellAt(column);
+        if (cell.isValue()) {
+            values_[i] = cell.getValue();
+            codes_[i] = VALUE_CODE;
+        }
+        else if (cell.isTag()) {
+            const std::string tag = cell.getTag();
+            // tags tend to occur in runs, so check the previous row first
+            if (i > 0 && codes_[i-1] < dictionary_.size() && dictionary_[codes_[i-1]] == tag) {
+                codes_[i] = codes_[i-1];
+                continue;
+            }
+            std::map<std::string, uint32_t>::const_iterator it = dictionaryIndex.find(tag);
+            if (it == dictionaryIndex.end()) {
+                it = dictionaryIndex.insert(std::make_pair(tag, static_cast<uint32_t>(dictionary_.size()))).first;
+                dictionary_.push_back(cell.getTag());
+            }
+            codes_[i] = it->second;
+        }
+    }
+}
+
+size_t PlotColumn::size() const {
+    return codes_.size();
+}
+
+const std::vector<plot_t>& PlotColumn::getValues() const {
+    return values_;
+}
+
+const std::vector<uint32_t>& PlotColumn::getCodes() const {
+    return codes_;
+}
+
+const std::vector<std::string>& PlotColumn::getDictionary() const {
+    return dictionary_;
+}
+
+} // namespace voreen
@@ -0,0 +1,78 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#ifndef VRN_PLOTCOLUMN_H
+#define VRN_PLOTCOLUMN_H
+
+#include "plotbase.h"
+
+#include <vector>
+#include <string>
+
+namespace voreen {
+
+class PlotRowValue;
+
+/**
+ * Column-oriented copy of a single PlotData column serving as acceleration structure for queries.
+ *
+ * Values are stored in a contiguous plot_t array holding NaN for each cell that is not a value, so
+ * that numeric predicates and aggregation functions can run over the plain array. Tags are
+ * dictionary-encoded: for each row a code is stored that either indexes the dictionary of distinct
+ * tags or marks the cell as value cell resp. null cell. Hence, tag predicates have to be evaluated
+ * only once per distinct tag.
+ *
+ * PlotColumns are built lazily by PlotData and discarded on each modification of its rows.
+ */
+class VRN_CORE_API PlotColumn {
+public:
+    static const uint32_t VALUE_CODE;   ///< code of value cells
+    static const uint32_t NULL_CODE;    ///< code of null cells
+
+    /// Builds the column with index \a column from the given rows.
+    PlotColumn(const std::vector<PlotRowValue>& rows, int column);
+
+    /// Returns the number of rows.
+    size_t size() const;
+
+    /// Returns the values of all rows, NaN for tag and null cells.
+    const std::vector<plot_t>& getValues() const;
+
+    /// Returns the code of each row: an index into the dictionary, VALUE_CODE or NULL_CODE.
+    const std::vector<uint32_t>& getCodes() const;
+
+    /// Returns the distinct tags of the column in order of their first occurrence.
+    const std::vector<std::string>& getDictionary() const;
+
+private:
+    std::vector<plot_t> values_;
+    std::vector<uint32_t> codes_;
+    std::vector<std::string> dictionary_;
+};
+
+} // namespace voreen
+
+#endif // VRN_PLOTCOLUMN_H
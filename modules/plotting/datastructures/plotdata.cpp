@@ -27,6 +27,7 @@
 #include "plotpredicate.h"
 #include "plotrow.h"
 #include "plotcell.h"
+#include "plotcolumn.h"
 
 #include "tgt/assert.h"
 #include "tgt/logmanager.h"
@@ -67,6 +68,7 @@ PlotData::PlotData(const PlotData& rhs)
 
 PlotData::~PlotData() {
     deleteImplicitRows();
+    clearColumnCache();
 }
 
 PlotData& PlotData::operator=(const PlotData& rhs) {
@@ -79,6 +81,7 @@ PlotData& PlotData::operator=(const PlotData& rhs) {
     // we do not use the copy-and-swap pattern here for performance reasons (avoid walking through all cells twice)
     // if an exception raises, this object will be empty but valid
     try {
+        clearColumnCache();
         rows_ = rhs.rows_;
         intervals_ = rhs.intervals_;
         sorted_ = rhs.sorted_;
@@ -124,19 +127,11 @@ PlotData& PlotData::operator=(const PlotData& rhs) {
 void PlotData::select(const std::vector< std::pair< int, PlotPredicate*> >& predicates, PlotData& target) const {
     target.reset(keyColumnCount_, dataColumnCount_);
 
-    std::vector<PlotRowValue>::const_iterator rit;
-    bool matches;
-    for (rit = rows_.begin(); rit < rows_.end(); ++rit) {
-        matches = true;
-        for (size_t i = 0; i < predicates.size(); ++i) {
-            if (!predicates.at(i).second->check(rit->getCellAt(predicates.at(i).first))) {
-                matches = false;
-                break;
-            }
-        }
-        if (matches) {
-            target.insert(rit->getCells());
-        }
+    std::vector<char> matches;
+    checkPredicates(predicates, matches);
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        if (matches[i])
+            target.insert(rows_[i].getCells());
     }
     for (int i = 0; i < getColumnCount(); ++i) {
         target.setColumnLabel(i,getColumnLabel(i));
@@ -185,22 +180,14 @@ void PlotData::select(const std::vector< int >& columns, int keyColumnCount, int
     if (columns.size() != 0) {
         columnCount = keyColumnCount + dataColumnCount;
 
-        std::vector<PlotRowValue>::const_iterator it;
-        std::vector<std::pair<int, PlotPredicate*> >::const_iterator pit;
-        bool matches;
+        std::vector<char> matches;
+        checkPredicates(predicates, matches);
         int i;
-        for (it = rows_.begin(); it < rows_.end(); ++it) {
-            std::vector<PlotCellValue> cellsToInsert;
-            matches = true;
-            for (pit = predicates.begin(); pit < predicates.end(); ++pit) {
-                if (! pit->second->check(it->getCellAt(pit->first))) {
-                    matches = false;
-                    break;
-                }
-            }
-            if (matches) {
+        for (size_t row = 0; row < rows_.size(); ++row) {
+            if (matches[row]) {
+                std::vector<PlotCellValue> cellsToInsert;
                 for (i=0; i< columnCount; ++i) {
-                    cellsToInsert.push_back(it->getCellAt(columns[i]));
+                    cellsToInsert.push_back(rows_[row].getCellAt(columns[i]));
                 }
                 target.insert(cellsToInsert);
             }
@@ -264,12 +251,8 @@ void PlotData::select(const std::vector<int>& columns, const std::vector<int>& r
 }
 
 plot_t PlotData::aggregate(int column, const AggregationFunction* function) const {
-    std::vector<plot_t> values;
-    std::vector<PlotRowValue>::const_iterator it;
-    for (it = rows_.begin(); it < rows_.end(); ++it) {
-        values.push_back(it->getValueAt(column));
-    }
-
+    // the function may reorder the values, so it has to work on a copy
+    std::vector<plot_t> values(getColumn(column).getValues());
     plot_t toReturn = function->evaluate(values);
     return toReturn;
 }
@@ -307,6 +290,7 @@ bool PlotData::insert(const std::vector<plot_t>& values) {
         }
 
         sorted_ = false;
+        clearColumnCache();
         rows_.push_back(PlotRowValue(this, cellsToInsert));
         updateIntervals(rows_.back());
         return true;
@@ -349,6 +333,7 @@ bool PlotData::insert(std::vector<std::pair<int, plot_t> >& values) {
             }
         }
         sorted_ = false;
+        clearColumnCache();
         rows_.push_back(PlotRowValue(this, cellsToInsert));
         updateIntervals(rows_.back());
         return true;
@@ -383,6 +368,7 @@ bool PlotData::insert(const std::vector<std::string>& tags) {
         }
 
         sorted_ = false;
+        clearColumnCache();
         rows_.push_back(PlotRowValue(this, cellsToInsert));
         updateIntervals(rows_.back());
         return true;
@@ -419,6 +405,7 @@ bool PlotData::insert(const std::vector<std::pair<int, std::string> >& tags) {
         }
 
         sorted_ = false;
+        clearColumnCache();
         rows_.push_back(PlotRowValue(this, cellsToInsert));
         updateIntervals(rows_.back());
         return true;
@@ -463,6 +450,7 @@ bool PlotData::insert(const std::vector< PlotCellValue >& cells) {
             }
         }
         sorted_ = false;
+        clearColumnCache();
         rows_.push_back(PlotRowValue(this, newcells));
         updateIntervals(rows_.back());
         return true;
@@ -503,6 +491,7 @@ bool PlotData::insert(std::vector< PlotCellValue >& cells) {
             // elsewise everything should be fine
         }
         sorted_ = false;
+        clearColumnCache();
         rows_.push_back(PlotRowValue(this, cells));
         updateIntervals(rows_.back());
         return true;
@@ -549,6 +538,7 @@ bool PlotData::insert(const std::vector< std::pair<int, PlotCellValue > >& cells
             }
         }
     sorted_ = false;
+    clearColumnCache();
     rows_.push_back(PlotRowValue(this, cellsToInsert));
     updateIntervals(rows_.back());
     return true;
@@ -563,26 +553,40 @@ std::vector<PlotRowValue>::const_iterator PlotData::lower_bound(const std::vecto
 }
 
 int PlotData::remove(const std::vector<std::pair<int, PlotPredicate*> >& predicates) {
-    std::vector<PlotRowValue>::iterator rit;
+    // a row is removed if it matches any of the predicates
+    std::vector<char> matched(rows_.size(), 0);
+    std::vector<char> matches;
     std::vector<std::pair<int, PlotPredicate*> >::const_iterator pit;
+    for (pit = predicates.begin(); pit < predicates.end(); ++pit) {
+        matches.assign(rows_.size(), 1);
+        pit->second->checkColumn(getColumn(pit->first), matches);
+        for (size_t i = 0; i < rows_.size(); ++i)
+            matched[i] |= matches[i];
+    }
 
     int count = 0;
-    bool matched;
-    rit = rows_.begin();
-    while (rit < rows_.end()) {
-        matched = false;
-        for (pit = predicates.begin(); pit < predicates.end(); ++pit)
-            if (pit->second->check(rit->getCellAt(pit->first))) {
-                matched = true;
-                break;
-            }
-        if (matched) {
-            removePointersToCellsOfRow(*rit);
-            rit = rows_.erase(rit);
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        if (matched[i])
             ++count;
-        }
-        else {
-            ++rit;
+    }
+    if (count == 0)
+        return 0;
+
+    // compact the remaining rows in one pass, this moves the cells, so the highlighted cells are collected anew
+    std::vector<PlotRowValue> remainingRows;
+    remainingRows.reserve(rows_.size() - count);
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        if (!matched[i])
+            remainingRows.push_back(rows_[i]);
+    }
+    clearColumnCache();
+    rows_.swap(remainingRows);
+
+    highlightedCells_.clear();
+    for (std::vector<PlotRowValue>::iterator it = rows_.begin(); it < rows_.end(); ++it) {
+        for (std::vector<PlotCellValue>::iterator cit = it->cells_.begin(); cit != it->cells_.end(); ++cit) {
+            if (cit->isHighlighted())
+                highlightedCells_.insert(&(*cit));
         }
     }
 
@@ -638,154 +642,71 @@ bool PlotData::groupBy(int groupColumn, const std::vector<std::pair<int, Aggrega
 
     target.reset(1, static_cast<int>(functions.size()));
 
-    // we will sort and group the data into hashmaps before applying the AggregationFunctions to them
-    std::map<plot_t, std::vector<plot_t>*> groupedByValues;
-    std::map<std::string, std::vector<plot_t>*> groupedByTags;
-    std::map<bool, std::vector<plot_t>*> groupedByNulls;
-
-    std::map<plot_t, std::vector<plot_t>*>::iterator gbvIt;
-    std::map<std::string, std::vector<plot_t>*>::iterator gbtIt;
-    std::map<bool, std::vector<plot_t>*>::iterator gbnIt;
-    // alright, we will start with grouping the data in our hashmaps
-    int funcCount = static_cast<int>(functions.size());
-    std::vector<PlotRowValue>::const_iterator rowIt;
-    for (rowIt = rows_.begin(); rowIt != rows_.end(); ++rowIt) {
-        const PlotCellValue& groupedCell = rowIt->getCellAt(groupColumn);
-
-        // check whether to group by value or by tag - here we group by value
-        if (groupedCell.isValue()) {
-            // check if the data in this cell is already in the hashmap -> a group for it already exists
-            gbvIt = groupedByValues.find(groupedCell.getValue());
-
-            // it is not in the hashmap -> create new group
-            if (gbvIt == groupedByValues.end()) {
-                // first we create an array of vector of plot_t where we will store the data which shall be aggregated:
-                std::vector<plot_t>* temp = new std::vector<plot_t>[funcCount]();
-                for (int i=0; i< funcCount; ++i) {
-                    temp[i].push_back(rowIt->getValueAt(functions[i].first));
-                }
-                groupedByValues.insert(std::pair<plot_t, std::vector<plot_t>*>(groupedCell.getValue(), temp));
-            }
-            // there is already an entry in the hashmap, so just push the values into the vector which shall be aggregated
-            else {
-                std::vector<plot_t>* temp = gbvIt->second;
-                for (int i=0; i< funcCount; ++i) {
-                    temp[i].push_back(rowIt->getValueAt(functions[i].first));
-                }
-            }
-        }
-        else if(groupedCell.isNull()) {
-            gbnIt = groupedByNulls.find(groupedCell.isNull());
-            if (gbnIt == groupedByNulls.end()) {
-                // first we create an array of vector of plot_t where we will store the data which shall be aggregated:
-                std::vector<plot_t>* temp = new std::vector<plot_t>[funcCount];
-                for (int i=0; i< funcCount; ++i) {
-                    temp[i].push_back(rowIt->getValueAt(functions[i].first));
-                }
-                groupedByNulls.insert(std::pair<bool, std::vector<plot_t>*>(groupedCell.isNull(), temp));
-            }
-            // there is already an entry in the hashmap, so just push the values into the vector which shall be aggregated
-            else {
-                std::vector<plot_t>* temp = gbnIt->second;
-                for (int i=0; i< funcCount; ++i) {
-                    temp[i].push_back(rowIt->getValueAt(functions[i].first));
-                }
-            }
-        }
-        // ok, we group by tag
-        else {
-            // check if the data in this cell is already in the hashmap -> a group for it already exists
-            gbtIt = groupedByTags.find(groupedCell.getTag());
-
-            // it is not in the hashmap -> create new group
-            if (gbtIt == groupedByTags.end()) {
-                // first we create an array of vector of plot_t where we will store the data which shall be aggregated:
-                std::vector<plot_t>* temp = new std::vector<plot_t>[funcCount];
-                for (int i=0; i< funcCount; ++i) {
-                    temp[i].push_back(rowIt->getValueAt(functions[i].first));
-                }
-                groupedByTags.insert(std::pair<std::string, std::vector<plot_t>*>(groupedCell.getTag(), temp));
-            }
-            // there is already an entry in the hashmap, so just push the values into the vector which shall be aggregated
-            else {
-                std::vector<plot_t>* temp = gbtIt->second;
-                for (int i=0; i< funcCount; ++i) {
-                    temp[i].push_back(rowIt->getValueAt(functions[i].first));
-                }
-            }
-        }
+    // assign each row to a group via the column-oriented copy of the group column:
+    // groups are ordered by value first, then by tag, finally the null group
+    const PlotColumn& groupCol = getColumn(groupColumn);
+    const std::vector<plot_t>& groupValues = groupCol.getValues();
+    const std::vector<uint32_t>& groupCodes = groupCol.getCodes();
+    const std::vector<std::string>& dictionary = groupCol.getDictionary();
+
+    std::map<plot_t, size_t> valueGroups;
+    bool hasNulls = false;
+    for (size_t i = 0; i < groupCodes.size(); ++i) {
+        if (groupCodes[i] == PlotColumn::VALUE_CODE)
+            valueGroups.insert(std::make_pair(groupValues[i], 0));
+        else if (groupCodes[i] == PlotColumn::NULL_CODE)
+            hasNulls = true;
     }
 
-    // grouping is done, now, we will insert the grouped data into the target PlotData
-    // first insert all groupedByValues rows
-    for (gbvIt = groupedByValues.begin(); gbvIt != groupedByValues.end(); ++gbvIt) {
-        std::vector<PlotCellValue> cells;
-        cells.push_back(PlotCellValue(gbvIt->first));
-
-        for (int i=0; i<funcCount; ++i) {
-            plot_t val = functions[i].second->evaluate(gbvIt->second[i]);
-            if (val != val){
-                cells.push_back(PlotCellValue());
-            }
-            else {
-                cells.push_back(PlotCellValue(functions[i].second->evaluate(gbvIt->second[i])));
-            }
-        }
-
-        target.insert(cells);
+    std::vector<PlotCellValue> groupKeys;
+    for (std::map<plot_t, size_t>::iterator it = valueGroups.begin(); it != valueGroups.end(); ++it) {
+        it->second = groupKeys.size();
+        groupKeys.push_back(PlotCellValue(it->first));
     }
-
-    // now insert all groupedByTags rows
-    for (gbtIt = groupedByTags.begin(); gbtIt != groupedByTags.end(); ++gbtIt) {
-        std::vector<PlotCellValue> cells;
-        cells.push_back(PlotCellValue(gbtIt->first));
-
-        for (int i=0; i<funcCount; ++i) {
-            plot_t val = functions[i].second->evaluate(gbtIt->second[i]);
-            if (val != val){
-                cells.push_back(PlotCellValue());
-            }
-            else {
-                cells.push_back(PlotCellValue(functions[i].second->evaluate(gbtIt->second[i])));
-            }
-        }
-
-        target.insert(cells);
+    std::map<std::string, uint32_t> sortedTags;
+    for (size_t i = 0; i < dictionary.size(); ++i)
+        sortedTags.insert(std::make_pair(dictionary[i], static_cast<uint32_t>(i)));
+    std::vector<size_t> tagGroups(dictionary.size());
+    for (std::map<std::string, uint32_t>::const_iterator it = sortedTags.begin(); it != sortedTags.end(); ++it) {
+        tagGroups[it->second] = groupKeys.size();
+        groupKeys.push_back(PlotCellValue(it->first));
+    }
+    const size_t nullGroup = groupKeys.size();
+    if (hasNulls)
+        groupKeys.push_back(PlotCellValue());
+
+    std::vector<size_t> rowGroups(groupCodes.size());
+    for (size_t i = 0; i < groupCodes.size(); ++i) {
+        if (groupCodes[i] == PlotColumn::VALUE_CODE)
+            rowGroups[i] = valueGroups.find(groupValues[i])->second;
+        else if (groupCodes[i] == PlotColumn::NULL_CODE)
+            rowGroups[i] = nullGroup;
+        else
+            rowGroups[i] = tagGroups[groupCodes[i]];
     }
-        // now insert all groupedByNulls rows
-    for (gbnIt = groupedByNulls.begin(); gbnIt != groupedByNulls.end(); ++gbnIt) {
-        std::vector<PlotCellValue> cells;
-        cells.push_back(PlotCellValue());
 
-        for (int i=0; i<funcCount; ++i) {
-            plot_t val = functions[i].second->evaluate(gbnIt->second[i]);
-            if (val != val){
-                cells.push_back(PlotCellValue());
-            }
-            else {
-                cells.push_back(PlotCellValue(functions[i].second->evaluate(gbnIt->second[i])));
-            }
+    // now gather the values of each function column group-wise and aggregate them
+    std::vector< std::vector<PlotCellValue> > groupedRows(groupKeys.size());
+    for (size_t g = 0; g < groupKeys.size(); ++g)
+        groupedRows[g].push_back(groupKeys[g]);
+
+    for (size_t f = 0; f < functions.size(); ++f) {
+        const std::vector<plot_t>& values = getColumn(functions[f].first).getValues();
+        std::vector< std::vector<plot_t> > groupedValues(groupKeys.size());
+        for (size_t i = 0; i < values.size(); ++i)
+            groupedValues[rowGroups[i]].push_back(values[i]);
+
+        for (size_t g = 0; g < groupKeys.size(); ++g) {
+            plot_t val = functions[f].second->evaluate(groupedValues[g]);
+            if (val != val)
+                groupedRows[g].push_back(PlotCellValue());
+            else
+                groupedRows[g].push_back(PlotCellValue(val));
         }
-
-        target.insert(cells);
     }
 
-    // finally free all data which is not necessary anymore:
-    while (groupedByValues.size() > 0) {
-        gbvIt = groupedByValues.begin();
-        delete [] gbvIt->second;
-        groupedByValues.erase(gbvIt);
-    }
-    while (groupedByTags.size() > 0) {
-        gbtIt = groupedByTags.begin();
-        delete [] gbtIt->second;
-        groupedByTags.erase(gbtIt);
-    }
-    while (groupedByNulls.size() > 0) {
-        gbnIt = groupedByNulls.begin();
-        delete [] gbnIt->second;
-        groupedByNulls.erase(gbnIt);
-    }
+    for (size_t g = 0; g < groupedRows.size(); ++g)
+        target.insert(groupedRows[g]);
 
     for (int i = 0; i < static_cast<int>(functions.size()); ++i) {
         target.setColumnLabel(i+1,getColumnLabel(functions.at(i).first));
@@ -1241,6 +1162,7 @@ void PlotData::removePointersToCellsOfRow(PlotRowValue& row) {
 }
 
 void PlotData::reset(int keyColumnCount, int dataColumnCount) {
+    clearColumnCache();
     highlightedCells_.clear();
     rows_.clear();
     deleteImplicitRows();
@@ -1283,12 +1205,37 @@ void PlotData::sortRows() const {
             // (the items of this plot data are still the same) sortRows() is const. So we do a const cast
             // here to be allowed to call std::sort
             PlotData* foo = const_cast<PlotData*>(this);
+            clearColumnCache();
             std::sort(foo->rows_.begin(), foo->rows_.end());
             sorted_ = true;
         }
     }
 }
 
+const PlotColumn& PlotData::getColumn(int column) const {
+    tgtAssert(column >= 0 && column < getColumnCount(), "PlotData::getColumn(): column out of bounds");
+    // concurrent const queries may build different columns at the same time
+    boost::lock_guard<boost::mutex> lock(columnCacheMutex_);
+    if (columnCache_.size() != static_cast<size_t>(getColumnCount()))
+        columnCache_.resize(getColumnCount(), 0);
+    if (!columnCache_[column])
+        columnCache_[column] = new PlotColumn(rows_, column);
+    return *columnCache_[column];
+}
+
+void PlotData::clearColumnCache() const {
+    for (size_t i = 0; i < columnCache_.size(); ++i)
+        delete columnCache_[i];
+    columnCache_.clear();
+}
+
+void PlotData::checkPredicates(const std::vector<std::pair<int, PlotPredicate*> >& predicates, std::vector<char>& matches) const {
+    matches.assign(rows_.size(), 1);
+    std::vector<std::pair<int, PlotPredicate*> >::const_iterator pit;
+    for (pit = predicates.begin(); pit < predicates.end(); ++pit)
+        pit->second->checkColumn(getColumn(pit->first), matches);
+}
+
 bool PlotData::sorted() const {
     return sorted_;
 }
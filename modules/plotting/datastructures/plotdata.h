@@ -32,6 +32,8 @@
 #include <vector>
 #include <set>
 
+#include <boost/thread/mutex.hpp>
+
 namespace voreen {
 
 class AggregationFunction;
@@ -40,13 +42,19 @@ class PlotCellValue;
 class PlotCellImplicit;
 class PlotRowValue;
 class PlotRowImplicit;
+class PlotColumn;
 
 /**
  * \brief   A PlotData stores rows which can be sorted by key columns. Insert and find calls should be fast.
  *
+ * The rows are the primary storage. Queries (select, remove, aggregate, groupBy) work on
+ * PlotColumns instead, which are column-oriented copies of single columns built on demand.
+ * getColumn() may be called concurrently, modifications (including sortRows()) have to be synchronized by the caller.
+ *
  * \note    As we are handling pointers in private member highlightedCells_, it is crucial to
  *          pay attention on implementing new member functions. Especially if you plan to
  *          modify rows_ make sure all pointers in this set remain valid or are removed!
+ *          Also call clearColumnCache() whenever the content or order of rows_ changes.
  *
  **/
 class VRN_CORE_API PlotData : public PlotBase {
@@ -379,6 +387,15 @@ public:
     /// Returns the number of PlotRowImplicits in this PlotData.
     int getImplicitRowsCount() const;
 
+    /**
+     * \brief  Returns a column-oriented copy of column \a column, which is built on first access.
+     *
+     * Only the requested column is built. This function may be called by concurrent readers.
+     *
+     * \note    The returned reference is invalidated by any modification of the rows, including sortRows().
+     **/
+    const PlotColumn& getColumn(int column) const;
+
     /// Returns whether this PlotData has PlotRowValues or not.
     bool rowsEmpty() const;
     /// Returns whether this PlotData has PlotRowImplicits or not.
@@ -458,6 +475,17 @@ private:
      **/
     void removePointersToCellsOfRow(PlotRowValue& row);
 
+    /// Deletes all cached PlotColumns, is to be called on each modification of rows_.
+    void clearColumnCache() const;
+
+    /**
+     * \brief   Evaluates \a predicates on the columns and stores for each row whether it matches all of them.
+     *
+     * \param   predicates  PlotPredicates paired with the index of the column to apply them to
+     * \param   matches     receives one entry per row, non-zero if the row matches all predicates
+     **/
+    void checkPredicates(const std::vector<std::pair<int, PlotPredicate*> >& predicates, std::vector<char>& matches) const;
+
     /**
      * \brief   all value rows of this PlotData
      *
@@ -487,6 +515,10 @@ private:
     /// flag whether rows_ is sorted lexicographically by key columns or not
     mutable bool sorted_;
 
+    /// lazily built column-oriented copies of the columns, 0 for columns not built yet
+    mutable std::vector<PlotColumn*> columnCache_;
+    mutable boost::mutex columnCacheMutex_; ///< serializes building columns in getColumn()
+
 };
 
 } // namespace voreen
@@ -24,6 +24,9 @@
  ***********************************************************************************/
 
 #include "plotpredicate.h"
+#include "plotcolumn.h"
+
+#include "tgt/assert.h"
 
 #include <limits>
 #include <sstream>
@@ -40,6 +43,87 @@ namespace {
         else if (base < 0)
             ss << std::setprecision(precision);
     }
+
+    /**
+     * Clears each entry of \a mask whose value does not fulfill \a op. As the column stores NaN for
+     * non-value cells and each comparison with NaN fails, these cells never fulfill \a op.
+     */
+    template<class Op>
+    void checkColumnValues(const PlotColumn& column, const Op& op, std::vector<char>& mask) {
+        tgtAssert(mask.size() == column.size(), "mask size does not match column size");
+        const std::vector<plot_t>& values = column.getValues();
+        const size_t numRows = values.size();
+        for (size_t i = 0; i < numRows; ++i)
+            mask[i] &= static_cast<char>(op(values[i]));
+    }
+
+    struct LessOp {
+        LessOp(plot_t threshold) : threshold_(threshold) {}
+        bool operator()(plot_t value) const { return value < threshold_; }
+        plot_t threshold_;
+    };
+
+    struct EqualOp {
+        EqualOp(plot_t threshold) : threshold_(threshold) {}
+        bool operator()(plot_t value) const { return value == threshold_; }
+        plot_t threshold_;
+    };
+
+    struct GreaterOp {
+        GreaterOp(plot_t threshold) : threshold_(threshold) {}
+        bool operator()(plot_t value) const { return value > threshold_; }
+        plot_t threshold_;
+    };
+
+    struct BetweenOp {
+        BetweenOp(plot_t lower, plot_t upper) : lower_(lower), upper_(upper) {}
+        bool operator()(plot_t value) const { return value > lower_ && value < upper_; }
+        plot_t lower_, upper_;
+    };
+
+    struct NotBetweenOp {
+        NotBetweenOp(plot_t lower, plot_t upper) : lower_(lower), upper_(upper) {}
+        bool operator()(plot_t value) const { return value <= lower_ || value >= upper_; }
+        plot_t lower_, upper_;
+    };
+
+    struct BetweenOrEqualOp {
+        BetweenOrEqualOp(plot_t lower, plot_t upper) : lower_(lower), upper_(upper) {}
+        bool operator()(plot_t value) const { return value >= lower_ && value <= upper_; }
+        plot_t lower_, upper_;
+    };
+
+    struct NotBetweenOrEqualOp {
+        NotBetweenOrEqualOp(plot_t lower, plot_t upper) : lower_(lower), upper_(upper) {}
+        bool operator()(plot_t value) const { return value < lower_ || value > upper_; }
+        plot_t lower_, upper_;
+    };
+}
+
+// PlotPredicate methods -----------------------------------------------------------
+
+void PlotPredicate::checkColumn(const PlotColumn& column, std::vector<char>& mask) const {
+    tgtAssert(mask.size() == column.size(), "mask size does not match column size");
+    const std::vector<plot_t>& values = column.getValues();
+    const std::vector<uint32_t>& codes = column.getCodes();
+    const std::vector<std::string>& dictionary = column.getDictionary();
+
+    // tag and null cells are checked only once
+    std::vector<char> tagResults(dictionary.size());
+    for (size_t i = 0; i < dictionary.size(); ++i)
+        tagResults[i] = check(PlotCellValue(dictionary[i]));
+    const char nullResult = check(PlotCellValue());
+
+    for (size_t i = 0; i < codes.size(); ++i) {
+        if (!mask[i])
+            continue;
+        if (codes[i] == PlotColumn::VALUE_CODE)
+            mask[i] = check(PlotCellValue(values[i]));
+        else if (codes[i] == PlotColumn::NULL_CODE)
+            mask[i] = nullResult;
+        else
+            mask[i] = tagResults[codes[i]];
+    }
 }
 
 // PlotPredicateLess methods -------------------------------------------------------
@@ -85,6 +169,13 @@ bool PlotPredicateLess::check(const PlotCellValue& value) const {
         || (value.isTag() && threshold_.isTag() && value.getTag() < threshold_.getTag()));
 }
 
+void PlotPredicateLess::checkColumn(const PlotColumn& column, std::vector<char>& mask) const {
+    if (threshold_.isValue())
+        checkColumnValues(column, LessOp(threshold_.getValue()), mask);
+    else
+        PlotPredicate::checkColumn(column, mask);
+}
+
 Interval<plot_t> PlotPredicateLess::getIntervalRepresentation() const {
     return Interval<plot_t>(-std::numeric_limits<plot_t>::max(), threshold_.getValue(), false, true);
 }
@@ -159,6 +250,13 @@ bool PlotPredicateEqual::check(const PlotCellValue& value) const {
         (value.isTag() && threshold_.isTag() && value.getTag() == threshold_.getTag()));
 }
 
+void PlotPredicateEqual::checkColumn(const PlotColumn& column, std::vector<char>& mask) const {
+    if (threshold_.isValue())
+        checkColumnValues(column, EqualOp(threshold_.getValue()), mask);
+    else
+        PlotPredicate::checkColumn(column, mask);
+}
+
 Interval<plot_t> PlotPredicateEqual::getIntervalRepresentation() const {
     return Interval<plot_t>(threshold_.getValue(), threshold_.getValue(), false, false);
 }
@@ -233,6 +331,13 @@ bool PlotPredicateGreater::check(const PlotCellValue& value) const {
         (value.isTag() && threshold_.isTag() && value.getTag() > threshold_.getTag()));
 }
 
+void PlotPredicateGreater::checkColumn(const PlotColumn& column, std::vector<char>& mask) const {
+    if (threshold_.isValue())
+        checkColumnValues(column, GreaterOp(threshold_.getValue()), mask);
+    else
+        PlotPredicate::checkColumn(column, mask);
+}
+
 Interval<plot_t> PlotPredicateGreater::getIntervalRepresentation() const {
     return Interval<plot_t>(threshold_.getValue(), std::numeric_limits<plot_t>::max(), true, false);
 }
@@ -318,6 +423,13 @@ bool PlotPredicateBetween::check(const PlotCellValue& value) const {
         value.getTag() > lowerThreshold_.getTag() && value.getTag() < upperThreshold_.getTag()));
 }
 
+void PlotPredicateBetween::checkColumn(const PlotColumn& column, std::vector<char>& mask) const {
+    if (lowerThreshold_.isValue() && upperThreshold_.isValue())
+        checkColumnValues(column, BetweenOp(lowerThreshold_.getValue(), upperThreshold_.getValue()), mask);
+    else
+        PlotPredicate::checkColumn(column, mask);
+}
+
 Interval<plot_t> PlotPredicateBetween::getIntervalRepresentation() const {
     return Interval<plot_t>(lowerThreshold_.getValue(), upperThreshold_.getValue(), true, true);
 }
@@ -414,6 +526,13 @@ bool PlotPredicateNotBetween::check(const PlotCellValue& value) const {
         (value.getTag() <= lowerThreshold_.getTag() || value.getTag() >= upperThreshold_.getTag())));
 }
 
+void PlotPredicateNotBetween::checkColumn(const PlotColumn& column, std::vector<char>& mask) const {
+    if (lowerThreshold_.isValue() && upperThreshold_.isValue())
+        checkColumnValues(column, NotBetweenOp(lowerThreshold_.getValue(), upperThreshold_.getValue()), mask);
+    else
+        PlotPredicate::checkColumn(column, mask);
+}
+
 Interval<plot_t> PlotPredicateNotBetween::getIntervalRepresentation() const {
     return Interval<plot_t>(upperThreshold_.getValue(),lowerThreshold_.getValue(), false, false);
 }
@@ -519,6 +638,13 @@ bool PlotPredicateBetweenOrEqual::check(const PlotCellValue& value) const {
     return false;
 }
 
+void PlotPredicateBetweenOrEqual::checkColumn(const PlotColumn& column, std::vector<char>& mask) const {
+    if (lowerThreshold_.isValue() && upperThreshold_.isValue())
+        checkColumnValues(column, BetweenOrEqualOp(lowerThreshold_.getValue(), upperThreshold_.getValue()), mask);
+    else
+        PlotPredicate::checkColumn(column, mask);
+}
+
 Interval<plot_t> PlotPredicateBetweenOrEqual::getIntervalRepresentation() const {
     return Interval<plot_t>(lowerThreshold_.getValue(), upperThreshold_.getValue(), false, false);
 }
@@ -624,6 +750,13 @@ bool PlotPredicateNotBetweenOrEqual::check(const PlotCellValue& value) const {
     return false;
 }
 
+void PlotPredicateNotBetweenOrEqual::checkColumn(const PlotColumn& column, std::vector<char>& mask) const {
+    if (lowerThreshold_.isValue() && upperThreshold_.isValue())
+        checkColumnValues(column, NotBetweenOrEqualOp(lowerThreshold_.getValue(), upperThreshold_.getValue()), mask);
+    else
+        PlotPredicate::checkColumn(column, mask);
+}
+
 Interval<plot_t> PlotPredicateNotBetweenOrEqual::getIntervalRepresentation() const {
     return Interval<plot_t>(upperThreshold_.getValue(),lowerThreshold_.getValue(), true, true);
 }
@@ -32,6 +32,8 @@
 
 namespace voreen {
 
+class PlotColumn;
+
 /**
  * Abstract super class for predicate classes used for selecting subsets out of PlotData tables.
  *
@@ -56,6 +58,15 @@ public:
     /// checks whether value stored in PlotCell \a value fulfills the predicate
     virtual bool check(const PlotCellValue& value) const = 0;
 
+    /**
+     * Checks all cells of \a column at once and clears the entries of \a mask belonging to
+     * rows that do not fulfill the predicate. Entries already cleared remain cleared.
+     *
+     * The default implementation evaluates check() once per distinct tag and once per value cell.
+     * Subclasses comparing against numeric thresholds override it to work on the value array directly.
+     */
+    virtual void checkColumn(const PlotColumn& column, std::vector<char>& mask) const;
+
     /// Returns an interval representation of the PlotPredicate if possible, non numeric predicates return an empty interval.
     virtual Interval<plot_t> getIntervalRepresentation() const = 0;
 
@@ -111,6 +122,9 @@ public:
     /// checks whether value stored in PlotCell \a value fulfills the predicate
     bool check(const PlotCellValue& value) const;
 
+    /// checks all cells of \a column at once, see PlotPredicate::checkColumn()
+    virtual void checkColumn(const PlotColumn& column, std::vector<char>& mask) const;
+
     /// Returns an interval representation of the PlotPredicate if possible, non numeric predicates return an empty interval.
     virtual Interval<plot_t> getIntervalRepresentation() const;
 
@@ -176,6 +190,9 @@ public:
     /// checks whether value stored in PlotCell \a value fulfills the predicate
     bool check(const PlotCellValue& value) const;
 
+    /// checks all cells of \a column at once, see PlotPredicate::checkColumn()
+    virtual void checkColumn(const PlotColumn& column, std::vector<char>& mask) const;
+
     /// Returns an interval representation of the PlotPredicate if possible, non numeric predicates return an empty interval.
     virtual Interval<plot_t> getIntervalRepresentation() const;
 
@@ -240,6 +257,9 @@ public:
     /// checks whether value stored in PlotCell \a value fulfills the predicate
     bool check(const PlotCellValue& value) const;
 
+    /// checks all cells of \a column at once, see PlotPredicate::checkColumn()
+    virtual void checkColumn(const PlotColumn& column, std::vector<char>& mask) const;
+
     /// Returns an interval representation of the PlotPredicate if possible, non numeric predicates return an empty interval.
     virtual Interval<plot_t> getIntervalRepresentation() const;
 
@@ -311,6 +331,9 @@ public:
     /// checks whether value stored in PlotCell \a value fulfills the predicate
     bool check(const PlotCellValue& value) const;
 
+    /// checks all cells of \a column at once, see PlotPredicate::checkColumn()
+    virtual void checkColumn(const PlotColumn& column, std::vector<char>& mask) const;
+
     /// creates a deep copy of the current PlotPredicate
     virtual PlotPredicate* clone() const;
 
@@ -379,6 +402,9 @@ public:
     /// checks whether value stored in PlotCell \a value fulfills the predicate
     bool check(const PlotCellValue& value) const;
 
+    /// checks all cells of \a column at once, see PlotPredicate::checkColumn()
+    virtual void checkColumn(const PlotColumn& column, std::vector<char>& mask) const;
+
     /// creates a deep copy of the current PlotPredicate
     virtual PlotPredicate* clone() const;
 
@@ -447,6 +473,9 @@ public:
     /// checks whether value stored in PlotCell \a value fulfills the predicate
     virtual bool check(const PlotCellValue& value) const;
 
+    /// checks all cells of \a column at once, see PlotPredicate::checkColumn()
+    virtual void checkColumn(const PlotColumn& column, std::vector<char>& mask) const;
+
     /// creates a deep copy of the current PlotPredicate
     virtual PlotPredicate* clone() const;
 
@@ -515,6 +544,9 @@ public:
     /// checks whether value stored in PlotCell \a value fulfills the predicate
     virtual bool check(const PlotCellValue& value) const;
 
+    /// checks all cells of \a column at once, see PlotPredicate::checkColumn()
+    virtual void checkColumn(const PlotColumn& column, std::vector<char>& mask) const;
+
     /// creates a deep copy of the current PlotPredicate
     virtual PlotPredicate* clone() const;
 
@@ -53,6 +53,7 @@ SET(MOD_CORE_SOURCES
     ${MOD_DIR}/datastructures/colormap.cpp
     ${MOD_DIR}/datastructures/plotbase.cpp
     ${MOD_DIR}/datastructures/plotcell.cpp
+    ${MOD_DIR}/datastructures/plotcolumn.cpp
     ${MOD_DIR}/datastructures/plotdata.cpp
     ${MOD_DIR}/datastructures/plotentitysettings.cpp
     ${MOD_DIR}/datastructures/plotexpression.cpp
@@ -129,6 +130,7 @@ SET(MOD_CORE_HEADERS
     ${MOD_DIR}/datastructures/interval.h
     ${MOD_DIR}/datastructures/plotbase.h
     ${MOD_DIR}/datastructures/plotcell.h
+    ${MOD_DIR}/datastructures/plotcolumn.h
     ${MOD_DIR}/datastructures/plotdata.h
     ${MOD_DIR}/datastructures/plotentitysettings.h
     ${MOD_DIR}/datastructures/plotexpression.h
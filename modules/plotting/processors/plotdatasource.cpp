@@ -33,9 +33,15 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <sstream>
 
 namespace voreen {
 
+namespace {
+    /// number of lines that are read from file and then parsed at once
+    const size_t LINES_PER_BATCH = 16384;
+}
+
 const std::string PlotDataSource::loggerCat_("voreen.PlotDataSource");
 
 PlotDataSource::PlotDataSource():
@@ -172,101 +178,99 @@ PlotData* PlotDataSource::readCSVData() {
     std::vector<int> tester(0);
     std::vector<PlotCellValue> pCellVector_;
     std::vector<int>::iterator rit;
-    double num;
     int counter = 0;
-    std::stringstream ssLine;
-    ssLine.imbue(std::locale::classic());
-    while(inFile.good()&& std::getline(inFile, line)){
-        csvline_populate(myvector, line);
-        position += line.size()*1.f/(size*1.f);
-        if (mass == 0) {
-            mass = myvector.size();
-            if (!constantOrder_.get()){
-                newData->reset(countKeyColumn_.get(),
-                    static_cast<int>(myvector.size()) - countKeyColumn_.get());
-                k = 0;
-            }
-            else {
-                newData->reset(1, static_cast<int>(myvector.size()));
-                newData->setColumnLabel(0,"Index");
-                k = 1;
-            }
-            for (int i = k; i < newData->getColumnCount(); ++i) {
-                std::stringstream Str;
-                Str << i;
-                newData->setColumnLabel(i,Str.str());
-            }
+    std::vector<std::string> lines;
+    std::vector<CSVRecord> records;
+    while (inFile.good()) {
+        // read a batch of lines, split and classify them in parallel and insert them in order
+        lines.clear();
+        while (lines.size() < LINES_PER_BATCH && std::getline(inFile, line)) {
+            position += line.size()*1.f/(size*1.f);
+            lines.push_back(line);
         }
-        if (constantOrder_.get()){
-            PlotCellValue cellValue(counter);
-            pCellVector_.push_back(cellValue);
-        }
-        size_t found = 0;
-        for(size_t i=0; i<mass; ++i){
-            if (i < myvector.size()){
-                found = myvector[i].find(',');
-                ssLine.str("");
-                ssLine.clear();
-                if (found != std::string::npos) {
-                    ssLine <<  myvector[i].replace(found,1,".");
+        parseCSVRecords(lines, records);
+
+        for (size_t l = 0; l < lines.size(); ++l) {
+            const CSVRecord& record = records[l];
+            const std::vector<std::string>& fields = record.fields_;
+            if (mass == 0) {
+                mass = fields.size();
+                if (!constantOrder_.get()){
+                    newData->reset(countKeyColumn_.get(),
+                        static_cast<int>(fields.size()) - countKeyColumn_.get());
+                    k = 0;
                 }
                 else {
-                    ssLine << myvector[i];
+                    newData->reset(1, static_cast<int>(fields.size()));
+                    newData->setColumnLabel(0,"Index");
+                    k = 1;
                 }
-                //the cast should be work for numbers x.y
-                if (ssLine >> num) {
-                    if(counter==0){
-                        tester.push_back(2);
-                    }
-                    else {
-                        if ((tester.at(i) == 1)){
-                            pCellVector_.push_back(PlotCellValue(myvector[i]));
-                            continue;
+                for (int i = k; i < newData->getColumnCount(); ++i) {
+                    std::stringstream Str;
+                    Str << i;
+                    newData->setColumnLabel(i,Str.str());
+                }
+            }
+            if (constantOrder_.get()){
+                PlotCellValue cellValue(counter);
+                pCellVector_.push_back(cellValue);
+            }
+            for(size_t i=0; i<mass; ++i){
+                if (i < fields.size()){
+                    //the cast should be work for numbers x.y
+                    if (record.types_[i] == CSVRecord::NUMBER_FIELD) {
+                        if(counter==0){
+                            tester.push_back(2);
                         }
-                        else if (tester.at(i) == 0) {
-                            rit = tester.begin() + i;
-                            *rit = 2;
+                        else {
+                            if ((tester.at(i) == 1)){
+                                pCellVector_.push_back(PlotCellValue(fields[i]));
+                                continue;
+                            }
+                            else if (tester.at(i) == 0) {
+                                rit = tester.begin() + i;
+                                *rit = 2;
+                            }
                         }
+                        pCellVector_.push_back(PlotCellValue(record.numbers_[i]));
                     }
-                    pCellVector_.push_back(PlotCellValue(num));
-                }
-                else if (myvector[i].length() == 0) {
-                    if (counter == 0) {
-                        tester.push_back(0);
-                    }
-                    pCellVector_.push_back(PlotCellValue());
-                }
-                else {
-                    if (counter==0){
-                        tester.push_back(1);
+                    else if (record.types_[i] == CSVRecord::EMPTY_FIELD) {
+                        if (counter == 0) {
+                            tester.push_back(0);
+                        }
+                        pCellVector_.push_back(PlotCellValue());
                     }
                     else {
-                        if ((tester.at(i) == 2)){
-                            pCellVector_.push_back(PlotCellValue());
-                            continue;
+                        if (counter==0){
+                            tester.push_back(1);
                         }
-                        else if (tester.at(i) == 0) {
-                            rit = tester.begin() + i;
-                            *rit = 1;
+                        else {
+                            if ((tester.at(i) == 2)){
+                                pCellVector_.push_back(PlotCellValue());
+                                continue;
+                            }
+                            else if (tester.at(i) == 0) {
+                                rit = tester.begin() + i;
+                                *rit = 1;
+                            }
                         }
+                        pCellVector_.push_back(PlotCellValue(fields[i]));
                     }
-                    pCellVector_.push_back(PlotCellValue(myvector[i]));
-                }
-            }
-            else {
-                if (i < tester.size()){
-                    pCellVector_.push_back(PlotCellValue());
                 }
                 else {
-                    pCellVector_.push_back(PlotCellValue());
-                    tester.push_back(0);
+                    if (i < tester.size()){
+                        pCellVector_.push_back(PlotCellValue());
+                    }
+                    else {
+                        pCellVector_.push_back(PlotCellValue());
+                        tester.push_back(0);
+                    }
                 }
             }
+            newData->insert(pCellVector_);
+            pCellVector_.clear();
+            ++counter;
         }
-        newData->insert(pCellVector_);
-        pCellVector_.clear();
-        myvector.clear();
-        ++counter;
         Processor::setProgress(position);
     }
     inFile.close();
@@ -278,6 +282,48 @@ namespace {
     const std::string whitespaces(" \t");
 }
 
+void PlotDataSource::parseCSVRecords(const std::vector<std::string>& lines, std::vector<CSVRecord>& records) {
+    records.resize(lines.size());
+    const int numLines = static_cast<int>(lines.size());
+
+#ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel
+#endif
+    {
+        std::stringstream ssField;
+        ssField.imbue(std::locale::classic());
+        double num;
+
+#ifdef VRN_MODULE_OPENMP
+        #pragma omp for schedule(dynamic, 256)
+#endif
+        for (int l = 0; l < numLines; ++l) {
+            CSVRecord& record = records[l];
+            record.fields_.clear();
+            csvline_populate(record.fields_, lines[l]);
+            record.types_.resize(record.fields_.size());
+            record.numbers_.resize(record.fields_.size());
+
+            for (size_t i = 0; i < record.fields_.size(); ++i) {
+                std::string& field = record.fields_[i];
+                size_t found = field.find(',');
+                if (found != std::string::npos)
+                    field.replace(found, 1, ".");
+                ssField.str(field);
+                ssField.clear();
+                if (ssField >> num) {
+                    record.types_[i] = CSVRecord::NUMBER_FIELD;
+                    record.numbers_[i] = num;
+                }
+                else if (field.length() == 0)
+                    record.types_[i] = CSVRecord::EMPTY_FIELD;
+                else
+                    record.types_[i] = CSVRecord::STRING_FIELD;
+            }
+        }
+    }
+}
+
 std::string PlotDataSource::trimString(const std::string& oldString) {
     size_t start = oldString.find_first_not_of(whitespaces);
     if (start == std::string::npos) // oldString contains only whitespaces
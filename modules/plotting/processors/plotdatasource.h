@@ -60,9 +60,24 @@ protected:
     virtual void deinitialize() throw (tgt::Exception);
 
 private:
+    /// Fields of one CSV line, each classified as it is by the column type detection.
+    struct CSVRecord {
+        enum FieldType {
+            EMPTY_FIELD = 0,
+            STRING_FIELD = 1,
+            NUMBER_FIELD = 2
+        };
+        std::vector<std::string> fields_;
+        std::vector<char> types_;       ///< FieldType of each field
+        std::vector<double> numbers_;   ///< parsed number of each NUMBER_FIELD
+    };
+
     void recalculate();
     PlotData* readCSVData();
     void csvline_populate(std::vector<std::string> &record, const std::string& line);
+
+    /// Splits and classifies the given lines, the lines are processed in parallel if OpenMP is available.
+    void parseCSVRecords(const std::vector<std::string>& lines, std::vector<CSVRecord>& records);
     std::string trimString(const std::string& oldString);
 
     PlotPort outPort_;
@@ -41,6 +41,10 @@
 #include "tgt/tgt_math.h"
 #include "tgt/stopwatch.h"
 
+#ifdef VRN_MODULE_OPENMP
+#include "omp.h"
+#endif
+
 using tgt::ivec2;
 using tgt::ivec3;
 using tgt::ivec4;
@@ -248,8 +252,17 @@ void SingleOctreeRaycasterCPU::renderVolume() {
         tgt::mat4 projectionMatrix = cameraProperty_.get().getProjectionMatrix(renderOutport_.getSize());
         tgt::ivec2 viewport = renderOutport_.getSize();
 
-        // render
-        for (size_t y=0; y<renderSize.y; y++) {
+        // make sure the TF texture is up to date before it is accessed concurrently
+        transfunc->getTexture();
+        std::vector<RayNode> rayNodes;
+
+        // render: rows are distributed dynamically among the threads
+        const int height = static_cast<int>(renderSize.y);
+#ifdef VRN_MODULE_OPENMP
+        #pragma omp parallel for schedule(dynamic)
+#endif
+        for (int yi=0; yi<height; yi++) {
+            const size_t y = static_cast<size_t>(yi);
             for (size_t x=0; x<renderSize.x; x++) {
                 //renderBuffer[y*renderSize.x + x] = entryBuffer[y*renderSize.x + x];
                 tgt::vec4 entryPoint = entryBuffer[y*renderSize.x + x];
@@ -261,11 +274,9 @@ void SingleOctreeRaycasterCPU::renderVolume() {
                 }
                 else{ // inside volume
                     if (x == rayPixelCoordsAbs.x && y == rayPixelCoordsAbs.y) { //< track nodes passed by ray
-                        std::vector<RayNode> rayNodes;
                         fragColor = traverseRay(entryPoint.xyz(), exitPoint.xyz(),
                             camPos, projectionMatrix, viewport,
                             rwm, transfunc, samplingStepSize, &rayNodes);
-                        rayNodeGeometryPort_.setData(generateRayNodePathGeometry(rayNodes));
                     }
                     else
                         fragColor = traverseRay(entryPoint.xyz(), exitPoint.xyz(),
@@ -277,6 +288,8 @@ void SingleOctreeRaycasterCPU::renderVolume() {
                 renderBuffer[y*renderSize.x + x] = fragColor;
             }
         }
+        if (!rayNodes.empty())
+            rayNodeGeometryPort_.setData(generateRayNodePathGeometry(rayNodes));
 
         // copy renderBuffer to framebuffer
         glWindowPos2i(0, 0);
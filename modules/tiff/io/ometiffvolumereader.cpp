@@ -40,12 +40,18 @@
 
 #include <fstream>
 #include <iostream>
+#include <algorithm>
 #include <assert.h>
 
 #include "tgt/exception.h"
 #include "tgt/vector.h"
 #include "tgt/texture.h"
 #include "tgt/filesystem.h"
+#include "tgt/stopwatch.h"
+
+#ifdef VRN_MODULE_OPENMP
+#include "omp.h"
+#endif
 
 using std::string;
 using tgt::vec3;
@@ -338,17 +344,14 @@ std::vector<VolumeRAM*> OMETiffVolumeReader::loadVolumesIntoRam(const OMETiffSta
 
 
     //
-    // Iterate over TIFF files and copy pixel content to respective positions in the volume stack
+    // Iterate over TIFF files and directories and determine the slices to read, together with their
+    // target positions in the volume stack (output volumes are created here, the pixel data is read afterwards)
     //
     VolumeFactory volumeFac;
+    std::vector<SliceReadTask> tasks;
     size_t curSlice = 0;
     for (int fileID = 0; fileID < static_cast<int>(stack.files_.size()); fileID++) {
         const OMETiffFile& curFile = stack.files_.at(fileID);
-        if (showProgress && getProgressBar())
-            getProgressBar()->setProgressMessage("Loading " + curFile.filename_ + " ...");
-
-        // current tiff file (open on demand)
-        TIFF* curTiffFile = 0;
 
         // check firstZ, firstC, firstT parameters of current file against current coordinates
         if (curFile.firstZ_ != curZ || curFile.firstC_ != curC || curFile.firstT_ != curT) {
@@ -364,30 +367,11 @@ std::vector<VolumeRAM*> OMETiffVolumeReader::loadVolumesIntoRam(const OMETiffSta
             tgtAssert(curC < (int)volumes.size(), "current C value larger than volumes vector");
             tgtAssert(curT < (int)volumes[curC].size(), "current T value larger than volumes vector");
 
-            if (showProgress && getProgressBar()) {
-                getProgressBar()->setProgress(static_cast<float>(curSlice) / static_cast<float>(stack.numSlices_-1));
-                getProgressBar()->forceUpdate();
-            }
-
             // ignore slice, if a specific channel/timestep/slice is requested, which does not match current channel/timestep/slice
             bool skipSlice = (requestedChannel >= 0  && curC != requestedChannel)  ||
                              (requestedTimestep >= 0 && curT != requestedTimestep) ||
                              (llf.z >= 0 && (llf.z > curZ || urb.z < curZ));
             if (!skipSlice) {
-
-                // open current TIFF file, if not already happened
-                if (!curTiffFile) {
-                    curTiffFile = TIFFOpen(curFile.filename_.c_str(), "r");
-                    if (!curTiffFile) {
-                        deleteVolumes(volumes);
-                        raiseIOException("Failed to open TIFF file", curFile.filename_, getProgressBar());
-                    }
-                }
-                tgtAssert(curTiffFile, "cur tiff file not opened");
-
-                // set current TIFF directory
-                TIFFSetDirectory(curTiffFile,static_cast<tdir_t>(tiffDir));
-
                 // retrieve current volume and create it, if not created yet
                 VolumeRAM*& currentVolume = volumes[curC][curT];
                 if (!currentVolume) {
@@ -397,8 +381,6 @@ std::vector<VolumeRAM*> OMETiffVolumeReader::loadVolumesIntoRam(const OMETiffSta
                     catch (std::exception& e) {
                         LERROR(e.what());
                         deleteVolumes(volumes);
-                        if (curTiffFile)
-                            TIFFClose(curTiffFile);
                         if (getProgressBar())
                             getProgressBar()->hide();
                         throw e;
@@ -406,52 +388,13 @@ std::vector<VolumeRAM*> OMETiffVolumeReader::loadVolumesIntoRam(const OMETiffSta
                 }
                 tgtAssert(currentVolume, "current volume is null");
 
-                // read current directory/slice
-                try {
-                    tgtAssert(llf.z == -1 || llf.z <= curZ, "invalid curZ (should have skipped this slice)");
-                    const size_t bytesPerVoxel = currentVolume->getBytesPerVoxel();
-                    const size_t zSliceInOutputVolume = llf.z >= 0 ? curZ-llf.z : curZ;
-                    const size_t curSliceByteOffset = tgt::hmul(outputVolDim.xy()) * zSliceInOutputVolume * bytesPerVoxel;
-                    char* curSlicePointer = reinterpret_cast<char*>(currentVolume->getData()) + curSliceByteOffset;
-
-                    // should the entire slice be written to the output volume or has a brick been requested?
-                    bool brickMode = tgt::hor(tgt::greaterThan(llf.xy(), tgt::ivec2(0)));
-                    brickMode |=     urb.x > -1 && tgt::hor(tgt::lessThan(urb.xy(), tgt::ivec2(stack.volumeDim_.xy())-1));
-                    if (brickMode) { // brick only => read entire tiff slice into temp buffer and extract sub-slice
-                        tgt::ivec2 subsliceDim = urb.xy()-llf.xy() + tgt::ivec2(1);
-                        tgtAssert(tgt::hand(tgt::greaterThan(subsliceDim, tgt::ivec2(0))) &&
-                                  tgt::hand(tgt::lessThan(subsliceDim, tgt::ivec2(stack.volumeDim_.xy()))), "invalid subsliceDim");
-                        size_t subSliceByteSize = tgt::hmul(subsliceDim) * bytesPerVoxel;
-
-                        // read full slice
-                        size_t sliceBytesize = tgt::hmul(stack.volumeDim_.xy()) * bytesPerVoxel;
-                        char* sliceBuffer = new char[sliceBytesize];
-                        readTiffDirectory(curTiffFile, stack.datatype_, stack.volumeDim_.xy(), sliceBuffer);
-
-                        // copy sub-slice to output volume
-                        size_t sliceBufferOffset = (llf.y * stack.volumeDim_.x + llf.x) * bytesPerVoxel;
-                        size_t subSliceBufferOffset = 0;
-                        for (size_t y=0; y<(size_t)subsliceDim.y; y++) {
-                            tgtAssert((sliceBufferOffset + subsliceDim.x*bytesPerVoxel) <= sliceBytesize, "invalid sliceBufferOffset");
-                            tgtAssert((subSliceBufferOffset + subsliceDim.x*bytesPerVoxel) <= subSliceByteSize, "invalid subSliceBufferOffset");
-                            memcpy(curSlicePointer + subSliceBufferOffset, sliceBuffer + sliceBufferOffset, subsliceDim.x*bytesPerVoxel);
-                            // advance one line in full slice and sub slice buffer
-                            sliceBufferOffset    += stack.volumeDim_.x * bytesPerVoxel;
-                            subSliceBufferOffset += subsliceDim.x * bytesPerVoxel;
-                        }
-
-                        delete[] sliceBuffer;
-                    }
-                    else { // full slice => write tiff slice directly into output volume
-                        readTiffDirectory(curTiffFile, stack.datatype_, stack.volumeDim_.xy(), curSlicePointer);
-                    }
-                }
-                catch (tgt::Exception& e) {
-                    deleteVolumes(volumes);
-                    if (curTiffFile)
-                        TIFFClose(curTiffFile);
-                    raiseIOException("Failed to read tiff slice: " + std::string(e.what()), curFile.filename_, getProgressBar());
-                }
+                tgtAssert(llf.z == -1 || llf.z <= curZ, "invalid curZ (should have skipped this slice)");
+                SliceReadTask task;
+                task.fileID_ = static_cast<size_t>(fileID);
+                task.tiffDir_ = tiffDir;
+                task.volume_ = currentVolume;
+                task.zSlice_ = llf.z >= 0 ? curZ-llf.z : curZ;
+                tasks.push_back(task);
             }
 
             // update stack indices (pointers to curZ, curC, curT)
@@ -470,13 +413,112 @@ std::vector<VolumeRAM*> OMETiffVolumeReader::loadVolumesIntoRam(const OMETiffSta
 
         } // directory iteration
 
-        // close current TIFF file, if open
-        if (curTiffFile) {
-            TIFFClose(curTiffFile);
-            curTiffFile = 0;
+    } // file iteration
+
+    //
+    // Read the slices: the directories are distributed across the threads (if OpenMP is available),
+    // each thread reads via its own handle of the TIFF file it is currently working on.
+    //
+
+    // should the entire slices be written to the output volume or has a brick been requested?
+    bool brickMode = tgt::hor(tgt::greaterThan(llf.xy(), tgt::ivec2(0)));
+    brickMode |=     urb.x > -1 && tgt::hor(tgt::lessThan(urb.xy(), tgt::ivec2(stack.volumeDim_.xy())-1));
+    const tgt::svec2 regionOffset = brickMode ? tgt::svec2(llf.xy()) : tgt::svec2::zero;
+    const tgt::svec2 regionDim = outputVolDim.xy();
+    tgtAssert(tgt::hand(tgt::lessThanEqual(regionOffset + regionDim, stack.volumeDim_.xy())), "invalid brick region");
+
+    if (showProgress && getProgressBar())
+        getProgressBar()->setProgressMessage("Loading " + stack.files_.front().filename_ + " ...");
+
+    tgt::Stopwatch stopwatch;
+    stopwatch.start();
+
+    bool failed = false;
+    std::string errorMsg;
+    std::string errorFile;
+    const int numTasks = static_cast<int>(tasks.size());
+
+    #ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel
+    #endif
+    {
+        // TIFF handle of the current thread (open on demand)
+        TIFF* curTiffFile = 0;
+        size_t curFileID = 0;
+
+        #ifdef VRN_MODULE_OPENMP
+        #pragma omp for schedule(dynamic, 4)
+        #endif
+        for (int taskID = 0; taskID < numTasks; taskID++) {
+            if (failed)
+                continue;
+            const SliceReadTask& task = tasks[taskID];
+            const OMETiffFile& curFile = stack.files_.at(task.fileID_);
+
+            try {
+                // open TIFF file of the current slice, if not already happened
+                if (!curTiffFile || curFileID != task.fileID_) {
+                    if (curTiffFile)
+                        TIFFClose(curTiffFile);
+                    curTiffFile = TIFFOpen(curFile.filename_.c_str(), "r");
+                    curFileID = task.fileID_;
+                    if (!curTiffFile)
+                        throw tgt::IOException("Failed to open TIFF file", curFile.filename_);
+                }
+                tgtAssert(curTiffFile, "cur tiff file not opened");
+
+                // set current TIFF directory
+                if (!TIFFSetDirectory(curTiffFile, static_cast<tdir_t>(task.tiffDir_)))
+                    throw tgt::CorruptedFileException("Failed to set directory " + itos(task.tiffDir_), curFile.filename_);
+
+                // read current directory/slice
+                const size_t bytesPerVoxel = task.volume_->getBytesPerVoxel();
+                const size_t curSliceByteOffset = tgt::hmul(outputVolDim.xy()) * task.zSlice_ * bytesPerVoxel;
+                char* curSlicePointer = reinterpret_cast<char*>(task.volume_->getData()) + curSliceByteOffset;
+                if (brickMode) // brick only => decode only the strips/tiles intersecting the brick
+                    readTiffDirectoryRegion(curTiffFile, stack.datatype_, stack.volumeDim_.xy(), regionOffset, regionDim, curSlicePointer);
+                else // full slice => write tiff slice directly into output volume
+                    readTiffDirectory(curTiffFile, stack.datatype_, stack.volumeDim_.xy(), curSlicePointer);
+            }
+            catch (tgt::Exception& e) {
+                #ifdef VRN_MODULE_OPENMP
+                #pragma omp critical(OMETiffVolumeReader_loadVolumesIntoRam)
+                #endif
+                {
+                    if (!failed) {
+                        failed = true;
+                        errorMsg = e.what();
+                        errorFile = curFile.filename_;
+                    }
+                }
+            }
+
+            // progress is updated by the main thread only
+            bool mainThread = true;
+            #ifdef VRN_MODULE_OPENMP
+            mainThread = (omp_get_thread_num() == 0);
+            #endif
+            if (showProgress && getProgressBar() && mainThread) {
+                getProgressBar()->setProgress(static_cast<float>(taskID) / static_cast<float>(std::max(numTasks-1, 1)));
+                getProgressBar()->forceUpdate();
+            }
         }
 
-    } // file iteration
+        // close TIFF file of the current thread, if open
+        if (curTiffFile)
+            TIFFClose(curTiffFile);
+    }
+
+    if (failed) {
+        deleteVolumes(volumes);
+        raiseIOException("Failed to read tiff slice: " + errorMsg, errorFile, getProgressBar());
+    }
+
+    if (showProgress && !tasks.empty()) {
+        const float megabytes = static_cast<float>(tasks.size() * tgt::hmul(regionDim) * tasks.front().volume_->getBytesPerVoxel()) / (1024.f*1024.f);
+        const float seconds = std::max(static_cast<float>(stopwatch.getRuntime()) / 1000.f, 0.001f);
+        LINFO("Read " << tasks.size() << " slices (" << megabytes << " MB) in " << seconds << " sec: " << (megabytes / seconds) << " MB/s");
+    }
 
     // collect created VolumeRAMs in result vector
     std::vector<VolumeRAM*> result;
@@ -501,7 +543,7 @@ std::vector<VolumeRAM*> OMETiffVolumeReader::loadVolumesIntoRam(const OMETiffSta
 // protected/private methods
 // -------------------------
 
-void OMETiffVolumeReader::readTiffDirectory(TIFF* tiffFile, const std::string& dataType, const tgt::svec2& sliceDim, void* destBuffer) const
+size_t OMETiffVolumeReader::checkTiffDirectory(TIFF* tiffFile, const std::string& dataType, const tgt::svec2& sliceDim) const
     throw (tgt::Exception)
 {
     tgtAssert(tiffFile, "null pointer passed");
@@ -537,6 +579,20 @@ void OMETiffVolumeReader::readTiffDirectory(TIFF* tiffFile, const std::string& d
         throw tgt::Exception("Bits per sample (" + itos(bitsPerVoxel) + ") does not match data type " + dataType + " (expected: " + itos(bitsPerVoxel) + ")");
     }
 
+    return static_cast<size_t>(bitsPerVoxel / 8);
+}
+
+void OMETiffVolumeReader::readTiffDirectory(TIFF* tiffFile, const std::string& dataType, const tgt::svec2& sliceDim, void* destBuffer) const
+    throw (tgt::Exception)
+{
+    checkTiffDirectory(tiffFile, dataType, sliceDim);
+
+    // tiles have to be cropped to the image region
+    if (TIFFIsTiled(tiffFile)) {
+        readTiffDirectoryRegion(tiffFile, dataType, sliceDim, tgt::svec2::zero, sliceDim, destBuffer);
+        return;
+    }
+
     // determine strip parameters
     tsize_t stripCount = TIFFNumberOfStrips(tiffFile);
     tsize_t stripSize = TIFFStripSize(tiffFile);
@@ -550,6 +606,67 @@ void OMETiffVolumeReader::readTiffDirectory(TIFF* tiffFile, const std::string& d
 
 }
 
+void OMETiffVolumeReader::readTiffDirectoryRegion(TIFF* tiffFile, const std::string& dataType, const tgt::svec2& sliceDim,
+        const tgt::svec2& regionOffset, const tgt::svec2& regionDim, void* destBuffer) const
+    throw (tgt::Exception)
+{
+    tgtAssert(tgt::hand(tgt::lessThanEqual(regionOffset + regionDim, sliceDim)), "region outside of slice");
+    const size_t bytesPerVoxel = checkTiffDirectory(tiffFile, dataType, sliceDim);
+    const tgt::svec2 regionEnd = regionOffset + regionDim; //< exclusive
+    char* dest = reinterpret_cast<char*>(destBuffer);
+
+    if (TIFFIsTiled(tiffFile)) {
+        uint32 tileWidth = 0, tileLength = 0;
+        TIFFGetField(tiffFile, TIFFTAG_TILEWIDTH, &tileWidth);
+        TIFFGetField(tiffFile, TIFFTAG_TILELENGTH, &tileLength);
+        if (tileWidth == 0 || tileLength == 0)
+            throw tgt::CorruptedFileException("Invalid tile dimensions");
+        tsize_t tileSize = TIFFTileSize(tiffFile);
+        std::vector<char> tileBuffer(static_cast<size_t>(tileSize));
+
+        // decode the tiles intersecting the region and copy their intersection to the dest buffer
+        for (size_t tileY = (regionOffset.y / tileLength) * tileLength; tileY < regionEnd.y; tileY += tileLength) {
+            for (size_t tileX = (regionOffset.x / tileWidth) * tileWidth; tileX < regionEnd.x; tileX += tileWidth) {
+                ttile_t tileID = TIFFComputeTile(tiffFile, static_cast<uint32>(tileX), static_cast<uint32>(tileY), 0, 0);
+                if (TIFFReadEncodedTile(tiffFile, tileID, &tileBuffer[0], tileSize) == -1)
+                    throw tgt::CorruptedFileException("Failed to read tile " + itos(static_cast<int>(tileID)));
+
+                const size_t x0 = std::max(tileX, regionOffset.x);
+                const size_t x1 = std::min(tileX + tileWidth, regionEnd.x);
+                const size_t y0 = std::max(tileY, regionOffset.y);
+                const size_t y1 = std::min(tileY + tileLength, regionEnd.y);
+                for (size_t y = y0; y < y1; y++) {
+                    memcpy(dest + ((y - regionOffset.y) * regionDim.x + (x0 - regionOffset.x)) * bytesPerVoxel,
+                           &tileBuffer[((y - tileY) * tileWidth + (x0 - tileX)) * bytesPerVoxel], (x1 - x0) * bytesPerVoxel);
+                }
+            }
+        }
+    }
+    else {
+        uint32 rowsPerStrip = static_cast<uint32>(sliceDim.y);
+        TIFFGetFieldDefaulted(tiffFile, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+        rowsPerStrip = std::min(rowsPerStrip, static_cast<uint32>(sliceDim.y));
+        if (rowsPerStrip == 0)
+            throw tgt::CorruptedFileException("Invalid rows per strip");
+        tsize_t stripSize = TIFFStripSize(tiffFile);
+        std::vector<char> stripBuffer(static_cast<size_t>(stripSize));
+
+        // decode the strips intersecting the region's rows and copy the region's columns to the dest buffer
+        for (size_t stripY = (regionOffset.y / rowsPerStrip) * rowsPerStrip; stripY < regionEnd.y; stripY += rowsPerStrip) {
+            tstrip_t stripID = TIFFComputeStrip(tiffFile, static_cast<uint32>(stripY), 0);
+            if (TIFFReadEncodedStrip(tiffFile, stripID, &stripBuffer[0], stripSize) == -1)
+                throw tgt::CorruptedFileException("Failed to read strip " + itos(static_cast<int>(stripID)));
+
+            const size_t y0 = std::max(stripY, regionOffset.y);
+            const size_t y1 = std::min(stripY + rowsPerStrip, regionEnd.y);
+            for (size_t y = y0; y < y1; y++) {
+                memcpy(dest + (y - regionOffset.y) * regionDim.x * bytesPerVoxel,
+                       &stripBuffer[((y - stripY) * sliceDim.x + regionOffset.x) * bytesPerVoxel], regionDim.x * bytesPerVoxel);
+            }
+        }
+    }
+}
+
 // see OME XML schema definition: http://www.openmicroscopy.org/Schemas/Documentation/Generated/OME-2012-06/ome.html
 OMETiffStack OMETiffVolumeReader::extractStackInformation(TIFF* tiffFile, const std::string& path) const
     throw (tgt::Exception)
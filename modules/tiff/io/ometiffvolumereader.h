@@ -107,6 +107,23 @@ private:
     size_t determineDirectoryCount(const std::string& filename) const
         throw (tgt::Exception);
 
+    /// Slice of the stack to be read by loadVolumesIntoRam.
+    struct SliceReadTask {
+        size_t fileID_;         ///< index of the file in the stack's file list
+        size_t tiffDir_;        ///< directory of the slice within the file
+        VolumeRAM* volume_;     ///< output volume the slice is copied to
+        size_t zSlice_;         ///< z position of the slice in the output volume
+    };
+
+    /**
+     * Checks the format of the current directory of the passed opened Tiff file against
+     * the passed data type and slice dimensions.
+     *
+     * @return the number of bytes per voxel
+     */
+    size_t checkTiffDirectory(TIFF* tiffFile, const std::string& dataType, const tgt::svec2& sliceDim) const
+        throw (tgt::Exception);
+
     /**
      * Reads the pixel data from the current directory of the passed opened Tiff file
      * and copies it to the dest buffer.
@@ -114,6 +131,15 @@ private:
     void readTiffDirectory(TIFF* tiffFile, const std::string& dataType, const tgt::svec2& sliceDim, void* destBuffer) const
         throw (tgt::Exception);
 
+    /**
+     * Reads a rectangular region from the current directory of the passed opened Tiff file
+     * and copies it to the dest buffer, which has to be of size hmul(regionDim) voxels.
+     * Only the strips or tiles intersecting the region are decoded.
+     */
+    void readTiffDirectoryRegion(TIFF* tiffFile, const std::string& dataType, const tgt::svec2& sliceDim,
+        const tgt::svec2& regionOffset, const tgt::svec2& regionDim, void* destBuffer) const
+        throw (tgt::Exception);
+
     // XPath-like XML helper functions
     const TiXmlNode* getXMLNode(const TiXmlNode* parent, const std::string& path) const
         throw (tgt::Exception);
@@ -26,6 +26,7 @@
 #include "voreen/core/datastructures/geometry/geometry.h"
 
 #include "voreen/core/io/serialization/serialization.h"
+#include "voreen/core/io/serialization/geometrybinaryserializer.h"
 #include "voreen/core/utils/hashing.h"
 #include "tgt/logmanager.h"
 
@@ -116,4 +117,12 @@ void Geometry::deserialize(XmlDeserializer& s) {
     s.optionalDeserialize("transformationMatrix", transformationMatrix_, tgt::mat4::identity);
 }
 
+void Geometry::serializeBinary(GeometryBinarySerializer& /*s*/) const {
+    throw SerializationException("Binary serialization is not supported by " + getClassName());
+}
+
+void Geometry::deserializeBinary(GeometryBinaryDeserializer& /*s*/) {
+    throw SerializationException("Binary serialization is not supported by " + getClassName());
+}
+
 } // namespace
@@ -0,0 +1,268 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "voreen/core/datastructures/octree/brickpoolcachepolicy.h"
+
+#include "tgt/assert.h"
+
+#include <algorithm>
+
+namespace voreen {
+
+const uint32_t BrickPoolCachePolicy::NO_NODE = 0xFFFFFFFF;
+
+BrickPoolCachePolicy::BrickPoolCachePolicy()
+    : capacity_(0)
+{}
+
+BrickPoolCachePolicy* BrickPoolCachePolicy::createPolicy(const std::string& name) throw (VoreenException) {
+    if (name == "clock")
+        return new BrickPoolCachePolicyClock();
+    else if (name == "2q")
+        return new BrickPoolCachePolicy2Q();
+    else if (name == "arc")
+        return new BrickPoolCachePolicyARC();
+    else
+        throw VoreenException("Unknown brick pool cache policy: " + name);
+}
+
+void BrickPoolCachePolicy::initialize(size_t numIds, size_t capacity) {
+    tgtAssert(numIds < NO_NODE, "too many ids");
+    nodes_.assign(numIds, Node());
+    capacity_ = capacity;
+}
+
+void BrickPoolCachePolicy::setNumIds(size_t numIds) {
+    tgtAssert(numIds < NO_NODE, "too many ids");
+    if (numIds > nodes_.size())
+        nodes_.resize(numIds);
+}
+
+void BrickPoolCachePolicy::pushBack(List& list, uint8_t listID, size_t id) {
+    tgtAssert(id < nodes_.size(), "invalid id");
+    Node& node = nodes_[id];
+    tgtAssert(node.list_ == LIST_NONE, "node is already in a list");
+    node.previous_ = list.tail_;
+    node.next_ = NO_NODE;
+    node.list_ = listID;
+    if (list.tail_ != NO_NODE)
+        nodes_[list.tail_].next_ = static_cast<uint32_t>(id);
+    else
+        list.head_ = static_cast<uint32_t>(id);
+    list.tail_ = static_cast<uint32_t>(id);
+    list.size_++;
+}
+
+void BrickPoolCachePolicy::unlink(List& list, size_t id) {
+    tgtAssert(id < nodes_.size(), "invalid id");
+    tgtAssert(list.size_ > 0, "unlink called on empty list");
+    Node& node = nodes_[id];
+    if (node.previous_ != NO_NODE)
+        nodes_[node.previous_].next_ = node.next_;
+    else
+        list.head_ = node.next_;
+    if (node.next_ != NO_NODE)
+        nodes_[node.next_].previous_ = node.previous_;
+    else
+        list.tail_ = node.previous_;
+    node.previous_ = NO_NODE;
+    node.next_ = NO_NODE;
+    node.list_ = LIST_NONE;
+    list.size_--;
+}
+
+void BrickPoolCachePolicy::rotate(List& list) {
+    if (list.size_ < 2)
+        return;
+    size_t id = list.head_;
+    uint8_t listID = nodes_[id].list_;
+    unlink(list, id);
+    pushBack(list, listID, id);
+}
+
+size_t BrickPoolCachePolicy::getMaxSearchSteps() const {
+    // each buffer may be moved/rotated twice before it is either evicted or known to be pinned
+    return 3*getNumResident() + 1;
+}
+
+//-------------------------------------------------------------------------------------------------
+// BrickPoolCachePolicyClock
+
+void BrickPoolCachePolicyClock::initialize(size_t numIds, size_t capacity) {
+    BrickPoolCachePolicy::initialize(numIds, capacity);
+    clock_ = List();
+}
+
+void BrickPoolCachePolicyClock::insert(size_t id) {
+    pushBack(clock_, LIST_RESIDENT_1, id);
+}
+
+bool BrickPoolCachePolicyClock::selectVictim(EvictionCallback& callback, size_t& victim) {
+    size_t maxSteps = getMaxSearchSteps();
+    for (size_t i = 0; i < maxSteps && clock_.size_ > 0; i++) {
+        size_t id = clock_.head_;
+        if (callback.testAndClearReference(id) == NOT_REFERENCED && callback.claim(id)) {
+            unlink(clock_, id);
+            victim = id;
+            return true;
+        }
+        rotate(clock_);
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------
+// BrickPoolCachePolicy2Q
+
+void BrickPoolCachePolicy2Q::initialize(size_t numIds, size_t capacity) {
+    BrickPoolCachePolicy::initialize(numIds, capacity);
+    a1in_ = List();
+    am_ = List();
+    a1out_ = List();
+    maxA1inSize_ = std::max<size_t>(capacity / 4, 1);
+    maxA1outSize_ = std::max<size_t>(capacity / 2, 1);
+}
+
+void BrickPoolCachePolicy2Q::insert(size_t id) {
+    tgtAssert(id < nodes_.size(), "invalid id");
+    if (nodes_[id].list_ == LIST_GHOST_1) {
+        // requested again after having been evicted from A1in => working set
+        unlink(a1out_, id);
+        pushBack(am_, LIST_RESIDENT_2, id);
+    }
+    else {
+        pushBack(a1in_, LIST_RESIDENT_1, id);
+    }
+}
+
+bool BrickPoolCachePolicy2Q::selectVictim(EvictionCallback& callback, size_t& victim) {
+    if (a1in_.size_ > maxA1inSize_ || am_.size_ == 0)
+        return evictFromA1in(callback, victim) || evictFromAm(callback, victim);
+    else
+        return evictFromAm(callback, victim) || evictFromA1in(callback, victim);
+}
+
+bool BrickPoolCachePolicy2Q::evictFromA1in(EvictionCallback& callback, size_t& victim) {
+    // FIFO: references while in A1in are considered correlated and ignored
+    size_t maxSteps = a1in_.size_;
+    for (size_t i = 0; i < maxSteps; i++) {
+        size_t id = a1in_.head_;
+        if (callback.claim(id)) {
+            unlink(a1in_, id);
+            pushBack(a1out_, LIST_GHOST_1, id);
+            if (a1out_.size_ > maxA1outSize_)
+                unlink(a1out_, a1out_.head_);
+            victim = id;
+            return true;
+        }
+        rotate(a1in_);
+    }
+    return false;
+}
+
+bool BrickPoolCachePolicy2Q::evictFromAm(EvictionCallback& callback, size_t& victim) {
+    size_t maxSteps = 2*am_.size_ + 1;
+    for (size_t i = 0; i < maxSteps && am_.size_ > 0; i++) {
+        size_t id = am_.head_;
+        if (callback.testAndClearReference(id) == NOT_REFERENCED && callback.claim(id)) {
+            unlink(am_, id);
+            victim = id;
+            return true;
+        }
+        rotate(am_);
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------
+// BrickPoolCachePolicyARC
+
+void BrickPoolCachePolicyARC::initialize(size_t numIds, size_t capacity) {
+    BrickPoolCachePolicy::initialize(numIds, capacity);
+    t1_ = List();
+    t2_ = List();
+    b1_ = List();
+    b2_ = List();
+    targetT1Size_ = 0;
+}
+
+void BrickPoolCachePolicyARC::insert(size_t id) {
+    tgtAssert(id < nodes_.size(), "invalid id");
+    uint8_t listID = nodes_[id].list_;
+    if (listID == LIST_GHOST_1) {
+        // recency list too small => grow T1
+        size_t delta = std::max<size_t>(b2_.size_ / b1_.size_, 1);
+        targetT1Size_ = std::min(targetT1Size_ + delta, capacity_);
+        unlink(b1_, id);
+        pushBack(t2_, LIST_RESIDENT_2, id);
+    }
+    else if (listID == LIST_GHOST_2) {
+        // frequency list too small => shrink T1
+        size_t delta = std::max<size_t>(b1_.size_ / b2_.size_, 1);
+        targetT1Size_ = (targetT1Size_ > delta ? targetT1Size_ - delta : 0);
+        unlink(b2_, id);
+        pushBack(t2_, LIST_RESIDENT_2, id);
+    }
+    else {
+        // keep the ghost directory bounded: |T1|+|B1| <= c and |T1|+|T2|+|B1|+|B2| <= 2c
+        if (t1_.size_ + b1_.size_ >= capacity_ && b1_.size_ > 0)
+            unlink(b1_, b1_.head_);
+        else if (t1_.size_ + t2_.size_ + b1_.size_ + b2_.size_ >= 2*capacity_ && b2_.size_ > 0)
+            unlink(b2_, b2_.head_);
+        pushBack(t1_, LIST_RESIDENT_1, id);
+    }
+}
+
+bool BrickPoolCachePolicyARC::selectVictim(EvictionCallback& callback, size_t& victim) {
+    size_t maxSteps = getMaxSearchSteps();
+    for (size_t i = 0; i < maxSteps && (t1_.size_ > 0 || t2_.size_ > 0); i++) {
+        bool fromT1 = (t1_.size_ > 0) && (t1_.size_ >= std::max<size_t>(targetT1Size_, 1) || t2_.size_ == 0);
+        List& list = (fromT1 ? t1_ : t2_);
+        size_t id = list.head_;
+
+        ReferenceState state = callback.testAndClearReference(id);
+        if (state == NOT_REFERENCED && callback.claim(id)) {
+            unlink(list, id);
+            if (fromT1)
+                pushBack(b1_, LIST_GHOST_1, id);
+            else
+                pushBack(b2_, LIST_GHOST_2, id);
+            victim = id;
+            return true;
+        }
+
+        if (state == REFERENCED && fromT1) {
+            // accessed again while in T1 => frequency list
+            unlink(t1_, id);
+            pushBack(t2_, LIST_RESIDENT_2, id);
+        }
+        else {
+            rotate(list);
+        }
+    }
+    return false;
+}
+
+} // namespace
@@ -0,0 +1,169 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "voreen/core/datastructures/octree/octreebrickcodec.h"
+
+#include "tgt/assert.h"
+
+#include <string.h>
+#include <algorithm>
+
+namespace voreen {
+
+namespace {
+
+/// Size of a block header: reference value (uint16) + bit width (uint8)
+const size_t BLOCK_HEADER_SIZE = 3;
+
+inline size_t getNumBits(uint16_t value) {
+    size_t numBits = 0;
+    while (value) {
+        numBits++;
+        value >>= 1;
+    }
+    return numBits;
+}
+
+}
+
+const size_t OctreeBrickCodec::BLOCK_SIZE;
+
+OctreeBrickCodec::OctreeBrickCodec(size_t numValues)
+    : numValues_(numValues)
+{
+    tgtAssert(numValues_ > 0, "no values");
+}
+
+size_t OctreeBrickCodec::getRawSize() const {
+    return numValues_*sizeof(uint16_t);
+}
+
+size_t OctreeBrickCodec::getMaxEncodedSize() const {
+    size_t numBlocks = (numValues_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    return numBlocks*BLOCK_HEADER_SIZE + getRawSize();
+}
+
+size_t OctreeBrickCodec::encode(const uint16_t* brick, char* encoded) const {
+    tgtAssert(brick && encoded, "null pointer passed");
+
+    unsigned char* out = reinterpret_cast<unsigned char*>(encoded);
+    for (size_t blockStart = 0; blockStart < numValues_; blockStart += BLOCK_SIZE) {
+        const size_t blockEnd = std::min(blockStart + BLOCK_SIZE, numValues_);
+
+        // determine frame of reference and bit width
+        uint16_t minValue = brick[blockStart];
+        uint16_t maxValue = minValue;
+        for (size_t i = blockStart+1; i < blockEnd; i++) {
+            uint16_t value = brick[i];
+            minValue = std::min(minValue, value);
+            maxValue = std::max(maxValue, value);
+        }
+        const size_t numBits = getNumBits(static_cast<uint16_t>(maxValue - minValue));
+
+        // block header (little endian)
+        *out++ = static_cast<unsigned char>(minValue & 0xFF);
+        *out++ = static_cast<unsigned char>(minValue >> 8);
+        *out++ = static_cast<unsigned char>(numBits);
+
+        // bit-pack offsets
+        if (numBits > 0) {
+            uint32_t bitBuffer = 0;
+            size_t numBufferedBits = 0;
+            for (size_t i = blockStart; i < blockEnd; i++) {
+                bitBuffer |= static_cast<uint32_t>(brick[i] - minValue) << numBufferedBits;
+                numBufferedBits += numBits;
+                while (numBufferedBits >= 8) {
+                    *out++ = static_cast<unsigned char>(bitBuffer & 0xFF);
+                    bitBuffer >>= 8;
+                    numBufferedBits -= 8;
+                }
+            }
+            if (numBufferedBits > 0)
+                *out++ = static_cast<unsigned char>(bitBuffer & 0xFF);
+        }
+    }
+
+    size_t encodedSize = static_cast<size_t>(out - reinterpret_cast<unsigned char*>(encoded));
+    tgtAssert(encodedSize <= getMaxEncodedSize(), "encoded size exceeds maximum");
+
+    // not compressible => store raw brick
+    if (encodedSize >= getRawSize()) {
+        memcpy(encoded, brick, getRawSize());
+        encodedSize = getRawSize();
+    }
+    return encodedSize;
+}
+
+bool OctreeBrickCodec::decode(const char* encoded, size_t encodedSize, uint16_t* brick) const {
+    tgtAssert(encoded && brick, "null pointer passed");
+
+    if (encodedSize == getRawSize()) {
+        memcpy(brick, encoded, getRawSize());
+        return true;
+    }
+
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(encoded);
+    const unsigned char* inEnd = in + encodedSize;
+    for (size_t blockStart = 0; blockStart < numValues_; blockStart += BLOCK_SIZE) {
+        const size_t blockEnd = std::min(blockStart + BLOCK_SIZE, numValues_);
+
+        // block header
+        if (inEnd - in < static_cast<ptrdiff_t>(BLOCK_HEADER_SIZE))
+            return false;
+        const uint16_t minValue = static_cast<uint16_t>(in[0] | (in[1] << 8));
+        const size_t numBits = in[2];
+        in += BLOCK_HEADER_SIZE;
+        if (numBits > 16)
+            return false;
+
+        if (numBits == 0) {
+            for (size_t i = blockStart; i < blockEnd; i++)
+                brick[i] = minValue;
+            continue;
+        }
+
+        const size_t numBlockBytes = ((blockEnd - blockStart)*numBits + 7) / 8;
+        if (static_cast<size_t>(inEnd - in) < numBlockBytes)
+            return false;
+
+        // unpack offsets
+        const uint32_t mask = (1u << numBits) - 1;
+        uint32_t bitBuffer = 0;
+        size_t numBufferedBits = 0;
+        for (size_t i = blockStart; i < blockEnd; i++) {
+            while (numBufferedBits < numBits) {
+                bitBuffer |= static_cast<uint32_t>(*in++) << numBufferedBits;
+                numBufferedBits += 8;
+            }
+            brick[i] = static_cast<uint16_t>(minValue + (bitBuffer & mask));
+            bitBuffer >>= numBits;
+            numBufferedBits -= numBits;
+        }
+    }
+
+    return (in == inEnd);
+}
+
+} // namespace
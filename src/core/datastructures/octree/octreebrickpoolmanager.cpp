@@ -51,6 +51,20 @@ namespace voreen {
 
 const std::string OctreeBrickPoolManagerBase::loggerCat_("voreen.OctreeBrickPoolManagerBase");
 
+OctreeBrickPoolManagerBase::PrefetchStatistics::PrefetchStatistics()
+    : numRequested_(0)
+    , numLoaded_(0)
+    , numHits_(0)
+    , numMisses_(0)
+    , numWasted_(0)
+{}
+
+float OctreeBrickPoolManagerBase::PrefetchStatistics::getHitRate() const {
+    if (numHits_ + numMisses_ == 0)
+        return 0.f;
+    return static_cast<float>(numHits_) / static_cast<float>(numHits_ + numMisses_);
+}
+
 OctreeBrickPoolManagerBase::OctreeBrickPoolManagerBase()
     : brickMemorySizeInByte_(0)
     , initialized_(false)
@@ -69,6 +83,10 @@ size_t OctreeBrickPoolManagerBase::getBrickMemorySizeInByte() const {
     return brickMemorySizeInByte_;
 }
 
+size_t OctreeBrickPoolManagerBase::getCompressedBrickSize(uint64_t /*virtualMemoryAddress*/) const {
+    return brickMemorySizeInByte_;
+}
+
 bool OctreeBrickPoolManagerBase::isInitialized() const {
     return initialized_;
 }
@@ -93,6 +111,16 @@ std::string OctreeBrickPoolManagerBase::getDescription() const {
     return "<not available>";
 }
 
+void OctreeBrickPoolManagerBase::prefetchBricks(const std::vector<uint64_t>& /*virtualMemoryAddresses*/) const {
+}
+
+OctreeBrickPoolManagerBase::PrefetchStatistics OctreeBrickPoolManagerBase::getPrefetchStatistics() const {
+    return PrefetchStatistics();
+}
+
+void OctreeBrickPoolManagerBase::resetPrefetchStatistics() {
+}
+
 void OctreeBrickPoolManagerBase::serialize(XmlSerializer& s) const {
     s.serialize("brickMemorySizeInByte", brickMemorySizeInByte_);
     s.serialize("initialized", initialized_);
@@ -107,11 +135,15 @@ void OctreeBrickPoolManagerBase::deserialize(XmlDeserializer& s) {
 // OctreeBrickPoolManagerRAM
 
 const std::string OctreeBrickPoolManagerRAM::loggerCat_("voreen.OctreeBrickPoolManagerRAM");
+const size_t OctreeBrickPoolManagerRAM::MAX_NUM_BUFFERS = 1<<20;
+const size_t OctreeBrickPoolManagerRAM::BUFFER_TABLE_CHUNK_SIZE = 1<<10;
 
 OctreeBrickPoolManagerRAM::OctreeBrickPoolManagerRAM(size_t maxSingleBufferSize)
     : OctreeBrickPoolManagerBase()
     , maxSingleBufferSizeBytes_(maxSingleBufferSize)
     , nextVirtualMemoryAddress_(0)
+    , bufferTable_(MAX_NUM_BUFFERS / BUFFER_TABLE_CHUNK_SIZE, 0)
+    , numBuffers_(0)
 {
     tgtAssert(maxSingleBufferSize > 0, "max buffer size must be greater zero");
 }
@@ -119,10 +151,29 @@ OctreeBrickPoolManagerRAM::OctreeBrickPoolManagerRAM(size_t maxSingleBufferSize)
 OctreeBrickPoolManagerRAM::~OctreeBrickPoolManagerRAM() {
     if (isInitialized())
         deinitialize();
+    for (size_t i=0; i<bufferTable_.size(); i++)
+        delete[] bufferTable_[i];
 }
 
 size_t OctreeBrickPoolManagerRAM::getNumBrickBuffers() const {
-    return brickBuffers_.size();
+    return numBuffers_.load();
+}
+
+char* OctreeBrickPoolManagerRAM::getBuffer(size_t bufferID) const {
+    return bufferTable_[bufferID / BUFFER_TABLE_CHUNK_SIZE][bufferID % BUFFER_TABLE_CHUNK_SIZE];
+}
+
+void OctreeBrickPoolManagerRAM::appendBuffer(char* buffer) {
+    size_t bufferID = numBuffers_.load();
+    tgtAssert(bufferID < MAX_NUM_BUFFERS, "buffer table is full");
+
+    char**& chunk = bufferTable_[bufferID / BUFFER_TABLE_CHUNK_SIZE];
+    if (!chunk)
+        chunk = new char*[BUFFER_TABLE_CHUNK_SIZE];
+    chunk[bufferID % BUFFER_TABLE_CHUNK_SIZE] = buffer;
+
+    // publish the entry only after it has been written
+    numBuffers_.store(bufferID + 1);
 }
 
 uint64_t OctreeBrickPoolManagerRAM::allocateBrick() throw (VoreenException) {
@@ -132,9 +183,10 @@ uint64_t OctreeBrickPoolManagerRAM::allocateBrick() throw (VoreenException) {
 
     uint64_t bufferID = nextVirtualMemoryAddress_ / getBrickBufferSizeInBytes();
     uint64_t bufferOffset = nextVirtualMemoryAddress_ % getBrickBufferSizeInBytes();
-    while (bufferID >= brickBuffers_.size()){
-        char* test = new char[getBrickBufferSizeInBytes()];
-        brickBuffers_.push_back(test);
+    while (bufferID >= numBuffers_.load()){
+        if (numBuffers_.load() >= MAX_NUM_BUFFERS)
+            throw VoreenException("Maximum number of brick buffers reached: " + itos(MAX_NUM_BUFFERS));
+        appendBuffer(new char[getBrickBufferSizeInBytes()]);
     }
     uint64_t returnValue = nextVirtualMemoryAddress_;
     nextVirtualMemoryAddress_ += getBrickMemorySizeInByte();
@@ -150,25 +202,22 @@ const uint16_t* OctreeBrickPoolManagerRAM::getBrick(uint64_t virtualMemoryAddres
 {
     // ignore blocking parameter, since we only operate in RAM anyway
 
-    boost::lock_guard<boost::mutex> lock(mutex_);
-
     tgtAssert(isInitialized(), "no initialized");
     tgtAssert(virtualMemoryAddress == 0 || (virtualMemoryAddress == std::numeric_limits<uint64_t>::max()) || (isMultipleOf(virtualMemoryAddress, (uint64_t)getBrickMemorySizeInByte())),
             "brick virtual memory address is not a multiple of the brick memory size");
 
     size_t bufferID = static_cast<size_t>(virtualMemoryAddress / getBrickBufferSizeInBytes());
     uint64_t bufferOffset = virtualMemoryAddress % getBrickBufferSizeInBytes();
-    if (bufferID >= brickBuffers_.size())
+
+    if (bufferID >= numBuffers_.load())
         return 0;
     else
-        return reinterpret_cast<uint16_t*>(brickBuffers_[bufferID] + bufferOffset);
+        return reinterpret_cast<uint16_t*>(getBuffer(bufferID) + bufferOffset);
 }
 
 uint16_t* OctreeBrickPoolManagerRAM::getWritableBrick(uint64_t virtualMemoryAddress, bool blocking) const
     throw (VoreenException)
 {
-    //boost::lock_guard<boost::mutex> lock(mutex_);
-
     return const_cast<uint16_t*>(getBrick(virtualMemoryAddress));
 }
 
@@ -205,7 +254,7 @@ void OctreeBrickPoolManagerRAM::serialize(XmlSerializer& s) const {
     s.serialize("maxSingleBufferSizeBytes", maxSingleBufferSizeBytes_);
     s.serialize("singleBufferSizeBytes",    singleBufferSizeBytes_);
     s.serialize("nextVirtualMemoryAddress", nextVirtualMemoryAddress_);
-    s.serialize("numBuffers", brickBuffers_.size());
+    s.serialize("numBuffers", getNumBrickBuffers());
 
     // determine output path for brick buffers
     const std::string octreeFile = s.getDocumentPath();
@@ -222,14 +271,14 @@ void OctreeBrickPoolManagerRAM::serialize(XmlSerializer& s) const {
     tgtAssert(tgt::FileSystem::dirExists(brickBufferPath), "brick buffer path not created");
 
     // serialize brick buffers
-    for (size_t i=0; i<brickBuffers_.size(); i++) {
+    for (size_t i=0; i<getNumBrickBuffers(); i++) {
         const std::string bufferFile = brickBufferPath + "/rambuffer_" + itos(i, 10, '0') + ".raw";
         std::fstream fileStream(bufferFile.c_str(), std::ios_base::out | std::ios_base::binary);
         if (fileStream.fail())
             throw SerializationException("Failed to open file '" + bufferFile + "' for writing");
 
         try {
-            fileStream.write(brickBuffers_.at(i), singleBufferSizeBytes_);
+            fileStream.write(getBuffer(i), singleBufferSizeBytes_);
         }
         catch (std::exception& e) {
             fileStream.close();
@@ -251,7 +300,7 @@ void OctreeBrickPoolManagerRAM::deserialize(XmlDeserializer& s) {
     s.deserialize("nextVirtualMemoryAddress", nextVirtualMemoryAddress_);
     int numBuffers = 0;
     s.deserialize("numBuffers", numBuffers);
-    if (numBuffers <= 0 || numBuffers > 1<<20)
+    if (numBuffers <= 0 || numBuffers > static_cast<int>(MAX_NUM_BUFFERS))
         throw SerializationException("OctreeBrickPoolManagerRAM: invalid buffer count: " + itos(numBuffers));
 
     // determine brick buffer path
@@ -278,7 +327,7 @@ void OctreeBrickPoolManagerRAM::deserialize(XmlDeserializer& s) {
             throw SerializationException("Bad allocation when creating brick buffer");
         }
         tgtAssert(buffer, "no buffer");
-        brickBuffers_.push_back(buffer);
+        appendBuffer(buffer);
 
         // read brick buffer from file
         try {
@@ -313,9 +362,10 @@ void OctreeBrickPoolManagerRAM::deinitialize() throw (VoreenException) {
 
     boost::lock_guard<boost::mutex> lock(mutex_);
 
-    for (size_t i=0; i<brickBuffers_.size(); i++)
-        delete[] brickBuffers_.at(i);
-    brickBuffers_.clear();
+    size_t numBuffers = numBuffers_.load();
+    numBuffers_.store(0);
+    for (size_t i=0; i<numBuffers; i++)
+        delete[] getBuffer(i);
     nextVirtualMemoryAddress_ = 0;
 
     OctreeBrickPoolManagerBase::deinitialize();
@@ -324,7 +374,7 @@ void OctreeBrickPoolManagerRAM::deinitialize() throw (VoreenException) {
 std::string OctreeBrickPoolManagerRAM::getDescription() const {
     std::string desc;
     desc += "Single Buffer Size: " + formatMemorySize(singleBufferSizeBytes_) + ", ";
-    desc += "Num Buffers Allocated: " + itos(brickBuffers_.size()) + ", ";
+    desc += "Num Buffers Allocated: " + itos(getNumBrickBuffers()) + ", ";
     desc += "Memory Allocated: " + formatMemorySize(getBrickPoolMemoryAllocated());
     return desc;
 }
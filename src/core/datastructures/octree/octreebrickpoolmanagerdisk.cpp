@@ -26,13 +26,26 @@
 #include "voreen/core/datastructures/octree/octreebrickpoolmanagerdisk.h"
 
 #include "voreen/core/utils/stringutils.h"
+#include "voreen/core/utils/tracing.h"
 #include "voreen/core/io/serialization/serialization.h"
 #include "voreen/core/io/progressreporter.h"
 
 #include "voreen/core/datastructures/octree/octreeutils.h"
+#include "voreen/core/datastructures/octree/octreebrickcodec.h"
 
 #include "tgt/filesystem.h"
 
+#include <limits>
+#include <fstream>
+#include <boost/bind.hpp>
+
+namespace {
+
+/// Identifies compressed buffer files ("VBRC"). Uncompressed buffer files have exactly the single buffer size.
+const uint32_t COMPRESSED_BUFFER_MAGIC = 0x43524256;
+
+}
+
 namespace voreen {
 
 void OctreeBrickPoolManagerDisk::BrickEntry::increaseInUse(size_t channel) {
@@ -102,22 +115,33 @@ bool OctreeBrickPoolManagerDisk::BrickEntry::isBeingWritten() {
     return ((entry_ & mask) > 0);
 }
 
+const size_t OctreeBrickPoolManagerDisk::MAX_NUM_BUFFERS = 1<<20;
+
 OctreeBrickPoolManagerDisk::OctreeBrickPoolManagerDisk(const size_t maxBufferSize, const size_t maxRamUsed,
         const std::string& brickPoolPath, const std::string& bufferFilePrefix)
     : OctreeBrickPoolManagerBase()
-    , maxBufferSizeBytes_(maxBufferSize)
     , brickPoolPath_(brickPoolPath)
     , bufferFilePrefix_(bufferFilePrefix)
+    , maxBufferSizeBytes_(maxBufferSize)
     , ramLimitInBytes_(maxRamUsed)
     , maxNumBuffersInRAM_(0)
     , nextVirtualMemoryAddress_(0)
     , numBuffersInRAM_(0)
+    , cachePolicy_(new BrickPoolCachePolicy2Q())
+    , compressBricks_(true)
+    , numEvictionWaiters_(0)
+    , numPrefetchThreads_(2)
+    , stopPrefetching_(false)
+    , numPrefetchHits_(0)
+    , numPrefetchHitsAtReset_(0)
 {
     brickPoolPath_ = tgt::FileSystem::absolutePath(brickPoolPath);
     bufferFilePrefix_ = (!bufferFilePrefix.empty() ? bufferFilePrefix : "brickbuffer_");
 }
 
 OctreeBrickPoolManagerDisk::~OctreeBrickPoolManagerDisk() {
+    stopPrefetchThreads();
+    delete cachePolicy_;
 }
 
 OctreeBrickPoolManagerDisk* OctreeBrickPoolManagerDisk::create() const {
@@ -151,9 +175,14 @@ void OctreeBrickPoolManagerDisk::initialize(size_t brickMemorySizeInByte) throw
 
     // define max value
     maxNumBuffersInRAM_ = ramLimitInBytes_/singleBufferSizeBytes_;
+    cachePolicy_->initialize(bufferVector_.size(), maxNumBuffersInRAM_);
+
+    // the buffer vector must not be reallocated, since it is read without holding the mutex
+    bufferVector_.reserve(MAX_NUM_BUFFERS);
 }
 
 void OctreeBrickPoolManagerDisk::deinitialize() throw (VoreenException) {
+    stopPrefetchThreads();
     flushPoolToDisk();
 
     for (size_t i = 0; i < bufferVector_.size(); i++) {
@@ -161,7 +190,8 @@ void OctreeBrickPoolManagerDisk::deinitialize() throw (VoreenException) {
         bufferVector_[i] = 0;
     }
     bufferVector_.clear();
-    brickPoolManagerQueue_.clear();
+    cachePolicy_->initialize(0, 0);
+    compressedBrickSizes_.clear();
     deletedBricks_.clear();
     numBuffersInRAM_ = 0;
 
@@ -180,6 +210,7 @@ void OctreeBrickPoolManagerDisk::setRAMLimit(size_t ramLimitInBytes) {
 
     if (ramLimitInBytes != ramLimitInBytes_) {
         // save non-persistent data to disk
+        stopPrefetchThreads();
         flushPoolToDisk();
 
         // delete RAM buffer vectors
@@ -188,7 +219,6 @@ void OctreeBrickPoolManagerDisk::setRAMLimit(size_t ramLimitInBytes) {
             bufferVector_[i] = 0;
         }
         bufferVector_.clear();
-        brickPoolManagerQueue_.clear();
         deletedBricks_.clear();
         numBuffersInRAM_ = 0;
 
@@ -197,7 +227,8 @@ void OctreeBrickPoolManagerDisk::setRAMLimit(size_t ramLimitInBytes) {
         maxNumBuffersInRAM_ = ramLimitInBytes_/singleBufferSizeBytes_;
 
         for (size_t i = 0; i < bufferFiles_.size(); i++)
-            bufferVector_.push_back(new BufferEntry(numBrickSlotsPerBuffer_, 0, 0));
+            bufferVector_.push_back(new BufferEntry(numBrickSlotsPerBuffer_, 0));
+        cachePolicy_->initialize(bufferVector_.size(), maxNumBuffersInRAM_);
     }
 }
 
@@ -216,6 +247,8 @@ void OctreeBrickPoolManagerDisk::serialize(XmlSerializer& s) const {
     s.serialize("bufferFilePrefix", bufferFilePrefix_);
 
     s.serialize("nextVirtualMemoryAddress", nextVirtualMemoryAddress_);
+    s.serialize("cachePolicy", cachePolicy_->getName());
+    s.serialize("brickCompression", compressBricks_);
 }
 
 void  OctreeBrickPoolManagerDisk::deserialize(XmlDeserializer& s) {
@@ -231,6 +264,12 @@ void  OctreeBrickPoolManagerDisk::deserialize(XmlDeserializer& s) {
 
     s.deserialize("nextVirtualMemoryAddress", nextVirtualMemoryAddress_);
 
+    std::string cachePolicy;
+    s.optionalDeserialize("cachePolicy", cachePolicy, std::string("2q"));
+    delete cachePolicy_;
+    cachePolicy_ = BrickPoolCachePolicy::createPolicy(cachePolicy);
+    s.optionalDeserialize("brickCompression", compressBricks_, false);
+
     // check brick pool path
     if (!tgt::FileSystem::dirExists(brickPoolPath_))
         throw VoreenException("Brick pool path does not exist: " + brickPoolPath_);
@@ -238,11 +277,20 @@ void  OctreeBrickPoolManagerDisk::deserialize(XmlDeserializer& s) {
     // make sure that buffer files are present
     if (bufferFiles_.empty())
         throw VoreenException("No brick buffer files");
+    if (bufferFiles_.size() > MAX_NUM_BUFFERS)
+        throw VoreenException("Too many brick buffer files: " + itos(bufferFiles_.size()));
     for (size_t i=0; i<bufferFiles_.size(); i++) {
         if (!tgt::FileSystem::fileExists(bufferFiles_.at(i)))
             throw VoreenException("Missing brick buffer file: " + bufferFiles_.at(i));
     }
 
+    // restore the encoded brick sizes from the buffer file headers
+    compressedBrickSizes_.assign(bufferFiles_.size()*numBrickSlotsPerBuffer_, 0);
+    for (size_t i=0; i<bufferFiles_.size(); i++) {
+        if (!readBufferFileBrickSizes(bufferFiles_.at(i), &compressedBrickSizes_[i*numBrickSlotsPerBuffer_]))
+            LWARNING("Failed to read brick sizes from buffer file: " << bufferFiles_.at(i));
+    }
+
     // check ram limit vs. buffer size
     if (2*singleBufferSizeBytes_ > ramLimitInBytes_)
         throw VoreenException("RAM memory limit is smaller than two times the size of a buffer. At least two buffer files have to fit in the RAM. "
@@ -250,22 +298,80 @@ void  OctreeBrickPoolManagerDisk::deserialize(XmlDeserializer& s) {
 
     // init buffer vector
     maxNumBuffersInRAM_ = ramLimitInBytes_/singleBufferSizeBytes_;
+    bufferVector_.reserve(MAX_NUM_BUFFERS);
     for (size_t i = 0; i < bufferFiles_.size(); i++)
-        bufferVector_.push_back(new BufferEntry(numBrickSlotsPerBuffer_, 0, 0));
+        bufferVector_.push_back(new BufferEntry(numBrickSlotsPerBuffer_, 0));
+    cachePolicy_->initialize(bufferVector_.size(), maxNumBuffersInRAM_);
 }
 
 //-----------------------------------------------------------------------------------------------------------------------
 //      BRICK INTERACTION
 //-----------------------------------------------------------------------------------------------------------------------
 bool OctreeBrickPoolManagerDisk::isBrickInRAM(uint64_t virtualMemoryAddress) const {
-    boost::unique_lock<boost::mutex> lock(mutex_);
     size_t bufferID = static_cast<size_t>(virtualMemoryAddress / singleBufferSizeBytes_);
     tgtAssert(bufferID < bufferVector_.size(), "bufferID not in vector");
+    boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
     return bufferVector_[bufferID]->isInRAM_;
 }
 
-const uint16_t* OctreeBrickPoolManagerDisk::getBrick(uint64_t virtualMemoryAddress, ChannelSelection channels, bool blocking) const throw (VoreenException) {
+OctreeBrickPoolManagerDisk::BufferEntry* OctreeBrickPoolManagerDisk::pinBuffer(size_t bufferID, bool blocking) const throw (VoreenException) {
+    tgtAssert(bufferID < bufferVector_.size(), "bufferID not in vector");
+    BufferEntry* entry = bufferVector_[bufferID];
+
+    //fast path: buffer is resident => only the stripe lock is needed
+    {
+        boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+        if(entry->isInRAM_) {
+            tgtAssert(entry->inUse_ != 255,"Overflow in use buffer!");
+            entry->inUse_++;
+            entry->referenced_ = true;
+            if(entry->isPrefetched_) {
+                entry->isPrefetched_ = false;
+                ++numPrefetchHits_;
+            }
+            return entry;
+        }
+    }
+
+    //slow path: buffer has to be loaded (or is currently loaded by another thread)
     boost::unique_lock<boost::mutex> lock(mutex_);
+    while(true) {
+        {
+            boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+            if(entry->isInRAM_) {
+                tgtAssert(entry->inUse_ != 255,"Overflow in use buffer!");
+                entry->inUse_++;
+                entry->referenced_ = true;
+                if(entry->isPrefetched_) {
+                    entry->isPrefetched_ = false;
+                    ++numPrefetchHits_;
+                }
+                return entry;
+            }
+            if(!entry->isLoading_)
+                break;
+        }
+        //wait for a running (prefetch) load instead of loading the buffer a second time
+        cond_.wait(lock);
+    }
+    return loadBufferFromDisk(bufferID, blocking, lock); //inUse_(1)
+}
+
+bool OctreeBrickPoolManagerDisk::unpinBuffer(BufferEntry* entry) const {
+    tgtAssert(entry->inUse_ > 0, "buffer not in use!");
+    entry->inUse_--;
+    return (entry->inUse_ == 0);
+}
+
+void OctreeBrickPoolManagerDisk::notifyBufferReleased() const {
+    //only bother the global mutex, if a thread actually waits for a buffer to become evictable
+    if(numEvictionWaiters_ > 0) {
+        boost::unique_lock<boost::mutex> lock(mutex_);
+        cond_.notify_all();
+    }
+}
+
+const uint16_t* OctreeBrickPoolManagerDisk::getBrick(uint64_t virtualMemoryAddress, ChannelSelection channels, bool blocking) const throw (VoreenException) {
     //constraint SIZE_MAX equals no brick
     if(virtualMemoryAddress == std::numeric_limits<uint64_t>::max()) return 0;
 
@@ -273,31 +379,28 @@ const uint16_t* OctreeBrickPoolManagerDisk::getBrick(uint64_t virtualMemoryAddre
     size_t bufferOffset = static_cast<size_t>(virtualMemoryAddress) % singleBufferSizeBytes_;
     size_t index = bufferOffset/getBrickMemorySizeInByte();
 
-    tgtAssert(bufferID < bufferVector_.size(), "bufferID not in vector");
-    if(bufferVector_[bufferID]->isInRAM_) {
-        //increase use counter to prevent buffer removel
-        tgtAssert(bufferVector_[bufferID]->inUse_ != 255,"Overflow in use buffer!");
-        bufferVector_[bufferID]->inUse_++;
-        bufferVector_[bufferID]->bricksInUse_[index].increaseInUse(channels);
-        //wait for other threads to release brick
-        if(blocking) {
-            while(bufferVector_[bufferID]->bricksInUse_[index].isBeingWritten(channels))
-                cond_.wait(lock);
-        } else {
-            if(bufferVector_[bufferID]->bricksInUse_[index].isBeingWritten(channels))
-                throw BrickIsBeingWrittenException();
-        }
-        brickPoolManagerQueue_.pushToFront(bufferVector_[bufferID]->node_);
-        return reinterpret_cast<uint16_t*>(bufferVector_[bufferID]->data_ + bufferOffset);
+    BufferEntry* entry = pinBuffer(bufferID, blocking);
+
+    boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+    entry->bricksInUse_[index].increaseInUse(channels);
+    //wait for other threads to release brick
+    if(blocking) {
+        while(entry->bricksInUse_[index].isBeingWritten(channels))
+            getStripeCondition(bufferID).wait(stripeLock);
     } else {
-        BufferEntry* entry = loadBufferFromDisk(bufferID,blocking,lock); //inUse_(1)
-        entry->bricksInUse_[index].increaseInUse(channels);
-        return reinterpret_cast<uint16_t*>(entry->data_ + bufferOffset);
+        if(entry->bricksInUse_[index].isBeingWritten(channels)) {
+            entry->bricksInUse_[index].decreaseInUse(channels);
+            bool released = unpinBuffer(entry);
+            stripeLock.unlock();
+            if(released)
+                notifyBufferReleased();
+            throw BrickIsBeingWrittenException();
+        }
     }
+    return reinterpret_cast<uint16_t*>(entry->data_ + bufferOffset);
 }
 
 uint16_t* OctreeBrickPoolManagerDisk::getWritableBrick(uint64_t virtualMemoryAddress, ChannelSelection channels, bool blocking) const throw (VoreenException){
-    boost::unique_lock<boost::mutex> lock(mutex_);
     //constraint SIZE_MAX equals no brick
     if(virtualMemoryAddress == (uint64_t)(-1)) return 0;
 
@@ -305,57 +408,57 @@ uint16_t* OctreeBrickPoolManagerDisk::getWritableBrick(uint64_t virtualMemoryAdd
     size_t bufferOffset = static_cast<size_t>(virtualMemoryAddress) % singleBufferSizeBytes_;
     size_t index = bufferOffset/getBrickMemorySizeInByte();
 
-    tgtAssert(bufferID < bufferVector_.size(), "bufferID not in vector");
-    if(bufferVector_[bufferID]->isInRAM_) {
-        //increase use counter to prevent buffer removel
-        tgtAssert(bufferVector_[bufferID]->inUse_ != 255,"Overflow in use buffer!");
-        bufferVector_[bufferID]->inUse_++;
-        bufferVector_[bufferID]->bricksInUse_[index].increaseInUse(channels);
-        if(blocking) {
-            while(bufferVector_[bufferID]->bricksInUse_[index].isBeingWritten(channels) ||
-                bufferVector_[bufferID]->bricksInUse_[index].isInUse(channels, 1)) //1, since it has been increased
-                cond_.wait(lock);
-        } else {
-            if(bufferVector_[bufferID]->bricksInUse_[index].isBeingWritten(channels)) {
+    BufferEntry* entry = pinBuffer(bufferID, blocking);
+
+    boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+    entry->bricksInUse_[index].increaseInUse(channels);
+    if(blocking) {
+        while(entry->bricksInUse_[index].isBeingWritten(channels) ||
+            entry->bricksInUse_[index].isInUse(channels, 1)) //1, since it has been increased
+            getStripeCondition(bufferID).wait(stripeLock);
+    } else {
+        if(entry->bricksInUse_[index].isBeingWritten(channels) || entry->bricksInUse_[index].isInUse(channels, 1)) {
+            bool beingWritten = entry->bricksInUse_[index].isBeingWritten(channels);
+            entry->bricksInUse_[index].decreaseInUse(channels);
+            bool released = unpinBuffer(entry);
+            stripeLock.unlock();
+            if(released)
+                notifyBufferReleased();
+            if(beingWritten)
                 throw BrickIsBeingWrittenException();
-            }
-            if(bufferVector_[bufferID]->bricksInUse_[index].isInUse(channels, 1)) {
+            else
                 throw BrickIsInUseException();
-            }
         }
-        bufferVector_[bufferID]->bricksInUse_[index].setBeingWritten(true, channels);
-        brickPoolManagerQueue_.pushToFront(bufferVector_[bufferID]->node_);
-        bufferVector_[bufferID]->mustBeSavedToDisk_ = true;
-        return reinterpret_cast<uint16_t*>(bufferVector_[bufferID]->data_ + bufferOffset);
-    } else {
-        BufferEntry* entry = loadBufferFromDisk(bufferID,blocking,lock); //inUse_(1)
-        entry->bricksInUse_[index].increaseInUse(channels);
-        entry->bricksInUse_[index].setBeingWritten(true, channels);
-        entry->mustBeSavedToDisk_ = true;
-        return reinterpret_cast<uint16_t*>(entry->data_ + bufferOffset);
     }
+    entry->bricksInUse_[index].setBeingWritten(true, channels);
+    entry->mustBeSavedToDisk_ = true;
+    return reinterpret_cast<uint16_t*>(entry->data_ + bufferOffset);
 }
 
 void OctreeBrickPoolManagerDisk::releaseBrick(uint64_t virtualMemoryAddress, ChannelSelection channels, AccessMode mode) const {
-    boost::unique_lock<boost::mutex> lock(mutex_);
-
     size_t bufferID = static_cast<size_t>(virtualMemoryAddress) / singleBufferSizeBytes_;
     size_t bufferOffset = static_cast<size_t>(virtualMemoryAddress) % singleBufferSizeBytes_;
     size_t index = bufferOffset/getBrickMemorySizeInByte();
 
     tgtAssert(bufferID < bufferVector_.size(), "bufferID not in vector");
-    if(bufferVector_[bufferID]->isInRAM_) {
-        if(mode == WRITE)
-            bufferVector_[bufferID]->bricksInUse_[index].setBeingWritten(false,channels);
-        tgtAssert(bufferVector_[bufferID]->bricksInUse_[index].isInUse(channels, 0), "releaseBrick called on brick without being in use!");
-        bufferVector_[bufferID]->bricksInUse_[index].decreaseInUse(channels);
-        tgtAssert(bufferVector_[bufferID]->inUse_ > 0, "releaseBrick called on brick without being in use!");
-        bufferVector_[bufferID]->inUse_--;
-        tgtAssert(!(!(bufferVector_[bufferID]->bricksInUse_[index].isInUse(channels,0)) && (bufferVector_[bufferID]->bricksInUse_[index].isBeingWritten(channels))), "brick has no handle but is still being written");
-        cond_.notify_all();
-    } else {
+    BufferEntry* entry = bufferVector_[bufferID];
+
+    boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+    if(!entry->isInRAM_) {
         tgtAssert(false, "buffer not in RAM!")
+        return;
     }
+    if(mode == WRITE)
+        entry->bricksInUse_[index].setBeingWritten(false,channels);
+    tgtAssert(entry->bricksInUse_[index].isInUse(channels, 0), "releaseBrick called on brick without being in use!");
+    entry->bricksInUse_[index].decreaseInUse(channels);
+    bool released = unpinBuffer(entry);
+    tgtAssert(!(!(entry->bricksInUse_[index].isInUse(channels,0)) && (entry->bricksInUse_[index].isBeingWritten(channels))), "brick has no handle but is still being written");
+    getStripeCondition(bufferID).notify_all();
+    stripeLock.unlock();
+
+    if(released)
+        notifyBufferReleased();
 }
 
 uint64_t OctreeBrickPoolManagerDisk::allocateBrick() throw (VoreenException){
@@ -375,43 +478,17 @@ uint64_t OctreeBrickPoolManagerDisk::allocateBrick() throw (VoreenException){
         deletedBricks_.pop_back();
         return returnValue;
     } else { //case3
+        if (bufferVector_.size() >= MAX_NUM_BUFFERS) {
+            LERROR("Maximum number of brick buffers reached: " << MAX_NUM_BUFFERS);
+            throw VoreenException("Maximum number of brick buffers reached: " + itos(MAX_NUM_BUFFERS));
+        }
 
-/*        std::ofstream outfile(path.str().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
-        if(outfile.fail())
-            throw VoreenException("Could not open: " + path.str());
-        outfile << itos(0,(int)singleBufferSizeBytes_);
-        outfile.close();*/
-
-
-        std::stringstream path;
-        path << brickPoolPath_ << "/" << bufferFilePrefix_ << itos(bufferFiles_.size(), 10);
-        bufferFiles_.push_back(path.str());
-
-        bufferVector_.push_back(new BufferEntry(numBrickSlotsPerBuffer_, 0, 0));
-
-        if(numBuffersInRAM_ == maxNumBuffersInRAM_) {
-            //find LRU buffer
-            size_t removeBuffer = brickPoolManagerQueue_.last_->previous_->data_;
-            tgtAssert(bufferVector_.size() > removeBuffer, "buffer is not in ram!")
-            if(bufferVector_[removeBuffer]->inUse_ > 0) {
+        if(numBuffersInRAM_ >= maxNumBuffersInRAM_) {
+            if(!evictBuffer(false)) {
                 tgtAssert(false,"All bricks are in use!");
                 LERROR("All bricks are in use!");
                 throw VoreenException("All bricks are in use!");
             }
-            //safe old buffer
-            if(bufferVector_[removeBuffer]->mustBeSavedToDisk_)
-                saveBufferToDisk(removeBuffer);
-            //clean up
-            if(removeBuffer != brickPoolManagerQueue_.removeLast()) {
-                tgtAssert(false, "something went wrong!");
-                LERROR("something went wrong!");
-            }
-            delete[] bufferVector_[removeBuffer]->data_;
-            bufferVector_[removeBuffer]->data_ = 0;
-            bufferVector_[removeBuffer]->node_ = 0;
-            bufferVector_[removeBuffer]->isInRAM_ = false;
-            //LERROR("kicked: " << removeBuffer << " loaded: " << bufferID);
-            numBuffersInRAM_--;
         }
 
         char* buffer = 0;
@@ -423,15 +500,21 @@ uint64_t OctreeBrickPoolManagerDisk::allocateBrick() throw (VoreenException){
             throw VoreenException(e.what());
         }
 
-        size_t bufferID = bufferVector_.size()-1;
-        BrickPoolManagerQueueNode<size_t>* node = brickPoolManagerQueue_.insertToFront(bufferID);
-        bufferVector_.back()->data_ = buffer;
-        bufferVector_[bufferID]->isInRAM_ = true;
-        bufferVector_[bufferID]->inUse_ = 0;
-        bufferVector_[bufferID]->mustBeSavedToDisk_ = true;
-        bufferVector_[bufferID]->node_ = node;
-        numBuffersInRAM_++;
+        std::stringstream path;
+        path << brickPoolPath_ << "/" << bufferFilePrefix_ << itos(bufferFiles_.size(), 10);
+        bufferFiles_.push_back(path.str());
 
+        //the buffer vector must not be reallocated, since it is read without holding the mutex
+        tgtAssert(bufferVector_.size() < bufferVector_.capacity(), "buffer vector would be reallocated");
+        BufferEntry* entry = new BufferEntry(numBrickSlotsPerBuffer_, buffer);
+        size_t bufferID = bufferVector_.size();
+        entry->isInRAM_ = true;
+        entry->inUse_ = 0;
+        entry->mustBeSavedToDisk_ = true;
+        bufferVector_.push_back(entry);
+        cachePolicy_->setNumIds(bufferVector_.size());
+        cachePolicy_->insert(bufferID);
+        numBuffersInRAM_++;
 
         uint64_t returnValue = nextVirtualMemoryAddress_;
         nextVirtualMemoryAddress_ += static_cast<uint64_t>(getBrickMemorySizeInByte());
@@ -440,20 +523,19 @@ uint64_t OctreeBrickPoolManagerDisk::allocateBrick() throw (VoreenException){
 }
 
 void OctreeBrickPoolManagerDisk::deleteBrick(uint64_t virtualMemoryAddress) {
-    boost::unique_lock<boost::mutex> lock(mutex_);
-
     size_t bufferID = static_cast<size_t>(virtualMemoryAddress) / singleBufferSizeBytes_;
     size_t bufferOffset = static_cast<size_t>(virtualMemoryAddress) % singleBufferSizeBytes_;
     size_t index = bufferOffset/getBrickMemorySizeInByte();
 
     //wait for brick to be not used
     tgtAssert(bufferID < bufferVector_.size(), "bufferID not in vector");
-    if(bufferVector_[bufferID]->isInRAM_) {
-        while(bufferVector_[bufferID]->bricksInUse_[index].isInUse((uint16_t) 0)) {
-                cond_.wait(lock);
-        }
+    {
+        boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+        while(bufferVector_[bufferID]->isInRAM_ && bufferVector_[bufferID]->bricksInUse_[index].isInUse((uint16_t) 0))
+            getStripeCondition(bufferID).wait(stripeLock);
     }
 
+    boost::unique_lock<boost::mutex> lock(mutex_);
     deletedBricks_.push_back(virtualMemoryAddress);
 }
 
@@ -469,79 +551,270 @@ OctreeBrickPoolManagerDisk::BufferEntry* OctreeBrickPoolManagerDisk::loadBufferF
         LERROR("loadBrickFromDisk(): Buffer has not been created");
         throw VoreenException("Buffer has not been created");
     }
-    else {
-        //kick out old buffer, if RAM is to full
-        if(numBuffersInRAM_ == maxNumBuffersInRAM_) {
-            //find LRU buffer
-            size_t removeBuffer = brickPoolManagerQueue_.last_->previous_->data_;
-            tgtAssert(bufferVector_.size() > removeBuffer, "buffer is not in ram!")
-            if(blocking) {
-                while (bufferVector_[removeBuffer]->inUse_ > 0) {
-                    cond_.wait(lock);
-                    removeBuffer = brickPoolManagerQueue_.last_->previous_->data_;
-                }
-            } else {
-                if(bufferVector_[removeBuffer]->inUse_ > 0) {
-                    throw AllBuffersInUseException();
-                }
-            }
-            //safe old buffer
-            if(bufferVector_[removeBuffer]->mustBeSavedToDisk_)
-                saveBufferToDisk(removeBuffer);
-            //clean up
-            if(removeBuffer != brickPoolManagerQueue_.removeLast()) {
-                tgtAssert(false, "something went wrong!");
-                LERROR("something went wrong!");
+
+    BufferEntry* entry = bufferVector_[bufferID];
+    //other threads requesting this buffer wait until it has been loaded
+    {
+        boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+        tgtAssert(!entry->isInRAM_ && !entry->isLoading_, "buffer is already in RAM or being loaded");
+        entry->isLoading_ = true;
+    }
+
+    //kick out old buffer, if RAM is to full
+    //(register as waiter before checking, so that a release in between is not missed)
+    ++numEvictionWaiters_;
+    while(numBuffersInRAM_ >= maxNumBuffersInRAM_) {
+        if(evictBuffer(false))
+            continue;
+        if(blocking) {
+            cond_.wait(lock);
+        } else {
+            --numEvictionWaiters_;
+            {
+                boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+                entry->isLoading_ = false;
             }
-            delete[] bufferVector_[removeBuffer]->data_;
-            bufferVector_[removeBuffer]->data_ = 0;
-            bufferVector_[removeBuffer]->node_ = 0;
-            bufferVector_[removeBuffer]->isInRAM_ = false;
-            //LERROR("kicked: " << removeBuffer << " loaded: " << bufferID);
-            numBuffersInRAM_--;
+            cond_.notify_all();
+            throw AllBuffersInUseException();
+        }
+    }
+    --numEvictionWaiters_;
+    //reserve the slot in RAM and read the file without holding the lock
+    numBuffersInRAM_++;
+    prefetchStatistics_.numMisses_++;
+    const std::string bufferFile = bufferFiles_.at(bufferID);
+    tgtAssert(!bufferFile.empty(), "buffer file path is empty");
+
+    lock.unlock();
+    char* buffer = readBufferFile(bufferFile);
+    lock.lock();
+
+    if(!buffer) {
+        numBuffersInRAM_--;
+        {
+            boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+            entry->isLoading_ = false;
         }
+        cond_.notify_all();
+        tgtAssert(false,"Could not read buffer file!");
+        LERROR("Could not read buffer file: " << bufferFile);
+        throw VoreenException("Could not read buffer file: " + bufferFile);
+    }
 
-        const std::string bufferFile = bufferFiles_.at(bufferID);
-        tgtAssert(!bufferFile.empty(), "buffer file path is empty");
-        if (!tgt::FileSystem::fileExists(bufferFile)) {
-            tgtAssert(false,"Buffer file does not exists!");
-            LERROR("Buffer file does not exists!");
-            throw VoreenException("Buffer file does not exists!");
+    cachePolicy_->insert(bufferID);
+    {
+        boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+        entry->data_ = buffer;
+        entry->isInRAM_ = true;
+        entry->isLoading_ = false;
+        entry->isPrefetched_ = false;
+        entry->referenced_ = false;
+        entry->inUse_ = 1;
+        entry->mustBeSavedToDisk_ = false;
+    }
+    cond_.notify_all();
+
+    return entry;
+}
+
+char* OctreeBrickPoolManagerDisk::readBufferFile(const std::string& bufferFile) const {
+    TraceSpan span("io", "OctreeBrickPoolManagerDisk.readBufferFile");
+    if (!tgt::FileSystem::fileExists(bufferFile))
+        return 0;
+
+    char* buffer = 0;
+    try {
+        buffer = new char[singleBufferSizeBytes_];
+    } catch(std::bad_alloc&) {
+        return 0;
+    }
+    std::ifstream infile(bufferFile.c_str(), std::ios::in | std::ios::binary);
+    if(infile.fail()) {
+        delete[] buffer;
+        return 0;
+    }
+    infile.seekg(0, std::ios::end);
+    size_t fileSize = static_cast<size_t>(infile.tellg());
+    infile.seekg(0, std::ios::beg);
+
+    //uncompressed buffer file
+    if (fileSize == singleBufferSizeBytes_) {
+        infile.read(buffer,singleBufferSizeBytes_);
+        if(infile.bad()) {
+            delete[] buffer;
+            return 0;
         }
-        char* buffer = 0;
-        try {
-            buffer = new char[singleBufferSizeBytes_];
-        } catch(std::bad_alloc& e) {
-            tgtAssert(false,e.what());
-            LERROR(e.what());
-            throw VoreenException(e.what());
+        infile.close();
+        return buffer;
+    }
+
+    //compressed buffer file: header, encoded brick sizes, encoded bricks
+    try {
+        uint32_t header[2];
+        infile.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (infile.fail() || header[0] != COMPRESSED_BUFFER_MAGIC || header[1] != numBrickSlotsPerBuffer_)
+            throw std::exception();
+
+        std::vector<uint32_t> brickSizes(numBrickSlotsPerBuffer_);
+        infile.read(reinterpret_cast<char*>(&brickSizes[0]), numBrickSlotsPerBuffer_*sizeof(uint32_t));
+        size_t encodedBufferSize = 0;
+        for (size_t i = 0; i < numBrickSlotsPerBuffer_; i++)
+            encodedBufferSize += brickSizes[i];
+        if (infile.fail() || sizeof(header) + numBrickSlotsPerBuffer_*sizeof(uint32_t) + encodedBufferSize != fileSize)
+            throw std::exception();
+
+        std::vector<char> encodedBuffer(encodedBufferSize);
+        infile.read(&encodedBuffer[0], encodedBufferSize);
+        if (infile.fail())
+            throw std::exception();
+        infile.close();
+
+        OctreeBrickCodec codec(getBrickMemorySizeInByte() / sizeof(uint16_t));
+        size_t offset = 0;
+        for (size_t i = 0; i < numBrickSlotsPerBuffer_; i++) {
+            uint16_t* brick = reinterpret_cast<uint16_t*>(buffer + i*getBrickMemorySizeInByte());
+            if (!codec.decode(&encodedBuffer[offset], brickSizes[i], brick))
+                throw std::exception();
+            offset += brickSizes[i];
         }
-        std::ifstream infile(bufferFile.c_str(), std::ios::in | std::ios::binary);
-        if(infile.fail()) {
-            delete buffer;
-            tgtAssert(false,"Could not open buffer file!");
-            LERROR("Could not open buffer file!");
-            throw VoreenException("Could not open buffer file!");
+    }
+    catch (std::exception&) { // also catches std::bad_alloc
+        delete[] buffer;
+        return 0;
+    }
+    return buffer;
+}
+
+class OctreeBrickPoolManagerDisk::BufferEvictionCallback : public BrickPoolCachePolicy::EvictionCallback {
+public:
+    BufferEvictionCallback(const OctreeBrickPoolManagerDisk* manager, bool keepPrefetched)
+        : manager_(manager)
+        , keepPrefetched_(keepPrefetched)
+    {}
+
+    BrickPoolCachePolicy::ReferenceState testAndClearReference(size_t id) {
+        BufferEntry* entry = manager_->bufferVector_[id];
+        boost::unique_lock<boost::mutex> stripeLock(manager_->getStripeMutex(id));
+        if (!isEvictable(entry))
+            return BrickPoolCachePolicy::NOT_EVICTABLE;
+        if (entry->referenced_) {
+            entry->referenced_ = false;
+            return BrickPoolCachePolicy::REFERENCED;
         }
-        infile.read(buffer,singleBufferSizeBytes_);
-        tgtAssert(!infile.bad(), "reading from disk went wrong");
-        infile.close();
+        return BrickPoolCachePolicy::NOT_REFERENCED;
+    }
 
-        BrickPoolManagerQueueNode<size_t>* node = brickPoolManagerQueue_.insertToFront(bufferID);
-        bufferVector_[bufferID]->data_ = buffer;
-        bufferVector_[bufferID]->isInRAM_ = true;
-        bufferVector_[bufferID]->inUse_ = 1;
-        bufferVector_[bufferID]->mustBeSavedToDisk_ = false;
-        bufferVector_[bufferID]->node_ = node;
-        numBuffersInRAM_++;
+    bool claim(size_t id) {
+        BufferEntry* entry = manager_->bufferVector_[id];
+        boost::unique_lock<boost::mutex> stripeLock(manager_->getStripeMutex(id));
+        if (!isEvictable(entry))
+            return false;
+        //the buffer is no longer accessible via the fast path
+        entry->isInRAM_ = false;
+        return true;
+    }
+
+private:
+    bool isEvictable(const BufferEntry* entry) const {
+        tgtAssert(entry->isInRAM_, "buffer not in RAM");
+        return entry->inUse_ == 0 && !(keepPrefetched_ && entry->isPrefetched_);
+    }
+
+    const OctreeBrickPoolManagerDisk* manager_;
+    bool keepPrefetched_;
+};
+
+bool OctreeBrickPoolManagerDisk::evictBuffer(bool keepPrefetched) const {
+    BufferEvictionCallback callback(this, keepPrefetched);
+    size_t removeBuffer = 0;
+    if (!cachePolicy_->selectVictim(callback, removeBuffer))
+        return false;
+    tgtAssert(bufferVector_.size() > removeBuffer, "buffer is not in ram!")
+    BufferEntry* entry = bufferVector_[removeBuffer];
+
+    //the buffer has been claimed: it cannot be pinned again without the global mutex
+    //safe old buffer
+    if(entry->mustBeSavedToDisk_)
+        saveBufferToDisk(removeBuffer);
+    if(entry->isPrefetched_) {
+        entry->isPrefetched_ = false;
+        prefetchStatistics_.numWasted_++;
+    }
+    //clean up
+    delete[] entry->data_;
+    entry->data_ = 0;
+    numBuffersInRAM_--;
+    return true;
+}
+
+void OctreeBrickPoolManagerDisk::setCachePolicy(const std::string& policyName) throw (VoreenException) {
+    BrickPoolCachePolicy* policy = BrickPoolCachePolicy::createPolicy(policyName);
+
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    policy->initialize(bufferVector_.size(), maxNumBuffersInRAM_);
+    for (size_t i = 0; i < bufferVector_.size(); i++) {
+        boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(i));
+        if (bufferVector_[i]->isInRAM_)
+            policy->insert(i);
+    }
+    delete cachePolicy_;
+    cachePolicy_ = policy;
+}
+
+std::string OctreeBrickPoolManagerDisk::getCachePolicy() const {
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    return cachePolicy_->getName();
+}
+
+void OctreeBrickPoolManagerDisk::setBrickCompression(bool enabled) {
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    compressBricks_ = enabled;
+}
+
+bool OctreeBrickPoolManagerDisk::getBrickCompression() const {
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    return compressBricks_;
+}
+
+size_t OctreeBrickPoolManagerDisk::getCompressedBrickSize(uint64_t virtualMemoryAddress) const {
+    size_t brickIndex = static_cast<size_t>(virtualMemoryAddress / getBrickMemorySizeInByte());
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    if (brickIndex < compressedBrickSizes_.size())
+        return compressedBrickSizes_[brickIndex];
+    else
+        return 0;
+}
+
+bool OctreeBrickPoolManagerDisk::readBufferFileBrickSizes(const std::string& bufferFile, uint32_t* brickSizes) const {
+    tgtAssert(brickSizes, "null pointer passed");
+    std::ifstream infile(bufferFile.c_str(), std::ios::in | std::ios::binary);
+    if (infile.fail())
+        return false;
+    infile.seekg(0, std::ios::end);
+    size_t fileSize = static_cast<size_t>(infile.tellg());
+    infile.seekg(0, std::ios::beg);
+
+    //uncompressed buffer file
+    if (fileSize == singleBufferSizeBytes_) {
+        std::fill(brickSizes, brickSizes + numBrickSlotsPerBuffer_, static_cast<uint32_t>(getBrickMemorySizeInByte()));
+        return true;
+    }
 
-        return bufferVector_[bufferID];
+    //compressed buffer file: header, encoded brick sizes
+    uint32_t header[2];
+    infile.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (infile.fail() || header[0] != COMPRESSED_BUFFER_MAGIC || header[1] != numBrickSlotsPerBuffer_)
+        return false;
+    infile.read(reinterpret_cast<char*>(brickSizes), numBrickSlotsPerBuffer_*sizeof(uint32_t));
+    if (infile.fail()) {
+        std::fill(brickSizes, brickSizes + numBrickSlotsPerBuffer_, 0);
+        return false;
     }
-    tgtAssert(false, "Should not get here");
-    throw VoreenException("Should not get here");
+    return true;
 }
 
 void OctreeBrickPoolManagerDisk::saveBufferToDisk(const size_t bufferID) const {
+    TraceSpan span("io", "OctreeBrickPoolManagerDisk.saveBufferToDisk");
     tgtAssert(bufferID < bufferVector_.size(), "bufferID not in vector");
     if (bufferID >= bufferFiles_.size()) {
         tgtAssert(false,"Buffer has not been created");
@@ -558,33 +831,74 @@ void OctreeBrickPoolManagerDisk::saveBufferToDisk(const size_t bufferID) const {
             return ;
         }*/
 
+        const char* data = bufferVector_[bufferID]->data_;
+        const size_t brickSize = getBrickMemorySizeInByte();
+
+        //encode bricks
+        std::vector<uint32_t> brickSizes(numBrickSlotsPerBuffer_, static_cast<uint32_t>(brickSize));
+        std::vector<char> encodedBuffer;
+        bool compressed = false;
+        if (compressBricks_) {
+            OctreeBrickCodec codec(brickSize / sizeof(uint16_t));
+            size_t encodedBufferSize = 0;
+            encodedBuffer.resize(numBrickSlotsPerBuffer_*codec.getMaxEncodedSize());
+            for (size_t i = 0; i < numBrickSlotsPerBuffer_; i++) {
+                brickSizes[i] = static_cast<uint32_t>(codec.encode(reinterpret_cast<const uint16_t*>(data + i*brickSize),
+                    &encodedBuffer[encodedBufferSize]));
+                encodedBufferSize += brickSizes[i];
+            }
+            encodedBuffer.resize(encodedBufferSize);
+            //store uncompressed, if compression does not pay off (uncompressed files are identified by their size)
+            compressed = (2*sizeof(uint32_t) + numBrickSlotsPerBuffer_*sizeof(uint32_t) + encodedBufferSize < singleBufferSizeBytes_);
+            if (!compressed)
+                std::fill(brickSizes.begin(), brickSizes.end(), static_cast<uint32_t>(brickSize));
+        }
+
         std::ofstream outfile(bufferFile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
         if(outfile.fail()) {
             tgtAssert(false,"Could not open buffer file!");
             LERROR("Could not open buffer file!");
             return ;
         }
-        outfile.write(bufferVector_[bufferID]->data_,singleBufferSizeBytes_);
+        if (compressed) {
+            uint32_t header[2] = { COMPRESSED_BUFFER_MAGIC, static_cast<uint32_t>(numBrickSlotsPerBuffer_) };
+            outfile.write(reinterpret_cast<const char*>(header), sizeof(header));
+            outfile.write(reinterpret_cast<const char*>(&brickSizes[0]), numBrickSlotsPerBuffer_*sizeof(uint32_t));
+            outfile.write(&encodedBuffer[0], encodedBuffer.size());
+        }
+        else {
+            outfile.write(data,singleBufferSizeBytes_);
+        }
         tgtAssert(!outfile.bad(), "writing brick to disk went wrong");
         outfile.close();
         bufferVector_[bufferID]->mustBeSavedToDisk_ = false;
+
+        //remember encoded brick sizes
+        if (compressedBrickSizes_.size() < (bufferID+1)*numBrickSlotsPerBuffer_)
+            compressedBrickSizes_.resize((bufferID+1)*numBrickSlotsPerBuffer_, 0);
+        std::copy(brickSizes.begin(), brickSizes.end(), compressedBrickSizes_.begin() + bufferID*numBrickSlotsPerBuffer_);
     }
 }
 
 void OctreeBrickPoolManagerDisk::flushPoolToDisk(ProgressReporter* progressReporter /*= 0*/) {
+    boost::unique_lock<boost::mutex> lock(mutex_);
+
     // determine number of buffers to be saved to disk
     size_t numToBeSavedToDisk = 0;
-    for (int i = 0; i < bufferVector_.size(); i++) {
+    for (size_t i = 0; i < bufferVector_.size(); i++) {
+        boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(i));
         if (bufferVector_[i]->mustBeSavedToDisk_)
             numToBeSavedToDisk++;
     }
 
     // save buffers to disk
     size_t numSavedToDisk = 0;
-    for (int i = 0; i < bufferVector_.size(); i++) {
+    for (size_t i = 0; i < bufferVector_.size(); i++) {
+        boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(i));
         if (bufferVector_[i]->mustBeSavedToDisk_) {
             tgtAssert(bufferVector_[i]->isInRAM_,"buffer not in ram!");
             saveBufferToDisk(i);
+            stripeLock.unlock();
             numSavedToDisk++;
             if (progressReporter)
                 progressReporter->setProgress((float)(numSavedToDisk) / (float)numToBeSavedToDisk);
@@ -593,6 +907,145 @@ void OctreeBrickPoolManagerDisk::flushPoolToDisk(ProgressReporter* progressRepor
     }
 }
 
+//-----------------------------------------------------------------------------------------------------------------------
+//      PREFETCHING
+//-----------------------------------------------------------------------------------------------------------------------
+void OctreeBrickPoolManagerDisk::prefetchBricks(const std::vector<uint64_t>& virtualMemoryAddresses) const {
+    if (numPrefetchThreads_ == 0 || virtualMemoryAddresses.empty())
+        return;
+
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    startPrefetchThreads();
+
+    //prefetching more buffers than fit into the RAM would evict the buffers just loaded
+    const size_t maxQueueSize = (maxNumBuffersInRAM_ > 1 ? maxNumBuffersInRAM_ - 1 : 1);
+
+    for (size_t i = 0; i < virtualMemoryAddresses.size(); i++) {
+        if (virtualMemoryAddresses[i] == std::numeric_limits<uint64_t>::max())
+            continue;
+        size_t bufferID = static_cast<size_t>(virtualMemoryAddresses[i]) / singleBufferSizeBytes_;
+        if (bufferID >= bufferVector_.size())
+            continue;
+        prefetchStatistics_.numRequested_++;
+
+        BufferEntry* entry = bufferVector_[bufferID];
+        if (entry->isQueuedForPrefetch_)
+            continue;
+        {
+            boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+            if (entry->isInRAM_ || entry->isLoading_)
+                continue;
+        }
+        if (prefetchQueue_.size() >= maxQueueSize)
+            break;
+        entry->isQueuedForPrefetch_ = true;
+        prefetchQueue_.push_back(bufferID);
+    }
+    prefetchCond_.notify_all();
+}
+
+void OctreeBrickPoolManagerDisk::prefetchThreadMain() const {
+    // note: no logging in here, since the logger is not thread-safe
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    while (true) {
+        while (prefetchQueue_.empty() && !stopPrefetching_)
+            prefetchCond_.wait(lock);
+        if (stopPrefetching_)
+            return;
+
+        size_t bufferID = prefetchQueue_.front();
+        prefetchQueue_.pop_front();
+        BufferEntry* entry = bufferVector_[bufferID];
+        entry->isQueuedForPrefetch_ = false;
+        {
+            boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+            if (entry->isInRAM_ || entry->isLoading_)
+                continue;
+        }
+
+        //make room without blocking: a prefetch must never stall a brick access,
+        //nor evict another prefetched buffer that has not been accessed yet
+        if (numBuffersInRAM_ >= maxNumBuffersInRAM_ && !evictBuffer(true))
+            continue;
+        numBuffersInRAM_++;
+        {
+            boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+            entry->isLoading_ = true;
+        }
+        const std::string bufferFile = bufferFiles_.at(bufferID);
+
+        lock.unlock();
+        char* buffer = readBufferFile(bufferFile);
+        lock.lock();
+
+        if (!buffer) {
+            numBuffersInRAM_--;
+            {
+                boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+                entry->isLoading_ = false;
+            }
+            cond_.notify_all();
+            continue;
+        }
+
+        cachePolicy_->insert(bufferID);
+        {
+            boost::unique_lock<boost::mutex> stripeLock(getStripeMutex(bufferID));
+            entry->data_ = buffer;
+            entry->isInRAM_ = true;
+            entry->isLoading_ = false;
+            entry->isPrefetched_ = true;
+            entry->referenced_ = false;
+            entry->inUse_ = 0;
+            entry->mustBeSavedToDisk_ = false;
+        }
+        prefetchStatistics_.numLoaded_++;
+        cond_.notify_all();
+    }
+}
+
+void OctreeBrickPoolManagerDisk::startPrefetchThreads() const {
+    if (!prefetchThreads_.empty())
+        return;
+    stopPrefetching_ = false;
+    for (size_t i = 0; i < numPrefetchThreads_; i++)
+        prefetchThreads_.push_back(new boost::thread(boost::bind(&OctreeBrickPoolManagerDisk::prefetchThreadMain, this)));
+}
+
+void OctreeBrickPoolManagerDisk::stopPrefetchThreads() {
+    {
+        boost::unique_lock<boost::mutex> lock(mutex_);
+        stopPrefetching_ = true;
+        for (size_t i = 0; i < prefetchQueue_.size(); i++)
+            bufferVector_[prefetchQueue_[i]]->isQueuedForPrefetch_ = false;
+        prefetchQueue_.clear();
+        prefetchCond_.notify_all();
+    }
+    for (size_t i = 0; i < prefetchThreads_.size(); i++) {
+        prefetchThreads_[i]->join();
+        delete prefetchThreads_[i];
+    }
+    prefetchThreads_.clear();
+}
+
+void OctreeBrickPoolManagerDisk::setNumPrefetchThreads(size_t numThreads) {
+    stopPrefetchThreads();
+    numPrefetchThreads_ = numThreads;
+}
+
+OctreeBrickPoolManagerBase::PrefetchStatistics OctreeBrickPoolManagerDisk::getPrefetchStatistics() const {
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    PrefetchStatistics stats = prefetchStatistics_;
+    stats.numHits_ = static_cast<uint64_t>(numPrefetchHits_) - numPrefetchHitsAtReset_;
+    return stats;
+}
+
+void OctreeBrickPoolManagerDisk::resetPrefetchStatistics() {
+    boost::unique_lock<boost::mutex> lock(mutex_);
+    prefetchStatistics_ = PrefetchStatistics();
+    numPrefetchHitsAtReset_ = static_cast<uint64_t>(numPrefetchHits_);
+}
+
 //-----------------------------------------------------------------------------------------------------------------------
 //      GENERAL FUNCTIONS
 //-----------------------------------------------------------------------------------------------------------------------
@@ -602,8 +1055,17 @@ uint64_t OctreeBrickPoolManagerDisk::getBrickPoolMemoryUsed() const {
 }
 
 std::string OctreeBrickPoolManagerDisk::getDescription() const {
-    // TODO
-    return "not available";
+    PrefetchStatistics stats = getPrefetchStatistics();
+    std::string desc;
+    desc += "Single Buffer Size: " + formatMemorySize(singleBufferSizeBytes_) + ", ";
+    desc += "Num Buffers: " + itos(bufferFiles_.size()) + ", ";
+    desc += "RAM Limit: " + formatMemorySize(ramLimitInBytes_) + ", ";
+    desc += "Cache Policy: " + getCachePolicy() + ", ";
+    desc += "Brick Compression: " + std::string(getBrickCompression() ? "on" : "off") + ", ";
+    desc += "Prefetch Threads: " + itos(numPrefetchThreads_) + ", ";
+    desc += "Prefetch Hit Rate: " + ftos(stats.getHitRate()) + " (" + itos(stats.numHits_) + " hits, " +
+        itos(stats.numMisses_) + " misses, " + itos(stats.numWasted_) + " wasted)";
+    return desc;
 }
 
 uint64_t OctreeBrickPoolManagerDisk::getBrickPoolMemoryAllocated() const {
@@ -0,0 +1,472 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "voreen/core/datastructures/octree/octreebrickpoolmanagermmap.h"
+
+#include "voreen/core/datastructures/octree/octreeutils.h"
+
+#include "voreen/core/utils/stringutils.h"
+#include "voreen/core/utils/tracing.h"
+#include "voreen/core/io/serialization/serialization.h"
+#include "voreen/core/io/progressreporter.h"
+
+#include <limits>
+#include <boost/thread/locks.hpp>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+#include "tgt/assert.h"
+#include "tgt/logmanager.h"
+#include "tgt/tgt_math.h"
+#include "tgt/filesystem.h"
+
+namespace voreen {
+
+const std::string OctreeBrickPoolManagerMmap::loggerCat_("voreen.OctreeBrickPoolManagerMmap");
+
+const size_t OctreeBrickPoolManagerMmap::MAX_NUM_BUFFERS = 1<<16;
+
+OctreeBrickPoolManagerMmap::MappedBuffer::MappedBuffer(size_t numBrickSlots)
+    : data_(0)
+    , fileHandle_(0)
+    , mappingHandle_(0)
+    , fileDescriptor_(-1)
+    , dirtyBricks_(new AtomicValue<int>[numBrickSlots])
+{}
+
+OctreeBrickPoolManagerMmap::MappedBuffer::~MappedBuffer() {
+    delete[] dirtyBricks_;
+}
+
+OctreeBrickPoolManagerMmap::OctreeBrickPoolManagerMmap(size_t maxSingleBufferSize, const std::string& brickPoolPath,
+        const std::string& bufferFilePrefix)
+    : OctreeBrickPoolManagerBase()
+    , maxBufferSizeBytes_(maxSingleBufferSize)
+    , singleBufferSizeBytes_(0)
+    , numBrickSlotsPerBuffer_(0)
+    , pageSize_(4096)
+    , nextVirtualMemoryAddress_(0)
+    , buffers_(new MappedBuffer*[MAX_NUM_BUFFERS])
+    , numBuffers_(0)
+{
+    tgtAssert(maxSingleBufferSize > 0, "max buffer size must be greater zero");
+    brickPoolPath_ = (!brickPoolPath.empty() ? tgt::FileSystem::absolutePath(brickPoolPath) : "");
+    bufferFilePrefix_ = (!bufferFilePrefix.empty() ? bufferFilePrefix : "brickbuffer_");
+
+#ifdef WIN32
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    pageSize_ = static_cast<size_t>(systemInfo.dwPageSize);
+#else
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (pageSize > 0)
+        pageSize_ = static_cast<size_t>(pageSize);
+#endif
+}
+
+OctreeBrickPoolManagerMmap::~OctreeBrickPoolManagerMmap() {
+    if (isInitialized())
+        deinitialize();
+    else
+        clearBuffers();
+    delete[] buffers_;
+}
+
+OctreeBrickPoolManagerMmap* OctreeBrickPoolManagerMmap::create() const {
+    return new OctreeBrickPoolManagerMmap(64<<20, "");
+}
+
+//-----------------------------------------------------------------------------------------------------------------------
+//      DE-/INITIALIZE
+//-----------------------------------------------------------------------------------------------------------------------
+void OctreeBrickPoolManagerMmap::initialize(size_t brickMemorySizeInByte) throw (VoreenException) {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    OctreeBrickPoolManagerBase::initialize(brickMemorySizeInByte);
+
+    if (maxBufferSizeBytes_ < getBrickMemorySizeInByte())
+        throw VoreenException("Max brick buffer size is smaller than the memory size of a single brick "
+            "[" + itos(maxBufferSizeBytes_) + " bytes < " + itos(getBrickMemorySizeInByte()) + " bytes]");
+
+    // round max buffer size down to next multiple of brick memory size
+    singleBufferSizeBytes_ = maxBufferSizeBytes_;
+    if (!isMultipleOf(singleBufferSizeBytes_, getBrickMemorySizeInByte()))
+        singleBufferSizeBytes_ = tgt::ifloor((float)maxBufferSizeBytes_ / (float)getBrickMemorySizeInByte()) * getBrickMemorySizeInByte();
+    numBrickSlotsPerBuffer_ = singleBufferSizeBytes_ / getBrickMemorySizeInByte();
+
+    if (!tgt::FileSystem::dirExists(brickPoolPath_))
+        throw VoreenException("Brick pool path does not exist: " + brickPoolPath_);
+}
+
+void OctreeBrickPoolManagerMmap::deinitialize() throw (VoreenException) {
+    flushPoolToDisk();
+
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    clearBuffers();
+    bufferFiles_.clear();
+    deletedBricks_.clear();
+    nextVirtualMemoryAddress_ = 0;
+
+    OctreeBrickPoolManagerBase::deinitialize();
+}
+
+void OctreeBrickPoolManagerMmap::clearBuffers() {
+    size_t numBuffers = numBuffers_.load();
+    numBuffers_.store(0);
+    for (size_t i = 0; i < numBuffers; i++) {
+        unmapBufferFile(buffers_[i]);
+        delete buffers_[i];
+        buffers_[i] = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------------
+//      DE-/SERIALIZATION
+//-----------------------------------------------------------------------------------------------------------------------
+void OctreeBrickPoolManagerMmap::serialize(XmlSerializer& s) const {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    OctreeBrickPoolManagerBase::serialize(s);
+
+    s.serialize("maxSingleBufferSizeBytes", maxBufferSizeBytes_);
+    s.serialize("singleBufferSizeBytes",    singleBufferSizeBytes_);
+    s.serialize("numBrickSlotsPerBuffer",   numBrickSlotsPerBuffer_);
+
+    s.serialize("bufferFiles", bufferFiles_);
+    s.serialize("brickPoolPath", brickPoolPath_);
+    s.serialize("bufferFilePrefix", bufferFilePrefix_);
+
+    s.serialize("nextVirtualMemoryAddress", nextVirtualMemoryAddress_);
+    s.serialize("deletedBricks", deletedBricks_);
+}
+
+void OctreeBrickPoolManagerMmap::deserialize(XmlDeserializer& s) {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    OctreeBrickPoolManagerBase::deserialize(s);
+
+    s.deserialize("maxSingleBufferSizeBytes", maxBufferSizeBytes_);
+    s.deserialize("singleBufferSizeBytes",    singleBufferSizeBytes_);
+    s.deserialize("numBrickSlotsPerBuffer",   numBrickSlotsPerBuffer_);
+
+    s.deserialize("bufferFiles", bufferFiles_);
+    s.deserialize("brickPoolPath", brickPoolPath_);
+    s.deserialize("bufferFilePrefix", bufferFilePrefix_);
+
+    s.deserialize("nextVirtualMemoryAddress", nextVirtualMemoryAddress_);
+    try {
+        s.deserialize("deletedBricks", deletedBricks_);
+    }
+    catch (XmlSerializationNoSuchDataException&) {
+        s.removeLastError();
+    }
+
+    // check brick pool path
+    if (!tgt::FileSystem::dirExists(brickPoolPath_))
+        throw VoreenException("Brick pool path does not exist: " + brickPoolPath_);
+
+    // make sure that buffer files are present
+    if (bufferFiles_.empty())
+        throw VoreenException("No brick buffer files");
+    if (bufferFiles_.size() > MAX_NUM_BUFFERS)
+        throw VoreenException("Too many brick buffer files: " + itos(bufferFiles_.size()));
+    for (size_t i=0; i<bufferFiles_.size(); i++) {
+        if (!tgt::FileSystem::fileExists(bufferFiles_.at(i)))
+            throw VoreenException("Missing brick buffer file: " + bufferFiles_.at(i));
+    }
+
+    // map buffer files
+    clearBuffers();
+    for (size_t i = 0; i < bufferFiles_.size(); i++) {
+        buffers_[i] = mapBufferFile(bufferFiles_.at(i));
+        numBuffers_.store(i+1);
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------------
+//      BRICK INTERACTION
+//-----------------------------------------------------------------------------------------------------------------------
+uint64_t OctreeBrickPoolManagerMmap::allocateBrick() throw (VoreenException) {
+    tgtAssert(isInitialized(), "not initialized");
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    // re-use deleted bricks first
+    if (!deletedBricks_.empty()) {
+        uint64_t returnValue = deletedBricks_.back();
+        deletedBricks_.pop_back();
+        return returnValue;
+    }
+
+    // current buffer is full => map a new buffer file
+    if (nextVirtualMemoryAddress_ % singleBufferSizeBytes_ == 0) {
+        size_t numBuffers = numBuffers_.load();
+        if (numBuffers >= MAX_NUM_BUFFERS)
+            throw VoreenException("Maximum number of brick buffers reached: " + itos(MAX_NUM_BUFFERS));
+
+        std::stringstream path;
+        path << brickPoolPath_ << "/" << bufferFilePrefix_ << itos(bufferFiles_.size(), 10);
+        MappedBuffer* buffer = mapBufferFile(path.str());
+
+        bufferFiles_.push_back(path.str());
+        // the slot is written before the count is published, so lock-free readers never see an unset entry
+        buffers_[numBuffers] = buffer;
+        numBuffers_.store(numBuffers + 1);
+    }
+
+    uint64_t returnValue = nextVirtualMemoryAddress_;
+    nextVirtualMemoryAddress_ += static_cast<uint64_t>(getBrickMemorySizeInByte());
+    return returnValue;
+}
+
+void OctreeBrickPoolManagerMmap::deleteBrick(uint64_t virtualMemoryAddress) {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+    deletedBricks_.push_back(virtualMemoryAddress);
+}
+
+const uint16_t* OctreeBrickPoolManagerMmap::getBrick(uint64_t virtualMemoryAddress, bool /*blocking*/) const
+    throw (VoreenException)
+{
+    //constraint SIZE_MAX equals no brick
+    if (virtualMemoryAddress == std::numeric_limits<uint64_t>::max())
+        return 0;
+
+    size_t bufferID = static_cast<size_t>(virtualMemoryAddress / singleBufferSizeBytes_);
+    size_t bufferOffset = static_cast<size_t>(virtualMemoryAddress % singleBufferSizeBytes_);
+
+    if (bufferID >= numBuffers_.load())
+        return 0;
+
+    return reinterpret_cast<const uint16_t*>(buffers_[bufferID]->data_ + bufferOffset);
+}
+
+uint16_t* OctreeBrickPoolManagerMmap::getWritableBrick(uint64_t virtualMemoryAddress, bool /*blocking*/) const
+    throw (VoreenException)
+{
+    //constraint SIZE_MAX equals no brick
+    if (virtualMemoryAddress == std::numeric_limits<uint64_t>::max())
+        return 0;
+
+    size_t bufferID = static_cast<size_t>(virtualMemoryAddress / singleBufferSizeBytes_);
+    size_t bufferOffset = static_cast<size_t>(virtualMemoryAddress % singleBufferSizeBytes_);
+
+    if (bufferID >= numBuffers_.load())
+        return 0;
+
+    MappedBuffer* buffer = buffers_[bufferID];
+    buffer->dirtyBricks_[bufferOffset / getBrickMemorySizeInByte()].store(1);
+    return reinterpret_cast<uint16_t*>(buffer->data_ + bufferOffset);
+}
+
+void OctreeBrickPoolManagerMmap::releaseBrick(uint64_t /*virtualMemoryAddress*/, AccessMode /*mode*/) const {
+    // nothing to do: pages are evicted by the operating system and dirty bricks are written back by flushPoolToDisk()
+}
+
+bool OctreeBrickPoolManagerMmap::isBrickInRAM(uint64_t /*virtualMemoryAddress*/) const {
+    return true;
+}
+
+void OctreeBrickPoolManagerMmap::flushPoolToDisk(ProgressReporter* progressReporter /*= 0*/) {
+    boost::lock_guard<boost::mutex> lock(mutex_);
+
+    size_t numBuffers = numBuffers_.load();
+    for (size_t i = 0; i < numBuffers; i++) {
+        flushBuffer(buffers_[i]);
+        if (progressReporter)
+            progressReporter->setProgress((float)(i+1) / (float)numBuffers);
+    }
+}
+
+//-----------------------------------------------------------------------------------------------------------------------
+//      DISK INTERACTION
+//-----------------------------------------------------------------------------------------------------------------------
+OctreeBrickPoolManagerMmap::MappedBuffer* OctreeBrickPoolManagerMmap::mapBufferFile(const std::string& bufferFile) const
+    throw (VoreenException)
+{
+    tgtAssert(!bufferFile.empty(), "buffer file path is empty");
+    tgtAssert(singleBufferSizeBytes_ > 0, "buffer size not set");
+    TraceSpan span("io", "OctreeBrickPoolManagerMmap.mapBufferFile");
+
+    MappedBuffer* buffer = new MappedBuffer(numBrickSlotsPerBuffer_);
+
+#ifdef WIN32
+    HANDLE fileHandle = CreateFileA(bufferFile.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, 0,
+        OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, 0);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        delete buffer;
+        throw VoreenException("Could not open buffer file: " + bufferFile);
+    }
+
+    // the file mapping extends the file to the buffer size, if necessary
+    uint64_t mappingSize = static_cast<uint64_t>(singleBufferSizeBytes_);
+    HANDLE mappingHandle = CreateFileMappingA(fileHandle, 0, PAGE_READWRITE,
+        static_cast<DWORD>(mappingSize >> 32), static_cast<DWORD>(mappingSize & 0xFFFFFFFF), 0);
+    if (!mappingHandle) {
+        CloseHandle(fileHandle);
+        delete buffer;
+        throw VoreenException("Could not create file mapping for buffer file: " + bufferFile);
+    }
+
+    void* data = MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, singleBufferSizeBytes_);
+    if (!data) {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        delete buffer;
+        throw VoreenException("Could not map buffer file: " + bufferFile);
+    }
+
+    buffer->fileHandle_ = fileHandle;
+    buffer->mappingHandle_ = mappingHandle;
+    buffer->data_ = static_cast<char*>(data);
+#else
+    int fd = open(bufferFile.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (fd < 0) {
+        delete buffer;
+        throw VoreenException("Could not open buffer file: " + bufferFile + " (" + std::string(strerror(errno)) + ")");
+    }
+
+    // extend new files to the buffer size (creates a sparse file on most file systems)
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || static_cast<uint64_t>(fileStat.st_size) < static_cast<uint64_t>(singleBufferSizeBytes_)) {
+        if (ftruncate(fd, static_cast<off_t>(singleBufferSizeBytes_)) != 0) {
+            close(fd);
+            delete buffer;
+            throw VoreenException("Could not resize buffer file: " + bufferFile + " (" + std::string(strerror(errno)) + ")");
+        }
+    }
+
+    void* data = mmap(0, singleBufferSizeBytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        close(fd);
+        delete buffer;
+        throw VoreenException("Could not map buffer file: " + bufferFile + " (" + std::string(strerror(errno)) + ")");
+    }
+
+    buffer->fileDescriptor_ = fd;
+    buffer->data_ = static_cast<char*>(data);
+#endif
+
+    return buffer;
+}
+
+void OctreeBrickPoolManagerMmap::unmapBufferFile(MappedBuffer* buffer) const {
+    tgtAssert(buffer, "null pointer passed");
+    if (!buffer->data_)
+        return;
+
+#ifdef WIN32
+    UnmapViewOfFile(buffer->data_);
+    CloseHandle(static_cast<HANDLE>(buffer->mappingHandle_));
+    CloseHandle(static_cast<HANDLE>(buffer->fileHandle_));
+    buffer->mappingHandle_ = 0;
+    buffer->fileHandle_ = 0;
+#else
+    if (munmap(buffer->data_, singleBufferSizeBytes_) != 0)
+        LWARNING("Failed to unmap brick buffer: " << strerror(errno));
+    close(buffer->fileDescriptor_);
+    buffer->fileDescriptor_ = -1;
+#endif
+    buffer->data_ = 0;
+}
+
+void OctreeBrickPoolManagerMmap::flushBuffer(MappedBuffer* buffer) const {
+    tgtAssert(buffer && buffer->data_, "buffer not mapped");
+    TraceSpan span("io", "OctreeBrickPoolManagerMmap.flushBuffer");
+
+    const size_t brickSize = getBrickMemorySizeInByte();
+#ifdef WIN32
+    bool flushed = false;
+#endif
+
+    // coalesce consecutive dirty bricks and write back the page range covering them.
+    // Flags are cleared before writing back, so a brick dirtied concurrently is flushed again next time.
+    size_t slot = 0;
+    while (slot < numBrickSlotsPerBuffer_) {
+        if (!buffer->dirtyBricks_[slot].exchange(0)) {
+            slot++;
+            continue;
+        }
+        size_t firstSlot = slot;
+        slot++;
+        while (slot < numBrickSlotsPerBuffer_ && buffer->dirtyBricks_[slot].exchange(0))
+            slot++;
+
+        size_t begin = (firstSlot * brickSize / pageSize_) * pageSize_;
+        size_t end = std::min(slot * brickSize, singleBufferSizeBytes_);
+#ifdef WIN32
+        if (!FlushViewOfFile(buffer->data_ + begin, end - begin))
+            LWARNING("Failed to flush brick buffer pages");
+        flushed = true;
+#else
+        if (msync(buffer->data_ + begin, end - begin, MS_SYNC) != 0)
+            LWARNING("Failed to flush brick buffer pages: " << strerror(errno));
+#endif
+    }
+
+#ifdef WIN32
+    // FlushViewOfFile does not flush file metadata
+    if (flushed)
+        FlushFileBuffers(static_cast<HANDLE>(buffer->fileHandle_));
+#endif
+}
+
+//-----------------------------------------------------------------------------------------------------------------------
+//      GENERAL FUNCTIONS
+//-----------------------------------------------------------------------------------------------------------------------
+size_t OctreeBrickPoolManagerMmap::getBrickBufferSizeInBytes() const {
+    return singleBufferSizeBytes_;
+}
+
+size_t OctreeBrickPoolManagerMmap::getNumBrickBuffers() const {
+    return numBuffers_.load();
+}
+
+uint64_t OctreeBrickPoolManagerMmap::getBrickPoolMemoryAllocated() const {
+    return static_cast<uint64_t>(getNumBrickBuffers()) * static_cast<uint64_t>(singleBufferSizeBytes_);
+}
+
+uint64_t OctreeBrickPoolManagerMmap::getBrickPoolMemoryUsed() const {
+    return nextVirtualMemoryAddress_;
+}
+
+std::string OctreeBrickPoolManagerMmap::getDescription() const {
+    std::string desc;
+    desc += "Single Buffer Size: " + formatMemorySize(singleBufferSizeBytes_) + ", ";
+    desc += "Num Buffers Mapped: " + itos(getNumBrickBuffers()) + ", ";
+    desc += "Memory Mapped: " + formatMemorySize(getBrickPoolMemoryAllocated());
+    return desc;
+}
+
+} // namespace
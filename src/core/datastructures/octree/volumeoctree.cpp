@@ -42,6 +42,9 @@
 #include <sstream>
 #include <queue>
 
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
 #ifdef VRN_MODULE_OPENMP
 #include "omp.h"
 #endif
@@ -97,6 +100,104 @@ namespace {
         size_t numNodes_;
     };
 
+    /**
+     * Helper class that loads a slab (range of z slices) of all channel volumes in a background thread,
+     * so that the next slab can be read while the bricks of the current one are extracted.
+     * Only used during iterative construction.
+     *
+     * @note No logging in the loader thread, since the logger is not thread-safe.
+     */
+    class SlabLoader {
+    public:
+        SlabLoader(const std::vector<const voreen::VolumeRAM*>& ramVolumes, const std::vector<const voreen::VolumeDisk*>& diskVolumes)
+            : ramVolumes_(ramVolumes)
+            , diskVolumes_(diskVolumes)
+            , startSlice_(0)
+            , endSlice_(0)
+            , running_(false)
+        {
+            tgtAssert(ramVolumes_.empty() != diskVolumes_.empty(), "either RAM or disk volumes expected");
+        }
+        ~SlabLoader() {
+            if (running_)
+                thread_.join();
+            deleteSlab();
+        }
+
+        /// Starts loading the slices [startSlice;endSlice] in the background.
+        void start(size_t startSlice, size_t endSlice) {
+            tgtAssert(!running_, "loader already running");
+            tgtAssert(slab_.empty(), "previous slab not fetched");
+            startSlice_ = startSlice;
+            endSlice_ = endSlice;
+            error_.clear();
+            running_ = true;
+            thread_ = boost::thread(boost::bind(&SlabLoader::load, this));
+        }
+
+        /**
+         * Waits for the running load to finish and passes the ownership of the channel slab volumes to the caller.
+         * @throw VoreenException if a slab could not be loaded
+         */
+        std::vector<voreen::VolumeRAM*> finish() throw (voreen::VoreenException) {
+            tgtAssert(running_, "loader not running");
+            thread_.join();
+            running_ = false;
+            if (!error_.empty()) {
+                deleteSlab();
+                throw voreen::VoreenException(error_);
+            }
+            std::vector<voreen::VolumeRAM*> slab;
+            slab.swap(slab_);
+            return slab;
+        }
+
+    private:
+        void load() {
+            const size_t numChannels = std::max(ramVolumes_.size(), diskVolumes_.size());
+            for (size_t ch=0; ch<numChannels; ch++) {
+                voreen::VolumeRAM* slabVolume = 0;
+                try {
+                    if (!ramVolumes_.empty()) { // extract current slice range from RAM volume
+                        tgt::svec3 slabLLF(0, 0, startSlice_);
+                        tgt::svec3 slabDim(ramVolumes_[ch]->getDimensions().x, ramVolumes_[ch]->getDimensions().y, endSlice_-startSlice_+1);
+                        slabVolume = ramVolumes_[ch]->getSubVolume(slabLLF, slabDim);
+                    }
+                    else { // load current slice range from disk
+                        slabVolume = diskVolumes_[ch]->loadSlices(startSlice_, endSlice_);
+                    }
+                }
+                catch (std::exception& e) {
+                    error_ = "Failed to extract slices [" + voreen::itos(startSlice_) + "," + voreen::itos(endSlice_) + "] for channel " +
+                        voreen::itos(ch) + ": " + e.what();
+                    return;
+                }
+                if (!slabVolume) {
+                    error_ = "Failed to extract slices [" + voreen::itos(startSlice_) + "," + voreen::itos(endSlice_) + "] from input " +
+                        (!ramVolumes_.empty() ? "RAM" : "disk") + " volume for channel " + voreen::itos(ch);
+                    return;
+                }
+                slab_.push_back(slabVolume);
+            }
+        }
+
+        void deleteSlab() {
+            for (size_t i=0; i<slab_.size(); i++)
+                delete slab_[i];
+            slab_.clear();
+        }
+
+        std::vector<const voreen::VolumeRAM*> ramVolumes_;
+        std::vector<const voreen::VolumeDisk*> diskVolumes_;
+        size_t startSlice_;
+        size_t endSlice_;
+
+        boost::thread thread_;
+        bool running_;
+        std::vector<voreen::VolumeRAM*> slab_;  ///< loaded slab volumes (one per channel)
+        std::string error_;                     ///< error message of the last load, empty on success
+    };
+
     // voxel value conversion templates
     template<class T>
     inline uint16_t convertVoxelValueToUInt16(T value) {
@@ -176,6 +277,7 @@ VolumeOctree::VolumeOctree(const std::vector<const VolumeBase*>& channelVolumes,
         if (progessReporter)
             progessReporter->setProgressRange(tgt::vec2(progessReporter->getProgress(), 1.f));
         brickPoolManager_->flushPoolToDisk(progessReporter);
+        assignCompressedBrickSizes(rootNode_);
     }
     catch (std::exception& e) {
         //if (brickPoolManager_)
@@ -221,6 +323,7 @@ VolumeOctree::VolumeOctree(const VolumeBase* volume, size_t brickDim, float homo
         if (progessReporter)
             progessReporter->setProgressRange(tgt::vec2(progessReporter->getProgress(), 1.f));
         brickPoolManager_->flushPoolToDisk(progessReporter);
+        assignCompressedBrickSizes(rootNode_);
     }
     catch (std::exception& e) {
         //if (brickPoolManager_)
@@ -576,16 +679,58 @@ void VolumeOctree::buildOctreeIteratively(const std::vector<const VolumeBase*>&
     }
 
     //
-    // 1. Create nodes at level 0 (full resolution bricks) from input volumes
+    // The tree is built plate by plate (one plate = one z-layer of level 0 nodes):
+    //  - the slab of the next plate is loaded in the background, while the bricks of the current one are extracted
+    //  - each node is created by exactly one thread and written to its own grid cell, i.e., no synchronization is needed
+    //  - as soon as two plates of a level are complete, the parent plate is built (instead of building level by level)
+    // The resulting nodes and bricks are independent of the construction order.
     //
-    LDEBUG("- Creating level 0 nodes");
     tgt::svec3 numNodesPerDim = getOctreeDim() / getBrickDim();
-    NodeGrid3D* level0Grid = new NodeGrid3D(numNodesPerDim);
+    tgtAssert(isCubicAndPot(numNodesPerDim), "level 0 grid dim is not cubic power-of-two");
+
+    // create node grids for all levels except the root: level 0 down to grid dimensions [2 2 2]
+    // the grids own the nodes that have not been attached to a parent yet (only non-empty on error)
+    struct LevelGrids {
+        std::vector<NodeGrid3D*> grids;
+        const VolumeOctree* octree;
+        ~LevelGrids() {
+            for (size_t i=0; i<grids.size(); i++) {
+                const size_t numNodes = tgt::hmul(grids[i]->getDim());
+                for (size_t n=0; n<numNodes; n++)
+                    octree->deleteSubTree(grids[i]->getNodes()[n]);
+                delete grids[i];
+            }
+        }
+    };
+    LevelGrids levelGrids;
+    levelGrids.octree = this;
+    levelGrids.grids.push_back(new NodeGrid3D(numNodesPerDim));
+    while (levelGrids.grids.back()->getDim().x > 2)
+        levelGrids.grids.push_back(new NodeGrid3D(levelGrids.grids.back()->getDim() / tgt::svec3::two));
+    NodeGrid3D* level0Grid = levelGrids.grids.front();
+
+    // slab loader for the input volumes
+    std::vector<const VolumeRAM*> ramVolumes;
+    std::vector<const VolumeDisk*> diskVolumes;
+    for (size_t ch=0; ch<getNumChannels(); ch++) {
+        if (ramMode)
+            ramVolumes.push_back(volumes.at(ch)->getRepresentation<VolumeRAM>());
+        else
+            diskVolumes.push_back(volumes.at(ch)->getRepresentation<VolumeDisk>());
+    }
+    SlabLoader slabLoader(ramVolumes, diskVolumes);
+
+    // number of plates intersecting the volume
+    const size_t numVolumePlates = std::min<size_t>(numNodesPerDim.z, (getVolumeDim().z + getBrickDim().z - 1) / getBrickDim().z);
+    tgtAssert(numVolumePlates > 0, "no plate intersecting the volume");
+    slabLoader.start(0, std::min(getBrickDim().z, getVolumeDim().z) - 1);
+
     for (size_t nodeIndexZ = 0; nodeIndexZ < numNodesPerDim.z; nodeIndexZ++) {
-        size_t startSlice = nodeIndexZ*getBrickDim().z;
 
-        // if nodes completely outside volume (first z slice index >= volumeDim.z) => create empty dummy nodes
-        if (startSlice >= getVolumeDim().z) {
+        //
+        // 1. Create level 0 nodes (full resolution bricks) of the current plate from the input volumes
+        //
+        if (nodeIndexZ >= numVolumePlates) { // nodes completely outside volume (first z slice index >= volumeDim.z) => create empty dummy nodes
             tgt::svec3 nodeIndex(0, 0, nodeIndexZ);
             for (nodeIndex.y = 0; nodeIndex.y < numNodesPerDim.y; nodeIndex.y++) {
                 for (nodeIndex.x = 0; nodeIndex.x < numNodesPerDim.x; nodeIndex.x++) {
@@ -593,240 +738,160 @@ void VolumeOctree::buildOctreeIteratively(const std::vector<const VolumeBase*>&
                     level0Grid->setNode(VolumeOctreeBase::createNode(getNumChannels()), nodeIndex);
                 }
             }
-
-            continue;
         }
-        size_t endSlice = std::min(startSlice + getBrickDim().z-1, getVolumeDim().z-1);
-
-        // load slices for current brick plate [startSlice;endSlice]
-        size_t sliceRangeMemSize = (endSlice-startSlice+1)*tgt::hmul(getVolumeDim().xy())*getBytesPerVoxel();
-        LDEBUG("-- Loading slice range [" << startSlice << "," << endSlice << "] (memory size: " << itos(getNumChannels()) << "x" << formatMemorySize(sliceRangeMemSize) << ")");
-        LDEBUG("--- Before: " << MemoryInfo::getProcessMemoryUsageAsString());
-        LDEBUG("--- Before: " << MemoryInfo::getAvailableMemoryAsString());
-
-        // RAII helper struct holding the temporary slice range volumes
-        struct SliceVolumes {
-            std::vector<const VolumeRAM*> channelVolumes;
-            std::vector<const void*> channelDataBuffers;
-            ~SliceVolumes() {
-                LDEBUG("-- Deleting loaded/extracted slices");
-                for (size_t i=0; i<channelVolumes.size(); i++)
-                    delete channelVolumes.at(i);
-
-                LDEBUG("--- After: " << MemoryInfo::getProcessMemoryUsageAsString());
-                LDEBUG("--- After: " << MemoryInfo::getAvailableMemoryAsString());
-            }
-        };
-        SliceVolumes sliceVolumes;
-
-        // create slice volumes
-        for (size_t ch=0; ch<getNumChannels(); ch++) {
-            VolumeRAM* sliceVolume = 0;
-            if (ramMode) { // extract current slice range from RAM volume
-                const VolumeRAM* channelVolume = volumes.at(ch)->getRepresentation<VolumeRAM>();
-                tgtAssert(channelVolume, "no ram representation"); //< checked above
-                tgt::svec3 slicePackageLLF(0, 0, startSlice);
-                tgt::svec3 slicePackageDim(channelVolume->getDimensions().x, channelVolume->getDimensions().y, endSlice-startSlice+1);
-                sliceVolume = channelVolume->getSubVolume(slicePackageLLF, slicePackageDim);
-                if (!sliceVolume)
-                    throw VoreenException("Failed to extract slices [" + itos(startSlice) + "," + itos(endSlice) + "] from input RAM volume for channel " + itos(ch));
+        else {
+            size_t startSlice = nodeIndexZ*getBrickDim().z;
+            size_t endSlice = std::min(startSlice + getBrickDim().z-1, getVolumeDim().z-1);
+
+            // RAII helper struct holding the temporary slab volumes
+            struct SlabVolumes {
+                std::vector<VolumeRAM*> channelVolumes;
+                std::vector<const void*> channelDataBuffers;
+                ~SlabVolumes() {
+                    for (size_t i=0; i<channelVolumes.size(); i++)
+                        delete channelVolumes.at(i);
+                }
+            };
+            SlabVolumes slabVolumes;
+
+            // wait for the slab of the current plate and start loading the next one
+            LDEBUG("-- Waiting for slice range [" << startSlice << "," << endSlice << "]");
+            slabVolumes.channelVolumes = slabLoader.finish();
+            for (size_t ch=0; ch<slabVolumes.channelVolumes.size(); ch++)
+                slabVolumes.channelDataBuffers.push_back(slabVolumes.channelVolumes.at(ch)->getData());
+            tgtAssert(slabVolumes.channelVolumes.size() == getNumChannels(), "invalid number of slab volumes");
+            if (nodeIndexZ+1 < numVolumePlates) {
+                size_t nextStartSlice = startSlice + getBrickDim().z;
+                slabLoader.start(nextStartSlice, std::min(nextStartSlice + getBrickDim().z-1, getVolumeDim().z-1));
             }
-            else { // load current slice range from disk
-                const VolumeDisk* channelDiskVolume = volumes.at(ch)->getRepresentation<VolumeDisk>();
-                tgtAssert(channelDiskVolume, "no disk representation"); //< checked above
-                sliceVolume = channelDiskVolume->loadSlices(startSlice, endSlice);
-                if (!sliceVolume)
-                    throw VoreenException("Failed to extract slices [" + itos(startSlice) + "," + itos(endSlice) + "] from input disk volume for channel " + itos(ch));
+            LDEBUG("--- " << MemoryInfo::getProcessMemoryUsageAsString());
+
+            // create nodes for current plate (multi-threaded, dynamically scheduled)
+            LDEBUG("-- Creating nodes for slice range [" << startSlice << "," << endSlice << "]");
+            const tgt::svec3 slabDim(getVolumeDim().x, getVolumeDim().y, endSlice-startSlice+1);
+            tgtAssert(slabDim == slabVolumes.channelVolumes.front()->getDimensions(), "invalid slab dim");
+            const int numPlateNodes = static_cast<int>(numNodesPerDim.x*numNodesPerDim.y);
+            std::string errorMessage;
+
+            #ifdef VRN_MODULE_OPENMP
+            #pragma omp parallel for schedule(dynamic) num_threads(static_cast<int>(numThreads))
+            #endif
+            for (int plateNodeID = 0; plateNodeID < numPlateNodes; plateNodeID++) {
+                #ifdef VRN_MODULE_OPENMP
+                const size_t threadID = static_cast<size_t>(omp_get_thread_num());
+                #else
+                const size_t threadID = 0;
+                #endif
+                tgtAssert(histogramBuffers.size() > threadID, "missing histogram buffer");
+                const tgt::svec3 nodeIndex(plateNodeID % numNodesPerDim.x, plateNodeID / numNodesPerDim.x, nodeIndexZ);
+                try {
+                    VolumeOctreeNode* node = createLevel0Node(nodeIndex, inputDataFormat, slabVolumes.channelDataBuffers, slabDim,
+                        octreeOptimization, homogeneityThreshold, histogramBuffers.at(threadID));
+                    tgtAssert(level0Grid->getNode(nodeIndex) == 0, "node already created");
+                    level0Grid->setNode(node, nodeIndex);
+                }
+                catch (std::exception& e) {
+                    #ifdef VRN_MODULE_OPENMP
+                    #pragma omp critical
+                    #endif
+                    errorMessage = e.what();
+                }
             }
-            tgtAssert(sliceVolume, "slice volume not created"); //< should have thrown exception
-            sliceVolumes.channelVolumes.push_back(sliceVolume);
-            sliceVolumes.channelDataBuffers.push_back(sliceVolume->getData());
+            if (!errorMessage.empty())
+                throw VoreenException(errorMessage);
         }
-        tgtAssert(sliceVolumes.channelVolumes.size() == getNumChannels() && sliceVolumes.channelDataBuffers.size() == getNumChannels(),
-            "invalid number of slice volumes");
-        LDEBUG("--- After: " << MemoryInfo::getProcessMemoryUsageAsString());
-        LDEBUG("--- After: " << MemoryInfo::getAvailableMemoryAsString());
-
-        // create nodes for current slice plate [startSlice;endSlice] (multi-threaded)
-        LDEBUG("-- Creating nodes for slice range [" << startSlice << "," << endSlice << "]");
-        LDEBUG("--- Before: " << MemoryInfo::getProcessMemoryUsageAsString());
-        LDEBUG("--- Before: " << MemoryInfo::getAvailableMemoryAsString());
-
-        #ifdef VRN_MODULE_OPENMP
-        #pragma omp parallel for
-        #endif
-        for (int threadID = 0; threadID < numThreads; threadID++) {
-            tgtAssert(histogramBuffers.size() > threadID, "missing histogram buffer");
-            uint16_t avgValues[MAX_CHANNELS], minValues[MAX_CHANNELS], maxValues[MAX_CHANNELS];
-
-            tgt::svec3 nodeIndex(0, 0, nodeIndexZ);
-            for (nodeIndex.y = threadID; nodeIndex.y < numNodesPerDim.y; nodeIndex.y += numThreads) {
-                for (nodeIndex.x = 0; nodeIndex.x < numNodesPerDim.x; nodeIndex.x++) {
-                    VolumeOctreeNode* node = 0;
-                    tgt::svec3 nodeLLF = nodeIndex*getBrickDim();
-                    tgt::svec3 nodeURB = nodeLLF + getBrickDim();
-                    if (tgt::hor(tgt::greaterThanEqual(nodeLLF, getVolumeDim()))) { // outside volume in x or y direction => create empty node
-                        node = VolumeOctreeBase::createNode(getNumChannels());
-                    }
-                    else { // create node from slice volume data buffer(s)
-                        nodeLLF.z = 0;
-                        nodeURB.z = getBrickDim().z;
-                        tgt::svec3 textureDim(getVolumeDim().x, getVolumeDim().y, endSlice-startSlice+1);
-                        tgtAssert(textureDim == sliceVolumes.channelVolumes.front()->getDimensions(), "invalid texture dim");
-                        if (inputDataFormat == "uint8")
-                            node = createTreeNodeFromTexture<uint8_t>(nodeLLF, nodeURB,
-                                sliceVolumes.channelDataBuffers, textureDim,
-                                octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histogramBuffers.at(threadID));
-                        else if (inputDataFormat == "int8")
-                            node = createTreeNodeFromTexture<int8_t>(nodeLLF, nodeURB,
-                                sliceVolumes.channelDataBuffers, textureDim,
-                                octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histogramBuffers.at(threadID));
-                        else if (inputDataFormat == "uint16")
-                            node = createTreeNodeFromTexture<uint16_t>(nodeLLF, nodeURB,
-                                sliceVolumes.channelDataBuffers, textureDim,
-                                octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histogramBuffers.at(threadID));
-                        else if (inputDataFormat == "int16")
-                            node = createTreeNodeFromTexture<int16_t>(nodeLLF, nodeURB,
-                                sliceVolumes.channelDataBuffers, textureDim,
-                                octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histogramBuffers.at(threadID));
-                        else if (inputDataFormat == "uint32")
-                            node = createTreeNodeFromTexture<uint32_t>(nodeLLF, nodeURB,
-                                sliceVolumes.channelDataBuffers, textureDim,
-                                octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histogramBuffers.at(threadID));
-                        else if (inputDataFormat == "int32")
-                            node = createTreeNodeFromTexture<int32_t>(nodeLLF, nodeURB,
-                                sliceVolumes.channelDataBuffers, textureDim,
-                                octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histogramBuffers.at(threadID));
-                        else if (inputDataFormat == "float")
-                            node = createTreeNodeFromTexture<float>(nodeLLF, nodeURB,
-                                sliceVolumes.channelDataBuffers, textureDim,
-                                octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histogramBuffers.at(threadID));
-                        else if (inputDataFormat == "double")
-                            node = createTreeNodeFromTexture<double>(nodeLLF, nodeURB,
-                                sliceVolumes.channelDataBuffers, textureDim,
-                                octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histogramBuffers.at(threadID));
-                        else
-                            throw VoreenException("Unknown/unsupported input data format: " + inputDataFormat);
-
-                        tgtAssert(node, "no node created");
-                        tgtAssert(minValues[0] <= avgValues[0] && avgValues[0] <= maxValues[0], "invalid avg/min/max values");
-                        tgtAssert(node->getAvgValue() == avgValues[0] && node->getMinValue() == minValues[0] && node->getMaxValue() == maxValues[0],
-                            "avg/min/max values of returned node differ from returned avg/min/max values");
-
-                    } // node creation
-                    tgtAssert(node, "no node created");
 
+        //
+        // 2. Create the parent plates whose children are complete now (a parent plate covers two child plates)
+        //
+        size_t childLevel = 0;
+        size_t childPlateZ = nodeIndexZ;
+        while (childLevel+1 < levelGrids.grids.size() && childPlateZ % 2 == 1) {
+            NodeGrid3D* childGrid = levelGrids.grids.at(childLevel);
+            NodeGrid3D* parentGrid = levelGrids.grids.at(childLevel+1);
+            const size_t parentPlateZ = childPlateZ / 2;
+            const tgt::svec3 parentGridDim = parentGrid->getDim();
+            const int numParentPlateNodes = static_cast<int>(parentGridDim.x*parentGridDim.y);
+            LDEBUG("-- Creating level " << childLevel+1 << " nodes for plate " << parentPlateZ);
+            std::string errorMessage;
+
+            #ifdef VRN_MODULE_OPENMP
+            #pragma omp parallel for schedule(dynamic) num_threads(static_cast<int>(numThreads))
+            #endif
+            for (int plateNodeID = 0; plateNodeID < numParentPlateNodes; plateNodeID++) {
+                const tgt::svec3 parentNodeID(plateNodeID % parentGridDim.x, plateNodeID / parentGridDim.x, parentPlateZ);
+                VolumeOctreeNode* childNodes[8];
+                for (size_t i=0; i<8; i++) {
+                    tgt::svec3 childNodeID = linearCoordToCubic(i, tgt::svec3::two);
+                    childNodes[i] = childGrid->getNode(parentNodeID*tgt::svec3::two + childNodeID);
+                    tgtAssert(childNodes[i], "child node not created");
+                }
+                try {
+                    uint16_t avgValues[MAX_CHANNELS], minValues[MAX_CHANNELS], maxValues[MAX_CHANNELS];
+                    VolumeOctreeNode* parentNode = createParentNode(childNodes, octreeOptimization, homogeneityThreshold,
+                        avgValues, minValues, maxValues);
+                    tgtAssert(minValues[0] <= avgValues[0] && avgValues[0] <= maxValues[0], "invalid avg/min/max values");
+                    tgtAssert(parentNode->getAvgValue() == avgValues[0] && parentNode->getMinValue() == minValues[0] && parentNode->getMaxValue() == maxValues[0],
+                        "avg/min/max values of returned node differ from returned avg/min/max values");
+                    tgtAssert(parentGrid->getNode(parentNodeID) == 0, "parent node already exists");
+                    parentGrid->setNode(parentNode, parentNodeID);
+                }
+                catch (std::exception& e) {
                     #ifdef VRN_MODULE_OPENMP
                     #pragma omp critical
                     #endif
-                    {
-                    tgtAssert(level0Grid->getNode(nodeIndex) == 0, "node already created");
-                    level0Grid->setNode(node, nodeIndex);
-                    }
+                    errorMessage = e.what();
+                }
+                // children are now owned by the parent node or have been deleted by createParentNode()
+                for (size_t i=0; i<8; i++)
+                    childGrid->setNode(0, parentNodeID*tgt::svec3::two + linearCoordToCubic(i, tgt::svec3::two));
+            }
+            if (!errorMessage.empty())
+                throw VoreenException(errorMessage);
 
-                } // nodeIndex.x
-            } // nodeIndex.y
-        } // multi-threading loop
+            childLevel++;
+            childPlateZ = parentPlateZ;
+        }
 
         // update progress bar
         if (progressReporter) {
-            float level0Progress = (float)(endSlice-1) / getVolumeDim().z;
-            progressReporter->setProgress(level0Progress*0.7f);
+            float progress = (float)(nodeIndexZ+1) / (float)numNodesPerDim.z;
+            progressReporter->setProgress(progress*0.9f);
         }
 
-    } // nodeIndexZ (slice plate)
-
-    tgtAssert(level0Grid->isComplete(), "level 0 node grid not completely constructed");
-
+    } // nodeIndexZ (plate)
 
     //
-    // 2. iteratively create next level nodes from current level
+    // 3. Create root node from the top level grid
     //
-
-    // brickDim == octreeDim => tree has only one level => already finished
-    if (level0Grid->getDim() == tgt::svec3::one) {
-        rootNode_ = level0Grid->getNode(tgt::svec3(0, 0, 0));
-        delete level0Grid;
+    NodeGrid3D* topLevelGrid = levelGrids.grids.back();
+    if (topLevelGrid->getDim() == tgt::svec3::one) { // brickDim == octreeDim => tree has only one level => already finished
+        rootNode_ = topLevelGrid->getNode(tgt::svec3(0, 0, 0));
+        topLevelGrid->setNode(0, tgt::svec3(0, 0, 0));
     }
-    else { // iterative construction of upper levels
-        size_t currentLevel = 1;
-        NodeGrid3D* currentLevelGrid = level0Grid;
-        while (currentLevelGrid->getDim() != tgt::svec3::two) {
-            // check current grid
-            tgtAssert(currentLevelGrid->isComplete(), "current level grid is not complete");
-            tgtAssert(isCubicAndPot(currentLevelGrid->getDim()), "grid dim is not cubic power-of-two");
-
-            // log memory usage
-            LDEBUG("- Creating level " << currentLevel << " nodes");
-            LDEBUG("-- Before: " << MemoryInfo::getProcessMemoryUsageAsString());
-            LDEBUG("-- Before: " << MemoryInfo::getAvailableMemoryAsString());
-
-            // create parent level grid
-            NodeGrid3D* parentLevelGrid = new NodeGrid3D(currentLevelGrid->getDim() / tgt::svec3::two);
-            tgtAssert(isCubicAndPot(parentLevelGrid->getDim()), "next level grid dim is not cubic power-of-two");
-
-            // create parent nodes
-            const tgt::svec3 parentLevelGridDim = parentLevelGrid->getDim();
-            for (size_t parentNodeZ=0; parentNodeZ<parentLevelGridDim.z; parentNodeZ++) {
-
-                #ifdef VRN_MODULE_OPENMP
-                #pragma omp parallel for
-                #endif
-                for (int threadID = 0; threadID < numThreads; threadID++) {
-                    tgt::svec3 parentNodeID(0, 0, parentNodeZ);
-                    for (parentNodeID.y=threadID; parentNodeID.y<parentLevelGridDim.y; parentNodeID.y += numThreads) {
-                        for (parentNodeID.x=0; parentNodeID.x<parentLevelGridDim.x; parentNodeID.x++) {
-                            VolumeOctreeNode* childNodes[8];
-                            for (size_t i=0; i<8; i++) {
-                                tgt::svec3 childNodeID = linearCoordToCubic(i, tgt::svec3::two);
-                                childNodes[i] = currentLevelGrid->getNode(parentNodeID*tgt::svec3::two + childNodeID);
-                            }
-                            uint16_t avgValues[MAX_CHANNELS], minValues[MAX_CHANNELS], maxValues[MAX_CHANNELS];
-                            VolumeOctreeNode* parentNode = createParentNode(childNodes, octreeOptimization, homogeneityThreshold,
-                                avgValues, minValues, maxValues);
-                            tgtAssert(minValues[0] <= avgValues[0] && avgValues[0] <= maxValues[0], "invalid avg/min/max values");
-                            tgtAssert(parentNode->getAvgValue() == avgValues[0] && parentNode->getMinValue() == minValues[0] && parentNode->getMaxValue() == maxValues[0],
-                                "avg/min/max values of returned node differ from returned avg/min/max values");
-
-                            #ifdef VRN_MODULE_OPENMP
-                            #pragma omp critical
-                            #endif
-                            {
-                            tgtAssert(parentLevelGrid->getNode(parentNodeID) == 0, "parent node already exists");
-                            parentLevelGrid->setNode(parentNode, parentNodeID);
-                            }
-
-                        } // parentNodeIndex.x
-                    } // parentNodeIndex.y
-                } // multi-threading loop
-
-                // update progress bar
-                if (progressReporter && currentLevel == 1) {
-                    float inLevelProgress = (float)(parentNodeZ+1) / (float)parentLevelGridDim.z;
-                    progressReporter->setProgress(0.7f + inLevelProgress*0.2f);
-                }
-
-            } // parentNodeIndexZ
-
-            // log memory usage
-            LDEBUG("-- After: " << MemoryInfo::getProcessMemoryUsageAsString());
-            LDEBUG("-- After: " << MemoryInfo::getAvailableMemoryAsString());
+    else {
+        tgtAssert(topLevelGrid->getDim() == tgt::svec3::two, "level grid dimensions [2 2 2] expected");
+        tgtAssert(topLevelGrid->isComplete(), "top level grid is not complete");
 
-            // advance to parent level
-            delete currentLevelGrid;
-            currentLevelGrid = parentLevelGrid;
-            currentLevel++;
+        // hand the top level nodes over to createParentNode(), which takes ownership
+        VolumeOctreeNode* childNodes[8];
+        for (size_t i=0; i<8; i++) {
+            childNodes[i] = topLevelGrid->getNodes()[i];
+            topLevelGrid->getNodes()[i] = 0;
         }
-        tgtAssert(currentLevelGrid->getDim() == tgt::svec3::two, "level grid dimensions [2 2 2] expected");
 
         LDEBUG("- Creating root node");
         uint16_t avgValues[MAX_CHANNELS], minValues[MAX_CHANNELS], maxValues[MAX_CHANNELS];
-        rootNode_ = createParentNode(currentLevelGrid->getNodes(), octreeOptimization, homogeneityThreshold,
+        rootNode_ = createParentNode(childNodes, octreeOptimization, homogeneityThreshold,
             avgValues, minValues, maxValues);
         tgtAssert(minValues[0] <= avgValues[0] && avgValues[0] <= maxValues[0], "invalid avg/min/max values");
-
-        delete currentLevelGrid;
     }
+    // all nodes are owned by the tree now
+    for (size_t i=0; i<levelGrids.grids.size(); i++) {
+        tgtAssert(levelGrids.grids[i]->getNode(tgt::svec3::zero) == 0, "level grid still holds nodes");
+        delete levelGrids.grids[i];
+    }
+    levelGrids.grids.clear();
 
     tgtAssert(rootNode_, "no root node");
     tgtAssert(rootNode_->getNumBricks() <= rootNode_->getNodeCount(), "number of bricks larger than number of nodes");
@@ -935,6 +1000,12 @@ void VolumeOctree::composeNodeTexture(const VolumeOctreeNode* node, const svec3&
         tgtAssert(!node->isLeaf(), "node not expected to be leaf"); //< higher level leaves have no brick (see above)
         svec3 subNodeDim = nodeDim / svec3(2);
         complete = true;
+
+        // children are the final level => let the brick pool manager load their bricks in the background,
+        // while the first child is being composed
+        if (curLevel-1 == targetLevel)
+            prefetchChildBricks(node, svec3::zero, svec3::two);
+
         VRN_FOR_EACH_VOXEL(childCoord, svec3::zero, svec3::two) {
             const VolumeOctreeNode* child = node->children_[cubicCoordToLinear(childCoord, svec3::two)];
             bool childComplete;
@@ -946,6 +1017,20 @@ void VolumeOctree::composeNodeTexture(const VolumeOctreeNode* node, const svec3&
     }
 }
 
+void VolumeOctree::prefetchChildBricks(const VolumeOctreeNode* node, const tgt::svec3& childStart, const tgt::svec3& childEnd) const {
+    tgtAssert(brickPoolManager_, "no brick pool manager");
+    tgtAssert(node && !node->isLeaf(), "invalid node");
+
+    std::vector<uint64_t> brickAddresses;
+    VRN_FOR_EACH_VOXEL(childCoord, childStart, childEnd) {
+        const VolumeOctreeNode* child = node->children_[cubicCoordToLinear(childCoord, svec3::two)];
+        if (child && child->hasBrick() && !child->isHomogeneous())
+            brickAddresses.push_back(child->getBrickAddress());
+    }
+    if (!brickAddresses.empty())
+        brickPoolManager_->prefetchBricks(brickAddresses);
+}
+
 void VolumeOctree::composeNodeSliceTexture(SliceAlignment sliceAlignment, const VolumeOctreeNode* node,
     const tgt::svec3& nodeOffsetInTexture, size_t sliceIndexInNode, size_t curLevel, size_t targetLevel,
     uint16_t* textureBuffer, const tgt::svec3& textureDim, clock_t timeLimit, tgt::Stopwatch& runtimeWatch, bool& complete) const
@@ -1024,6 +1109,11 @@ void VolumeOctree::composeNodeSliceTexture(SliceAlignment sliceAlignment, const
         childStart[sliceAlignment] = childLayer;
         childEnd[sliceAlignment] = childLayer+1;
         complete = true;
+
+        // children are the final level => let the brick pool manager load their bricks in the background
+        if (curLevel-1 == targetLevel)
+            prefetchChildBricks(node, childStart, childEnd);
+
         VRN_FOR_EACH_VOXEL(childCoord, childStart, childEnd) {
             const VolumeOctreeNode* child = node->children_[cubicCoordToLinear(childCoord, svec3::two)];
             tgtAssert(child, "no child node");
@@ -1170,6 +1260,56 @@ void VolumeOctree::extractBrickFromTexture(const std::vector<const void*>& textu
     }
 }
 
+VolumeOctreeNode* VolumeOctree::createLevel0Node(const tgt::svec3& nodeIndex, const std::string& inputDataFormat,
+    const std::vector<const void*>& slabDataBuffers, const tgt::svec3& slabDim,
+    bool octreeOptimization, uint16_t homogeneityThreshold, std::vector< std::vector<uint64_t> >& histograms)
+    throw (VoreenException)
+{
+    tgt::svec3 nodeLLF = nodeIndex*getBrickDim();
+    tgt::svec3 nodeURB = nodeLLF + getBrickDim();
+    if (tgt::hor(tgt::greaterThanEqual(nodeLLF, getVolumeDim()))) // outside volume in x or y direction => create empty node
+        return VolumeOctreeBase::createNode(getNumChannels());
+
+    // create node from slab data buffer(s)
+    nodeLLF.z = 0;
+    nodeURB.z = getBrickDim().z;
+    uint16_t avgValues[MAX_CHANNELS], minValues[MAX_CHANNELS], maxValues[MAX_CHANNELS];
+    VolumeOctreeNode* node = 0;
+    if (inputDataFormat == "uint8")
+        node = createTreeNodeFromTexture<uint8_t>(nodeLLF, nodeURB, slabDataBuffers, slabDim,
+            octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histograms);
+    else if (inputDataFormat == "int8")
+        node = createTreeNodeFromTexture<int8_t>(nodeLLF, nodeURB, slabDataBuffers, slabDim,
+            octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histograms);
+    else if (inputDataFormat == "uint16")
+        node = createTreeNodeFromTexture<uint16_t>(nodeLLF, nodeURB, slabDataBuffers, slabDim,
+            octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histograms);
+    else if (inputDataFormat == "int16")
+        node = createTreeNodeFromTexture<int16_t>(nodeLLF, nodeURB, slabDataBuffers, slabDim,
+            octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histograms);
+    else if (inputDataFormat == "uint32")
+        node = createTreeNodeFromTexture<uint32_t>(nodeLLF, nodeURB, slabDataBuffers, slabDim,
+            octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histograms);
+    else if (inputDataFormat == "int32")
+        node = createTreeNodeFromTexture<int32_t>(nodeLLF, nodeURB, slabDataBuffers, slabDim,
+            octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histograms);
+    else if (inputDataFormat == "float")
+        node = createTreeNodeFromTexture<float>(nodeLLF, nodeURB, slabDataBuffers, slabDim,
+            octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histograms);
+    else if (inputDataFormat == "double")
+        node = createTreeNodeFromTexture<double>(nodeLLF, nodeURB, slabDataBuffers, slabDim,
+            octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues, histograms);
+    else
+        throw VoreenException("Unknown/unsupported input data format: " + inputDataFormat);
+
+    tgtAssert(node, "no node created");
+    tgtAssert(minValues[0] <= avgValues[0] && avgValues[0] <= maxValues[0], "invalid avg/min/max values");
+    tgtAssert(node->getAvgValue() == avgValues[0] && node->getMinValue() == minValues[0] && node->getMaxValue() == maxValues[0],
+        "avg/min/max values of returned node differ from returned avg/min/max values");
+
+    return node;
+}
+
 VolumeOctreeNode* VolumeOctree::createParentNode(VolumeOctreeNode* children[8], bool octreeOptimization, uint16_t homogeneityThreshold,
     uint16_t* avgValues, uint16_t* minValues, uint16_t* maxValues)
     throw (VoreenException)
@@ -1219,72 +1359,84 @@ VolumeOctreeNode* VolumeOctree::createParentNode(VolumeOctreeNode* children[8],
         }
     }
 
-    if (homogeneous && octreeOptimization) { // node is homogeneous => create leaf node without brick
-        VolumeOctreeNode* parent = 0;
-        if (numNonEmptyChildren > 0)
-            parent = VolumeOctreeBase::createNode(getNumChannels(), avgValues, minValues, maxValues);
-        else
-            parent = VolumeOctreeBase::createNode(getNumChannels());
-
-        // delete child nodes
-        for (size_t i=0; i<8; i++)
-            deleteSubTree(children[i]);
-
-        return parent;
-
-    }
-    else { // node is not homogeneous => create inner node with brick by merging child nodes
-        // OPTIMIZATION: half-sample directly into target brick buffer
+    // the children are either attached to the parent or deleted, also if an exception is thrown
+    uint16_t* halfSampledBrickBuffer = 0;
+    try {
+        if (homogeneous && octreeOptimization) { // node is homogeneous => create leaf node without brick
+            VolumeOctreeNode* parent = 0;
+            if (numNonEmptyChildren > 0)
+                parent = VolumeOctreeBase::createNode(getNumChannels(), avgValues, minValues, maxValues);
+            else
+                parent = VolumeOctreeBase::createNode(getNumChannels());
 
-        // half sample child bricks and compute avg value
-        svec3 halfSampleBrickDim = getBrickDim() / svec3(2);
-        size_t halfSampleBufferSize = tgt::hmul(halfSampleBrickDim)*getNumChannels();
-        size_t brickBufferSize = halfSampleBufferSize*8;
+            // delete child nodes
+            for (size_t i=0; i<8; i++)
+                deleteSubTree(children[i]);
 
-        // store all half sampled bricks in one temporary buffer
-        uint16_t* halfSampledBrickBuffer = acquireTempBrickBuffer();
+            return parent;
 
-        for (size_t childID=0; childID<8; childID++) {
-            VolumeOctreeNode* child = children[childID];
-            tgtAssert(child, "null pointer");
-            if (child->hasBrick()) { // node brick present => halfsample into buffer
-                halfSampleBrick(brickPoolManager_->getBrick(child->getBrickAddress()), getBrickDim(), &halfSampledBrickBuffer[childID*halfSampleBufferSize]);
-                brickPoolManager_->releaseBrick(child->getBrickAddress());
-            }
-            else { // no brick present => use node's avg values
-                size_t childOffset = childID*halfSampleBufferSize;
-                for (size_t channel=0; channel<getNumChannels(); channel++) {
-                    uint16_t childAvgValue = child->getAvgValue(channel);
-                    for (size_t voxel=0; voxel<tgt::hmul(halfSampleBrickDim); voxel++) {
-                        size_t bufferIndex = childOffset + voxel*numChannels + channel;
-                        tgtAssert(bufferIndex < brickBufferSize, "invalid buffer index");
-                        halfSampledBrickBuffer[bufferIndex] = childAvgValue;
+        }
+        else { // node is not homogeneous => create inner node with brick by merging child nodes
+            // OPTIMIZATION: half-sample directly into target brick buffer
+
+            // half sample child bricks and compute avg value
+            svec3 halfSampleBrickDim = getBrickDim() / svec3(2);
+            size_t halfSampleBufferSize = tgt::hmul(halfSampleBrickDim)*getNumChannels();
+            size_t brickBufferSize = halfSampleBufferSize*8;
+
+            // store all half sampled bricks in one temporary buffer
+            halfSampledBrickBuffer = acquireTempBrickBuffer();
+
+            for (size_t childID=0; childID<8; childID++) {
+                VolumeOctreeNode* child = children[childID];
+                tgtAssert(child, "null pointer");
+                if (child->hasBrick()) { // node brick present => halfsample into buffer
+                    halfSampleBrick(brickPoolManager_->getBrick(child->getBrickAddress()), getBrickDim(), &halfSampledBrickBuffer[childID*halfSampleBufferSize]);
+                    brickPoolManager_->releaseBrick(child->getBrickAddress());
+                }
+                else { // no brick present => use node's avg values
+                    size_t childOffset = childID*halfSampleBufferSize;
+                    for (size_t channel=0; channel<getNumChannels(); channel++) {
+                        uint16_t childAvgValue = child->getAvgValue(channel);
+                        for (size_t voxel=0; voxel<tgt::hmul(halfSampleBrickDim); voxel++) {
+                            size_t bufferIndex = childOffset + voxel*numChannels + channel;
+                            tgtAssert(bufferIndex < brickBufferSize, "invalid buffer index");
+                            halfSampledBrickBuffer[bufferIndex] = childAvgValue;
+                        }
                     }
                 }
             }
-        }
 
-        // copy halfsampled bricks to dest buffer (child nodes/halfsampled bricks are expected to be zyx ordered)
-        uint64_t brickVirtualMemoryAddress = brickPoolManager_->allocateBrick();
-        uint16_t* brickBuffer = brickPoolManager_->getWritableBrick(brickVirtualMemoryAddress);
+            // copy halfsampled bricks to dest buffer (child nodes/halfsampled bricks are expected to be zyx ordered)
+            uint64_t brickVirtualMemoryAddress = brickPoolManager_->allocateBrick();
+            uint16_t* brickBuffer = brickPoolManager_->getWritableBrick(brickVirtualMemoryAddress);
 
-        VRN_FOR_EACH_VOXEL(child, svec3::zero, svec3::two) {
-            const size_t childOffset = cubicCoordToLinear(child, svec3::two)*halfSampleBufferSize;
-            svec3 halfSampleOffset = child * halfSampleBrickDim;
-            uint16_t* halfSampledBrick = halfSampledBrickBuffer + childOffset;
-            tgtAssert(brickBuffer, "no brick buffer allocated");
-            copyBrickToTexture(halfSampledBrick, halfSampleBrickDim, brickBuffer, getBrickDim(), halfSampleOffset);
-        }
+            VRN_FOR_EACH_VOXEL(child, svec3::zero, svec3::two) {
+                const size_t childOffset = cubicCoordToLinear(child, svec3::two)*halfSampleBufferSize;
+                svec3 halfSampleOffset = child * halfSampleBrickDim;
+                uint16_t* halfSampledBrick = halfSampledBrickBuffer + childOffset;
+                tgtAssert(brickBuffer, "no brick buffer allocated");
+                copyBrickToTexture(halfSampledBrick, halfSampleBrickDim, brickBuffer, getBrickDim(), halfSampleOffset);
+            }
 
-        releaseTempBrickBuffer(halfSampledBrickBuffer);
+            releaseTempBrickBuffer(halfSampledBrickBuffer);
+            halfSampledBrickBuffer = 0;
 
-        // create parent node
-        VolumeOctreeNode* parent = VolumeOctreeBase::createNode(getNumChannels(), avgValues, minValues, maxValues,
-            brickVirtualMemoryAddress, children);
+            // create parent node
+            VolumeOctreeNode* parent = VolumeOctreeBase::createNode(getNumChannels(), avgValues, minValues, maxValues,
+                brickVirtualMemoryAddress, children);
 
-        brickPoolManager_->releaseBrick(brickVirtualMemoryAddress, OctreeBrickPoolManagerBase::WRITE);
+            brickPoolManager_->releaseBrick(brickVirtualMemoryAddress, OctreeBrickPoolManagerBase::WRITE);
 
-        return parent;
+            return parent;
+        }
+    }
+    catch (...) {
+        if (halfSampledBrickBuffer)
+            releaseTempBrickBuffer(halfSampledBrickBuffer);
+        for (size_t i=0; i<8; i++)
+            deleteSubTree(children[i]);
+        throw;
     }
 }
 
@@ -1340,6 +1492,17 @@ void VolumeOctree::halfSampleBrick(const uint16_t* brick, const svec3& brickDim,
     }
 }
 
+void VolumeOctree::assignCompressedBrickSizes(VolumeOctreeNode* root) const {
+    if (!root)
+        return;
+
+    if (root->hasBrick())
+        root->compressedBrickSize_ = static_cast<uint32_t>(brickPoolManager_->getCompressedBrickSize(root->getBrickAddress()));
+
+    for (size_t i=0; i<8; i++)
+        assignCompressedBrickSizes(root->children_[i]);
+}
+
 void VolumeOctree::deleteSubTree(VolumeOctreeNode* root) const {
     if (!root)
         return;
@@ -1828,18 +1991,27 @@ VolumeOctreeNode* VolumeOctree::createTreeNodeRecursively(const svec3& llf, cons
             avgValues, minValues, maxValues, histograms);
     }
     else { // recursively create child nodes
-        VolumeOctreeNode* children[8];
+        VolumeOctreeNode* children[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
         const svec3 childNodeDim = nodeDim / svec3(2);
 
-        VRN_FOR_EACH_VOXEL(child, svec3::zero, svec3::two) {
-            size_t childIndex = cubicCoordToLinear(child, svec3(2));
-            svec3 childLlf = llf + child*childNodeDim;
-            svec3 childUrb = childLlf + childNodeDim;
-            uint16_t childAvg[MAX_CHANNELS], childMin[MAX_CHANNELS], childMax[MAX_CHANNELS];
-            children[childIndex] = createTreeNodeRecursively<T>(childLlf, childUrb, textureBuffers, textureDim,
-                octreeOptimization, homogeneityThreshold,
-                childAvg, childMin, childMax, histograms, progressReporter);
+        try {
+            VRN_FOR_EACH_VOXEL(child, svec3::zero, svec3::two) {
+                size_t childIndex = cubicCoordToLinear(child, svec3(2));
+                svec3 childLlf = llf + child*childNodeDim;
+                svec3 childUrb = childLlf + childNodeDim;
+                uint16_t childAvg[MAX_CHANNELS], childMin[MAX_CHANNELS], childMax[MAX_CHANNELS];
+                children[childIndex] = createTreeNodeRecursively<T>(childLlf, childUrb, textureBuffers, textureDim,
+                    octreeOptimization, homogeneityThreshold,
+                    childAvg, childMin, childMax, histograms, progressReporter);
+            }
         }
+        catch (...) {
+            for (size_t i=0; i<8; i++)
+                deleteSubTree(children[i]);
+            throw;
+        }
+
+        // takes ownership of the children
 
         node = createParentNode(children, octreeOptimization, homogeneityThreshold, avgValues, minValues, maxValues);
     }
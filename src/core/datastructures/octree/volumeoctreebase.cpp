@@ -48,6 +48,7 @@ namespace voreen {
 
 VolumeOctreeNode::VolumeOctreeNode()
     : brickAddress_(std::numeric_limits<uint64_t>::max())
+    , compressedBrickSize_(0)
     , inVolume_(true)
 {
     children_[0] = 0;
@@ -71,6 +72,10 @@ uint64_t VolumeOctreeNode::getBrickAddress() const {
     return brickAddress_;
 }
 
+uint32_t VolumeOctreeNode::getCompressedBrickSize() const {
+    return compressedBrickSize_;
+}
+
 bool VolumeOctreeNode::isHomogeneous() const {
     return !hasBrick();
 }
@@ -140,6 +145,8 @@ void VolumeOctreeNode::serializeContentToBinaryBuffer(char* buffer) const {
 
     memcpy(buffer, &brickAddress_, sizeof(uint64_t));
     buffer += sizeof(uint64_t);
+    memcpy(buffer, &compressedBrickSize_, sizeof(uint32_t));
+    buffer += sizeof(uint32_t);
     memcpy(buffer, &inVolume_, sizeof(bool));
 }
 
@@ -148,6 +155,8 @@ void VolumeOctreeNode::deserializeContentFromBinaryBuffer(const char* buffer) {
 
     memcpy(const_cast<uint64_t*>(&brickAddress_), buffer, sizeof(uint64_t));
     buffer += sizeof(uint64_t);
+    memcpy(const_cast<uint32_t*>(&compressedBrickSize_), buffer, sizeof(uint32_t));
+    buffer += sizeof(uint32_t);
     memcpy(const_cast<bool*>(&inVolume_), buffer, sizeof(bool));
 }
 
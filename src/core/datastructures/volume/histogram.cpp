@@ -27,6 +27,7 @@
 #include "voreen/core/datastructures/volume/volume.h"
 #include "voreen/core/datastructures/volume/volumeram.h"
 #include "voreen/core/datastructures/volume/volumedisk.h"
+#include "voreen/core/datastructures/volume/volumederiveddataengine.h"
 #include "voreen/core/datastructures/volume/operators/volumeoperatorgradient.h"
 
 #include "voreen/core/io/serialization/xmlserializer.h"
@@ -209,12 +210,7 @@ VolumeHistogramIntensity::VolumeHistogramIntensity(const std::vector<Histogram1D
 
 VolumeDerivedData* VolumeHistogramIntensity::createFrom(const VolumeBase* handle) const {
     tgtAssert(handle, "no volume");
-    VolumeHistogramIntensity* h = new VolumeHistogramIntensity();
-    for (size_t channel = 0; channel < handle->getNumChannels(); channel++) {
-        Histogram1D hist = createHistogram1DFromVolume(handle, 256, channel);
-        h->histograms_.push_back(hist);
-    }
-    return h;
+    return VolumeDerivedDataEngine::createDerivedData(handle, getClassName());
 }
 
 size_t VolumeHistogramIntensity::getNumChannels() const {
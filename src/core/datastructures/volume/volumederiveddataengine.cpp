@@ -0,0 +1,533 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "voreen/core/datastructures/volume/volumederiveddataengine.h"
+
+#include "voreen/core/datastructures/volume/volume.h"
+#include "voreen/core/datastructures/volume/volumeram.h"
+#include "voreen/core/datastructures/volume/volumedisk.h"
+#include "voreen/core/datastructures/volume/volumeelement.h"
+#include "voreen/core/datastructures/volume/volumeminmax.h"
+#include "voreen/core/datastructures/volume/volumehash.h"
+#include "voreen/core/datastructures/volume/volumestatistics.h"
+#include "voreen/core/datastructures/volume/histogram.h"
+#include "voreen/core/utils/hashing.h"
+
+#include <boost/thread.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef VRN_MODULE_OPENMP
+#include "omp.h"
+#endif
+
+namespace voreen {
+
+const int VolumeDerivedDataEngine::HISTOGRAM_BUCKET_COUNT = 256;
+const size_t VolumeDerivedDataEngine::MAX_SLAB_SIZE = 64 << 20;
+const std::string VolumeDerivedDataEngine::loggerCat_("voreen.VolumeDerivedDataEngine");
+
+namespace {
+
+/// Statistics of one channel in normalized values, with the histogram covering the channel's real world range.
+struct ChannelResult {
+    ChannelResult()
+        : minNorm_(0.f)
+        , maxNorm_(1.f)
+        , mean_(0.f)
+        , stdDev_(0.f)
+    {}
+
+    float minNorm_;
+    float maxNorm_;
+    float mean_;
+    float stdDev_;
+    Histogram1D histogram_;
+};
+
+int getNumThreads() {
+#ifdef VRN_MODULE_OPENMP
+    return std::max(omp_get_max_threads(), 1);
+#else
+    return 1;
+#endif
+}
+
+/// Creates an empty histogram covering the real world range of the passed normalized range.
+Histogram1D createChannelHistogram(const RealWorldMapping& rwm, float minNorm, float maxNorm) {
+    float min = rwm.normalizedToRealWorld(minNorm);
+    float max = rwm.normalizedToRealWorld(maxNorm);
+    return Histogram1D(std::min(min, max), std::max(min, max), VolumeDerivedDataEngine::HISTOGRAM_BUCKET_COUNT);
+}
+
+/**
+ * Passes the voxel data of the volume to the accumulator's processVoxels(data, firstElement, endElement, thread),
+ * where [firstElement, endElement) is a range of whole voxels within the current chunk, i.e., the RAM volume
+ * or a slab of z slices loaded from the disk volume. The chunks are split into blocks of
+ * VoreenBlockHash::DEFAULT_BLOCK_SIZE bytes, which are processed in parallel. If a block hash is passed,
+ * the blocks of the RAM volume are hashed within the same loop.
+ */
+template<typename T, class Accumulator>
+void scanVoxels(const VolumeRAM* volumeRam, const VolumeDisk* volumeDisk, Accumulator& accumulator, VoreenBlockHash* blockHash)
+    throw (tgt::Exception)
+{
+    tgtAssert(volumeRam || volumeDisk, "no representation");
+    tgtAssert(!blockHash || volumeRam, "block hash requires RAM volume");
+
+    const size_t blockSize = VoreenBlockHash::DEFAULT_BLOCK_SIZE;
+    const size_t blocksPerBatch = 4 * static_cast<size_t>(getNumThreads());
+
+    const tgt::svec3 dims = (volumeRam ? volumeRam->getDimensions() : volumeDisk->getDimensions());
+    const size_t bytesPerVoxel = (volumeRam ? volumeRam->getBytesPerVoxel() : volumeDisk->getBytesPerVoxel());
+    const size_t numChannels = bytesPerVoxel / sizeof(T);
+    const size_t sliceSize = dims.x * dims.y * bytesPerVoxel;
+    const size_t slicesPerChunk = (volumeRam ? dims.z : std::max<size_t>(VolumeDerivedDataEngine::MAX_SLAB_SIZE / sliceSize, 1));
+
+    if (blockHash)
+        blockHash->reset(static_cast<uint64_t>(volumeRam->getNumVoxels()) * bytesPerVoxel);
+
+    for (size_t firstSlice = 0; firstSlice < dims.z; firstSlice += slicesPerChunk) {
+        boost::this_thread::interruption_point();
+
+        const size_t lastSlice = std::min(firstSlice + slicesPerChunk, dims.z) - 1;
+        const VolumeRAM* chunk = (volumeRam ? volumeRam : volumeDisk->loadSlices(firstSlice, lastSlice));
+        tgtAssert(chunk, "null pointer returned (exception expected)");
+
+        try {
+            const T* data = static_cast<const T*>(chunk->getData());
+            const size_t numVoxels = chunk->getNumVoxels();
+            const size_t numBlocks = (numVoxels * bytesPerVoxel + blockSize - 1) / blockSize;
+
+            for (size_t firstBlock = 0; firstBlock < numBlocks; firstBlock += blocksPerBatch) {
+                boost::this_thread::interruption_point();
+
+                const int endBlock = static_cast<int>(std::min(firstBlock + blocksPerBatch, numBlocks));
+                #ifdef VRN_MODULE_OPENMP
+                #pragma omp parallel for schedule(dynamic)
+                #endif
+                for (int block = static_cast<int>(firstBlock); block < endBlock; block++) {
+                    int thread = 0;
+                    #ifdef VRN_MODULE_OPENMP
+                    thread = omp_get_thread_num();
+                    #endif
+                    const size_t blockOffset = static_cast<size_t>(block) * blockSize;
+                    if (blockHash)
+                        blockHash->hashBlock(reinterpret_cast<const char*>(data) + blockOffset, static_cast<size_t>(block));
+
+                    // process the voxels starting within the block
+                    const size_t firstVoxel = (blockOffset + bytesPerVoxel - 1) / bytesPerVoxel;
+                    const size_t endVoxel = std::min((blockOffset + blockSize + bytesPerVoxel - 1) / bytesPerVoxel, numVoxels);
+                    if (firstVoxel < endVoxel)
+                        accumulator.processVoxels(data, firstVoxel*numChannels, endVoxel*numChannels, thread);
+                }
+            }
+        }
+        catch (...) {
+            if (chunk != volumeRam)
+                delete chunk;
+            throw;
+        }
+        if (chunk != volumeRam)
+            delete chunk;
+    }
+}
+
+/**
+ * Counts the occurrences of each value per channel and thread. All results are derived from the counts,
+ * so a single pass over the data is sufficient. Only suitable for 8 and 16 bit data.
+ */
+template<typename T>
+class ValueCounter {
+public:
+    ValueCounter(size_t numChannels, int numThreads)
+        : numChannels_(numChannels)
+        , numValues_(static_cast<size_t>(1) << (8*sizeof(T)))
+        , counts_(numThreads, std::vector<uint64_t>(numChannels*numValues_, 0))
+    {}
+
+    void processVoxels(const T* data, size_t firstElement, size_t endElement, int thread) {
+        uint64_t* counts = &counts_[thread][0];
+        for (size_t i = firstElement; i < endElement; i += numChannels_) {
+            for (size_t c = 0; c < numChannels_; c++)
+                counts[c*numValues_ + getIndex(data[i+c])]++;
+        }
+    }
+
+    /// Merges the per-thread counts and derives the channel results from them.
+    std::vector<ChannelResult> getResults(const RealWorldMapping& rwm) const {
+        std::vector<float> normValues(numValues_);
+        for (size_t v = 0; v < numValues_; v++)
+            normValues[v] = getTypeAsFloat(getValue(v));
+
+        std::vector<ChannelResult> results(numChannels_);
+        std::vector<uint64_t> counts(numValues_);
+        for (size_t c = 0; c < numChannels_; c++) {
+            std::fill(counts.begin(), counts.end(), 0);
+            for (size_t t = 0; t < counts_.size(); t++) {
+                const uint64_t* threadCounts = &counts_[t][c*numValues_];
+                for (size_t v = 0; v < numValues_; v++)
+                    counts[v] += threadCounts[v];
+            }
+
+            size_t minIndex = numValues_;
+            size_t maxIndex = 0;
+            uint64_t numSamples = 0;
+            double sum = 0.0;
+            for (size_t v = 0; v < numValues_; v++) {
+                if (counts[v] == 0)
+                    continue;
+                if (minIndex == numValues_)
+                    minIndex = v;
+                maxIndex = v;
+                numSamples += counts[v];
+                sum += static_cast<double>(counts[v]) * normValues[v];
+            }
+            if (numSamples == 0)
+                continue;
+
+            const double mean = sum / static_cast<double>(numSamples);
+            double sumSq = 0.0;
+            for (size_t v = minIndex; v <= maxIndex; v++) {
+                const double diff = normValues[v] - mean;
+                sumSq += static_cast<double>(counts[v]) * diff * diff;
+            }
+
+            ChannelResult& result = results[c];
+            result.minNorm_ = normValues[minIndex];
+            result.maxNorm_ = normValues[maxIndex];
+            result.mean_ = static_cast<float>(mean);
+            result.stdDev_ = static_cast<float>(std::sqrt(sumSq / static_cast<double>(numSamples)));
+            result.histogram_ = createChannelHistogram(rwm, result.minNorm_, result.maxNorm_);
+            for (size_t v = minIndex; v <= maxIndex; v++) {
+                if (counts[v] > 0)
+                    result.histogram_.addSamples(rwm.normalizedToRealWorld(normValues[v]), counts[v]);
+            }
+        }
+        return results;
+    }
+
+private:
+    static size_t getIndex(T value) {
+        return static_cast<size_t>(static_cast<int>(value) - static_cast<int>(std::numeric_limits<T>::min()));
+    }
+
+    static T getValue(size_t index) {
+        return static_cast<T>(static_cast<int>(index) + static_cast<int>(std::numeric_limits<T>::min()));
+    }
+
+    size_t numChannels_;
+    size_t numValues_;
+    std::vector< std::vector<uint64_t> > counts_;  ///< per thread: numValues_ counts for each channel
+};
+
+/// First pass for data that is not counted: determines the range and the sum of the normalized values per channel and thread.
+template<typename T>
+class RangeAccumulator {
+public:
+    RangeAccumulator(size_t numChannels, int numThreads)
+        : numChannels_(numChannels)
+        , minValues_(numThreads, std::vector<float>(numChannels, std::numeric_limits<float>::max()))
+        , maxValues_(numThreads, std::vector<float>(numChannels, -std::numeric_limits<float>::max()))
+        , sums_(numThreads, std::vector<double>(numChannels, 0.0))
+        , numVoxels_(numThreads, 0)
+    {}
+
+    void processVoxels(const T* data, size_t firstElement, size_t endElement, int thread) {
+        // accumulate locally in order to avoid false sharing between the threads
+        std::vector<float> minValues = minValues_[thread];
+        std::vector<float> maxValues = maxValues_[thread];
+        std::vector<double> sums(numChannels_, 0.0);
+        for (size_t i = firstElement; i < endElement; i += numChannels_) {
+            for (size_t c = 0; c < numChannels_; c++) {
+                const float value = getTypeAsFloat(data[i+c]);
+                minValues[c] = std::min(minValues[c], value);
+                maxValues[c] = std::max(maxValues[c], value);
+                sums[c] += value;
+            }
+        }
+
+        minValues_[thread] = minValues;
+        maxValues_[thread] = maxValues;
+        for (size_t c = 0; c < numChannels_; c++)
+            sums_[thread][c] += sums[c];
+        numVoxels_[thread] += (endElement - firstElement) / numChannels_;
+    }
+
+    /// Merges the per-thread values and returns the channel results without standard deviations and histogram samples.
+    std::vector<ChannelResult> getResults(const RealWorldMapping& rwm) const {
+        uint64_t numVoxels = 0;
+        for (size_t t = 0; t < numVoxels_.size(); t++)
+            numVoxels += numVoxels_[t];
+
+        std::vector<ChannelResult> results(numChannels_);
+        for (size_t c = 0; c < numChannels_; c++) {
+            float minNorm = std::numeric_limits<float>::max();
+            float maxNorm = -std::numeric_limits<float>::max();
+            double sum = 0.0;
+            for (size_t t = 0; t < sums_.size(); t++) {
+                minNorm = std::min(minNorm, minValues_[t][c]);
+                maxNorm = std::max(maxNorm, maxValues_[t][c]);
+                sum += sums_[t][c];
+            }
+
+            ChannelResult& result = results[c];
+            if (numVoxels > 0 && minNorm <= maxNorm) {
+                result.minNorm_ = minNorm;
+                result.maxNorm_ = maxNorm;
+                result.mean_ = static_cast<float>(sum / static_cast<double>(numVoxels));
+            }
+            result.histogram_ = createChannelHistogram(rwm, result.minNorm_, result.maxNorm_);
+        }
+        return results;
+    }
+
+private:
+    size_t numChannels_;
+    std::vector< std::vector<float> > minValues_;
+    std::vector< std::vector<float> > maxValues_;
+    std::vector< std::vector<double> > sums_;
+    std::vector<uint64_t> numVoxels_;
+};
+
+/// Second pass for data that is not counted: fills the histograms and sums up the squared deviations from the mean per channel and thread.
+template<typename T>
+class DistributionAccumulator {
+public:
+    DistributionAccumulator(const std::vector<ChannelResult>& results, const RealWorldMapping& rwm, int numThreads)
+        : numChannels_(results.size())
+        , scale_(rwm.getScale())
+        , offset_(rwm.getOffset())
+        , sumsSq_(numThreads, std::vector<double>(results.size(), 0.0))
+        , numVoxels_(numThreads, 0)
+    {
+        for (size_t c = 0; c < numChannels_; c++)
+            means_.push_back(results[c].mean_);
+
+        std::vector<Histogram1D> histograms;
+        for (size_t c = 0; c < numChannels_; c++)
+            histograms.push_back(results[c].histogram_);
+        histograms_.assign(numThreads, histograms);
+    }
+
+    void processVoxels(const T* data, size_t firstElement, size_t endElement, int thread) {
+        std::vector<Histogram1D>& histograms = histograms_[thread];
+        std::vector<double> sumsSq(numChannels_, 0.0);
+        for (size_t i = firstElement; i < endElement; i += numChannels_) {
+            for (size_t c = 0; c < numChannels_; c++) {
+                const float value = getTypeAsFloat(data[i+c]);
+                histograms[c].addSamples(value*scale_ + offset_, 1);
+                const double diff = value - means_[c];
+                sumsSq[c] += diff * diff;
+            }
+        }
+
+        for (size_t c = 0; c < numChannels_; c++)
+            sumsSq_[thread][c] += sumsSq[c];
+        numVoxels_[thread] += (endElement - firstElement) / numChannels_;
+    }
+
+    /// Merges the per-thread histograms and sums into the passed channel results.
+    void getResults(std::vector<ChannelResult>& results) const {
+        tgtAssert(results.size() == numChannels_, "channel count mismatch");
+        uint64_t numVoxels = 0;
+        for (size_t t = 0; t < numVoxels_.size(); t++)
+            numVoxels += numVoxels_[t];
+        if (numVoxels == 0)
+            return;
+
+        for (size_t c = 0; c < numChannels_; c++) {
+            double sumSq = 0.0;
+            for (size_t t = 0; t < histograms_.size(); t++) {
+                sumSq += sumsSq_[t][c];
+                const Histogram1D& threadHistogram = histograms_[t][c];
+                for (size_t b = 0; b < threadHistogram.getNumBuckets(); b++) {
+                    if (threadHistogram.getBucket(b) > 0)
+                        results[c].histogram_.increaseBucket(b, threadHistogram.getBucket(b));
+                }
+            }
+            results[c].stdDev_ = static_cast<float>(std::sqrt(sumSq / static_cast<double>(numVoxels)));
+        }
+    }
+
+private:
+    size_t numChannels_;
+    float scale_;
+    float offset_;
+    std::vector<double> means_;
+    std::vector< std::vector<Histogram1D> > histograms_;
+    std::vector< std::vector<double> > sumsSq_;
+    std::vector<uint64_t> numVoxels_;
+};
+
+size_t getNumChannels(const VolumeRAM* volumeRam, const VolumeDisk* volumeDisk, size_t bytesPerValue) {
+    return (volumeRam ? volumeRam->getBytesPerVoxel() : volumeDisk->getBytesPerVoxel()) / bytesPerValue;
+}
+
+template<typename T>
+std::vector<ChannelResult> computeByCounting(const VolumeRAM* volumeRam, const VolumeDisk* volumeDisk,
+    const RealWorldMapping& rwm, VoreenBlockHash* blockHash)
+    throw (tgt::Exception)
+{
+    ValueCounter<T> counter(getNumChannels(volumeRam, volumeDisk, sizeof(T)), getNumThreads());
+    scanVoxels<T>(volumeRam, volumeDisk, counter, blockHash);
+    return counter.getResults(rwm);
+}
+
+template<typename T>
+std::vector<ChannelResult> computeInTwoPasses(const VolumeRAM* volumeRam, const VolumeDisk* volumeDisk,
+    const RealWorldMapping& rwm, VoreenBlockHash* blockHash)
+    throw (tgt::Exception)
+{
+    RangeAccumulator<T> range(getNumChannels(volumeRam, volumeDisk, sizeof(T)), getNumThreads());
+    scanVoxels<T>(volumeRam, volumeDisk, range, blockHash);
+    std::vector<ChannelResult> results = range.getResults(rwm);
+
+    DistributionAccumulator<T> distribution(results, rwm, getNumThreads());
+    scanVoxels<T>(volumeRam, volumeDisk, distribution, 0);
+    distribution.getResults(results);
+    return results;
+}
+
+/// Adds the by-product to the volume or deletes it.
+template<class T>
+void attachByProduct(const VolumeBase* volume, T* item, bool attach) {
+    if (attach)
+        volume->addDerivedDataIfMissing<T>(item);
+    else
+        delete item;
+}
+
+} // namespace
+
+VolumeDerivedData* VolumeDerivedDataEngine::createDerivedData(const VolumeBase* volume, const std::string& className) {
+    tgtAssert(volume, "no volume");
+    tgtAssert(className == "VolumeMinMax" || className == "VolumeHistogramIntensity" || className == "VolumeStatistics",
+        "unsupported derived data class");
+
+    // use RAM representation only if already present,
+    // otherwise use disk representation, if available
+    const VolumeRAM* volumeRam = 0;
+    const VolumeDisk* volumeDisk = 0;
+    if (volume->hasRepresentation<VolumeRAM>())
+        volumeRam = volume->getRepresentation<VolumeRAM>();
+    else if (volume->hasRepresentation<VolumeDisk>())
+        volumeDisk = volume->getRepresentation<VolumeDisk>();
+
+    // the hash of a disk volume is obtained from the disk representation (see VolumeHash::createFrom())
+    VoreenBlockHash blockHash;
+    VoreenBlockHash* hashToCompute = (volumeRam && !volume->hasRepresentation<VolumeDisk>() ? &blockHash : 0);
+
+    const RealWorldMapping rwm = volume->getRealWorldMapping();
+    std::vector<ChannelResult> results;
+    if (volumeRam || volumeDisk) {
+        const std::string baseType = (volumeRam ? volumeRam->getBaseType() : volumeDisk->getBaseType());
+        try {
+            if (baseType == "uint8")
+                results = computeByCounting<uint8_t>(volumeRam, volumeDisk, rwm, hashToCompute);
+            else if (baseType == "int8")
+                results = computeByCounting<int8_t>(volumeRam, volumeDisk, rwm, hashToCompute);
+            else if (baseType == "uint16")
+                results = computeByCounting<uint16_t>(volumeRam, volumeDisk, rwm, hashToCompute);
+            else if (baseType == "int16")
+                results = computeByCounting<int16_t>(volumeRam, volumeDisk, rwm, hashToCompute);
+            else if (baseType == "uint32")
+                results = computeInTwoPasses<uint32_t>(volumeRam, volumeDisk, rwm, hashToCompute);
+            else if (baseType == "int32")
+                results = computeInTwoPasses<int32_t>(volumeRam, volumeDisk, rwm, hashToCompute);
+            else if (baseType == "uint64")
+                results = computeInTwoPasses<uint64_t>(volumeRam, volumeDisk, rwm, hashToCompute);
+            else if (baseType == "int64")
+                results = computeInTwoPasses<int64_t>(volumeRam, volumeDisk, rwm, hashToCompute);
+            else if (baseType == "float")
+                results = computeInTwoPasses<float>(volumeRam, volumeDisk, rwm, hashToCompute);
+            else if (baseType == "double")
+                results = computeInTwoPasses<double>(volumeRam, volumeDisk, rwm, hashToCompute);
+            else
+                LWARNING("Unable to compute derived data: unsupported base type '" << baseType << "'");
+        }
+        catch (tgt::Exception& e) {
+            LWARNING("Unable to compute derived data: failed to load slices from disk volume: " << e.what());
+            results.clear();
+        }
+        catch (std::bad_alloc&) {
+            LWARNING("Unable to compute derived data: bad allocation");
+            results.clear();
+        }
+    }
+    else {
+        LWARNING("Unable to compute derived data: neither disk nor RAM representation available");
+    }
+
+    const bool success = !results.empty();
+    if (!success) {
+        results.assign(volume->getNumChannels(), ChannelResult());
+        for (size_t c = 0; c < results.size(); c++)
+            results[c].histogram_ = createChannelHistogram(rwm, results[c].minNorm_, results[c].maxNorm_);
+    }
+
+    std::vector<float> minValues, maxValues, minNormValues, maxNormValues;
+    std::vector<float> means, stdDevs, meansNormalized, stdDevsNormalized;
+    std::vector<Histogram1D> histograms;
+    for (size_t c = 0; c < results.size(); c++) {
+        const ChannelResult& result = results[c];
+        minValues.push_back(rwm.normalizedToRealWorld(result.minNorm_));
+        maxValues.push_back(rwm.normalizedToRealWorld(result.maxNorm_));
+        minNormValues.push_back(result.minNorm_);
+        maxNormValues.push_back(result.maxNorm_);
+        means.push_back(rwm.normalizedToRealWorld(result.mean_));
+        stdDevs.push_back(result.stdDev_ * std::abs(rwm.getScale()));
+        meansNormalized.push_back(result.mean_);
+        stdDevsNormalized.push_back(result.stdDev_);
+        histograms.push_back(result.histogram_);
+    }
+
+    VolumeMinMax* minMax = new VolumeMinMax(minValues, maxValues, minNormValues, maxNormValues);
+    VolumeHistogramIntensity* histogram = new VolumeHistogramIntensity(histograms);
+    VolumeStatistics* statistics = new VolumeStatistics(means, stdDevs, meansNormalized, stdDevsNormalized);
+
+    VolumeDerivedData* requested = 0;
+    if (className == "VolumeMinMax")
+        requested = minMax;
+    else if (className == "VolumeHistogramIntensity")
+        requested = histogram;
+    else
+        requested = statistics;
+
+    if (requested != minMax)
+        attachByProduct(volume, minMax, success);
+    if (requested != histogram)
+        attachByProduct(volume, histogram, success);
+    if (requested != statistics)
+        attachByProduct(volume, statistics, success);
+    if (success && hashToCompute)
+        volume->addDerivedDataIfMissing(new VolumeHash(blockHash));
+
+    return requested;
+}
+
+} // namespace voreen
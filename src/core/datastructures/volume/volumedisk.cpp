@@ -36,6 +36,20 @@
 #include <typeinfo>
 #include <fstream>
 
+#ifdef WIN32
+#include <stdio.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#endif
+
+#ifdef __linux__
+#include <sys/uio.h>
+#define VRN_VOLUMEDISK_PREADV
+#endif
+
 using tgt::vec3;
 using tgt::bvec3;
 using tgt::ivec3;
@@ -45,6 +59,91 @@ using tgt::mat4;
 
 namespace voreen {
 
+namespace {
+
+/// Maximum gap (in bytes) between two brick rows that is read and discarded instead of issuing a separate read.
+const size_t MAX_READ_GAP = 256 << 10;
+
+/// Maximum number of buffers passed to a single vectored read.
+const size_t MAX_READ_VECTORS = 512;
+
+/// Contiguous byte range of the file that is read into a contiguous range of the destination buffer.
+struct ReadSegment {
+    uint64_t fileOffset_;
+    char* dest_;
+    size_t numBytes_;
+};
+
+#ifdef WIN32
+typedef FILE* FileHandle;
+#else
+typedef int FileHandle;
+#endif
+
+/// Reads numBytes starting at the passed file offset into dest. Returns false on failure.
+bool readAt(FileHandle file, uint64_t fileOffset, char* dest, size_t numBytes) {
+#ifdef WIN32
+    if (_fseeki64(file, fileOffset, SEEK_SET) != 0)
+        return false;
+    return (fread(dest, 1, numBytes, file) == numBytes);
+#else
+    while (numBytes > 0) {
+        ssize_t result = pread(file, dest, numBytes, static_cast<off_t>(fileOffset));
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result <= 0)
+            return false;
+        dest += result;
+        fileOffset += result;
+        numBytes -= result;
+    }
+    return true;
+#endif
+}
+
+/**
+ * Reads the segments [first, last) by a single vectored read, if supported by the platform.
+ * The gaps between the segments are read into the sink buffer and discarded.
+ */
+bool readSegments(FileHandle file, const std::vector<ReadSegment>& segments, size_t first, size_t last, std::vector<char>& sink) {
+#ifdef VRN_VOLUMEDISK_PREADV
+    if (last - first > 1) {
+        std::vector<struct iovec> vectors;
+        size_t numBytes = 0;
+        for (size_t i = first; i < last; i++) {
+            if (i > first) {
+                struct iovec gap;
+                gap.iov_base = &sink[0];
+                gap.iov_len = static_cast<size_t>(segments[i].fileOffset_ - segments[i-1].fileOffset_ - segments[i-1].numBytes_);
+                if (gap.iov_len > 0)
+                    vectors.push_back(gap);
+                numBytes += gap.iov_len;
+            }
+            struct iovec data;
+            data.iov_base = segments[i].dest_;
+            data.iov_len = segments[i].numBytes_;
+            vectors.push_back(data);
+            numBytes += data.iov_len;
+        }
+
+        ssize_t result;
+        do {
+            result = preadv(file, &vectors[0], static_cast<int>(vectors.size()), static_cast<off_t>(segments[first].fileOffset_));
+        } while (result < 0 && errno == EINTR);
+        if (result == static_cast<ssize_t>(numBytes))
+            return true;
+        // short read => fall back to reading the segments separately
+    }
+#endif
+    for (size_t i = first; i < last; i++) {
+        if (!readAt(file, segments[i].fileOffset_, segments[i].dest_, segments[i].numBytes_))
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
 const std::string VolumeDisk::loggerCat_("voreen.VolumeDisk");
 
 VolumeDisk::VolumeDisk(const std::string& format, tgt::svec3 dimensions)
@@ -172,140 +271,145 @@ VolumeRAM* VolumeDiskRaw::loadSlices(const size_t firstSlice, const size_t lastS
     if(firstSlice > lastSlice)
         throw std::invalid_argument("firstSlice has to be less or equal lastSlice!!!");
 
-    //create new VolumeRam
+    // the slices span full rows and plates => read by a single call
+    return loadBrick(tgt::svec3(0, 0, firstSlice), tgt::svec3(getDimensions().x, getDimensions().y, lastSlice-firstSlice+1));
+}
+
+VolumeRAM* VolumeDiskRaw::loadBrick(const tgt::svec3& brickOffset, const tgt::svec3& brickDim) const
+    throw (tgt::Exception)
+{
+    // check parameters
+    if (tgt::hmul(brickDim) == 0)
+        throw std::invalid_argument("requested brick dimensions are zero");
+    if (!tgt::hand(tgt::lessThanEqual(brickOffset+brickDim, getDimensions())))
+        throw std::invalid_argument("requested brick (at least partially) outside volume dimensions");
+
+    // create output VolumeRAM
     VolumeFactory vf;
-    VolumeRAM* vr = vf.create(getFormat(), tgt::svec3(getDimensions().x,getDimensions().y, lastSlice-firstSlice+1));
+    VolumeRAM* vr = 0;
+    try {
+        vr = vf.create(getFormat(), brickDim);
+    }
+    catch (std::bad_alloc&) {
+        throw tgt::Exception("bad allocation");
+    }
     if (!vr)
         throw VoreenException("Failed to create VolumeRAM");
 
-    //open file
-    std::ifstream infile(getFileName().c_str(), std::ios::in | std::ios::binary);
-    if (infile.fail())
-        throw tgt::FileException("Failed to open file for reading: " + getFileName());
-
-    size_t bytesPerVoxel = static_cast<size_t>(vr->getBitsAllocated() / 8);
-    size_t numVoxels = getDimensions().x*getDimensions().y*(lastSlice-firstSlice+1);
-    size_t numBytes = numVoxels * bytesPerVoxel;
-
-    int64_t offset = getOffset();
-
-    if(offset < 0) {
-        //Assume data is aligned to end of file.
-
-        // get file size:
-        infile.seekg( 0, infile.end);
-        std::streampos fileSize = infile.tellg();
-        infile.seekg( 0, infile.beg);
-
-        //calculate real offset:
-        offset = static_cast<std::string::size_type>(fileSize) - hmul(getDimensions())*bytesPerVoxel;
+    try {
+        loadBrick(brickOffset, brickDim, vr);
     }
-
-    //modify offset to start at first slice
-    offset += getDimensions().x*getDimensions().y*firstSlice*bytesPerVoxel;
-    infile.seekg(offset);
-
-    //read into ram
-    infile.read(reinterpret_cast<char*>(vr->getData()),numBytes);
-
-    if (infile.fail()) {
-        //LERRORC("voreen.RepresentationConverterLoadFromDisk", "read() failed");
-        infile.close();
+    catch (...) {
         delete vr;
-        throw tgt::FileException("Failed to read from file: " + getFileName());
-    }
-    infile.close();
-
-    //swap endian
-    if(getSwapEndian()) {
-        Volume* tempHandle = new Volume(vr, vec3(1.0f), vec3(0.0f));
-        VolumeOperatorSwapEndianness::APPLY_OP(tempHandle);
-        tempHandle->releaseAllRepresentations();
-        delete tempHandle;
+        throw;
     }
 
     return vr;
 }
 
-VolumeRAM* VolumeDiskRaw::loadBrick(const tgt::svec3& brickOffset, const tgt::svec3& brickDim) const
+void VolumeDiskRaw::loadBrick(const tgt::svec3& brickOffset, const tgt::svec3& brickDim, VolumeRAM* dest) const
     throw (tgt::Exception)
 {
+    tgtAssert(dest, "null pointer passed");
+
     // check parameters
     if (tgt::hmul(brickDim) == 0)
         throw std::invalid_argument("requested brick dimensions are zero");
     if (!tgt::hand(tgt::lessThanEqual(brickOffset+brickDim, getDimensions())))
         throw std::invalid_argument("requested brick (at least partially) outside volume dimensions");
+    if (dest->getDimensions() != brickDim || dest->getBytesPerVoxel() != getBytesPerVoxel())
+        throw std::invalid_argument("destination volume does not match brick dimensions or format");
 
     LDEBUG("Loading brick: offset=" << brickOffset << ", dim=" << brickDim);
 
-    // open file
-    std::ifstream infile(getFileName().c_str(), std::ios::in | std::ios::binary);
-    if (infile.fail())
-        throw tgt::FileException("Failed to open file for reading: " + getFileName());
+    readBrickFromFile(getFileName(), getOffset(), getDimensions(), getBytesPerVoxel(),
+        brickOffset, brickDim, dest->getData(), brickDim);
 
-    // create output VolumeRAM
-    VolumeFactory vf;
-    VolumeRAM* vr = vf.create(getFormat(), brickDim);
-    if (!vr)
-        throw VoreenException("Failed to create VolumeRAM");
+    //swap endian
+    if (getSwapEndian()) {
+        Volume* tempHandle = new Volume(dest, vec3(1.0f), vec3(0.0f));
+        VolumeOperatorSwapEndianness::APPLY_OP(tempHandle);
+        tempHandle->releaseAllRepresentations();
+        delete tempHandle;
+    }
+}
 
-    size_t bytesPerVoxel = vr->getBytesPerVoxel();
-    size_t numVoxelsPerLine = brickDim.x;
-    size_t numBytesPerLine = numVoxelsPerLine * bytesPerVoxel;
+void VolumeDiskRaw::readBrickFromFile(const std::string& filename, int64_t dataOffset, const tgt::svec3& volumeDim,
+        size_t bytesPerVoxel, const tgt::svec3& brickOffset, const tgt::svec3& brickDim, void* dest, const tgt::svec3& destDim)
+    throw (tgt::FileException)
+{
+    tgtAssert(dest, "null pointer passed");
+    tgtAssert(tgt::hand(tgt::lessThanEqual(brickOffset+brickDim, volumeDim)), "brick outside volume");
+    tgtAssert(tgt::hand(tgt::lessThanEqual(brickDim, destDim)), "brick larger than destination");
 
-    int64_t offset = getOffset();
-    if (offset < 0) {
+    if (dataOffset < 0) {
         //Assume data is aligned to end of file.
-
-        // get file size:
-        infile.seekg( 0, infile.end);
-        std::streampos fileSize = infile.tellg();
-        infile.seekg( 0, infile.beg);
-
-        //calculate real offset:
-        offset = static_cast<std::string::size_type>(fileSize) - hmul(getDimensions())*bytesPerVoxel;
+        dataOffset = static_cast<int64_t>(tgt::FileSystem::fileSize(filename)) - static_cast<int64_t>(tgt::hmul(volumeDim)*bytesPerVoxel);
+        if (dataOffset < 0)
+            throw tgt::FileException("File is smaller than the volume: " + filename);
     }
 
-    // modify file offset to start at first slice
-    offset += (dimensions_.x*dimensions_.y*brickOffset.z + dimensions_.x*brickOffset.y + brickOffset.x)*bytesPerVoxel;
-    infile.seekg(offset);
-
-    // read lines into ram
-    size_t destOffset = 0;
-    char* destBuffer = reinterpret_cast<char*>(vr->getData());
-    for (size_t z = 0; z < brickDim.z; z++){
+    // determine the byte ranges to read, merging rows that are adjacent in both file and buffer
+    std::vector<ReadSegment> segments;
+    const size_t numBytesPerLine = brickDim.x * bytesPerVoxel;
+    char* destBuffer = reinterpret_cast<char*>(dest);
+    for (size_t z = 0; z < brickDim.z; z++) {
         for (size_t y = 0; y < brickDim.y; y++) {
+            uint64_t fileOffset = static_cast<uint64_t>(dataOffset) + (static_cast<uint64_t>((brickOffset.z + z)*volumeDim.y + brickOffset.y + y)
+                                   * volumeDim.x + brickOffset.x) * bytesPerVoxel;
+            char* destLine = destBuffer + ((z*destDim.y + y)*destDim.x)*bytesPerVoxel;
 
-            // read line into ram and write to dest buffer
-            infile.read(destBuffer+destOffset, numBytesPerLine);
-            if (infile.fail()) {
-                infile.close();
-                delete vr;
-                throw tgt::FileException("Failed to read from file: " + getFileName());
+            if (!segments.empty() && segments.back().fileOffset_ + segments.back().numBytes_ == fileOffset
+                    && segments.back().dest_ + segments.back().numBytes_ == destLine) {
+                segments.back().numBytes_ += numBytesPerLine;
+            }
+            else {
+                ReadSegment segment;
+                segment.fileOffset_ = fileOffset;
+                segment.dest_ = destLine;
+                segment.numBytes_ = numBytesPerLine;
+                segments.push_back(segment);
             }
-            // move dest offset by one line
-            destOffset += numBytesPerLine;
-
-            // move file handle to next line
-            infile.seekg((dimensions_.x-brickDim.x)*bytesPerVoxel, std::ios_base::cur);
         }
-
-        // move file offset to next slice
-        infile.seekg((dimensions_.y-brickDim.y)*dimensions_.x*bytesPerVoxel, std::ios_base::cur);
-
     }
 
-    infile.close();
+    // open file
+#ifdef WIN32
+    FileHandle file = fopen(filename.c_str(), "rb");
+    if (!file)
+        throw tgt::FileException("Failed to open file for reading: " + filename);
+#else
+    FileHandle file = open(filename.c_str(), O_RDONLY);
+    if (file < 0)
+        throw tgt::FileException("Failed to open file for reading: " + filename);
+#endif
 
-    //swap endian
-    if (getSwapEndian()) {
-        Volume* tempHandle = new Volume(vr, vec3(1.0f), vec3(0.0f));
-        VolumeOperatorSwapEndianness::APPLY_OP(tempHandle);
-        tempHandle->releaseAllRepresentations();
-        delete tempHandle;
+    // read segments in groups separated by small gaps
+    std::vector<char> sink;
+#ifdef VRN_VOLUMEDISK_PREADV
+    sink.resize(MAX_READ_GAP);
+#endif
+    bool success = true;
+    size_t groupStart = 0;
+    while (success && groupStart < segments.size()) {
+        size_t groupEnd = groupStart + 1;
+#ifdef VRN_VOLUMEDISK_PREADV
+        while (groupEnd < segments.size() && (groupEnd - groupStart) < MAX_READ_VECTORS/2 &&
+               segments[groupEnd].fileOffset_ - (segments[groupEnd-1].fileOffset_ + segments[groupEnd-1].numBytes_) <= MAX_READ_GAP)
+            groupEnd++;
+#endif
+        success = readSegments(file, segments, groupStart, groupEnd, sink);
+        groupStart = groupEnd;
     }
 
-    return vr;
+#ifdef WIN32
+    fclose(file);
+#else
+    close(file);
+#endif
+
+    if (!success)
+        throw tgt::FileException("Failed to read from file: " + filename);
 }
 
 
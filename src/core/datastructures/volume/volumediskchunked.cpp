@@ -0,0 +1,736 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "voreen/core/datastructures/volume/volumediskchunked.h"
+
+#include "voreen/core/datastructures/volume/volume.h"
+#include "voreen/core/datastructures/volume/volumefactory.h"
+#include "voreen/core/datastructures/volume/operators/volumeoperatorhalfsample.h"
+
+#include "voreen/core/io/progressreporter.h"
+#include "voreen/core/utils/hashing.h"
+#include "voreen/core/utils/stringutils.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string.h>
+
+#ifdef VRN_MODULE_OPENMP
+#include "omp.h"
+#endif
+
+using tgt::svec3;
+
+namespace voreen {
+
+namespace {
+
+const char CHUNK_FILE_MAGIC[8] = { 'V', 'R', 'N', 'C', 'H', 'U', 'N', 'K' };
+const uint32_t CHUNK_FILE_VERSION = 1;
+
+/// Size of the file header: magic, version, bytes per voxel, bytes per value, chunk dimensions (3), number of levels, index offset
+const size_t CHUNK_FILE_HEADER_SIZE = sizeof(CHUNK_FILE_MAGIC) + 7*sizeof(uint32_t) + sizeof(uint64_t);
+
+/// Number of values of a byte plane sharing one reference value and bit width.
+const size_t CODEC_BLOCK_SIZE = 64;
+
+/// Size of a block header: reference value (uint8) + bit width (uint8)
+const size_t CODEC_BLOCK_HEADER_SIZE = 2;
+
+inline size_t getNumBits(uint8_t value) {
+    size_t numBits = 0;
+    while (value) {
+        numBits++;
+        value >>= 1;
+    }
+    return numBits;
+}
+
+size_t getMaxEncodedSize(size_t numBytes, size_t bytesPerValue) {
+    const size_t numBlocks = (numBytes / bytesPerValue + CODEC_BLOCK_SIZE - 1) / CODEC_BLOCK_SIZE;
+    return bytesPerValue*numBlocks*CODEC_BLOCK_HEADER_SIZE + numBytes;
+}
+
+/**
+ * Encodes a chunk of numBytes bytes by bit-packing each byte plane block-wise relative to the
+ * block's minimum. Returns the encoded size. If the chunk does not shrink, it is copied raw
+ * (i.e., an encoded size equal to numBytes denotes a raw chunk).
+ */
+size_t encodeChunk(const char* chunk, size_t numBytes, size_t bytesPerValue, char* encoded) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(chunk);
+    unsigned char* out = reinterpret_cast<unsigned char*>(encoded);
+    const size_t numValues = numBytes / bytesPerValue;
+
+    for (size_t plane = 0; plane < bytesPerValue; plane++) {
+        for (size_t blockStart = 0; blockStart < numValues; blockStart += CODEC_BLOCK_SIZE) {
+            const size_t blockEnd = std::min(blockStart + CODEC_BLOCK_SIZE, numValues);
+
+            // determine frame of reference and bit width
+            uint8_t minValue = in[blockStart*bytesPerValue + plane];
+            uint8_t maxValue = minValue;
+            for (size_t i = blockStart+1; i < blockEnd; i++) {
+                uint8_t value = in[i*bytesPerValue + plane];
+                minValue = std::min(minValue, value);
+                maxValue = std::max(maxValue, value);
+            }
+            const size_t numBits = getNumBits(static_cast<uint8_t>(maxValue - minValue));
+
+            *out++ = minValue;
+            *out++ = static_cast<unsigned char>(numBits);
+
+            // bit-pack offsets
+            if (numBits > 0) {
+                uint32_t bitBuffer = 0;
+                size_t numBufferedBits = 0;
+                for (size_t i = blockStart; i < blockEnd; i++) {
+                    bitBuffer |= static_cast<uint32_t>(in[i*bytesPerValue + plane] - minValue) << numBufferedBits;
+                    numBufferedBits += numBits;
+                    while (numBufferedBits >= 8) {
+                        *out++ = static_cast<unsigned char>(bitBuffer & 0xFF);
+                        bitBuffer >>= 8;
+                        numBufferedBits -= 8;
+                    }
+                }
+                if (numBufferedBits > 0)
+                    *out++ = static_cast<unsigned char>(bitBuffer & 0xFF);
+            }
+        }
+    }
+
+    size_t encodedSize = static_cast<size_t>(out - reinterpret_cast<unsigned char*>(encoded));
+    tgtAssert(encodedSize <= getMaxEncodedSize(numBytes, bytesPerValue), "encoded size exceeds maximum");
+
+    // not compressible => store raw chunk
+    if (encodedSize >= numBytes) {
+        memcpy(encoded, chunk, numBytes);
+        encodedSize = numBytes;
+    }
+    return encodedSize;
+}
+
+/// Decodes a chunk encoded by encodeChunk(). Returns false, if the encoded data is corrupt.
+bool decodeChunk(const char* encoded, size_t encodedSize, size_t numBytes, size_t bytesPerValue, char* chunk) {
+    if (encodedSize == numBytes) {
+        memcpy(chunk, encoded, numBytes);
+        return true;
+    }
+
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(encoded);
+    const unsigned char* inEnd = in + encodedSize;
+    unsigned char* out = reinterpret_cast<unsigned char*>(chunk);
+    const size_t numValues = numBytes / bytesPerValue;
+
+    for (size_t plane = 0; plane < bytesPerValue; plane++) {
+        for (size_t blockStart = 0; blockStart < numValues; blockStart += CODEC_BLOCK_SIZE) {
+            const size_t blockEnd = std::min(blockStart + CODEC_BLOCK_SIZE, numValues);
+
+            // block header
+            if (inEnd - in < static_cast<ptrdiff_t>(CODEC_BLOCK_HEADER_SIZE))
+                return false;
+            const uint8_t minValue = in[0];
+            const size_t numBits = in[1];
+            in += CODEC_BLOCK_HEADER_SIZE;
+            if (numBits > 8)
+                return false;
+
+            if (numBits == 0) {
+                for (size_t i = blockStart; i < blockEnd; i++)
+                    out[i*bytesPerValue + plane] = minValue;
+                continue;
+            }
+
+            const size_t numBlockBytes = ((blockEnd - blockStart)*numBits + 7) / 8;
+            if (static_cast<size_t>(inEnd - in) < numBlockBytes)
+                return false;
+
+            // unpack offsets
+            const uint32_t mask = (1u << numBits) - 1;
+            uint32_t bitBuffer = 0;
+            size_t numBufferedBits = 0;
+            for (size_t i = blockStart; i < blockEnd; i++) {
+                while (numBufferedBits < numBits) {
+                    bitBuffer |= static_cast<uint32_t>(*in++) << numBufferedBits;
+                    numBufferedBits += 8;
+                }
+                out[i*bytesPerValue + plane] = static_cast<unsigned char>(minValue + (bitBuffer & mask));
+                bitBuffer >>= numBits;
+                numBufferedBits -= numBits;
+            }
+        }
+    }
+
+    return (in == inEnd);
+}
+
+/// Copies a box of voxels of size regionDim from the source to the destination buffer.
+void copyRegion(const char* src, const svec3& srcDim, const svec3& srcOffset,
+                char* dst, const svec3& dstDim, const svec3& dstOffset,
+                const svec3& regionDim, size_t bytesPerVoxel)
+{
+    const size_t numBytesPerLine = regionDim.x*bytesPerVoxel;
+    for (size_t z = 0; z < regionDim.z; z++) {
+        for (size_t y = 0; y < regionDim.y; y++) {
+            const size_t srcIndex = ((srcOffset.z + z)*srcDim.y + srcOffset.y + y)*srcDim.x + srcOffset.x;
+            const size_t dstIndex = ((dstOffset.z + z)*dstDim.y + dstOffset.y + y)*dstDim.x + dstOffset.x;
+            memcpy(dst + dstIndex*bytesPerVoxel, src + srcIndex*bytesPerVoxel, numBytesPerLine);
+        }
+    }
+}
+
+template<typename T>
+void writeValue(std::ostream& stream, T value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+T readValue(std::istream& stream) {
+    T value = T(0);
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+svec3 getNumChunks(const svec3& dimensions, const svec3& chunkDim) {
+    return (dimensions + chunkDim - svec3(1)) / chunkDim;
+}
+
+/**
+ * Encodes the levels of a chunk file from a stream of full resolution slices, so that the
+ * volume never has to be held in memory as a whole. Each level buffers a single layer of chunks,
+ * which is encoded and written as soon as it is complete. The next coarser level is fed with
+ * the halfsampled pairs of slices of its predecessor.
+ */
+class ChunkStreamWriter {
+public:
+    ChunkStreamWriter(std::ostream& outfile, const std::string& format, const std::vector<svec3>& levelDims,
+                      const svec3& chunkDim, size_t bytesPerVoxel, size_t bytesPerValue);
+    ~ChunkStreamWriter();
+
+    /// Appends consecutive slices to the passed level.
+    void addSlices(size_t level, const char* slices, size_t numSlices);
+
+    /// Writes the chunk index after all slices have been added.
+    void writeIndex();
+
+    /// Returns the file offset of the chunk index, valid after writeIndex().
+    uint64_t getIndexOffset() const;
+
+private:
+    struct LevelState {
+        svec3 dimensions_;
+        svec3 numChunks_;
+        std::vector<uint64_t> chunkOffsets_;
+        std::vector<uint64_t> chunkSizes_;
+        std::vector<char> layer_;       ///< slices of the current chunk layer
+        size_t numLayerSlices_;
+        size_t layerIndex_;
+        VolumeRAM* slicePair_;          ///< slices to be halfsampled into the next level, 0 for the coarsest level
+        Volume* slicePairHandle_;
+        size_t numPairSlices_;
+    };
+
+    /// Encodes the chunks of the current layer of the passed level in parallel and writes them in order.
+    void writeLayer(size_t level);
+
+    /// Halfsamples the slice pair of the passed level and adds the result to the next level.
+    void halfsampleSlicePair(size_t level);
+
+    std::ostream& outfile_;
+    svec3 chunkDim_;
+    size_t bytesPerVoxel_;
+    size_t bytesPerValue_;
+    uint64_t fileOffset_;
+    std::vector<LevelState> levels_;
+
+    // not copyable
+    ChunkStreamWriter(const ChunkStreamWriter&);
+    ChunkStreamWriter& operator=(const ChunkStreamWriter&);
+};
+
+ChunkStreamWriter::ChunkStreamWriter(std::ostream& outfile, const std::string& format, const std::vector<svec3>& levelDims,
+                                     const svec3& chunkDim, size_t bytesPerVoxel, size_t bytesPerValue)
+    : outfile_(outfile)
+    , chunkDim_(chunkDim)
+    , bytesPerVoxel_(bytesPerVoxel)
+    , bytesPerValue_(bytesPerValue)
+    , fileOffset_(CHUNK_FILE_HEADER_SIZE)
+    , levels_(levelDims.size())
+{
+    for (size_t l = 0; l < levels_.size(); l++) {
+        LevelState& level = levels_[l];
+        level.dimensions_ = levelDims[l];
+        level.numChunks_ = getNumChunks(level.dimensions_, chunkDim_);
+        level.chunkOffsets_.resize(tgt::hmul(level.numChunks_), 0);
+        level.chunkSizes_.resize(tgt::hmul(level.numChunks_), 0);
+        level.layer_.resize(level.dimensions_.x*level.dimensions_.y*std::min(chunkDim_.z, level.dimensions_.z)*bytesPerVoxel_);
+        level.numLayerSlices_ = 0;
+        level.layerIndex_ = 0;
+        level.slicePair_ = 0;
+        level.slicePairHandle_ = 0;
+        level.numPairSlices_ = 0;
+    }
+
+    try {
+        VolumeFactory vf;
+        for (size_t l = 0; l+1 < levels_.size(); l++) {
+            LevelState& level = levels_[l];
+            level.slicePair_ = vf.create(format, svec3(level.dimensions_.x, level.dimensions_.y, 2));
+            if (!level.slicePair_)
+                throw VoreenException("Failed to create VolumeRAM of format " + format);
+            level.slicePairHandle_ = new Volume(level.slicePair_, tgt::vec3(1.f), tgt::vec3(0.f));
+        }
+    }
+    catch (...) {
+        for (size_t l = 0; l < levels_.size(); l++) {
+            if (levels_[l].slicePairHandle_)
+                delete levels_[l].slicePairHandle_;
+            else
+                delete levels_[l].slicePair_;
+        }
+        throw;
+    }
+}
+
+ChunkStreamWriter::~ChunkStreamWriter() {
+    // the handles own the slice pairs
+    for (size_t l = 0; l < levels_.size(); l++)
+        delete levels_[l].slicePairHandle_;
+}
+
+void ChunkStreamWriter::addSlices(size_t level, const char* slices, size_t numSlices) {
+    tgtAssert(level < levels_.size(), "invalid level");
+    LevelState& lvl = levels_[level];
+    const size_t numSliceBytes = lvl.dimensions_.x*lvl.dimensions_.y*bytesPerVoxel_;
+
+    for (size_t i = 0; i < numSlices; i++) {
+        const char* slice = slices + i*numSliceBytes;
+        tgtAssert(lvl.layerIndex_ < lvl.numChunks_.z, "level already complete");
+
+        memcpy(&lvl.layer_[lvl.numLayerSlices_*numSliceBytes], slice, numSliceBytes);
+        lvl.numLayerSlices_++;
+        if (lvl.numLayerSlices_ == std::min(chunkDim_.z, lvl.dimensions_.z - lvl.layerIndex_*chunkDim_.z)) {
+            writeLayer(level);
+            lvl.layerIndex_++;
+            lvl.numLayerSlices_ = 0;
+        }
+
+        // a trailing unpaired slice is dropped, as by the halfsampling of the whole volume
+        if (lvl.slicePair_) {
+            memcpy(reinterpret_cast<char*>(lvl.slicePair_->getData()) + lvl.numPairSlices_*numSliceBytes, slice, numSliceBytes);
+            lvl.numPairSlices_++;
+            if (lvl.numPairSlices_ == 2) {
+                halfsampleSlicePair(level);
+                lvl.numPairSlices_ = 0;
+            }
+        }
+    }
+}
+
+void ChunkStreamWriter::writeLayer(size_t level) {
+    LevelState& lvl = levels_[level];
+    const svec3 layerDim(lvl.dimensions_.x, lvl.dimensions_.y, lvl.numLayerSlices_);
+    const int numLayerChunks = static_cast<int>(lvl.numChunks_.x*lvl.numChunks_.y);
+
+    std::vector<std::vector<char> > encoded(numLayerChunks);
+#ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel
+#endif
+    {
+        std::vector<char> chunkBuffer;
+#ifdef VRN_MODULE_OPENMP
+        #pragma omp for schedule(dynamic, 1)
+#endif
+        for (int i = 0; i < numLayerChunks; i++) {
+            const svec3 chunkOffset = svec3(i % lvl.numChunks_.x, i / lvl.numChunks_.x, 0)*chunkDim_;
+            const svec3 curChunkDim = tgt::min(chunkDim_, layerDim - chunkOffset);
+            const size_t numChunkBytes = tgt::hmul(curChunkDim)*bytesPerVoxel_;
+
+            chunkBuffer.resize(numChunkBytes);
+            copyRegion(&lvl.layer_[0], layerDim, chunkOffset, &chunkBuffer[0], curChunkDim, svec3::zero, curChunkDim, bytesPerVoxel_);
+            encoded[i].resize(getMaxEncodedSize(numChunkBytes, bytesPerValue_));
+            encoded[i].resize(encodeChunk(&chunkBuffer[0], numChunkBytes, bytesPerValue_, &encoded[i][0]));
+        }
+    }
+
+    const size_t firstChunk = lvl.layerIndex_*numLayerChunks;
+    for (int i = 0; i < numLayerChunks; i++) {
+        outfile_.write(&encoded[i][0], encoded[i].size());
+        lvl.chunkOffsets_[firstChunk + i] = fileOffset_;
+        lvl.chunkSizes_[firstChunk + i] = encoded[i].size();
+        fileOffset_ += encoded[i].size();
+    }
+}
+
+void ChunkStreamWriter::halfsampleSlicePair(size_t level) {
+    tgtAssert(level+1 < levels_.size(), "no next level");
+    Volume* halfsampled = VolumeOperatorHalfsample::APPLY_OP(levels_[level].slicePairHandle_);
+    if (!halfsampled)
+        throw VoreenException("Failed to halfsample slices of resolution level " + itos(level));
+
+    try {
+        const VolumeRAM* slice = halfsampled->getRepresentation<VolumeRAM>();
+        tgtAssert(slice && slice->getDimensions() == svec3(levels_[level+1].dimensions_.x, levels_[level+1].dimensions_.y, 1),
+                  "unexpected dimensions of halfsampled slice");
+        addSlices(level+1, reinterpret_cast<const char*>(slice->getData()), 1);
+    }
+    catch (...) {
+        delete halfsampled;
+        throw;
+    }
+    delete halfsampled;
+}
+
+void ChunkStreamWriter::writeIndex() {
+    for (size_t l = 0; l < levels_.size(); l++) {
+        const LevelState& level = levels_[l];
+        tgtAssert(level.layerIndex_ == level.numChunks_.z, "level not complete");
+        writeValue<uint64_t>(outfile_, level.dimensions_.x);
+        writeValue<uint64_t>(outfile_, level.dimensions_.y);
+        writeValue<uint64_t>(outfile_, level.dimensions_.z);
+        for (size_t i = 0; i < level.chunkOffsets_.size(); i++) {
+            writeValue<uint64_t>(outfile_, level.chunkOffsets_[i]);
+            writeValue<uint64_t>(outfile_, level.chunkSizes_[i]);
+        }
+    }
+}
+
+uint64_t ChunkStreamWriter::getIndexOffset() const {
+    return fileOffset_;
+}
+
+} // namespace
+
+const std::string VolumeDiskChunked::loggerCat_("voreen.VolumeDiskChunked");
+const size_t VolumeDiskChunked::DEFAULT_CHUNK_SIZE;
+
+VolumeDiskChunked::VolumeDiskChunked(const std::string& filename, const std::string& format, tgt::svec3 dimensions)
+        throw (tgt::FileException)
+    : VolumeDisk(format, dimensions)
+    , filename_(filename)
+    , chunkDim_(svec3::zero)
+    , bytesPerValue_(0)
+{
+    readIndex();
+}
+
+VolumeDiskChunked::~VolumeDiskChunked() {
+}
+
+size_t VolumeDiskChunked::getNumLevels() const {
+    return levels_.size();
+}
+
+tgt::svec3 VolumeDiskChunked::getLevelDimensions(size_t level) const {
+    tgtAssert(level < levels_.size(), "invalid level");
+    return levels_[level].dimensions_;
+}
+
+std::string VolumeDiskChunked::getHash() const {
+    std::string configStr = getFileName() + "#";
+    configStr += genericToString(tgt::FileSystem::fileTime(getFileName())) + "#";
+    configStr += genericToString(tgt::FileSystem::fileSize(getFileName())) + "#";
+    configStr += getFormat() + "#";
+    configStr += genericToString(getDimensions()) + "#";
+    configStr += "chunked";
+
+    return VoreenHash::getHash(configStr);
+}
+
+VolumeRAM* VolumeDiskChunked::loadVolume() const
+    throw (tgt::Exception)
+{
+    LDEBUG("Creating volume from chunk file " << getFileName() << " format: " << getFormat());
+    return loadBrick(0, svec3::zero, getDimensions());
+}
+
+VolumeRAM* VolumeDiskChunked::loadSlices(const size_t firstSlice, const size_t lastSlice) const
+    throw (tgt::Exception)
+{
+    if (getDimensions().z <= lastSlice)
+        throw std::invalid_argument("lastSlice is out of volume dimension!!!");
+    if (firstSlice > lastSlice)
+        throw std::invalid_argument("firstSlice has to be less or equal lastSlice!!!");
+
+    return loadBrick(0, svec3(0, 0, firstSlice), svec3(getDimensions().x, getDimensions().y, lastSlice-firstSlice+1));
+}
+
+VolumeRAM* VolumeDiskChunked::loadBrick(const tgt::svec3& offset, const tgt::svec3& dimensions) const
+    throw (tgt::Exception)
+{
+    return loadBrick(0, offset, dimensions);
+}
+
+VolumeRAM* VolumeDiskChunked::loadBrick(size_t level, const tgt::svec3& brickOffset, const tgt::svec3& brickDim) const
+    throw (tgt::Exception)
+{
+    // check parameters
+    if (level >= levels_.size())
+        throw std::invalid_argument("requested level does not exist");
+    const Level& lvl = levels_[level];
+    if (tgt::hmul(brickDim) == 0)
+        throw std::invalid_argument("requested brick dimensions are zero");
+    if (!tgt::hand(tgt::lessThanEqual(brickOffset+brickDim, lvl.dimensions_)))
+        throw std::invalid_argument("requested brick (at least partially) outside volume dimensions");
+
+    // create output VolumeRAM
+    VolumeFactory vf;
+    VolumeRAM* vr = 0;
+    try {
+        vr = vf.create(getFormat(), brickDim);
+    }
+    catch (std::bad_alloc&) {
+        throw tgt::Exception("bad allocation");
+    }
+    if (!vr)
+        throw VoreenException("Failed to create VolumeRAM");
+
+    // determine the chunks touching the brick
+    const svec3 firstChunk = brickOffset / chunkDim_;
+    const svec3 lastChunk = (brickOffset + brickDim - svec3(1)) / chunkDim_;
+    std::vector<svec3> chunks;
+    for (size_t z = firstChunk.z; z <= lastChunk.z; z++)
+        for (size_t y = firstChunk.y; y <= lastChunk.y; y++)
+            for (size_t x = firstChunk.x; x <= lastChunk.x; x++)
+                chunks.push_back(svec3(x, y, z));
+
+    // read and decode the chunks and copy their intersection with the brick into the output volume
+    const size_t bytesPerVoxel = getBytesPerVoxel();
+    char* destBuffer = reinterpret_cast<char*>(vr->getData());
+    const int numChunks = static_cast<int>(chunks.size());
+    bool failed = false;
+#ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel
+#endif
+    {
+        std::ifstream infile(getFileName().c_str(), std::ios::in | std::ios::binary);
+        std::vector<char> encoded;
+        std::vector<char> decoded;
+
+#ifdef VRN_MODULE_OPENMP
+        #pragma omp for schedule(dynamic, 1)
+#endif
+        for (int i = 0; i < numChunks; i++) {
+            const svec3& chunk = chunks[i];
+            const ChunkEntry& entry = lvl.chunks_[(chunk.z*lvl.numChunks_.y + chunk.y)*lvl.numChunks_.x + chunk.x];
+            const svec3 chunkOffset = chunk*chunkDim_;
+            const svec3 curChunkDim = tgt::min(chunkDim_, lvl.dimensions_ - chunkOffset);
+            const size_t numChunkBytes = tgt::hmul(curChunkDim)*bytesPerVoxel;
+
+            encoded.resize(static_cast<size_t>(entry.size_));
+            decoded.resize(numChunkBytes);
+            infile.seekg(static_cast<std::streamoff>(entry.offset_));
+            infile.read(&encoded[0], encoded.size());
+            if (infile.fail() || !decodeChunk(&encoded[0], encoded.size(), numChunkBytes, bytesPerValue_, &decoded[0])) {
+                infile.clear();
+#ifdef VRN_MODULE_OPENMP
+                #pragma omp critical(VolumeDiskChunked_failed)
+#endif
+                failed = true;
+                continue;
+            }
+
+            const svec3 regionLlf = tgt::max(brickOffset, chunkOffset);
+            const svec3 regionUrb = tgt::min(brickOffset + brickDim, chunkOffset + curChunkDim);
+            copyRegion(&decoded[0], curChunkDim, regionLlf - chunkOffset,
+                       destBuffer, brickDim, regionLlf - brickOffset,
+                       regionUrb - regionLlf, bytesPerVoxel);
+        }
+    }
+
+    if (failed) {
+        delete vr;
+        throw tgt::FileException("Failed to read chunks from file: " + getFileName());
+    }
+
+    return vr;
+}
+
+void VolumeDiskChunked::readIndex()
+    throw (tgt::FileException)
+{
+    std::ifstream infile(getFileName().c_str(), std::ios::in | std::ios::binary);
+    if (infile.fail())
+        throw tgt::FileException("Failed to open chunk file for reading: " + getFileName());
+
+    char magic[sizeof(CHUNK_FILE_MAGIC)];
+    infile.read(magic, sizeof(magic));
+    const uint32_t version = readValue<uint32_t>(infile);
+    const uint32_t bytesPerVoxel = readValue<uint32_t>(infile);
+    bytesPerValue_ = readValue<uint32_t>(infile);
+    chunkDim_.x = readValue<uint32_t>(infile);
+    chunkDim_.y = readValue<uint32_t>(infile);
+    chunkDim_.z = readValue<uint32_t>(infile);
+    const uint32_t numLevels = readValue<uint32_t>(infile);
+    const uint64_t indexOffset = readValue<uint64_t>(infile);
+
+    if (infile.fail() || memcmp(magic, CHUNK_FILE_MAGIC, sizeof(magic)) != 0)
+        throw tgt::FileException("Not a chunk file: " + getFileName());
+    if (version != CHUNK_FILE_VERSION)
+        throw tgt::FileException("Unsupported chunk file version " + itos(version) + ": " + getFileName());
+    if (bytesPerVoxel != getBytesPerVoxel() || bytesPerValue_ == 0 || bytesPerVoxel % bytesPerValue_ != 0)
+        throw tgt::FileException("Chunk file does not match volume format " + getFormat() + ": " + getFileName());
+    if (tgt::hmul(chunkDim_) == 0 || numLevels == 0)
+        throw tgt::FileException("Invalid chunk file header: " + getFileName());
+
+    infile.seekg(0, std::ios::end);
+    const uint64_t fileSize = static_cast<uint64_t>(infile.tellg());
+    if (infile.fail() || indexOffset >= fileSize)
+        throw tgt::FileException("Invalid chunk index offset: " + getFileName());
+
+    // read chunk index
+    infile.seekg(static_cast<std::streamoff>(indexOffset));
+    levels_.resize(numLevels);
+    for (size_t l = 0; l < numLevels; l++) {
+        Level& level = levels_[l];
+        level.dimensions_.x = static_cast<size_t>(readValue<uint64_t>(infile));
+        level.dimensions_.y = static_cast<size_t>(readValue<uint64_t>(infile));
+        level.dimensions_.z = static_cast<size_t>(readValue<uint64_t>(infile));
+        if (infile.fail() || tgt::hmul(level.dimensions_) == 0)
+            throw tgt::FileException("Invalid chunk index: " + getFileName());
+
+        level.numChunks_ = getNumChunks(level.dimensions_, chunkDim_);
+        level.chunks_.resize(tgt::hmul(level.numChunks_));
+        for (size_t i = 0; i < level.chunks_.size(); i++) {
+            level.chunks_[i].offset_ = readValue<uint64_t>(infile);
+            level.chunks_[i].size_ = readValue<uint64_t>(infile);
+        }
+        if (infile.fail())
+            throw tgt::FileException("Failed to read chunk index: " + getFileName());
+
+        // validate the entries here, since readBrick() allocates the encoded chunks within a parallel region
+        for (size_t i = 0; i < level.chunks_.size(); i++) {
+            const ChunkEntry& entry = level.chunks_[i];
+            const svec3 chunk(i % level.numChunks_.x, (i / level.numChunks_.x) % level.numChunks_.y,
+                              i / (level.numChunks_.x*level.numChunks_.y));
+            const svec3 curChunkDim = tgt::min(chunkDim_, level.dimensions_ - chunk*chunkDim_);
+            const size_t numChunkBytes = tgt::hmul(curChunkDim)*bytesPerVoxel;
+            if (entry.size_ == 0 || entry.size_ > static_cast<uint64_t>(getMaxEncodedSize(numChunkBytes, bytesPerValue_))
+                    || entry.offset_ > fileSize || entry.size_ > fileSize - entry.offset_)
+                throw tgt::FileException("Invalid chunk index entry " + itos(i) + " of level " + itos(l) + ": " + getFileName());
+        }
+    }
+
+    if (levels_.front().dimensions_ != getDimensions())
+        throw tgt::FileException("Chunk file does not match volume dimensions: " + getFileName());
+}
+
+void VolumeDiskChunked::writeChunkFile(const std::string& filename, const VolumeBase* volume, const tgt::svec3& chunkDim,
+        size_t numLevels, ProgressReporter* progressReporter)
+    throw (tgt::IOException)
+{
+    tgtAssert(volume, "null pointer passed");
+    if (tgt::hmul(chunkDim) == 0)
+        throw tgt::IOException("Chunk dimensions must not be zero");
+
+    // stream the slices from the RAM representation, if present, otherwise from the disk representation
+    const VolumeRAM* volumeRam = (volume->hasRepresentation<VolumeRAM>() ? volume->getRepresentation<VolumeRAM>() : 0);
+    const VolumeDisk* volumeDisk = (!volumeRam && volume->hasRepresentation<VolumeDisk>() ? volume->getRepresentation<VolumeDisk>() : 0);
+    if (!volumeRam && !volumeDisk)
+        volumeRam = volume->getRepresentation<VolumeRAM>();
+    if (!volumeRam && !volumeDisk)
+        throw tgt::IOException("Failed to access volume data for writing chunk file: " + filename);
+
+    const svec3 dim = volume->getDimensions();
+    const size_t bytesPerVoxel = volume->getBytesPerVoxel();
+    const size_t bytesPerValue = bytesPerVoxel / volume->getNumChannels();
+
+    // determine the dimensions of the levels, each level is halfsampled from its predecessor
+    std::vector<svec3> levelDims;
+    levelDims.push_back(dim);
+    while (true) {
+        const svec3 levelDim = levelDims.back();
+        bool addLevel = (numLevels > 0 ? levelDims.size() < numLevels :
+                         !tgt::hand(tgt::lessThanEqual(levelDim, chunkDim)));
+        if (tgt::min(levelDim) < 2 || !addLevel)
+            break;
+        levelDims.push_back(levelDim / svec3(2));
+    }
+
+    std::ofstream outfile(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (outfile.fail())
+        throw tgt::IOException("Failed to open chunk file for writing: " + filename);
+
+    // reserve space for the header, which is written when the index offset is known
+    std::vector<char> header(CHUNK_FILE_HEADER_SIZE, 0);
+    outfile.write(&header[0], header.size());
+
+    try {
+        ChunkStreamWriter writer(outfile, volume->getFormat(), levelDims, chunkDim, bytesPerVoxel, bytesPerValue);
+
+        // feed the full resolution level slab-wise, one chunk layer at a time
+        const size_t numSliceBytes = dim.x*dim.y*bytesPerVoxel;
+        for (size_t z = 0; z < dim.z; z += chunkDim.z) {
+            const size_t numSlabSlices = std::min(chunkDim.z, dim.z - z);
+            if (volumeRam) {
+                writer.addSlices(0, reinterpret_cast<const char*>(volumeRam->getData()) + z*numSliceBytes, numSlabSlices);
+            }
+            else {
+                VolumeRAM* slab = volumeDisk->loadSlices(z, z + numSlabSlices - 1);
+                try {
+                    writer.addSlices(0, reinterpret_cast<const char*>(slab->getData()), numSlabSlices);
+                }
+                catch (...) {
+                    delete slab;
+                    throw;
+                }
+                delete slab;
+            }
+
+            if (outfile.fail())
+                throw tgt::IOException("Failed to write chunks to file: " + filename);
+            if (progressReporter)
+                progressReporter->setProgress(std::min(0.99f, static_cast<float>(z + numSlabSlices) / dim.z));
+        }
+
+        writer.writeIndex();
+
+        // write header
+        outfile.seekp(0);
+        outfile.write(CHUNK_FILE_MAGIC, sizeof(CHUNK_FILE_MAGIC));
+        writeValue<uint32_t>(outfile, CHUNK_FILE_VERSION);
+        writeValue<uint32_t>(outfile, static_cast<uint32_t>(bytesPerVoxel));
+        writeValue<uint32_t>(outfile, static_cast<uint32_t>(bytesPerValue));
+        writeValue<uint32_t>(outfile, static_cast<uint32_t>(chunkDim.x));
+        writeValue<uint32_t>(outfile, static_cast<uint32_t>(chunkDim.y));
+        writeValue<uint32_t>(outfile, static_cast<uint32_t>(chunkDim.z));
+        writeValue<uint32_t>(outfile, static_cast<uint32_t>(levelDims.size()));
+        writeValue<uint64_t>(outfile, writer.getIndexOffset());
+    }
+    catch (tgt::IOException&) {
+        throw;
+    }
+    catch (std::exception& e) {
+        throw tgt::IOException("Failed to write chunk file " + filename + ": " + e.what());
+    }
+
+    if (outfile.fail())
+        throw tgt::IOException("Failed to write chunk index to file: " + filename);
+    outfile.close();
+
+    if (progressReporter)
+        progressReporter->setProgress(1.f);
+}
+
+} // namespace voreen
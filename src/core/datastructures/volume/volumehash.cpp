@@ -45,6 +45,12 @@ VolumeHash::VolumeHash(const std::string& hash) :
     setHash(hash);
 }
 
+VolumeHash::VolumeHash(const VoreenBlockHash& blockHash) :
+    VolumeDerivedData()
+{
+    setHash(blockHash.getHash());
+}
+
 VolumeDerivedData* VolumeHash::create() const {
     return new VolumeHash();
 }
@@ -62,8 +68,9 @@ VolumeDerivedData* VolumeHash::createFrom(const VolumeBase* handle) const {
 
         size_t s = v->getNumVoxels() * v->getBytesPerVoxel();
 
-        std::string h = VoreenHash::getHash(v->getData(), s);
-        return new VolumeHash(h);
+        VoreenBlockHash blockHash;
+        blockHash.compute(v->getData(), s);
+        return new VolumeHash(blockHash);
     }
     else {
         LWARNING("Unable to compute volume hash: neither disk nor ram representation available");
@@ -25,8 +25,7 @@
 
 #include "voreen/core/datastructures/volume/volumeminmax.h"
 
-#include "voreen/core/datastructures/volume/volumeram.h"
-#include "voreen/core/datastructures/volume/volumedisk.h"
+#include "voreen/core/datastructures/volume/volumederiveddataengine.h"
 
 namespace voreen {
 
@@ -69,62 +68,7 @@ VolumeDerivedData* VolumeMinMax::create() const {
 
 VolumeDerivedData* VolumeMinMax::createFrom(const VolumeBase* handle) const {
     tgtAssert(handle, "no volume");
-
-    std::vector<float> tMinValues;
-    std::vector<float> tMaxValues;
-    std::vector<float> tMinNormValues;
-    std::vector<float> tMaxNormValues;
-
-    for (size_t i=0; i<handle->getNumChannels(); i++) {
-        // use RAM representation only if already present,
-        // otherwise use disk representation, if available
-        float minNorm = 0.f;
-        float maxNorm = 1.f;
-        if (handle->hasRepresentation<VolumeRAM>()) {
-            const VolumeRAM* v = handle->getRepresentation<VolumeRAM>();
-            tgtAssert(v, "no volume");
-
-            minNorm = v->minNormalizedValue();
-            maxNorm = v->maxNormalizedValue();
-        }
-        else if (handle->hasRepresentation<VolumeDisk>()) {
-            const VolumeDisk* volumeDisk = handle->getRepresentation<VolumeDisk>();
-            tgtAssert(volumeDisk, "no disk volume");
-
-            minNorm = FLT_MAX;
-            maxNorm = -FLT_MAX;
-
-            // compute min/max values slice-wise
-            size_t numSlices = handle->getDimensions().z;
-            tgtAssert(numSlices > 0, "empty volume");
-            for (size_t i=0; i<numSlices; i++) {
-                try {
-                    VolumeRAM* sliceVolume = volumeDisk->loadSlices(i, i);
-                    minNorm = std::min(minNorm, sliceVolume->minNormalizedValue());
-                    maxNorm = std::max(maxNorm, sliceVolume->maxNormalizedValue());
-                    delete sliceVolume;
-                }
-                catch (tgt::Exception& e) {
-                    LWARNING("Unable to compute min/max values: failed to load slice from disk volume: " << e.what());
-                    break;
-                }
-            }
-        }
-        else {
-            LWARNING("Unable to compute min/max values: neither disk nor ram representation available");
-        }
-        tgtAssert(minNorm <= maxNorm, "invalid min/max values");
-
-        float min = handle->getRealWorldMapping().normalizedToRealWorld(minNorm);
-        float max = handle->getRealWorldMapping().normalizedToRealWorld(maxNorm);
-
-        tMinValues.push_back(min);
-        tMaxValues.push_back(max);
-        tMinNormValues.push_back(minNorm);
-        tMaxNormValues.push_back(maxNorm);
-    }
-
-    return new VolumeMinMax(tMinValues, tMaxValues, tMinNormValues, tMaxNormValues);
+    return VolumeDerivedDataEngine::createDerivedData(handle, getClassName());
 }
 
 size_t VolumeMinMax::getNumChannels() const {
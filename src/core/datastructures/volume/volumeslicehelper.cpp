@@ -33,9 +33,9 @@
 #include "voreen/core/datastructures/volume/volumeatomic.h"
 #include "voreen/core/datastructures/octree/volumeoctreebase.h"
 #include "voreen/core/datastructures/volume/operators/volumeoperatorresample.h"
-#include "voreen/core/utils/hashing.h"
 
 #include <boost/thread/locks.hpp>
+#include <boost/bind.hpp>
 
 namespace voreen {
 
@@ -182,6 +182,91 @@ void VolumeSliceGL::createTexture() const {
 
 //-------------------------------------------------------------------------------------------------
 
+namespace {
+
+/// Samples a volume at voxel coordinates via the generic VolumeRAM interface.
+struct GenericSliceSampler {
+    GenericSliceSampler(const VolumeRAM* volume) : volume_(volume) {}
+
+    float operator()(const vec3& pos) const {
+        return volume_->getVoxelNormalizedLinear(pos);
+    }
+
+    const VolumeRAM* volume_;
+};
+
+/// Trilinear sampling of the first channel as in VolumeRAM::getVoxelNormalizedLinear(), but without virtual calls.
+template<typename T>
+struct TypedSliceSampler {
+    TypedSliceSampler(const VolumeAtomic<T>* volume)
+        : data_(volume->voxel())
+        , dims_(volume->getDimensions())
+        , maxIndex_(volume->getDimensions() - tgt::svec3(1))
+    {}
+
+    inline float value(size_t x, size_t y, size_t z) const {
+        return getTypeAsFloat(VolumeElement<T>::getChannel(data_[(z*dims_.y + y)*dims_.x + x], 0));
+    }
+
+    float operator()(const vec3& pos) const {
+        vec3 posAbs = tgt::max(pos - 0.5f, vec3(0.0f));
+        vec3 p = posAbs - floor(posAbs); // get decimal part
+        tgt::svec3 llb = tgt::min(tgt::svec3(posAbs), maxIndex_);
+        tgt::svec3 urf = tgt::min(tgt::svec3(ceil(posAbs)), maxIndex_);
+
+        float back  = (value(llb.x, llb.y, llb.z) * (1.f-p.x) + value(urf.x, llb.y, llb.z) * p.x) * (1.f-p.y)
+                    + (value(llb.x, urf.y, llb.z) * (1.f-p.x) + value(urf.x, urf.y, llb.z) * p.x) * p.y;
+        float front = (value(llb.x, llb.y, urf.z) * (1.f-p.x) + value(urf.x, llb.y, urf.z) * p.x) * (1.f-p.y)
+                    + (value(llb.x, urf.y, urf.z) * (1.f-p.x) + value(urf.x, urf.y, urf.z) * p.x) * p.y;
+        return back * (1.f-p.z) + front * p.z;
+    }
+
+    const T* data_;
+    tgt::svec3 dims_;
+    tgt::svec3 maxIndex_;
+};
+
+/**
+ * Fills the row-major buffer by sampling the positions origin + x*stepX + y*stepY (voxel coordinates).
+ * Positions outside the volume are set to zero. The rows are sampled in parallel.
+ */
+template<typename Sampler>
+void sampleSlice(const Sampler& sampler, const vec3& dims, float* buffer, const ivec2& res,
+    const vec3& origin, const vec3& stepX, const vec3& stepY)
+{
+    #ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+    #endif
+    for (int y = 0; y < res.y; y++) {
+        float* row = buffer + static_cast<size_t>(y) * res.x;
+        vec3 rowOrigin = origin + static_cast<float>(y) * stepY;
+        for (int x = 0; x < res.x; x++) {
+            vec3 pos = rowOrigin + static_cast<float>(x) * stepX;
+            if (hand(greaterThanEqual(pos, vec3(0.0f))) && hand(lessThanEqual(pos, dims)))
+                row[x] = sampler(pos);
+            else
+                row[x] = 0.0f;
+        }
+    }
+}
+
+/// Samples the slice, if the volume is of type VolumeAtomic<T>.
+template<typename T>
+bool sampleSliceTyped(const VolumeRAM* volume, float* buffer, const ivec2& res,
+    const vec3& origin, const vec3& stepX, const vec3& stepY)
+{
+    const VolumeAtomic<T>* typedVolume = dynamic_cast<const VolumeAtomic<T>*>(volume);
+    if (!typedVolume)
+        return false;
+
+    sampleSlice(TypedSliceSampler<T>(typedVolume), vec3(volume->getDimensions()), buffer, res, origin, stepX, stepY);
+    return true;
+}
+
+} // namespace
+
+//-------------------------------------------------------------------------------------------------
+
 const std::string VolumeSliceHelper::loggerCat_("voreen.VolumeSliceHelper");
 
 VolumeSliceGL* VolumeSliceHelper::getVolumeSlice(const VolumeBase* vh, SliceAlignment alignment, size_t sliceIndex,
@@ -541,35 +626,34 @@ VolumeSliceGL* VolumeSliceHelper::getVolumeSlice(const VolumeBase* vh, tgt::plan
     vec3 xVec = maxVec * (sp.x * res.x);
     vec3 yVec = temp * (sp.y * res.y);
 
-    LGL_ERROR;
-    tgt::Texture* tex = new tgt::Texture(tgt::ivec3(res, 1), GL_ALPHA, GL_ALPHA32F_ARB, GL_FLOAT, tgt::Texture::LINEAR); //TODO: make dependent on input, add support for multiple channels
-    LGL_ERROR;
     vec3 fetchX = normalize(xVec) * sp.x;
     vec3 fetchY = normalize(yVec) * sp.y;
     vec3 fetchOrigin = origin + (0.5f * fetchX) + (0.5f * fetchY);
+
+    // the world-to-voxel mapping is affine, so the sampling grid can be transformed once
     mat4 wToV = vh->getWorldToVoxelMatrix();
-    vec3 dims = vh->getDimensions();
-    for(int x=0; x<res.x; x++) {
-        for(int y=0; y<res.y; y++) {
-            vec3 pos = fetchOrigin + ((float)x * fetchX) + ((float)y * fetchY);
-            pos = wToV * pos;
-            float valueFloat = 0.0f;
-            if(hand(greaterThanEqual(pos, vec3(0.0f))) && hand(lessThanEqual(pos, dims)))
-                valueFloat = vol->getVoxelNormalizedLinear(pos);
-            //uint8_t value = tgt::iround(valueFloat * 255.0f);
-
-            tex->texel<float>(x, y) = valueFloat;
-            //tex->texel<tgt::col4>(x, y) = tgt::col4(value);
-            //tex->texel<tgt::col4>(x, y) = tgt::col4(128);
-            //tex->texel<tgt::col4>(x, y) = tgt::col4(x);
-        }
+    vec3 voxelOrigin = wToV * fetchOrigin;
+    vec3 voxelStepX = (wToV * (fetchOrigin + fetchX)) - voxelOrigin;
+    vec3 voxelStepY = (wToV * (fetchOrigin + fetchY)) - voxelOrigin;
+
+    float* dataBuffer = new float[tgt::hmul(res)]; //TODO: make dependent on input, add support for multiple channels
+    if (!sampleSliceTyped<uint8_t>(vol, dataBuffer, res, voxelOrigin, voxelStepX, voxelStepY) &&
+        !sampleSliceTyped<int8_t>(vol, dataBuffer, res, voxelOrigin, voxelStepX, voxelStepY) &&
+        !sampleSliceTyped<uint16_t>(vol, dataBuffer, res, voxelOrigin, voxelStepX, voxelStepY) &&
+        !sampleSliceTyped<int16_t>(vol, dataBuffer, res, voxelOrigin, voxelStepX, voxelStepY) &&
+        !sampleSliceTyped<uint32_t>(vol, dataBuffer, res, voxelOrigin, voxelStepX, voxelStepY) &&
+        !sampleSliceTyped<int32_t>(vol, dataBuffer, res, voxelOrigin, voxelStepX, voxelStepY) &&
+        !sampleSliceTyped<float>(vol, dataBuffer, res, voxelOrigin, voxelStepX, voxelStepY) &&
+        !sampleSliceTyped<double>(vol, dataBuffer, res, voxelOrigin, voxelStepX, voxelStepY))
+    {
+        // multi-channel volumes: first channel via the (slower) generic interface
+        sampleSlice(GenericSliceSampler(vol), vec3(vol->getDimensions()), dataBuffer, res, voxelOrigin, voxelStepX, voxelStepY);
     }
-    LGL_ERROR;
-    tex->uploadTexture();
-    LGL_ERROR;
-    return new VolumeSliceGL(tex->getDimensions().xy(), UNALIGNED_PLANE, vh->getFormat(), vh->getBaseType(),
+
+    // the texture is created on first use, i.e., in the rendering thread
+    return new VolumeSliceGL(tgt::svec2(res), UNALIGNED_PLANE, vh->getFormat(), vh->getBaseType(),
         origin, xVec, yVec, vh->getRealWorldMapping(),
-        tex);
+        dataBuffer, GL_ALPHA, GL_ALPHA32F_ARB, GL_FLOAT);
 }
 
 template<typename T>
@@ -979,47 +1063,11 @@ TriangleMeshGeometryVec3* VolumeSliceHelper::getSliceGeometry(const VolumeBase*
 //------------------------------------------------------------------------------------------------
 // Slice Cache
 
-class SliceCreationBackgroundThread : public BackgroundThread {
-public:
-    SliceCreationBackgroundThread(Processor* processor, const VolumeSliceCache* sliceCache,
-           const VolumeBase* volume, SliceAlignment alignment, size_t sliceIndex,
-            size_t levelOfDetail, const std::string& hash)
-        //: ProcessorBackgroundThread(processor)
-        : BackgroundThread()
-        , sliceCache_(sliceCache)
-        , volume_(volume)
-        , alignment_(alignment)
-        , sliceIndex_(sliceIndex)
-        , levelOfDetail_(levelOfDetail)
-        , hash_(hash)
-    {
-        //tgtAssert(processor_, "null pointer passed as processor");
-        tgtAssert(volume_, "null pointer passed as volume");
-        tgtAssert(!hash_.empty(), "passed hash is empty");
-    }
-
-    virtual void threadMain() {
-        VolumeSliceGL* slice = VolumeSliceHelper::getVolumeSlice(volume_, alignment_, sliceIndex_, levelOfDetail_);
-
-        if (slice) {
-            sliceCache_->addSliceToCache(slice, hash_);
-        }
-    }
-
-    const VolumeSliceCache* sliceCache_;
-
-    const VolumeBase* volume_;
-    SliceAlignment alignment_;
-    size_t sliceIndex_;
-    size_t levelOfDetail_;
-    std::string hash_;
-
-}; // SliceCreationBackgroundThread
-
-VolumeSliceCache::VolumeSliceCache(Processor* owner, size_t cacheSize)
+VolumeSliceCache::VolumeSliceCache(Processor* owner, size_t cacheSize, size_t numPrefetchThreads)
     : owner_(owner)
     , cacheSize_(cacheSize)
-    , currentBackgroundThread_(0)
+    , numPrefetchThreads_(numPrefetchThreads)
+    , stopPrefetching_(false)
 {
     tgtAssert(owner_, "null pointer passed");
 }
@@ -1033,26 +1081,30 @@ size_t VolumeSliceCache::getCacheSize() const {
 }
 
 void VolumeSliceCache::setCacheSize(size_t cacheSize) {
+    boost::lock_guard<boost::mutex> lock(cacheAccessMutex_);
     cacheSize_ = cacheSize;
-    while (slices_.size() > cacheSize_) {
-        delete slices_.back().slice_;
-        slices_.pop_back();
-    }
+    cleanupCache();
 }
 
 void VolumeSliceCache::clear() {
-    boost::lock_guard<boost::mutex> lock(cacheAccessMutex_);
+    stopPrefetchThreads();
 
-    if (currentBackgroundThread_ && currentBackgroundThread_->isRunning())
-        currentBackgroundThread_->interruptAndJoin();
-    delete currentBackgroundThread_;
-    currentBackgroundThread_ = 0;
-
-    for (std::list<CacheEntry>::iterator it = slices_.begin(); it != slices_.end(); ++it) {
+    boost::lock_guard<boost::mutex> lock(cacheAccessMutex_);
+    for (CacheList::iterator it = slices_.begin(); it != slices_.end(); ++it) {
         tgtAssert(it->slice_, "cache entry does not store slice");
         delete it->slice_;
     }
     slices_.clear();
+    sliceMap_.clear();
+}
+
+size_t VolumeSliceCache::getNumPrefetchThreads() const {
+    return numPrefetchThreads_;
+}
+
+void VolumeSliceCache::setNumPrefetchThreads(size_t numThreads) {
+    stopPrefetchThreads();
+    numPrefetchThreads_ = numThreads;
 }
 
 VolumeSliceGL* VolumeSliceCache::getVolumeSlice(const VolumeBase* volume, SliceAlignment alignment, size_t sliceIndex,
@@ -1060,44 +1112,41 @@ VolumeSliceGL* VolumeSliceCache::getVolumeSlice(const VolumeBase* volume, SliceA
 {
     tgtAssert(volume, "null pointer passed");
 
-    std::string hash = getHash(volume, alignment, sliceIndex, levelOfDetail);
+    SliceKey key = getKey(volume, alignment, sliceIndex, levelOfDetail);
 
     // check if slice is present in cache, otherwise create it and add it to cache (if complete)
-    VolumeSliceGL* slice = findSliceInCache(hash, true);
+    boost::unique_lock<boost::mutex> lock(cacheAccessMutex_);
+    cleanupCache();
+    VolumeSliceGL* slice = findSliceInCache(key, true);
     bool sliceComplete = true;
 
     if (!slice) {
-
-        if (!asynchronous) { // create slice synchronously
-            slice = VolumeSliceHelper::getVolumeSlice(volume, alignment, sliceIndex, levelOfDetail, timeLimit, &sliceComplete);
-            if (slice && sliceComplete) {
-                addSliceToCache(slice, hash);
-                cleanupCache();
-                tgtAssert(slices_.size() <= cacheSize_, "invalid cache size");
-            }
+        if (asynchronous && numPrefetchThreads_ > 0) { // create slice in background thread
+            if (!isRequestRunning(key))
+                enqueueRequest(volume, key, false);
+            sliceComplete = false;
         }
-        else { // create slice in background thread
-            bool sliceCurrentlyCreated = currentBackgroundThread_ && currentBackgroundThread_->hash_ == hash;
-            if (!sliceCurrentlyCreated) {
-
-                // interrupt/delete current thread
-                if (currentBackgroundThread_) {
-                    if (currentBackgroundThread_->isRunning()) {
-                        currentBackgroundThread_->interruptAndJoin();
-                    }
-                    delete currentBackgroundThread_;
-                    currentBackgroundThread_ = 0;
-                }
+        else {
+            // a worker thread might already create the slice: wait for it instead of creating it a second time
+            while (isRequestRunning(key))
+                requestFinishedCond_.wait(lock);
+            slice = findSliceInCache(key, true);
+        }
+    }
 
-                cleanupCache();
+    if (!slice && sliceComplete) { // create slice synchronously
+        removePendingRequest(key);
+        lock.unlock();
+        slice = VolumeSliceHelper::getVolumeSlice(volume, alignment, sliceIndex, levelOfDetail, timeLimit, &sliceComplete);
+        lock.lock();
 
-                // start new thread
-                currentBackgroundThread_ = new SliceCreationBackgroundThread(owner_, this, volume, alignment, sliceIndex, levelOfDetail, hash);
-                currentBackgroundThread_->run();
+        if (slice && sliceComplete && cacheSize_ > 0) {
+            if (!addSliceToCache(slice, key)) {
+                delete slice;
+                slice = findSliceInCache(key, true);
             }
-
-            sliceComplete = false;
-            slice = 0;
+            cleanupCache();
+            tgtAssert(slices_.size() <= cacheSize_, "invalid cache size");
         }
     }
 
@@ -1110,15 +1159,35 @@ VolumeSliceGL* VolumeSliceCache::getVolumeSlice(const VolumeBase* volume, SliceA
 VolumeSliceGL* VolumeSliceCache::getVolumeSlice(const VolumeBase* volume, tgt::plane pl, float samplingRate, bool asynchronous) const {
     tgtAssert(volume, "null pointer passed");
 
-    std::string hash = getHash(volume, pl, samplingRate);
+    SliceKey key = getKey(volume, pl, samplingRate);
 
     // check if slice is present in cache, otherwise create it and add it to cache
-    VolumeSliceGL* slice = findSliceInCache(hash, true);
+    boost::unique_lock<boost::mutex> lock(cacheAccessMutex_);
+    cleanupCache();
+    VolumeSliceGL* slice = findSliceInCache(key, true);
+
+    if (!slice && asynchronous && numPrefetchThreads_ > 0) {
+        if (!isRequestRunning(key))
+            enqueueRequest(volume, key, false);
+        return 0;
+    }
+
+    while (!slice && isRequestRunning(key)) {
+        requestFinishedCond_.wait(lock);
+        slice = findSliceInCache(key, true);
+    }
 
     if (!slice) {
+        removePendingRequest(key);
+        lock.unlock();
         slice = VolumeSliceHelper::getVolumeSlice(volume, pl, samplingRate);
-        if (slice) {
-            addSliceToCache(slice, hash);
+        lock.lock();
+
+        if (slice && cacheSize_ > 0) {
+            if (!addSliceToCache(slice, key)) {
+                delete slice;
+                slice = findSliceInCache(key, true);
+            }
             cleanupCache();
             tgtAssert(slices_.size() <= cacheSize_, "invalid cache size");
         }
@@ -1127,76 +1196,283 @@ VolumeSliceGL* VolumeSliceCache::getVolumeSlice(const VolumeBase* volume, tgt::p
     return slice;
 }
 
-// private
+bool VolumeSliceCache::hasSliceInCache(const VolumeBase* volume, SliceAlignment alignment, size_t sliceIndex, size_t levelOfDetail /*= 0*/) const {
+    SliceKey key = getKey(volume, alignment, sliceIndex, levelOfDetail);
+    boost::lock_guard<boost::mutex> lock(cacheAccessMutex_);
+    return (findSliceInCache(key, false) != 0);
+}
 
-void VolumeSliceCache::addSliceToCache(VolumeSliceGL* slice, const std::string& hash) const {
+bool VolumeSliceCache::hasSliceInCache(const VolumeBase* volume, tgt::plane pl, float samplingRate) const {
+    SliceKey key = getKey(volume, pl, samplingRate);
     boost::lock_guard<boost::mutex> lock(cacheAccessMutex_);
+    return (findSliceInCache(key, false) != 0);
+}
 
-    tgtAssert(slice, "null pointer passed");
-    tgtAssert(!hash.empty(), "hash is empty");
+void VolumeSliceCache::prefetchSlices(const VolumeBase* volume, SliceAlignment alignment, size_t sliceIndex, int direction,
+    size_t numSlices, size_t levelOfDetail) const
+{
+    tgtAssert(volume, "null pointer passed");
+    tgtAssert(alignment != UNALIGNED_PLANE, "invalid alignment");
+    if (numPrefetchThreads_ == 0 || direction == 0)
+        return;
 
-    if (cacheSize_ == 0)
+    // do not let the prefetched slices evict the slices currently in use
+    numSlices = std::min(numSlices, cacheSize_ / 2);
+    const size_t numVolumeSlices = volume->getDimensions()[alignment];
+    std::vector<SliceKey> keys;
+    for (size_t i = 1; i <= numSlices; i++) {
+        int index = static_cast<int>(sliceIndex) + direction*static_cast<int>(i);
+        if (index < 0 || index >= static_cast<int>(numVolumeSlices))
+            break;
+        keys.push_back(getKey(volume, alignment, static_cast<size_t>(index), levelOfDetail));
+    }
+
+    boost::lock_guard<boost::mutex> lock(cacheAccessMutex_);
+    discardPrefetchRequests();
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (!findSliceInCache(keys[i], false) && !isRequestRunning(keys[i]))
+            enqueueRequest(volume, keys[i], true);
+    }
+}
+
+void VolumeSliceCache::prefetchSlices(const VolumeBase* volume, tgt::plane pl, float samplingRate, float planeDistance,
+    size_t numSlices) const
+{
+    tgtAssert(volume, "null pointer passed");
+    if (numPrefetchThreads_ == 0 || planeDistance == 0.f)
         return;
 
+    numSlices = std::min(numSlices, cacheSize_ / 2);
+    std::vector<SliceKey> keys;
+    for (size_t i = 1; i <= numSlices; i++) {
+        tgt::plane neighbor(pl.n, pl.d + planeDistance*static_cast<float>(i));
+        keys.push_back(getKey(volume, neighbor, samplingRate));
+    }
+
+    boost::lock_guard<boost::mutex> lock(cacheAccessMutex_);
+    discardPrefetchRequests();
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (!findSliceInCache(keys[i], false) && !isRequestRunning(keys[i]))
+            enqueueRequest(volume, keys[i], true);
+    }
+}
+
+void VolumeSliceCache::volumeDelete(const VolumeBase* source) {
+    discardRequests(source);
+}
+
+void VolumeSliceCache::volumeChange(const VolumeBase* source) {
+    discardRequests(source);
+}
+
+// private
+
+bool VolumeSliceCache::SliceKey::operator<(const SliceKey& other) const {
+    if (alignment_ != other.alignment_)
+        return alignment_ < other.alignment_;
+    if (sliceIndex_ != other.sliceIndex_)
+        return sliceIndex_ < other.sliceIndex_;
+    if (levelOfDetail_ != other.levelOfDetail_)
+        return levelOfDetail_ < other.levelOfDetail_;
+    if (samplingRate_ != other.samplingRate_)
+        return samplingRate_ < other.samplingRate_;
+    for (size_t i = 0; i < 4; i++) {
+        if (plane_[i] != other.plane_[i])
+            return plane_[i] < other.plane_[i];
+    }
+    return volumeHash_ < other.volumeHash_;
+}
+
+bool VolumeSliceCache::SliceKey::operator==(const SliceKey& other) const {
+    return !(*this < other) && !(other < *this);
+}
+
+VolumeSliceCache::SliceKey VolumeSliceCache::getKey(const VolumeBase* volume, SliceAlignment alignment, size_t sliceIndex,
+    size_t levelOfDetail) const
+{
+    SliceKey key;
+    key.volumeHash_ = volume->getHash();
+    key.alignment_ = alignment;
+    key.sliceIndex_ = sliceIndex;
+    key.levelOfDetail_ = levelOfDetail;
+    key.plane_ = tgt::vec4(0.f);
+    key.samplingRate_ = 0.f;
+    return key;
+}
+
+VolumeSliceCache::SliceKey VolumeSliceCache::getKey(const VolumeBase* volume, tgt::plane pl, float samplingRate) const {
+    SliceKey key;
+    key.volumeHash_ = volume->getHash();
+    key.alignment_ = UNALIGNED_PLANE;
+    key.sliceIndex_ = 0;
+    key.levelOfDetail_ = 0;
+    key.plane_ = tgt::vec4(pl.n, pl.d);
+    key.samplingRate_ = samplingRate;
+    return key;
+}
+
+void VolumeSliceCache::enqueueRequest(const VolumeBase* volume, const SliceKey& key, bool prefetch) const {
+    for (size_t i = 0; i < requestQueue_.size(); i++) {
+        if (requestQueue_[i].key_ == key)
+            return;
+    }
+
+    // discard the pending requests, if the volume is deleted
+    if (!observes(volume))
+        volume->addObserver(this);
+
+    startPrefetchThreads();
+    SliceRequest request;
+    request.volume_ = volume;
+    request.key_ = key;
+    request.prefetch_ = prefetch;
+    if (prefetch)
+        requestQueue_.push_back(request);
+    else
+        requestQueue_.push_front(request);
+    prefetchCond_.notify_one();
+}
+
+bool VolumeSliceCache::addSliceToCache(VolumeSliceGL* slice, const SliceKey& key) const {
+    tgtAssert(slice, "null pointer passed");
+
+    if (cacheSize_ == 0 || sliceMap_.find(key) != sliceMap_.end())
+        return false;
+
     CacheEntry entry;
-    entry.hash_ = hash;
+    entry.key_ = key;
     entry.slice_ = slice;
     slices_.push_front(entry);
+    sliceMap_[key] = slices_.begin();
+    return true;
 }
 
-
 void VolumeSliceCache::cleanupCache() const {
-    boost::lock_guard<boost::mutex> lock(cacheAccessMutex_);
-
     while (slices_.size() > cacheSize_) {
+        sliceMap_.erase(slices_.back().key_);
         delete slices_.back().slice_;
         slices_.pop_back();
     }
     tgtAssert(slices_.size() <= cacheSize_, "invalid cache size");
 }
 
-VolumeSliceGL* VolumeSliceCache::findSliceInCache(const std::string& hash, bool updateUsage) const {
-    boost::lock_guard<boost::mutex> lock(cacheAccessMutex_);
+VolumeSliceGL* VolumeSliceCache::findSliceInCache(const SliceKey& key, bool updateUsage) const {
+    std::map<SliceKey, CacheList::iterator>::iterator it = sliceMap_.find(key);
+    if (it == sliceMap_.end())
+        return 0;
 
-    tgtAssert(!hash.empty(), "hash is empty");
-    for (std::list<CacheEntry>::iterator it = slices_.begin(); it != slices_.end(); ++it) {
-        if (it->hash_ == hash) {
-            CacheEntry entry = *it;
-            if (updateUsage) { // move found entry to front
-                slices_.erase(it);
-                slices_.push_front(entry);
-            }
-            tgtAssert(entry.slice_, "cache entry does not contain slice");
-            return entry.slice_;
+    if (updateUsage) // move found entry to front
+        slices_.splice(slices_.begin(), slices_, it->second);
+    tgtAssert(it->second->slice_, "cache entry does not contain slice");
+    return it->second->slice_;
+}
+
+bool VolumeSliceCache::isRequestRunning(const SliceKey& key) const {
+    for (size_t i = 0; i < runningRequests_.size(); i++) {
+        if (runningRequests_[i].key_ == key)
+            return true;
+    }
+    return false;
+}
+
+void VolumeSliceCache::removePendingRequest(const SliceKey& key) const {
+    for (std::deque<SliceRequest>::iterator it = requestQueue_.begin(); it != requestQueue_.end(); ++it) {
+        if (it->key_ == key) {
+            requestQueue_.erase(it);
+            return;
         }
     }
-    return 0;
 }
 
-bool VolumeSliceCache::hasSliceInCache(const VolumeBase* volume, SliceAlignment alignment, size_t sliceIndex, size_t levelOfDetail /*= 0*/) const {
-    return (findSliceInCache(getHash(volume, alignment, sliceIndex, levelOfDetail), false) != 0);
+void VolumeSliceCache::discardPrefetchRequests() const {
+    std::deque<SliceRequest>::iterator it = requestQueue_.begin();
+    while (it != requestQueue_.end()) {
+        if (it->prefetch_)
+            it = requestQueue_.erase(it);
+        else
+            ++it;
+    }
 }
 
-bool VolumeSliceCache::hasSliceInCache(const VolumeBase* volume, tgt::plane pl, float samplingRate) const {
-    return (findSliceInCache(getHash(volume, pl, samplingRate), false) != 0);
+void VolumeSliceCache::discardRequests(const VolumeBase* volume) {
+    boost::unique_lock<boost::mutex> lock(cacheAccessMutex_);
+    std::deque<SliceRequest>::iterator it = requestQueue_.begin();
+    while (it != requestQueue_.end()) {
+        if (it->volume_ == volume)
+            it = requestQueue_.erase(it);
+        else
+            ++it;
+    }
+
+    // wait for the worker threads accessing the volume
+    bool volumeInUse = true;
+    while (volumeInUse) {
+        volumeInUse = false;
+        for (size_t i = 0; i < runningRequests_.size(); i++)
+            volumeInUse |= (runningRequests_[i].volume_ == volume);
+        if (volumeInUse)
+            requestFinishedCond_.wait(lock);
+    }
+}
+
+VolumeSliceGL* VolumeSliceCache::createSlice(const VolumeBase* volume, const SliceKey& key) {
+    if (key.alignment_ == UNALIGNED_PLANE)
+        return VolumeSliceHelper::getVolumeSlice(volume, tgt::plane(key.plane_.xyz(), key.plane_.w), key.samplingRate_);
+    else
+        return VolumeSliceHelper::getVolumeSlice(volume, key.alignment_, key.sliceIndex_, key.levelOfDetail_);
 }
 
-std::string VolumeSliceCache::getHash(const VolumeBase* volume, SliceAlignment alignment, size_t sliceIndex, size_t levelOfDetail) const {
-    std::ostringstream configStr;
-    configStr << volume->getHash();
-    configStr << alignment;
-    configStr << sliceIndex;
-    configStr << levelOfDetail;
-    return VoreenHash::getHash(configStr.str());
+void VolumeSliceCache::prefetchThreadMain() const {
+    // note: no logging in here, since the logger is not thread-safe
+    boost::unique_lock<boost::mutex> lock(cacheAccessMutex_);
+    while (true) {
+        while (requestQueue_.empty() && !stopPrefetching_)
+            prefetchCond_.wait(lock);
+        if (stopPrefetching_)
+            return;
+
+        SliceRequest request = requestQueue_.front();
+        requestQueue_.pop_front();
+        runningRequests_.push_back(request);
+
+        lock.unlock();
+        VolumeSliceGL* slice = createSlice(request.volume_, request.key_);
+        lock.lock();
+
+        if (slice && !addSliceToCache(slice, request.key_))
+            delete slice;
+
+        for (size_t i = 0; i < runningRequests_.size(); i++) {
+            if (runningRequests_[i].key_ == request.key_) {
+                runningRequests_.erase(runningRequests_.begin() + i);
+                break;
+            }
+        }
+        requestFinishedCond_.notify_all();
+    }
 }
 
-std::string VolumeSliceCache::getHash(const VolumeBase* volume, tgt::plane pl, float samplingRate) const {
-    std::ostringstream configStr;
-    configStr << volume->getHash();
-    configStr << pl;
-    configStr << samplingRate;
-    return VoreenHash::getHash(configStr.str());
+void VolumeSliceCache::startPrefetchThreads() const {
+    if (!prefetchThreads_.empty())
+        return;
+    stopPrefetching_ = false;
+    for (size_t i = 0; i < numPrefetchThreads_; i++)
+        prefetchThreads_.push_back(new boost::thread(boost::bind(&VolumeSliceCache::prefetchThreadMain, this)));
+}
 
+void VolumeSliceCache::stopPrefetchThreads() {
+    {
+        boost::lock_guard<boost::mutex> lock(cacheAccessMutex_);
+        stopPrefetching_ = true;
+        requestQueue_.clear();
+        prefetchCond_.notify_all();
+    }
+    for (size_t i = 0; i < prefetchThreads_.size(); i++) {
+        prefetchThreads_[i]->join();
+        delete prefetchThreads_[i];
+    }
+    prefetchThreads_.clear();
+    runningRequests_.clear();
 }
 
 } // namespace voreen
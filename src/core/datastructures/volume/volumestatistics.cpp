@@ -0,0 +1,98 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "voreen/core/datastructures/volume/volumestatistics.h"
+#include "voreen/core/datastructures/volume/volumederiveddataengine.h"
+
+#include "voreen/core/io/serialization/xmlserializer.h"
+#include "voreen/core/io/serialization/xmldeserializer.h"
+
+namespace voreen {
+
+VolumeStatistics::VolumeStatistics()
+    : VolumeDerivedData()
+{}
+
+VolumeStatistics::VolumeStatistics(const std::vector<float>& means, const std::vector<float>& stdDevs,
+        const std::vector<float>& meansNormalized, const std::vector<float>& stdDevsNormalized)
+    : VolumeDerivedData()
+    , means_(means)
+    , stdDevs_(stdDevs)
+    , meansNormalized_(meansNormalized)
+    , stdDevsNormalized_(stdDevsNormalized)
+{
+    tgtAssert(means.size() == stdDevs.size() && means.size() == meansNormalized.size() && means.size() == stdDevsNormalized.size(),
+        "passed vectors differ in size");
+}
+
+VolumeDerivedData* VolumeStatistics::create() const {
+    return new VolumeStatistics();
+}
+
+VolumeDerivedData* VolumeStatistics::createFrom(const VolumeBase* handle) const {
+    tgtAssert(handle, "no volume");
+    return VolumeDerivedDataEngine::createDerivedData(handle, getClassName());
+}
+
+size_t VolumeStatistics::getNumChannels() const {
+    return means_.size();
+}
+
+float VolumeStatistics::getMean(size_t channel /*= 0*/) const {
+    tgtAssert(channel < means_.size(), "invalid channel");
+    return means_.at(channel);
+}
+
+float VolumeStatistics::getStdDev(size_t channel /*= 0*/) const {
+    tgtAssert(channel < stdDevs_.size(), "invalid channel");
+    return stdDevs_.at(channel);
+}
+
+float VolumeStatistics::getMeanNormalized(size_t channel /*= 0*/) const {
+    tgtAssert(channel < meansNormalized_.size(), "invalid channel");
+    return meansNormalized_.at(channel);
+}
+
+float VolumeStatistics::getStdDevNormalized(size_t channel /*= 0*/) const {
+    tgtAssert(channel < stdDevsNormalized_.size(), "invalid channel");
+    return stdDevsNormalized_.at(channel);
+}
+
+void VolumeStatistics::serialize(XmlSerializer& s) const  {
+    s.serialize("means", means_, "channel");
+    s.serialize("stdDevs", stdDevs_, "channel");
+    s.serialize("meansNormalized", meansNormalized_, "channel");
+    s.serialize("stdDevsNormalized", stdDevsNormalized_, "channel");
+}
+
+void VolumeStatistics::deserialize(XmlDeserializer& s) {
+    s.deserialize("means", means_, "channel");
+    s.deserialize("stdDevs", stdDevs_, "channel");
+    s.deserialize("meansNormalized", meansNormalized_, "channel");
+    s.deserialize("stdDevsNormalized", stdDevsNormalized_, "channel");
+}
+
+} // namespace voreen
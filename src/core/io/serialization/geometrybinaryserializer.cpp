@@ -0,0 +1,278 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "voreen/core/io/serialization/geometrybinaryserializer.h"
+
+#include "voreen/core/datastructures/geometry/geometry.h"
+#include "voreen/core/voreenapplication.h"
+#include "voreen/core/utils/stringutils.h"
+
+#include "tgt/filesystem.h"
+
+#include <fstream>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+namespace {
+
+const char MAGIC_NUMBER[8] = { 'V', 'R', 'N', 'G', 'E', 'O', 'M', 'B' };
+const uint32_t FORMAT_VERSION = 1;
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/// Read-only memory mapping of an entire file, unmapped on destruction.
+class MappedFile {
+public:
+    MappedFile(const std::string& filename)
+        throw (voreen::SerializationException)
+        : data_(0)
+        , size_(0)
+#ifdef WIN32
+        , fileHandle_(INVALID_HANDLE_VALUE)
+        , mappingHandle_(0)
+#endif
+    {
+#ifdef WIN32
+        fileHandle_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, 0);
+        if (fileHandle_ == INVALID_HANDLE_VALUE)
+            throw voreen::SerializationException("Failed to open file for reading: " + filename);
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle_, &fileSize)) {
+            CloseHandle(fileHandle_);
+            throw voreen::SerializationException("Failed to determine file size: " + filename);
+        }
+        size_ = static_cast<size_t>(fileSize.QuadPart);
+        if (size_ == 0)
+            return;
+
+        mappingHandle_ = CreateFileMappingA(fileHandle_, 0, PAGE_READONLY, 0, 0, 0);
+        if (mappingHandle_)
+            data_ = static_cast<const char*>(MapViewOfFile(mappingHandle_, FILE_MAP_READ, 0, 0, 0));
+        if (!data_) {
+            if (mappingHandle_)
+                CloseHandle(mappingHandle_);
+            CloseHandle(fileHandle_);
+            throw voreen::SerializationException("Failed to map file: " + filename);
+        }
+#else
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw voreen::SerializationException("Failed to open file for reading: " + filename + " (" + std::string(strerror(errno)) + ")");
+
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0) {
+            close(fd);
+            throw voreen::SerializationException("Failed to determine file size: " + filename + " (" + std::string(strerror(errno)) + ")");
+        }
+        size_ = static_cast<size_t>(fileStat.st_size);
+        if (size_ > 0) {
+            void* data = mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                close(fd);
+                throw voreen::SerializationException("Failed to map file: " + filename + " (" + std::string(strerror(errno)) + ")");
+            }
+            // the blobs are read front to back
+            madvise(data, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(data);
+        }
+        // the mapping remains valid after closing the descriptor
+        close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef WIN32
+        if (data_)
+            UnmapViewOfFile(data_);
+        if (mappingHandle_)
+            CloseHandle(mappingHandle_);
+        if (fileHandle_ != INVALID_HANDLE_VALUE)
+            CloseHandle(fileHandle_);
+#else
+        if (data_)
+            munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    const char* getData() const { return data_; }
+    size_t getSize() const { return size_; }
+
+private:
+    const char* data_;
+    size_t size_;
+#ifdef WIN32
+    HANDLE fileHandle_;
+    HANDLE mappingHandle_;
+#endif
+};
+
+} // namespace anonymous
+
+namespace voreen {
+
+const std::string GeometryBinarySerializer::FILE_EXTENSION("vgb");
+
+GeometryBinarySerializer::GeometryBinarySerializer(std::ostream& stream)
+    : stream_(stream)
+{}
+
+void GeometryBinarySerializer::writeGeometry(const Geometry* geometry, const std::string& filename)
+    throw (SerializationException)
+{
+    tgtAssert(geometry, "null pointer passed");
+
+    // write to a temporary file first, so that an existing file is kept, if the geometry cannot be serialized
+    const std::string tempFilename = filename + ".tmp";
+    std::ofstream stream(tempFilename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (stream.fail())
+        throw SerializationException("Failed to open file for writing: " + tempFilename);
+
+    try {
+        GeometryBinarySerializer s(stream);
+        s.writeBlob(MAGIC_NUMBER, sizeof(MAGIC_NUMBER));
+        s.write(FORMAT_VERSION);
+        s.write(BYTE_ORDER_MARK);
+
+        const std::string className = geometry->getClassName();
+        s.write(static_cast<uint32_t>(className.size()));
+        s.writeBlob(className.c_str(), className.size());
+
+        s.write(geometry->getTransformationMatrix());
+        geometry->serializeBinary(s);
+
+        stream.close();
+        if (stream.fail())
+            throw SerializationException("Failed to write binary geometry file: " + tempFilename);
+    }
+    catch (...) {
+        if (stream.is_open())
+            stream.close();
+        tgt::FileSystem::deleteFile(tempFilename);
+        throw;
+    }
+
+    // replace the target file
+    if ((tgt::FileSystem::fileExists(filename) && !tgt::FileSystem::deleteFile(filename))
+            || !tgt::FileSystem::renameFile(tempFilename, filename, false)) {
+        tgt::FileSystem::deleteFile(tempFilename);
+        throw SerializationException("Failed to replace binary geometry file: " + filename);
+    }
+}
+
+bool GeometryBinarySerializer::isBinaryGeometryFile(const std::string& filename) {
+    return endsWith(toLower(filename), "." + FILE_EXTENSION);
+}
+
+void GeometryBinarySerializer::writeBlob(const void* data, size_t numBytes)
+    throw (SerializationException)
+{
+    if (numBytes == 0)
+        return;
+    stream_.write(static_cast<const char*>(data), static_cast<std::streamsize>(numBytes));
+    if (stream_.fail())
+        throw SerializationException("Failed to write binary geometry data");
+}
+
+//-------------------------------------------------------------------------------------------------
+
+GeometryBinaryDeserializer::GeometryBinaryDeserializer(const char* data, size_t size, const std::string& source)
+    : data_(data)
+    , size_(size)
+    , position_(0)
+    , source_(source)
+{}
+
+Geometry* GeometryBinaryDeserializer::readGeometry(const std::string& filename)
+    throw (SerializationException)
+{
+    MappedFile file(filename);
+    GeometryBinaryDeserializer d(file.getData(), file.getSize(), filename);
+
+    if (file.getSize() < sizeof(MAGIC_NUMBER) || memcmp(d.readBlob(sizeof(MAGIC_NUMBER)), MAGIC_NUMBER, sizeof(MAGIC_NUMBER)) != 0)
+        throw SerializationException("Not a binary Voreen geometry file: " + filename);
+
+    uint32_t version = 0;
+    uint32_t byteOrderMark = 0;
+    d.read(version);
+    d.read(byteOrderMark);
+    if (version > FORMAT_VERSION)
+        throw SerializationException("Unsupported binary geometry format version " + itos(version) + ": " + filename);
+    if (byteOrderMark != BYTE_ORDER_MARK)
+        throw SerializationException("Binary geometry file has been written on a platform with different byte order: " + filename);
+
+    uint32_t classNameLength = 0;
+    d.read(classNameLength);
+    const char* classNameData = d.readBlob(classNameLength);
+    const std::string className(classNameData, classNameLength);
+
+    VoreenSerializableObject* object = VoreenApplication::app() ? VoreenApplication::app()->createSerializableType(className) : 0;
+    Geometry* geometry = dynamic_cast<Geometry*>(object);
+    if (!geometry) {
+        delete object;
+        throw SerializationException("Unknown geometry type '" + className + "' in binary geometry file: " + filename);
+    }
+
+    try {
+        tgt::mat4 transformation;
+        d.read(transformation);
+        geometry->setTransformationMatrix(transformation);
+        geometry->deserializeBinary(d);
+    }
+    catch (...) {
+        delete geometry;
+        throw;
+    }
+
+    return geometry;
+}
+
+const char* GeometryBinaryDeserializer::readBlob(size_t numBytes)
+    throw (SerializationException)
+{
+    if (numBytes > size_ - position_)
+        throw SerializationException("Unexpected end of binary geometry " + source_);
+
+    const char* blob = data_ + position_;
+    position_ += numBytes;
+    return blob;
+}
+
+size_t GeometryBinaryDeserializer::getNumRemainingBytes() const {
+    return size_ - position_;
+}
+
+} // namespace
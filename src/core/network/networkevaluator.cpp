@@ -30,6 +30,7 @@
 #include "voreen/core/interaction/idmanager.h"
 #include "voreen/core/network/networkgraph.h"
 #include "voreen/core/utils/exception.h"
+#include "voreen/core/utils/tracing.h"
 
 #include "modules/core/processors/output/canvasrenderer.h" //< core module is always available
 
@@ -54,6 +55,7 @@ NetworkEvaluator::NetworkEvaluator(bool glMode, tgt::GLCanvas* sharedContext)
     , locked_(false)
     , processPending_(false)
 {
+    performanceRecord_.setName("NetworkEvaluator");
 #ifdef VRN_DEBUG
     if (glMode_)
         addObserver(new CheckOpenGLStateObserver());
@@ -276,6 +278,8 @@ void NetworkEvaluator::process() {
         return;
     }
 
+    TraceSpan span("network", "NetworkEvaluator.process");
+
     // re-analyze and initialize network, if its topology has changed since last process() call
     if (networkChanged_ || checkForInvalidPorts()) {
         onNetworkChange();
@@ -756,6 +760,12 @@ void NetworkEvaluator::clearPerformanceRecords() {
     }
 }
 
+void NetworkEvaluator::writeChromeTrace(const std::string& filename) const
+        throw (VoreenException)
+{
+    Tracer::writeChromeTrace(filename);
+}
+
 void NetworkEvaluator::updateCanvases() {
 
     if (!glMode_) {
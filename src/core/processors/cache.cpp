@@ -27,6 +27,7 @@
 
 #include "voreen/core/properties/property.h"
 #include "voreen/core/ports/port.h"
+#include "voreen/core/ports/volumeport.h"
 
 #include "voreen/core/utils/stringutils.h"
 #include "voreen/core/utils/hashing.h"
@@ -34,15 +35,37 @@
 
 #include <stdio.h>
 #include <time.h>
+#include <algorithm>
 
 namespace voreen {
 
 const std::string Cache::loggerCat_("voreen.Cache");
 
+Cache::MemoryCacheStatistics::MemoryCacheStatistics()
+    : numEntries_(0)
+    , sizeInBytes_(0)
+    , limitInBytes_(0)
+    , numHits_(0)
+    , numMisses_(0)
+    , numEvictions_(0)
+{}
+
+std::string Cache::MemoryCacheStatistics::toString() const {
+    if (limitInBytes_ == 0)
+        return "disabled";
+    return itos(numEntries_) + " entries, " + formatMemorySize(sizeInBytes_) + " / " + formatMemorySize(limitInBytes_) + ", " +
+        itos(numHits_) + " hits, " + itos(numMisses_) + " misses, " + itos(numEvictions_) + " evictions";
+}
+
 Cache::Cache(Processor* proc) : processor_(proc), initialized_(false) {
     tgtAssert(proc, "Null processor!");
 }
 
+Cache::~Cache() {
+    while (!memoryCache_.empty())
+        deleteEntry(memoryCache_.begin());
+}
+
 void Cache::initialize() {
     std::string interfaceStr = getInterfaceString();
     std::string fname = processor_->getCachePath() + "/interfaceStr.txt";
@@ -183,6 +206,10 @@ void Cache::addAllProperties() {
             continue;
         if(properties[i]->getID() == "clearCache")
             continue;
+        if(properties[i]->getID() == "memoryCacheSize")
+            continue;
+        if(properties[i]->getID() == "memoryCacheInfo")
+            continue;
 
         addProperty(properties[i]);
     }
@@ -467,6 +494,8 @@ bool Cache::restore() {
 }
 
 void Cache::clearCache() {
+    clearMemoryCache();
+
     std::string dir = processor_->getCachePath();
     LINFO("Clearing cache path: " << dir);
 
@@ -486,6 +515,134 @@ void Cache::clearCache() {
     }
 }
 
+void Cache::setMemoryCacheLimit(uint64_t limitInBytes) {
+    memoryCacheStatistics_.limitInBytes_ = limitInBytes;
+    limitMemoryCache(limitInBytes);
+}
+
+Cache::MemoryCacheStatistics Cache::getMemoryCacheStatistics() const {
+    memoryCacheStatistics_.numEntries_ = memoryCache_.size();
+    return memoryCacheStatistics_;
+}
+
+void Cache::clearMemoryCache() {
+    limitMemoryCache(0);
+}
+
+void Cache::storeToMemory() {
+    if (memoryCacheStatistics_.limitInBytes_ == 0)
+        return;
+    storeToMemory(getAllInportHashes() + "/" + getPropertyStateHash(), getPropertyState());
+}
+
+bool Cache::restoreFromMemory() {
+    if (memoryCacheStatistics_.limitInBytes_ == 0)
+        return false;
+    return restoreFromMemory(getAllInportHashes() + "/" + getPropertyStateHash(), getPropertyState());
+}
+
+bool Cache::restoreFromMemory(const std::string& key, const std::string& propertyState) {
+    for (std::list<MemoryCacheEntry>::iterator it = memoryCache_.begin(); it != memoryCache_.end(); ++it) {
+        if (it->key_ != key)
+            continue;
+        if (it->propertyState_ != propertyState) {
+            LWARNING("PropertyState Collision! Deleting memory cache entry.");
+            if (!isInUse(*it))
+                deleteEntry(it);
+            break;
+        }
+
+        tgtAssert(it->volumes_.size() == outports_.size(), "number of cached volumes does not match number of outports");
+        for (size_t i=0; i<outports_.size(); i++) {
+            VolumePort* p = dynamic_cast<VolumePort*>(processor_->getPort(outports_[i]));
+            tgtAssert(p, "no volume port");
+            if (p->getData() != it->volumes_[i])
+                p->setData(it->volumes_[i], false);
+        }
+
+        // move to front
+        memoryCache_.splice(memoryCache_.begin(), memoryCache_, it);
+        memoryCacheStatistics_.numHits_++;
+        return true;
+    }
+
+    memoryCacheStatistics_.numMisses_++;
+    return false;
+}
+
+void Cache::storeToMemory(const std::string& key, const std::string& propertyState) {
+    // collect outport volumes
+    MemoryCacheEntry entry;
+    entry.key_ = key;
+    entry.propertyState_ = propertyState;
+    entry.size_ = 0;
+    std::vector<VolumePort*> ports;
+    for (size_t i=0; i<outports_.size(); i++) {
+        VolumePort* p = dynamic_cast<VolumePort*>(processor_->getPort(outports_[i]));
+        if (!p)
+            return;
+        ports.push_back(p);
+        entry.volumes_.push_back(p->getData());
+        if (p->hasData())
+            entry.size_ += static_cast<uint64_t>(p->getData()->getNumVoxels()) * p->getData()->getBytesPerVoxel();
+    }
+
+    // already cached (e.g., restored from memory)?
+    for (std::list<MemoryCacheEntry>::iterator it = memoryCache_.begin(); it != memoryCache_.end(); ++it) {
+        if (it->key_ == key) {
+            if (it->volumes_ == entry.volumes_)
+                return;
+            if (isInUse(*it))
+                return;
+            deleteEntry(it);
+            break;
+        }
+    }
+
+    // the cache can only hold volumes it can take over from the ports
+    if (entry.size_ > memoryCacheStatistics_.limitInBytes_)
+        return;
+    for (size_t i=0; i<ports.size(); i++) {
+        if (ports[i]->hasData() && !ports[i]->ownsData())
+            return;
+    }
+    for (size_t i=0; i<ports.size(); i++)
+        ports[i]->releaseDataOwnership();
+
+    memoryCache_.push_front(entry);
+    memoryCacheStatistics_.sizeInBytes_ += entry.size_;
+    limitMemoryCache(memoryCacheStatistics_.limitInBytes_);
+}
+
+void Cache::limitMemoryCache(uint64_t limitInBytes) {
+    // iterate from least to most recently used entry
+    std::list<MemoryCacheEntry>::iterator it = memoryCache_.end();
+    while (memoryCacheStatistics_.sizeInBytes_ > limitInBytes && it != memoryCache_.begin()) {
+        --it;
+        if (isInUse(*it))
+            continue;
+        std::list<MemoryCacheEntry>::iterator evicted = it++;
+        deleteEntry(evicted);
+        memoryCacheStatistics_.numEvictions_++;
+    }
+}
+
+bool Cache::isInUse(const MemoryCacheEntry& entry) const {
+    for (size_t i=0; i<outports_.size(); i++) {
+        const VolumePort* p = dynamic_cast<const VolumePort*>(processor_->getPort(outports_[i]));
+        if (p && p->hasData() && std::find(entry.volumes_.begin(), entry.volumes_.end(), p->getData()) != entry.volumes_.end())
+            return true;
+    }
+    return false;
+}
+
+void Cache::deleteEntry(std::list<MemoryCacheEntry>::iterator entry) {
+    for (size_t i=0; i<entry->volumes_.size(); i++)
+        delete entry->volumes_[i];
+    memoryCacheStatistics_.sizeInBytes_ -= entry->size_;
+    memoryCache_.erase(entry);
+}
+
 //-----------------------------------------------------------------------------
 
 const std::string CacheCleaner::loggerCat_("voreen.CacheCleaner");
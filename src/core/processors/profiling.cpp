@@ -24,15 +24,11 @@
  ***********************************************************************************/
 
 #include "voreen/core/processors/profiling.h"
+#include "voreen/core/utils/tracing.h"
 #include <iomanip>
 #include "tgt/tgt_gl.h"
 #include "tgt/logmanager.h"
 
-#ifdef _MSC_VER  // high-performance counter
-#include <windows.h>
-#include <winbase.h>
-#endif
-
 namespace voreen {
 
 //const std::string ProfilingBlock::loggerCat_ = "voreen.ProfilingBlock";
@@ -161,6 +157,8 @@ void PerformanceSample::normalize(){
 
 //----------------------------------------------------------------
 
+const size_t PerformanceRecord::MAX_SAMPLES = 100;
+
 PerformanceRecord::PerformanceRecord() : current_(0) {
 }
 
@@ -178,8 +176,13 @@ void PerformanceRecord::startBlock(const ProfilingBlock* const pb) {
 
 void PerformanceRecord::endBlock(const ProfilingBlock* const pb) {
     current_->setTime(pb->getTime());
-    if(current_->getParent() == 0)
+    if(current_->getParent() == 0) {
         samples_.push_back(current_);
+        if (samples_.size() > MAX_SAMPLES) {
+            delete samples_.front();
+            samples_.erase(samples_.begin());
+        }
+    }
 
     current_ = current_->getParent();
 }
@@ -212,47 +215,24 @@ std::string PerformanceRecord::getName() const {
 
 //----------------------------------------------------------------
 
-ProfilingBlock::ProfilingBlock(std::string name, PerformanceRecord& pr) : name_(name), pr_(pr) {
+ProfilingBlock::ProfilingBlock(std::string name, PerformanceRecord& pr) : name_(name), pr_(pr), end_(0) {
     //LINFO("Starting Block " << name);
     pr_.startBlock((const ProfilingBlock* const) this);
     //glFinish();
-
-#ifdef _MSC_VER  // use high-performance counter on windows, if available
-    if (QueryPerformanceFrequency(&hpfTicksPerSecond_) && QueryPerformanceCounter(&hpfStart_)) {
-        useHpf_ = true;
-    }
-    else { // hpf not available
-        useHpf_ = false;
-        start_ = clock();
-    }
-#else
-    start_ = clock();
-#endif
+    start_ = Tracer::getTimestamp();
 }
 
 ProfilingBlock::~ProfilingBlock() {
     //glFinish();
-#ifdef _MSC_VER
-    if (useHpf_)
-        QueryPerformanceCounter(&hpfEnd_);
-    else
-        end_ = clock();
-#else
-    end_ = clock();
-#endif
+    end_ = Tracer::getTimestamp();
+    if (Tracer::isEnabled())
+        Tracer::recordSpan("processor", pr_.getName() + "." + name_, start_, end_);
     //LINFO("Finishing Block " << name_);
     pr_.endBlock((const ProfilingBlock* const)this);
 }
 
 float ProfilingBlock::getTime() const {
-#ifdef _MSC_VER
-    if (useHpf_)
-        return ((hpfEnd_.QuadPart-hpfStart_.QuadPart) / static_cast<float>(hpfTicksPerSecond_.QuadPart));
-    else
-        return ((end_-start_) / static_cast<float>(CLOCKS_PER_SEC));
-#else
-    return ((end_-start_) / static_cast<float>(CLOCKS_PER_SEC));
-#endif
+    return static_cast<float>((end_ - start_) * 1e-9);
 }
 
 std::string ProfilingBlock::getName() const {
@@ -50,6 +50,8 @@ CachingVolumeProcessor::CachingVolumeProcessor()
     : VolumeProcessor()
     , useCaching_("useCaching", "Use Cache", true, VALID)
     , clearCache_("clearCache", "Clear Cache", VALID)
+    , memoryCacheSize_("memoryCacheSize", "Memory Cache Size (MB)", 256, 0, 16384, VALID)
+    , memoryCacheInfo_("memoryCacheInfo", "Memory Cache", "", VALID)
     , cache_(this)
 {
     addProperty(useCaching_);
@@ -57,28 +59,48 @@ CachingVolumeProcessor::CachingVolumeProcessor()
     clearCache_.onChange(CallMemberAction<CachingVolumeProcessor>(this, &CachingVolumeProcessor::clearCache));
     addProperty(clearCache_);
 
+    memoryCacheSize_.onChange(CallMemberAction<CachingVolumeProcessor>(this, &CachingVolumeProcessor::updateMemoryCacheSize));
+    addProperty(memoryCacheSize_);
+    memoryCacheInfo_.setReadOnly(true);
+    addProperty(memoryCacheInfo_);
+
     useCaching_.setGroupID("caching");
     clearCache_.setGroupID("caching");
+    memoryCacheSize_.setGroupID("caching");
+    memoryCacheInfo_.setGroupID("caching");
 }
 
 CachingVolumeProcessor::~CachingVolumeProcessor() {}
 
+bool CachingVolumeProcessor::hasImmutableOutput() const {
+    return false;
+}
+
 void CachingVolumeProcessor::beforeProcess() {
     VolumeProcessor::beforeProcess();
 
-    if (useCaching_.get() && VoreenApplication::app()->useCaching()) {
-        if (cache_.restore()) {
+    if (useCaching_.get()) {
+        if (hasImmutableOutput() && cache_.restoreFromMemory()) {
             setValid();
         }
+        else if (VoreenApplication::app() && VoreenApplication::app()->useCaching()) {
+            if (cache_.restore()) {
+                setValid();
+            }
+        }
     }
 }
 
 void CachingVolumeProcessor::afterProcess() {
     VolumeProcessor::afterProcess();
 
-    if (useCaching_.get() && VoreenApplication::app()->useCaching()) {
-        cache_.store();
+    if (useCaching_.get()) {
+        if (VoreenApplication::app() && VoreenApplication::app()->useCaching())
+            cache_.store();
+        if (hasImmutableOutput())
+            cache_.storeToMemory();
     }
+    updateMemoryCacheInfo();
 }
 
 void CachingVolumeProcessor::initialize() throw (tgt::Exception) {
@@ -89,10 +111,26 @@ void CachingVolumeProcessor::initialize() throw (tgt::Exception) {
     cache_.addAllProperties();
 
     cache_.initialize();
+
+    // the memory tier is only available for processors with immutable output
+    memoryCacheSize_.setVisible(hasImmutableOutput());
+    memoryCacheInfo_.setVisible(hasImmutableOutput());
+    updateMemoryCacheSize();
 }
 
 void CachingVolumeProcessor::clearCache() {
     cache_.clearCache();
+    updateMemoryCacheInfo();
+}
+
+void CachingVolumeProcessor::updateMemoryCacheSize() {
+    if (hasImmutableOutput())
+        cache_.setMemoryCacheLimit(static_cast<uint64_t>(memoryCacheSize_.get()) << 20);
+    updateMemoryCacheInfo();
+}
+
+void CachingVolumeProcessor::updateMemoryCacheInfo() {
+    memoryCacheInfo_.set(cache_.getMemoryCacheStatistics().toString());
 }
 
 }   // namespace
@@ -0,0 +1,637 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "voreen/core/utils/cpuraycastingengine.h"
+
+#include "voreen/core/datastructures/volume/volume.h"
+#include "voreen/core/datastructures/volume/volumeatomic.h"
+#include "voreen/core/datastructures/volume/volumeelement.h"
+#include "voreen/core/datastructures/transfunc/transfunc1dkeys.h"
+
+#include "tgt/logmanager.h"
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+#ifdef VRN_MODULE_OPENMP
+#include "omp.h"
+#endif
+
+using tgt::ivec2;
+using tgt::ivec3;
+using tgt::vec3;
+using tgt::vec4;
+using tgt::mat4;
+
+namespace {
+
+// Same reference sampling interval as used by the CPURaycaster and the raycasting shaders
+const float SAMPLING_BASE_INTERVAL_RCP = 200.f;
+
+/// Reads raw values from a VolumeAtomic without virtual calls.
+template<class T, bool SIGNED_INTEGER = std::numeric_limits<T>::is_signed && std::numeric_limits<T>::is_integer>
+class TypedVoxelAccess {
+public:
+    TypedVoxelAccess(const voreen::VolumeAtomic<T>* volume)
+        : data_(volume->voxel())
+    {}
+
+    inline float operator()(size_t index) const {
+        return static_cast<float>(data_[index]);
+    }
+
+    /// Factor converting raw values to normalized values, as done by VolumeAtomic::getVoxelNormalized().
+    static float getRawToNormalized() {
+        return voreen::getTypeAsFloat(static_cast<T>(1));
+    }
+
+private:
+    const T* data_;
+};
+
+/**
+ * Signed integers are normalized by different factors for negative and non-negative values
+ * (e.g., 1/128 and 1/127 for int8), so the values are normalized per voxel.
+ */
+template<class T>
+class TypedVoxelAccess<T, true> {
+public:
+    TypedVoxelAccess(const voreen::VolumeAtomic<T>* volume)
+        : data_(volume->voxel())
+        , rangeMax_(static_cast<float>(voreen::VolumeElement<T>::rangeMaxElement()))
+        , rangeMinNeg_(-static_cast<float>(voreen::VolumeElement<T>::rangeMinElement()))
+    {}
+
+    /// Returns the normalized value, as done by VolumeAtomic::getVoxelNormalized().
+    inline float operator()(size_t index) const {
+        const T value = data_[index];
+        return static_cast<float>(value) / (value >= 0 ? rangeMax_ : rangeMinNeg_);
+    }
+
+    static float getRawToNormalized() {
+        return 1.f;
+    }
+
+private:
+    const T* data_;
+    float rangeMax_;
+    float rangeMinNeg_;
+};
+
+/// Fallback for all other formats: samples the normalized value of the first channel.
+class GenericVoxelAccess {
+public:
+    GenericVoxelAccess(const voreen::VolumeRAM* volume)
+        : volume_(volume)
+    {}
+
+    inline float operator()(size_t index) const {
+        return volume_->getVoxelNormalized(index);
+    }
+
+    static float getRawToNormalized() {
+        return 1.f;
+    }
+
+private:
+    const voreen::VolumeRAM* volume_;
+};
+
+/// Samples the voxel containing the passed texture coordinate.
+template<class ACCESS>
+inline float sampleNearest(const ACCESS& access, const vec3& pos, const ivec3& dim, const vec3& dimF) {
+    int x = std::min(std::max(static_cast<int>(pos.x * dimF.x), 0), dim.x - 1);
+    int y = std::min(std::max(static_cast<int>(pos.y * dimF.y), 0), dim.y - 1);
+    int z = std::min(std::max(static_cast<int>(pos.z * dimF.z), 0), dim.z - 1);
+    return access(static_cast<size_t>(z)*dim.x*dim.y + static_cast<size_t>(y)*dim.x + x);
+}
+
+/// Trilinear interpolation with voxel centers at (i+0.5)/dim, like OpenGL texture filtering.
+template<class ACCESS>
+inline float sampleLinear(const ACCESS& access, const vec3& pos, const ivec3& dim, const vec3& dimF) {
+    float vx = std::min(std::max(pos.x * dimF.x - 0.5f, 0.f), dimF.x - 1.f);
+    float vy = std::min(std::max(pos.y * dimF.y - 0.5f, 0.f), dimF.y - 1.f);
+    float vz = std::min(std::max(pos.z * dimF.z - 0.5f, 0.f), dimF.z - 1.f);
+
+    int x0 = static_cast<int>(vx);
+    int y0 = static_cast<int>(vy);
+    int z0 = static_cast<int>(vz);
+    float fx = vx - x0;
+    float fy = vy - y0;
+    float fz = vz - z0;
+
+    size_t sliceSize = static_cast<size_t>(dim.x) * dim.y;
+    size_t i000 = z0*sliceSize + static_cast<size_t>(y0)*dim.x + x0;
+    size_t dx = (x0 < dim.x - 1) ? 1 : 0;
+    size_t dy = (y0 < dim.y - 1) ? dim.x : 0;
+    size_t dz = (z0 < dim.z - 1) ? sliceSize : 0;
+
+    float c00 = access(i000)           * (1.f - fx) + access(i000 + dx)           * fx;
+    float c10 = access(i000 + dy)      * (1.f - fx) + access(i000 + dy + dx)      * fx;
+    float c01 = access(i000 + dz)      * (1.f - fx) + access(i000 + dz + dx)      * fx;
+    float c11 = access(i000 + dz + dy) * (1.f - fx) + access(i000 + dz + dy + dx) * fx;
+
+    float c0 = c00 * (1.f - fy) + c10 * fy;
+    float c1 = c01 * (1.f - fy) + c11 * fy;
+    return c0 * (1.f - fz) + c1 * fz;
+}
+
+/**
+ * Clips the ray origin + t*direction, t in [tMin, tMax], against the box [llf, urb].
+ * Returns false, if the ray misses the box.
+ */
+inline bool clipRay(const vec3& origin, const vec3& direction, const vec3& llf, const vec3& urb, float& tMin, float& tMax) {
+    for (int i=0; i<3; i++) {
+        if (std::abs(direction[i]) < 1e-8f) {
+            if (origin[i] < llf[i] || origin[i] > urb[i])
+                return false;
+        }
+        else {
+            float t0 = (llf[i] - origin[i]) / direction[i];
+            float t1 = (urb[i] - origin[i]) / direction[i];
+            if (t0 > t1)
+                std::swap(t0, t1);
+            tMin = std::max(tMin, t0);
+            tMax = std::min(tMax, t1);
+        }
+    }
+    return tMin <= tMax;
+}
+
+} // namespace anonymous
+
+namespace voreen {
+
+const int CPURaycastingEngine::BLOCK_SIZE = 8;
+const std::string CPURaycastingEngine::loggerCat_("voreen.CPURaycastingEngine");
+
+CPURaycastingEngine::CPURaycastingEngine()
+    : volume_(0)
+    , volumeRAM_(0)
+    , volumeDim_(0)
+    , rawToNormalized_(1.f)
+    , transFunc_(0)
+    , filterMode_(FILTER_LINEAR)
+    , samplingRate_(2.f)
+    , ertThreshold_(0.95f)
+    , emptySpaceSkipping_(true)
+    , tileSize_(16)
+    , tableIndexScale_(0.f)
+    , tableIndexOffset_(0.f)
+    , numSkippedSamples_(0)
+{}
+
+CPURaycastingEngine::~CPURaycastingEngine() {
+}
+
+void CPURaycastingEngine::setVolume(const VolumeBase* volume)
+    throw (VoreenException)
+{
+    volume_ = 0;
+    volumeRAM_ = 0;
+    minMaxOctree_.clear();
+    if (!volume)
+        return;
+
+    const VolumeRAM* volumeRAM = volume->getRepresentation<VolumeRAM>();
+    if (!volumeRAM)
+        throw VoreenException("CPURaycastingEngine: volume has no RAM representation");
+
+    volume_ = volume;
+    volumeRAM_ = volumeRAM;
+    volumeDim_ = ivec3(volumeRAM->getDimensions());
+    textureToWorld_ = volume->getTextureToWorldMatrix();
+    realWorldMapping_ = volume->getRealWorldMapping();
+
+    if (const VolumeAtomic<uint8_t>* v = dynamic_cast<const VolumeAtomic<uint8_t>*>(volumeRAM))
+        buildMinMaxOctree(TypedVoxelAccess<uint8_t>(v));
+    else if (const VolumeAtomic<int8_t>* v = dynamic_cast<const VolumeAtomic<int8_t>*>(volumeRAM))
+        buildMinMaxOctree(TypedVoxelAccess<int8_t>(v));
+    else if (const VolumeAtomic<uint16_t>* v = dynamic_cast<const VolumeAtomic<uint16_t>*>(volumeRAM))
+        buildMinMaxOctree(TypedVoxelAccess<uint16_t>(v));
+    else if (const VolumeAtomic<int16_t>* v = dynamic_cast<const VolumeAtomic<int16_t>*>(volumeRAM))
+        buildMinMaxOctree(TypedVoxelAccess<int16_t>(v));
+    else if (const VolumeAtomic<float>* v = dynamic_cast<const VolumeAtomic<float>*>(volumeRAM))
+        buildMinMaxOctree(TypedVoxelAccess<float>(v));
+    else
+        buildMinMaxOctree(GenericVoxelAccess(volumeRAM));
+}
+
+const VolumeBase* CPURaycastingEngine::getVolume() const {
+    return volume_;
+}
+
+void CPURaycastingEngine::setTransFunc(const TransFunc1DKeys* transFunc) {
+    transFunc_ = transFunc;
+}
+
+void CPURaycastingEngine::setFilterMode(FilterMode mode) {
+    filterMode_ = mode;
+}
+
+CPURaycastingEngine::FilterMode CPURaycastingEngine::getFilterMode() const {
+    return filterMode_;
+}
+
+void CPURaycastingEngine::setSamplingRate(float samplingRate) {
+    tgtAssert(samplingRate > 0.f, "sampling rate must be positive");
+    samplingRate_ = samplingRate;
+}
+
+float CPURaycastingEngine::getSamplingRate() const {
+    return samplingRate_;
+}
+
+void CPURaycastingEngine::setEarlyRayTerminationThreshold(float threshold) {
+    ertThreshold_ = threshold;
+}
+
+void CPURaycastingEngine::setEmptySpaceSkipping(bool enabled) {
+    emptySpaceSkipping_ = enabled;
+}
+
+bool CPURaycastingEngine::getEmptySpaceSkipping() const {
+    return emptySpaceSkipping_;
+}
+
+void CPURaycastingEngine::setTileSize(int tileSize) {
+    tgtAssert(tileSize > 0, "invalid tile size");
+    tileSize_ = tileSize;
+}
+
+size_t CPURaycastingEngine::getNumSkippedSamples() const {
+    return numSkippedSamples_;
+}
+
+void CPURaycastingEngine::render(const tgt::Camera& camera, const ivec2& imageSize, vec4* output)
+    throw (VoreenException)
+{
+    if (!volumeRAM_)
+        throw VoreenException("CPURaycastingEngine: no volume");
+
+    RaySetup setup;
+    setup.entryPoints_ = 0;
+    setup.exitPoints_ = 0;
+    setup.imageSize_ = imageSize;
+
+    mat4 textureToNDC = camera.getProjectionMatrix(imageSize) * camera.getViewMatrix() * textureToWorld_;
+    if (!textureToNDC.invert(setup.ndcToTexture_))
+        throw VoreenException("CPURaycastingEngine: projection matrix is not invertible");
+
+    renderImage(setup, output);
+}
+
+void CPURaycastingEngine::render(const vec4* entryPoints, const vec4* exitPoints, const ivec2& imageSize, vec4* output)
+    throw (VoreenException)
+{
+    tgtAssert(entryPoints && exitPoints, "null pointer passed as entry/exit points");
+    if (!volumeRAM_)
+        throw VoreenException("CPURaycastingEngine: no volume");
+
+    RaySetup setup;
+    setup.entryPoints_ = entryPoints;
+    setup.exitPoints_ = exitPoints;
+    setup.imageSize_ = imageSize;
+
+    renderImage(setup, output);
+}
+
+void CPURaycastingEngine::renderImage(const RaySetup& setup, vec4* output)
+    throw (VoreenException)
+{
+    tgtAssert(volumeRAM_, "no volume");
+    tgtAssert(output, "no output buffer");
+    if (!transFunc_)
+        throw VoreenException("CPURaycastingEngine: no transfer function");
+
+    // use dimension with the highest resolution for calculating the sampling step size
+    float samplingStepSize = 1.f / (tgt::max(volumeDim_) * samplingRate_);
+    buildClassificationTable(samplingStepSize);
+    numSkippedSamples_ = 0;
+
+    if (const VolumeAtomic<uint8_t>* v = dynamic_cast<const VolumeAtomic<uint8_t>*>(volumeRAM_))
+        dispatchFilter(TypedVoxelAccess<uint8_t>(v), setup, samplingStepSize, output);
+    else if (const VolumeAtomic<int8_t>* v = dynamic_cast<const VolumeAtomic<int8_t>*>(volumeRAM_))
+        dispatchFilter(TypedVoxelAccess<int8_t>(v), setup, samplingStepSize, output);
+    else if (const VolumeAtomic<uint16_t>* v = dynamic_cast<const VolumeAtomic<uint16_t>*>(volumeRAM_))
+        dispatchFilter(TypedVoxelAccess<uint16_t>(v), setup, samplingStepSize, output);
+    else if (const VolumeAtomic<int16_t>* v = dynamic_cast<const VolumeAtomic<int16_t>*>(volumeRAM_))
+        dispatchFilter(TypedVoxelAccess<int16_t>(v), setup, samplingStepSize, output);
+    else if (const VolumeAtomic<float>* v = dynamic_cast<const VolumeAtomic<float>*>(volumeRAM_))
+        dispatchFilter(TypedVoxelAccess<float>(v), setup, samplingStepSize, output);
+    else
+        dispatchFilter(GenericVoxelAccess(volumeRAM_), setup, samplingStepSize, output);
+}
+
+template<class ACCESS>
+void CPURaycastingEngine::dispatchFilter(const ACCESS& access, const RaySetup& setup, float samplingStepSize, vec4* output) {
+    if (filterMode_ == FILTER_LINEAR)
+        renderTiles<ACCESS, true>(access, setup, samplingStepSize, output);
+    else
+        renderTiles<ACCESS, false>(access, setup, samplingStepSize, output);
+}
+
+void CPURaycastingEngine::buildClassificationTable(float samplingStepSize) {
+    tgtAssert(transFunc_, "no transfer function");
+
+    // replicate the texture generated by TransFunc1DKeys::updateTexture()
+    int tableSize = std::max(transFunc_->getDimensions().x, 2);
+    tgt::vec2 thresholds = transFunc_->getThresholds();
+    int frontEnd = tgt::iround(thresholds.x * tableSize);
+    int backStart = tgt::iround(thresholds.y * tableSize);
+
+    float opacityCorrection = samplingStepSize * SAMPLING_BASE_INTERVAL_RCP;
+    classificationTable_.resize(tableSize);
+    for (int i=0; i<tableSize; i++) {
+        vec4 color(0.f);
+        if (i >= frontEnd && i < backStart)
+            color = vec4(transFunc_->getMappingForValue(static_cast<float>(i) / tableSize)) / 255.f;
+        if (color.a > 0.f) {
+            color.a = 1.f - std::pow(1.f - color.a, opacityCorrection);
+            classificationTable_[i] = vec4(color.xyz() * color.a, color.a);
+        }
+        else
+            classificationTable_[i] = vec4(0.f);
+    }
+
+    nextVisibleIndex_.resize(tableSize + 1);
+    nextVisibleIndex_[tableSize] = tableSize;
+    for (int i=tableSize-1; i>=0; i--)
+        nextVisibleIndex_[i] = (classificationTable_[i].a > 0.f) ? i : nextVisibleIndex_[i+1];
+
+    // raw value -> normalized -> real world -> TF domain -> table index, which is linear up to clamping
+    tgt::vec2 domain = transFunc_->getDomain();
+    float domainWidth = (domain.y > domain.x) ? (domain.y - domain.x) : 1.f;
+    float rw0 = realWorldMapping_.normalizedToRealWorld(0.f);
+    float rw1 = realWorldMapping_.normalizedToRealWorld(1.f);
+    tableIndexScale_ = rawToNormalized_ * (rw1 - rw0) / domainWidth * (tableSize - 1);
+    tableIndexOffset_ = (rw0 - domain.x) / domainWidth * (tableSize - 1) + 0.5f;
+}
+
+inline int CPURaycastingEngine::getTableIndex(float rawValue) const {
+    float index = rawValue * tableIndexScale_ + tableIndexOffset_;
+    if (!(index > 0.f))
+        return 0;
+    return std::min(static_cast<int>(index), static_cast<int>(classificationTable_.size()) - 1);
+}
+
+inline bool CPURaycastingEngine::isTransparent(float minValue, float maxValue) const {
+    int first = getTableIndex(minValue);
+    int last = getTableIndex(maxValue);
+    if (first > last)
+        std::swap(first, last);
+    return nextVisibleIndex_[first] > last;
+}
+
+bool CPURaycastingEngine::computeRay(const RaySetup& setup, int x, int y, vec3& entry, vec3& direction, float& rayLength) const {
+    if (setup.entryPoints_) {
+        size_t p = static_cast<size_t>(y) * setup.imageSize_.x + x;
+        const vec4& front = setup.entryPoints_[p];
+        const vec4& back = setup.exitPoints_[p];
+        if (front == vec4(0.f) && back == vec4(0.f))
+            return false;
+
+        entry = front.xyz();
+        direction = back.xyz() - front.xyz();
+        rayLength = tgt::length(direction);
+        if (rayLength > 0.f)
+            direction /= rayLength;
+        return true;
+    }
+    else {
+        // unproject the pixel center at the near and far plane into texture space
+        float ndcX = (x + 0.5f) / setup.imageSize_.x * 2.f - 1.f;
+        float ndcY = (y + 0.5f) / setup.imageSize_.y * 2.f - 1.f;
+        vec4 nearPoint = setup.ndcToTexture_ * vec4(ndcX, ndcY, -1.f, 1.f);
+        vec4 farPoint = setup.ndcToTexture_ * vec4(ndcX, ndcY, 1.f, 1.f);
+        vec3 origin = nearPoint.xyz() / nearPoint.w;
+        direction = farPoint.xyz() / farPoint.w - origin;
+        float farDistance = tgt::length(direction);
+        if (farDistance <= 0.f)
+            return false;
+        direction /= farDistance;
+
+        float tMin = 0.f;
+        float tMax = farDistance;
+        if (!clipRay(origin, direction, vec3(0.f), vec3(1.f), tMin, tMax))
+            return false;
+
+        entry = origin + tMin * direction;
+        rayLength = tMax - tMin;
+        return true;
+    }
+}
+
+template<class ACCESS>
+void CPURaycastingEngine::buildMinMaxOctree(const ACCESS& access) {
+    rawToNormalized_ = ACCESS::getRawToNormalized();
+    minMaxOctree_.clear();
+
+    // level 0: one node per block. The value range of each block includes the adjacent voxels,
+    // since they contribute to trilinearly interpolated samples within the block.
+    MinMaxLevel level0;
+    level0.dim_ = (volumeDim_ + ivec3(BLOCK_SIZE - 1)) / BLOCK_SIZE;
+    size_t numBlocks = tgt::hmul(tgt::svec3(level0.dim_));
+    level0.min_.resize(numBlocks);
+    level0.max_.resize(numBlocks);
+
+    const ivec3 dim = volumeDim_;
+    const size_t sliceSize = static_cast<size_t>(dim.x) * dim.y;
+#ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int bz=0; bz<level0.dim_.z; bz++) {
+        for (int by=0; by<level0.dim_.y; by++) {
+            for (int bx=0; bx<level0.dim_.x; bx++) {
+                ivec3 llf = tgt::max(ivec3(bx, by, bz) * BLOCK_SIZE - ivec3(1), ivec3(0));
+                ivec3 urb = tgt::min(ivec3(bx + 1, by + 1, bz + 1) * BLOCK_SIZE, dim - ivec3(1));
+
+                float minValue = access(llf.z*sliceSize + static_cast<size_t>(llf.y)*dim.x + llf.x);
+                float maxValue = minValue;
+                for (int z=llf.z; z<=urb.z; z++) {
+                    for (int y=llf.y; y<=urb.y; y++) {
+                        size_t index = z*sliceSize + static_cast<size_t>(y)*dim.x + llf.x;
+                        for (int x=llf.x; x<=urb.x; x++, index++) {
+                            float value = access(index);
+                            minValue = std::min(minValue, value);
+                            maxValue = std::max(maxValue, value);
+                        }
+                    }
+                }
+
+                size_t blockIndex = (static_cast<size_t>(bz)*level0.dim_.y + by)*level0.dim_.x + bx;
+                level0.min_[blockIndex] = minValue;
+                level0.max_[blockIndex] = maxValue;
+            }
+        }
+    }
+    minMaxOctree_.push_back(level0);
+
+    // coarser levels: combine 2x2x2 child nodes until a single root node remains
+    while (tgt::hmul(minMaxOctree_.back().dim_) > 1) {
+        const MinMaxLevel& child = minMaxOctree_.back();
+        MinMaxLevel parent;
+        parent.dim_ = (child.dim_ + ivec3(1)) / 2;
+        size_t numNodes = tgt::hmul(tgt::svec3(parent.dim_));
+        parent.min_.resize(numNodes);
+        parent.max_.resize(numNodes);
+
+        for (int z=0; z<parent.dim_.z; z++) {
+            for (int y=0; y<parent.dim_.y; y++) {
+                for (int x=0; x<parent.dim_.x; x++) {
+                    ivec3 childLlf = ivec3(x, y, z) * 2;
+                    ivec3 childUrb = tgt::min(childLlf + ivec3(1), child.dim_ - ivec3(1));
+                    size_t firstChild = (static_cast<size_t>(childLlf.z)*child.dim_.y + childLlf.y)*child.dim_.x + childLlf.x;
+                    float minValue = child.min_[firstChild];
+                    float maxValue = child.max_[firstChild];
+                    for (int cz=childLlf.z; cz<=childUrb.z; cz++) {
+                        for (int cy=childLlf.y; cy<=childUrb.y; cy++) {
+                            for (int cx=childLlf.x; cx<=childUrb.x; cx++) {
+                                size_t childIndex = (static_cast<size_t>(cz)*child.dim_.y + cy)*child.dim_.x + cx;
+                                minValue = std::min(minValue, child.min_[childIndex]);
+                                maxValue = std::max(maxValue, child.max_[childIndex]);
+                            }
+                        }
+                    }
+                    size_t nodeIndex = (static_cast<size_t>(z)*parent.dim_.y + y)*parent.dim_.x + x;
+                    parent.min_[nodeIndex] = minValue;
+                    parent.max_[nodeIndex] = maxValue;
+                }
+            }
+        }
+        minMaxOctree_.push_back(parent);
+    }
+}
+
+template<class ACCESS, bool LINEAR>
+void CPURaycastingEngine::renderTiles(const ACCESS& access, const RaySetup& setup, float samplingStepSize, vec4* output) {
+    const ivec2 imageSize = setup.imageSize_;
+    const int tileSize = tileSize_;
+    const int numTilesX = (imageSize.x + tileSize - 1) / tileSize;
+    const int numTilesY = (imageSize.y + tileSize - 1) / tileSize;
+    const int numTiles = numTilesX * numTilesY;
+
+    const ivec3 dim = volumeDim_;
+    const vec3 dimF = vec3(volumeDim_);
+    const bool skipping = emptySpaceSkipping_ && !minMaxOctree_.empty();
+    const int numLevels = static_cast<int>(minMaxOctree_.size());
+    const vec4* table = &classificationTable_[0];
+
+    std::vector<size_t> skippedPerTile(numTiles, 0);
+
+    // tiles are handed out one by one, so that threads finishing early pick up the remaining work
+#ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int tile=0; tile<numTiles; tile++) {
+        const int tileX = (tile % numTilesX) * tileSize;
+        const int tileY = (tile / numTilesX) * tileSize;
+        const int tileEndX = std::min(tileX + tileSize, imageSize.x);
+        const int tileEndY = std::min(tileY + tileSize, imageSize.y);
+        size_t skipped = 0;
+
+        for (int y=tileY; y<tileEndY; y++) {
+            for (int x=tileX; x<tileEndX; x++) {
+                vec4 result(0.f);
+                vec3 entry, direction;
+                float rayLength;
+                if (!computeRay(setup, x, y, entry, direction, rayLength)) {
+                    output[static_cast<size_t>(y)*imageSize.x + x] = result;
+                    continue;
+                }
+
+                // samples are taken at t = i*samplingStepSize, i = 0..lastSample
+                const int lastSample = static_cast<int>(rayLength / samplingStepSize);
+                for (int i=0; i<=lastSample; ) {
+                    float t = i * samplingStepSize;
+                    vec3 pos = entry + t * direction;
+
+                    if (skipping) {
+                        ivec3 voxel = tgt::clamp(ivec3(pos * dimF), ivec3(0), dim - ivec3(1));
+                        ivec3 node = voxel / BLOCK_SIZE;
+                        const MinMaxLevel& leaf = minMaxOctree_[0];
+                        size_t leafIndex = (static_cast<size_t>(node.z)*leaf.dim_.y + node.y)*leaf.dim_.x + node.x;
+                        if (isTransparent(leaf.min_[leafIndex], leaf.max_[leafIndex])) {
+                            // ascend to the largest transparent node containing the sample
+                            int level = 0;
+                            while (level + 1 < numLevels) {
+                                const MinMaxLevel& parent = minMaxOctree_[level + 1];
+                                ivec3 parentNode = node / 2;
+                                size_t parentIndex = (static_cast<size_t>(parentNode.z)*parent.dim_.y + parentNode.y)*parent.dim_.x + parentNode.x;
+                                if (!isTransparent(parent.min_[parentIndex], parent.max_[parentIndex]))
+                                    break;
+                                node = parentNode;
+                                level++;
+                            }
+
+                            // continue with the first sample behind the node
+                            int nodeSize = BLOCK_SIZE << level;
+                            vec3 nodeLlf = vec3(node * nodeSize) / dimF;
+                            vec3 nodeUrb = tgt::min(vec3((node + ivec3(1)) * nodeSize), dimF) / dimF;
+                            float tExit = rayLength;
+                            for (int c=0; c<3; c++) {
+                                if (direction[c] > 0.f)
+                                    tExit = std::min(tExit, (nodeUrb[c] - entry[c]) / direction[c]);
+                                else if (direction[c] < 0.f)
+                                    tExit = std::min(tExit, (nodeLlf[c] - entry[c]) / direction[c]);
+                            }
+                            int next = std::max(static_cast<int>(tExit / samplingStepSize) + 1, i + 1);
+                            next = std::min(next, lastSample + 1);
+                            skipped += next - i;
+                            i = next;
+                            continue;
+                        }
+                    }
+
+                    float value = LINEAR ? sampleLinear(access, pos, dim, dimF) : sampleNearest(access, pos, dim, dimF);
+                    const vec4& color = table[getTableIndex(value)];
+                    if (color.a > 0.f) {
+                        float transparency = 1.f - result.a;
+                        result.r += transparency * color.r;
+                        result.g += transparency * color.g;
+                        result.b += transparency * color.b;
+                        result.a += transparency * color.a;
+
+                        // early ray termination
+                        if (result.a >= ertThreshold_) {
+                            result.a = 1.f;
+                            break;
+                        }
+                    }
+                    i++;
+                }
+
+                output[static_cast<size_t>(y)*imageSize.x + x] = result;
+            }
+        }
+        skippedPerTile[tile] = skipped;
+    }
+
+    for (int tile=0; tile<numTiles; tile++)
+        numSkippedSamples_ += skippedPerTile[tile];
+}
+
+} // namespace voreen
@@ -28,6 +28,61 @@
 #include "voreen/core/utils/hashing.h"
 #include "md5/md5.h"
 
+#include "tgt/assert.h"
+
+#include <string.h>
+#include <algorithm>
+
+#ifdef VRN_MODULE_OPENMP
+#include "omp.h"
+#endif
+
+namespace {
+
+// XXH64, see https://github.com/Cyan4973/xxHash (assumes a little endian host)
+const uint64_t PRIME64_1 = 11400714785074694791ULL;
+const uint64_t PRIME64_2 = 14029467366897019727ULL;
+const uint64_t PRIME64_3 =  1609587929392839161ULL;
+const uint64_t PRIME64_4 =  9650029242287828579ULL;
+const uint64_t PRIME64_5 =  2870177450012600261ULL;
+
+inline uint64_t rotateLeft(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t read64(const unsigned char* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(uint64_t));
+    return v;
+}
+
+inline uint32_t read32(const unsigned char* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(uint32_t));
+    return v;
+}
+
+inline uint64_t xxhRound(uint64_t acc, uint64_t input) {
+    acc += input * PRIME64_2;
+    acc = rotateLeft(acc, 31);
+    return acc * PRIME64_1;
+}
+
+inline uint64_t xxhMergeRound(uint64_t acc, uint64_t val) {
+    acc ^= xxhRound(0, val);
+    return acc * PRIME64_1 + PRIME64_4;
+}
+
+std::string toHexString(uint64_t value) {
+    char output[2 * 8 + 1];
+    for (int i=0; i<8; i++)
+        sprintf(output + (2 * i), "%02x", static_cast<unsigned int>((value >> (56 - 8*i)) & 0xFF));
+    output[2 * 8] = '\0';
+    return std::string(output);
+}
+
+}
+
 namespace voreen {
 
 std::string VoreenHash::getHash(const void* data, size_t size) {
@@ -50,4 +105,124 @@ std::string VoreenHash::getHash(const std::string& s) {
     return getHash(s.c_str(), s.length());
 }
 
+uint64_t VoreenHash::getFastHash(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + size;
+    uint64_t h;
+
+    if (size >= 32) {
+        const unsigned char* limit = end - 32;
+        uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+        uint64_t v2 = seed + PRIME64_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME64_1;
+        do {
+            v1 = xxhRound(v1, read64(p));      p += 8;
+            v2 = xxhRound(v2, read64(p));      p += 8;
+            v3 = xxhRound(v3, read64(p));      p += 8;
+            v4 = xxhRound(v4, read64(p));      p += 8;
+        } while (p <= limit);
+
+        h = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+        h = xxhMergeRound(h, v1);
+        h = xxhMergeRound(h, v2);
+        h = xxhMergeRound(h, v3);
+        h = xxhMergeRound(h, v4);
+    }
+    else {
+        h = seed + PRIME64_5;
+    }
+
+    h += static_cast<uint64_t>(size);
+
+    while (p + 8 <= end) {
+        h ^= xxhRound(0, read64(p));
+        h = rotateLeft(h, 27) * PRIME64_1 + PRIME64_4;
+        p += 8;
+    }
+    if (p + 4 <= end) {
+        h ^= static_cast<uint64_t>(read32(p)) * PRIME64_1;
+        h = rotateLeft(h, 23) * PRIME64_2 + PRIME64_3;
+        p += 4;
+    }
+    while (p < end) {
+        h ^= (*p) * PRIME64_5;
+        h = rotateLeft(h, 11) * PRIME64_1;
+        p++;
+    }
+
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+//-------------------------------------------------------------------------------------------------
+
+const size_t VoreenBlockHash::DEFAULT_BLOCK_SIZE = 4 << 20;
+
+VoreenBlockHash::VoreenBlockHash(size_t blockSize)
+    : blockSize_(blockSize)
+    , dataSize_(0)
+{
+    tgtAssert(blockSize_ > 0, "invalid block size");
+}
+
+void VoreenBlockHash::compute(const void* data, size_t size) {
+    tgtAssert(data || size == 0, "null pointer passed");
+    dataSize_ = size;
+    blockHashes_.assign((size + blockSize_ - 1) / blockSize_, 0);
+    if (!blockHashes_.empty())
+        hashBlocks(static_cast<const char*>(data), 0, blockHashes_.size() - 1);
+}
+
+void VoreenBlockHash::reset(uint64_t size) {
+    dataSize_ = size;
+    blockHashes_.assign(static_cast<size_t>((size + blockSize_ - 1) / blockSize_), 0);
+}
+
+void VoreenBlockHash::hashBlock(const void* blockData, size_t blockIndex) {
+    tgtAssert(blockData, "null pointer passed");
+    tgtAssert(blockIndex < blockHashes_.size(), "invalid block index");
+    uint64_t blockOffset = static_cast<uint64_t>(blockIndex) * blockSize_;
+    size_t blockSize = static_cast<size_t>(std::min<uint64_t>(blockSize_, dataSize_ - blockOffset));
+    blockHashes_[blockIndex] = VoreenHash::getFastHash(blockData, blockSize);
+}
+
+void VoreenBlockHash::hashBlocks(const char* data, size_t firstBlock, size_t lastBlock) {
+    tgtAssert(firstBlock <= lastBlock && lastBlock < blockHashes_.size(), "invalid block range");
+
+    #ifdef VRN_MODULE_OPENMP
+    #pragma omp parallel for schedule(dynamic)
+    #endif
+    for (int i = static_cast<int>(firstBlock); i <= static_cast<int>(lastBlock); i++)
+        hashBlock(data + static_cast<size_t>(i)*blockSize_, static_cast<size_t>(i));
+}
+
+std::string VoreenBlockHash::getHash() const {
+    const void* hashes = (blockHashes_.empty() ? 0 : &blockHashes_[0]);
+    const size_t hashesSize = blockHashes_.size() * sizeof(uint64_t);
+    uint64_t h1 = VoreenHash::getFastHash(hashes, hashesSize, dataSize_);
+    uint64_t h2 = VoreenHash::getFastHash(hashes, hashesSize, h1);
+    return toHexString(h1) + toHexString(h2);
+}
+
+size_t VoreenBlockHash::getBlockSize() const {
+    return blockSize_;
+}
+
+size_t VoreenBlockHash::getNumBlocks() const {
+    return blockHashes_.size();
+}
+
+uint64_t VoreenBlockHash::getDataSize() const {
+    return dataSize_;
+}
+
+const std::vector<uint64_t>& VoreenBlockHash::getBlockHashes() const {
+    return blockHashes_;
+}
+
 } // namespace
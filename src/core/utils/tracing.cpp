@@ -0,0 +1,266 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Voreen - The Volume Rendering Engine                                            *
+ *                                                                                 *
+ * Copyright (C) 2005-2013 University of Muenster, Germany.                        *
+ * Visualization and Computer Graphics Group <http://viscg.uni-muenster.de>        *
+ * For a list of authors please refer to the file "CREDITS.txt".                   *
+ *                                                                                 *
+ * This file is part of the Voreen software package. Voreen is free software:      *
+ * you can redistribute it and/or modify it under the terms of the GNU General     *
+ * Public License version 2 as published by the Free Software Foundation.          *
+ *                                                                                 *
+ * Voreen is distributed in the hope that it will be useful, but WITHOUT ANY       *
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR   *
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.      *
+ *                                                                                 *
+ * You should have received a copy of the GNU General Public License in the file   *
+ * "LICENSE.txt" along with this file. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                                 *
+ * For non-commercial academic use see the license exception specified in the file *
+ * "LICENSE-academic.txt". To get information about commercial licensing please    *
+ * contact the authors.                                                            *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "voreen/core/utils/tracing.h"
+
+#include <boost/thread.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+
+#ifdef WIN32
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+
+namespace voreen {
+
+namespace {
+
+/// Ring buffer of the spans recorded by one thread.
+struct ThreadBuffer {
+    ThreadBuffer(size_t threadID)
+        : threadID_(threadID)
+        , events_(Tracer::BUFFER_CAPACITY)
+        , next_(0)
+        , numEvents_(0)
+    {}
+
+    boost::mutex mutex_;    ///< only contended while the spans are collected
+    size_t threadID_;
+    std::vector<Tracer::TraceEvent> events_;
+    size_t next_;           ///< index of the slot to be written next
+    size_t numEvents_;
+};
+
+void releaseThreadBuffer(ThreadBuffer* buffer);
+
+/// Owns the buffers of all threads. The buffers of terminated threads are reused by new threads.
+struct TraceRegistry {
+    TraceRegistry()
+        : currentBuffer_(&releaseThreadBuffer)
+    {}
+
+    ~TraceRegistry() {
+        currentBuffer_.release();
+        for (size_t i = 0; i < buffers_.size(); ++i)
+            delete buffers_[i];
+    }
+
+    ThreadBuffer* getCurrentBuffer() {
+        ThreadBuffer* buffer = currentBuffer_.get();
+        if (!buffer) {
+            boost::lock_guard<boost::mutex> lock(mutex_);
+            if (!freeBuffers_.empty()) {
+                buffer = freeBuffers_.back();
+                freeBuffers_.pop_back();
+            }
+            else {
+                buffer = new ThreadBuffer(buffers_.size());
+                buffers_.push_back(buffer);
+            }
+            currentBuffer_.reset(buffer);
+        }
+        return buffer;
+    }
+
+    boost::mutex mutex_;                     ///< guards buffers_ and freeBuffers_
+    std::vector<ThreadBuffer*> buffers_;
+    std::vector<ThreadBuffer*> freeBuffers_;
+    boost::thread_specific_ptr<ThreadBuffer> currentBuffer_; ///< declared last: is destructed first
+};
+
+TraceRegistry& getRegistry() {
+    static TraceRegistry registry;
+    return registry;
+}
+
+void releaseThreadBuffer(ThreadBuffer* buffer) {
+    TraceRegistry& registry = getRegistry();
+    boost::lock_guard<boost::mutex> lock(registry.mutex_);
+    registry.freeBuffers_.push_back(buffer);
+}
+
+bool eventStartsBefore(const Tracer::TraceEvent& a, const Tracer::TraceEvent& b) {
+    return a.start_ < b.start_;
+}
+
+void writeJSONString(std::ostream& stream, const std::string& str) {
+    stream << '"';
+    for (size_t i = 0; i < str.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(str[i]);
+        if (c == '"' || c == '\\')
+            stream << '\\' << c;
+        else if (c < 0x20)
+            stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        else
+            stream << c;
+    }
+    stream << '"';
+}
+
+/// Writes the passed nanosecond value in microseconds, which is the time unit of the trace event format.
+void writeMicroseconds(std::ostream& stream, uint64_t ns) {
+    stream << (ns / 1000) << '.' << std::setw(3) << std::setfill('0') << (ns % 1000);
+}
+
+} // namespace
+
+const size_t Tracer::BUFFER_CAPACITY = 1 << 14;
+
+volatile bool Tracer::enabled_ = false;
+
+void Tracer::setEnabled(bool enabled) {
+    getRegistry(); // make sure that the registry is constructed before any span is recorded
+    enabled_ = enabled;
+}
+
+uint64_t Tracer::getTimestamp() {
+#ifdef WIN32
+    static LARGE_INTEGER frequency = { 0 };
+    if (frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    // split up to prevent overflow
+    return static_cast<uint64_t>(counter.QuadPart / frequency.QuadPart) * 1000000000
+        + static_cast<uint64_t>(counter.QuadPart % frequency.QuadPart) * 1000000000 / frequency.QuadPart;
+#elif defined(__APPLE__)
+    static mach_timebase_info_data_t timebase = { 0, 0 };
+    if (timebase.denom == 0)
+        mach_timebase_info(&timebase);
+    return mach_absolute_time() * timebase.numer / timebase.denom;
+#else
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000 + static_cast<uint64_t>(time.tv_nsec);
+#endif
+}
+
+void Tracer::recordSpan(const char* category, const std::string& name, uint64_t start, uint64_t end) {
+    if (!enabled_)
+        return;
+
+    ThreadBuffer* buffer = getRegistry().getCurrentBuffer();
+    boost::lock_guard<boost::mutex> lock(buffer->mutex_);
+    TraceEvent& event = buffer->events_[buffer->next_];
+    event.name_ = name;
+    event.category_ = category;
+    event.start_ = start;
+    event.duration_ = (end > start ? end - start : 0);
+    event.threadID_ = buffer->threadID_;
+    buffer->next_ = (buffer->next_ + 1) % BUFFER_CAPACITY;
+    buffer->numEvents_ = std::min(buffer->numEvents_ + 1, BUFFER_CAPACITY);
+}
+
+std::vector<Tracer::TraceEvent> Tracer::getEvents() {
+    TraceRegistry& registry = getRegistry();
+    std::vector<TraceEvent> events;
+
+    boost::lock_guard<boost::mutex> registryLock(registry.mutex_);
+    for (size_t i = 0; i < registry.buffers_.size(); ++i) {
+        ThreadBuffer* buffer = registry.buffers_[i];
+        boost::lock_guard<boost::mutex> lock(buffer->mutex_);
+        size_t first = (buffer->next_ + BUFFER_CAPACITY - buffer->numEvents_) % BUFFER_CAPACITY;
+        for (size_t j = 0; j < buffer->numEvents_; ++j)
+            events.push_back(buffer->events_[(first + j) % BUFFER_CAPACITY]);
+    }
+
+    std::stable_sort(events.begin(), events.end(), eventStartsBefore);
+    return events;
+}
+
+void Tracer::clear() {
+    TraceRegistry& registry = getRegistry();
+    boost::lock_guard<boost::mutex> registryLock(registry.mutex_);
+    for (size_t i = 0; i < registry.buffers_.size(); ++i) {
+        ThreadBuffer* buffer = registry.buffers_[i];
+        boost::lock_guard<boost::mutex> lock(buffer->mutex_);
+        buffer->next_ = 0;
+        buffer->numEvents_ = 0;
+    }
+}
+
+void Tracer::writeChromeTrace(std::ostream& stream) {
+    std::vector<TraceEvent> events = getEvents();
+    uint64_t origin = (events.empty() ? 0 : events.front().start_);
+
+    stream << "{\"traceEvents\":[";
+    size_t numThreads = 0;
+    for (size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent& event = events[i];
+        numThreads = std::max(numThreads, event.threadID_ + 1);
+
+        stream << (i > 0 ? ",\n" : "\n") << "{\"name\":";
+        writeJSONString(stream, event.name_);
+        stream << ",\"cat\":";
+        writeJSONString(stream, event.category_);
+        stream << ",\"ph\":\"X\",\"ts\":";
+        writeMicroseconds(stream, event.start_ - origin);
+        stream << ",\"dur\":";
+        writeMicroseconds(stream, event.duration_);
+        stream << ",\"pid\":1,\"tid\":" << event.threadID_ << "}";
+    }
+    for (size_t i = 0; i < numThreads; ++i) {
+        stream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+               << ",\"args\":{\"name\":\"Thread " << i << "\"}}";
+    }
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void Tracer::writeChromeTrace(const std::string& filename)
+        throw (VoreenException)
+{
+    std::ofstream stream(filename.c_str());
+    if (!stream.good())
+        throw VoreenException("Failed to open trace file for writing: " + filename);
+    writeChromeTrace(stream);
+    if (!stream.good())
+        throw VoreenException("Failed to write trace file: " + filename);
+}
+
+//---------------------------------------------------------------------------------------
+
+TraceSpan::TraceSpan(const char* category, const char* name)
+    : category_(category)
+    , start_(0)
+{
+    if (Tracer::isEnabled()) {
+        name_ = name;
+        start_ = Tracer::getTimestamp();
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    if (start_ != 0)
+        Tracer::recordSpan(category_, name_, start_, Tracer::getTimestamp());
+}
+
+} // namespace